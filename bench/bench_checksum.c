@@ -0,0 +1,153 @@
+/**
+ * @file bench_checksum.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Frame checksum kernels: Tacho_ChecksumXor() (VDO) and Tacho_ChecksumSum()
+ * (Stoneridge)
+ *
+ * The kernel is picked at build time (TACHO_CFG_CHECKSUM_KERNEL), so the
+ * Makefile builds this program once per kernel. Each build first checks
+ * its results against a byte loop on every length up to 300 at every
+ * alignment, then times the frame sizes (45 to 48 byte Stoneridge, 70, 88
+ * and 106 byte VDO) and bulk buffers.
+ *
+ * Usage: bench_checksum [scale]
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "std_types.h"
+#include "tacho_countries.h"
+#include "tacho.h"
+#include "tacho_d8.h"
+#include "tacho_ctx.h"
+#include "tacho_checksum.h"
+#include "bench_util.h"
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#define BENCH_MAX_CHECK 300U  /**< Lengths checked against the byte loop */
+#define BENCH_ALIGNMENTS 16U  /**< Buffer offsets checked */
+#define BENCH_BUF_SIZE (1UL << 20)  /**< Largest buffer */
+#define BENCH_BYTES_PER_SIZE (64UL << 20)  /**< Bytes checksummed per size and scale unit */
+
+/******************************************************************************/
+/*    PRIVATE DATA                                                            */
+/******************************************************************************/
+
+static uint8_t Bench_Buf[BENCH_BUF_SIZE + BENCH_ALIGNMENTS];  /**< Random data */
+
+/** Sizes timed: Stoneridge and VDO frames, then bulk buffers */
+static const uint32_t Bench_Sizes[] = {45U, 46U, 47U, 48U, 70U, 88U, 106U, 4096U, 65536U, BENCH_BUF_SIZE};
+
+#if (TACHO_CFG_CHECKSUM_KERNEL == TACHO_CHECKSUM_KERNEL_SCALAR)
+static const char Bench_Kernel[] = "scalar";
+#elif (TACHO_CFG_CHECKSUM_KERNEL == TACHO_CHECKSUM_KERNEL_WORD)
+static const char Bench_Kernel[] = "word";
+#elif (TACHO_CFG_CHECKSUM_KERNEL == TACHO_CHECKSUM_KERNEL_SSE2)
+static const char Bench_Kernel[] = "sse2";
+#else
+static const char Bench_Kernel[] = "neon";
+#endif
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+/**
+ * Checks both kernels against a byte loop
+ * @return Number of mismatches
+ */
+static uint32_t Bench_Check(void)
+{
+    uint32_t errors = 0;
+    uint32_t align;
+    uint32_t len;
+    uint32_t i;
+    uint8_t x;
+    uint8_t s;
+
+    for (align = 0; align < BENCH_ALIGNMENTS; align++)
+    {
+        for (len = 0; len <= BENCH_MAX_CHECK; len++)
+        {
+            x = (uint8_t) len;
+            s = (uint8_t) len;
+            for (i = 0; i < len; i++)
+            {
+                x ^= Bench_Buf[align + i];
+                s = (uint8_t) (s + Bench_Buf[align + i]);
+            }
+            if (x != Tacho_ChecksumXor(&Bench_Buf[align], len, (uint8_t) len))
+            {
+                errors++;
+            }
+            if (s != Tacho_ChecksumSum(&Bench_Buf[align], len, (uint8_t) len))
+            {
+                errors++;
+            }
+        }
+    }
+    return errors;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t scale = (1 < argc) ? (uint32_t) strtoul(argv[1], NULL, 0) : 1U;
+    uint32_t rng = 0x9E3779B9UL;
+    volatile uint8_t sink = 0;
+    uint8_t acc;
+    uint32_t errors;
+    uint32_t reps;
+    uint32_t c;
+    uint32_t i;
+    uint64_t t0;
+    double xor_ns;
+    double sum_ns;
+
+    for (i = 0; i < sizeof(Bench_Buf); i++)
+    {
+        Bench_Buf[i] = (uint8_t) Bench_Rand(&rng);
+    }
+
+    errors = Bench_Check();
+    printf("kernel %s: %u mismatches against the byte loop\n", Bench_Kernel, (unsigned) errors);
+
+    printf("%8s %12s %9s %12s %9s\n", "bytes", "xor ns/call", "GB/s", "sum ns/call", "GB/s");
+    for (c = 0; c < sizeof(Bench_Sizes) / sizeof(Bench_Sizes[0]); c++)
+    {
+        reps = (uint32_t) ((BENCH_BYTES_PER_SIZE * scale) / Bench_Sizes[c]);
+
+        /* Chained through init, so that calls cannot overlap or be hoisted */
+        acc = 0;
+        t0 = Bench_Nanos();
+        for (i = 0; i < reps; i++)
+        {
+            acc = Tacho_ChecksumXor(&Bench_Buf[acc & 7U], Bench_Sizes[c], acc);
+        }
+        xor_ns = (double) (Bench_Nanos() - t0) / reps;
+        sink ^= acc;
+
+        acc = 0;
+        t0 = Bench_Nanos();
+        for (i = 0; i < reps; i++)
+        {
+            acc = Tacho_ChecksumSum(&Bench_Buf[acc & 7U], Bench_Sizes[c], acc);
+        }
+        sum_ns = (double) (Bench_Nanos() - t0) / reps;
+        sink ^= acc;
+
+        printf("%8u %12.2f %9.2f %12.2f %9.2f\n", (unsigned) Bench_Sizes[c],
+               xor_ns, Bench_Sizes[c] / xor_ns, sum_ns, Bench_Sizes[c] / sum_ns);
+    }
+    (void) sink;
+
+    return (0U == errors) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,286 @@
+/**
+ * @file bench_column.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Columnar blocks (tacho_column.c) against the raw D8 capture of one week
+ *
+ * A week of 1 Hz VDO history frames follows a day shift pattern: driving at
+ * a varying speed with short breaks during the day, resting at night, with
+ * the card changing every day. The frames are written in one block per hour
+ * and compared with the size of the same frames as D8 bytes. The query is
+ * the maximum speed per hour, answered from the stamp and speed columns only
+ * and, for comparison, by decoding every column of each block. A run whose
+ * blocks do not read back the frames, or whose query answers disagree, is
+ * reported as failed.
+ *
+ * Usage: bench_column [repetitions]
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "std_types.h"
+#include "tacho_countries.h"
+#include "tacho.h"
+#include "tacho_d8.h"
+#include "tacho_ctx.h"
+#include "tacho_encode.h"
+#include "tacho_column.h"
+#include "bench_util.h"
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#define BENCH_HOUR 3600U  /**< Frames per hour, and per block */
+#define BENCH_HOURS (7U * 24U)  /**< Hours of history */
+#define BENCH_FRAMES (BENCH_HOURS * BENCH_HOUR)
+#define BENCH_OUT_SIZE (BENCH_FRAMES * 8U)  /**< Room for the blocks */
+#define BENCH_TARGET_RATIO 20.0  /**< Minimum size reduction against the D8 capture */
+
+/******************************************************************************/
+/*    PRIVATE DATA                                                            */
+/******************************************************************************/
+
+static Tacho_HistFrame_t Bench_Frames[BENCH_FRAMES];  /**< Frames written */
+static Tacho_HistFrame_t Bench_Back[BENCH_HOUR];  /**< Frames of one block read back */
+static uint8_t Bench_Out[BENCH_OUT_SIZE];  /**< Concatenated blocks */
+static uint32_t Bench_Stamps[BENCH_HOUR];  /**< Stamp column of one block */
+static uint32_t Bench_Speeds[BENCH_HOUR];  /**< Speed column of one block */
+static uint32_t Bench_Expected[BENCH_HOURS];  /**< Maximum speed per hour of the frames */
+static uint32_t Bench_Max[BENCH_HOURS];  /**< Maximum speed per hour found by a query */
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+/**
+ * Builds the week of frames
+ * @return Size of the same frames as a D8 capture in bytes
+ */
+static uint32_t Bench_Build(void)
+{
+    uint8_t raw[BENCH_MAX_FRAME];
+    Tacho_Frame_t frame;
+    Tacho_HistFrame_t *hist;
+    uint32_t rng = 0x5EEDU;
+    uint32_t odometer = 200000000UL;
+    uint32_t raw_size = 0;
+    uint32_t speed = 0;
+    uint32_t k, hour;
+    bool_t driving;
+
+    memset(Bench_Expected, 0, sizeof(Bench_Expected));
+    for (k = 0; k < BENCH_FRAMES; k++)
+    {
+        hour = (k / BENCH_HOUR) % 24U;
+        driving = (bool_t) ( (6U <= hour) && (18U > hour) && (0U != (k / 600U) % 5U) );
+
+        memset(&frame, 0, sizeof(frame));
+        if (driving)
+        {
+            speed = MAX(42U, speed) + (Bench_Rand(&rng) % 5U) - 2U;
+            speed = MAX(40U, MIN(90U, speed));
+            frame.working_state = 0x03U;
+            frame.driver1_state = 0x03U;
+            frame.speed_msb = (uint8_t) speed;
+            frame.speed_lsb = (uint8_t) Bench_Rand(&rng);
+            odometer += speed / 18U;  /* km/h to 5 m/s */
+        }
+        else
+        {
+            speed = 0;
+            frame.working_state = ( (6U > hour) || (18U <= hour) ) ? 0x00U : 0x02U;
+            frame.driver1_state = frame.working_state;
+        }
+        memcpy(frame.driver[0].country, "RO ", TACHO_MAX_COUNTRY_CODE);
+        memcpy(frame.driver[0].cardnr, (0U != (k / (24U * BENCH_HOUR)) % 2U) ? "0000000000086H10" : "DF00000012345678",
+               TACHO_MAX_CARD_NR);
+        Bench_SetTime(&frame.vdo.time, BENCH_TIME_BASE + k);
+        frame.vdo.odometer = odometer;
+        frame.vdo.trip = odometer - 200000000UL;
+        frame.vdo.k_factor = 8000U;
+        raw_size += Tacho_EncodeVdo(&frame, (const uint8_t *) BENCH_VIN, BENCH_VIN_LEN,
+                                    (const uint8_t *) BENCH_CSTR, BENCH_CSTR_LEN, raw, sizeof(raw));
+
+        /* As Tacho_HistoryPush() records it */
+        hist = &Bench_Frames[k];
+        memset(hist, 0, sizeof(*hist));
+        hist->stamp = k;
+        hist->seq = (uint16_t) k;
+        hist->standard = TACHO_STANDARD_VDO;
+        hist->tco1[TACHO_TCO1_WORKING_STATE] = frame.working_state;
+        hist->tco1[TACHO_TCO1_DRV1_STATE] = frame.driver1_state;
+        hist->tco1[TACHO_TCO1_SPEED_LSB] = frame.speed_lsb;
+        hist->tco1[TACHO_TCO1_SPEED_MSB] = frame.speed_msb;
+        memcpy(hist->driver, frame.driver, sizeof(hist->driver));
+        hist->time = frame.vdo.time;
+        hist->odometer = frame.vdo.odometer;
+        hist->trip = frame.vdo.trip;
+
+        Bench_Expected[k / BENCH_HOUR] = MAX(Bench_Expected[k / BENCH_HOUR],
+                                             ((uint32_t) frame.speed_msb << 8) | frame.speed_lsb);
+    }
+    return raw_size;
+}
+
+/**
+ * Maximum speed per hour from the stamp and speed columns
+ * @param len Size of the blocks in bytes
+ */
+static void Bench_QueryColumns(uint32_t len)
+{
+    Tacho_ColumnBlock_t block;
+    uint32_t pos;
+    uint32_t hour;
+    uint16_t count, i;
+
+    memset(Bench_Max, 0, sizeof(Bench_Max));
+    for (pos = 0; (pos < len) && (E_OK == Tacho_ColumnOpen(&Bench_Out[pos], len - pos, &block)); pos += block.size)
+    {
+        count = Tacho_ColumnRead(&block, TACHO_COLUMN_STAMP, Bench_Stamps, BENCH_HOUR);
+        count = MIN(count, Tacho_ColumnRead(&block, TACHO_COLUMN_SPEED, Bench_Speeds, BENCH_HOUR));
+        for (i = 0; i < count; i++)
+        {
+            hour = Bench_Stamps[i] / BENCH_HOUR;
+            if ( (BENCH_HOURS > hour) && (Bench_Speeds[i] > Bench_Max[hour]) )
+            {
+                Bench_Max[hour] = Bench_Speeds[i];
+            }
+        }
+    }
+}
+
+/**
+ * Maximum speed per hour from fully decoded frames
+ * @param len Size of the blocks in bytes
+ */
+static void Bench_QueryFrames(uint32_t len)
+{
+    Tacho_ColumnBlock_t block;
+    uint32_t pos;
+    uint32_t hour;
+    uint32_t speed;
+    uint16_t count, i;
+
+    memset(Bench_Max, 0, sizeof(Bench_Max));
+    for (pos = 0; (pos < len) && (E_OK == Tacho_ColumnOpen(&Bench_Out[pos], len - pos, &block)); pos += block.size)
+    {
+        count = Tacho_ColumnDecode(&block, Bench_Back, BENCH_HOUR);
+        for (i = 0; i < count; i++)
+        {
+            hour = Bench_Back[i].stamp / BENCH_HOUR;
+            speed = ((uint32_t) Bench_Back[i].tco1[TACHO_TCO1_SPEED_MSB] << 8) | Bench_Back[i].tco1[TACHO_TCO1_SPEED_LSB];
+            if ( (BENCH_HOURS > hour) && (speed > Bench_Max[hour]) )
+            {
+                Bench_Max[hour] = speed;
+            }
+        }
+    }
+}
+
+/**
+ * Reads every block back
+ * @param len Size of the blocks in bytes
+ * @return E_OK if the blocks hold exactly the frames written
+ */
+static Std_ReturnType Bench_Verify(uint32_t len)
+{
+    Tacho_ColumnBlock_t block;
+    uint32_t pos;
+    uint32_t k = 0;
+    uint16_t count;
+
+    for (pos = 0; pos < len; pos += block.size)
+    {
+        if (E_OK != Tacho_ColumnOpen(&Bench_Out[pos], len - pos, &block))
+        {
+            return E_NOT_OK;
+        }
+        count = Tacho_ColumnDecode(&block, Bench_Back, BENCH_HOUR);
+        if ( (count != block.count) || (BENCH_FRAMES - k < count) ||
+             (0 != memcmp(Bench_Back, &Bench_Frames[k], count * sizeof(Tacho_HistFrame_t))) )
+        {
+            return E_NOT_OK;
+        }
+        k += count;
+    }
+    return (BENCH_FRAMES == k) ? E_OK : E_NOT_OK;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t reps = (1 < argc) ? (uint32_t) strtoul(argv[1], NULL, 0) : 20U;
+    Std_ReturnType op_status = E_OK;
+    uint32_t raw_size;
+    uint32_t len = 0;
+    uint32_t size;
+    uint32_t k, i;
+    uint64_t t0;
+    double write_ns, column_ns, frame_ns;
+    double ratio;
+
+    raw_size = Bench_Build();
+
+    t0 = Bench_Nanos();
+    for (k = 0; k < BENCH_FRAMES; k += BENCH_HOUR)
+    {
+        size = Tacho_ColumnWrite(&Bench_Frames[k], BENCH_HOUR, &Bench_Out[len], sizeof(Bench_Out) - len);
+        if (0U == size)
+        {
+            printf("block %u not written\n", (unsigned) (k / BENCH_HOUR));
+            return EXIT_FAILURE;
+        }
+        len += size;
+    }
+    write_ns = (double) (Bench_Nanos() - t0) / BENCH_FRAMES;
+
+    if (E_OK != Bench_Verify(len))
+    {
+        printf("blocks do not read back the frames\n");
+        op_status = E_NOT_OK;
+    }
+
+    t0 = Bench_Nanos();
+    for (i = 0; i < reps; i++)
+    {
+        Bench_QueryColumns(len);
+    }
+    column_ns = (double) (Bench_Nanos() - t0) / ((double) BENCH_FRAMES * reps);
+    if (0 != memcmp(Bench_Max, Bench_Expected, sizeof(Bench_Max)))
+    {
+        printf("column query: wrong maximum speeds\n");
+        op_status = E_NOT_OK;
+    }
+
+    t0 = Bench_Nanos();
+    for (i = 0; i < reps; i++)
+    {
+        Bench_QueryFrames(len);
+    }
+    frame_ns = (double) (Bench_Nanos() - t0) / ((double) BENCH_FRAMES * reps);
+    if (0 != memcmp(Bench_Max, Bench_Expected, sizeof(Bench_Max)))
+    {
+        printf("frame query: wrong maximum speeds\n");
+        op_status = E_NOT_OK;
+    }
+
+    ratio = (double) raw_size / (double) len;
+    printf("%u frames: D8 capture %u bytes, columnar %u bytes (%.2f bytes/frame), %.1fx smaller\n",
+           (unsigned) BENCH_FRAMES, (unsigned) raw_size, (unsigned) len, (double) len / BENCH_FRAMES, ratio);
+    printf("write                         %6.2f ns/frame\n", write_ns);
+    printf("max speed per hour, columns   %6.2f ns/frame %7.1f Mframes/s\n", column_ns, 1e3 / column_ns);
+    printf("max speed per hour, frames    %6.2f ns/frame %7.1f Mframes/s\n", frame_ns, 1e3 / frame_ns);
+    if (BENCH_TARGET_RATIO > ratio)
+    {
+        printf("size reduction below %.0fx\n", BENCH_TARGET_RATIO);
+        op_status = E_NOT_OK;
+    }
+
+    return (E_OK == op_status) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
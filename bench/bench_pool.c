@@ -0,0 +1,213 @@
+/**
+ * @file bench_pool.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Sustained throughput and latency of a decoder pool (tacho_pool.c) with
+ * many streams
+ *
+ * Each stream carries the same BENCH_FRAMES VDO frames. The streams are fed
+ * round-robin, one read per stream and round as a gateway polling its
+ * sockets would see them: through Tacho_PoolRxBlock() with 32 and 256 byte
+ * reads, and through Tacho_PoolRxNotif() with Tacho_PoolTask() runs of
+ * BENCH_BUDGET streams after every round. Throughput is measured on one
+ * pass; a second pass timestamps every read and takes the time from the
+ * read holding the last byte of a frame to the sink, reported as p50 and
+ * p99. A run where any frame misses the sink is reported as failed.
+ *
+ * Usage: bench_pool [streams]
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "std_types.h"
+#include "tacho_countries.h"
+#include "tacho.h"
+#include "tacho_d8.h"
+#include "tacho_ctx.h"
+#include "tacho_pool.h"
+#include "bench_util.h"
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#define BENCH_MAX_STREAMS 10000U  /**< Streams of the pool (default and maximum) */
+#define BENCH_FRAMES 20U  /**< Frames per stream */
+#define BENCH_BUDGET 64U  /**< Streams serviced by a Tacho_PoolTask() run (byte path) */
+#define BENCH_BYTE_PATH 0U  /**< Read size standing for Tacho_PoolRxNotif() */
+
+/******************************************************************************/
+/*    PRIVATE DATA                                                            */
+/******************************************************************************/
+
+static Tacho_Ctx_t Bench_Ctx[BENCH_MAX_STREAMS];  /**< One context per stream */
+static uint8_t Bench_Data[BENCH_FRAMES * BENCH_MAX_FRAME];  /**< Frames of every stream */
+static uint32_t Bench_Len;  /**< Bytes in Bench_Data */
+static uint16_t Bench_Count;  /**< Streams in use */
+static uint32_t Bench_Decoded[BENCH_MAX_STREAMS];  /**< Frames reaching the sink, per stream */
+static uint64_t Bench_FedAt[BENCH_MAX_STREAMS];  /**< Time of the last read of each stream, 0 when not timed */
+static uint32_t Bench_Latency[BENCH_MAX_STREAMS * BENCH_FRAMES];  /**< Read to sink, in ns */
+static uint32_t Bench_Samples;  /**< Entries in Bench_Latency */
+
+/** Read sizes, BENCH_BYTE_PATH last */
+static const uint32_t Bench_Reads[] = {32U, 256U, BENCH_BYTE_PATH};
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+/**
+ * Sink: counts the frame and, on a timed pass, its latency
+ * @param pool Decoder pool
+ * @param stream Stream index
+ * @param ctx Context of the stream
+ */
+static void Bench_SinkFrame(Tacho_Pool_t *pool, uint16_t stream, Tacho_Ctx_t *ctx)
+{
+    (void) pool;
+    (void) ctx;
+
+    Bench_Decoded[stream]++;
+    if ( (0U != Bench_FedAt[stream]) && (BENCH_MAX_STREAMS * BENCH_FRAMES > Bench_Samples) )
+    {
+        Bench_Latency[Bench_Samples++] = (uint32_t) (Bench_Nanos() - Bench_FedAt[stream]);
+    }
+}
+
+/**
+ * qsort() comparison of two latencies
+ * @param a[in] First latency
+ * @param b[in] Second latency
+ * @return Sign of a - b
+ */
+static int Bench_Compare(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *) a;
+    uint32_t y = *(const uint32_t *) b;
+
+    return (x > y) - (x < y);
+}
+
+/**
+ * Feeds every stream once, round-robin
+ * @param pool Decoder pool
+ * @param read Bytes per read, BENCH_BYTE_PATH for Tacho_PoolRxNotif()
+ * @param timed TRUE to timestamp every read
+ */
+static void Bench_Feed(Tacho_Pool_t *pool, uint32_t read, bool_t timed)
+{
+    uint32_t chunk = (BENCH_BYTE_PATH == read) ? 32U : read;
+    uint32_t pos, n, i;
+    uint16_t s;
+
+    for (pos = 0; pos < Bench_Len; pos += chunk)
+    {
+        n = MIN(chunk, Bench_Len - pos);
+        for (s = 0; s < Bench_Count; s++)
+        {
+            if (timed)
+            {
+                Bench_FedAt[s] = Bench_Nanos();
+            }
+            if (BENCH_BYTE_PATH == read)
+            {
+                for (i = 0; i < n; i++)
+                {
+                    Tacho_PoolRxNotif(pool, s, Bench_Data[pos + i]);
+                }
+            }
+            else
+            {
+                Tacho_PoolRxBlock(pool, s, &Bench_Data[pos], n);
+            }
+        }
+        if (BENCH_BYTE_PATH == read)
+        {
+            while (0U < Tacho_PoolTask(pool, BENCH_BUDGET))
+            {
+            }
+        }
+    }
+}
+
+/**
+ * Benchmarks one read size
+ * @param read Bytes per read, BENCH_BYTE_PATH for Tacho_PoolRxNotif()
+ * @return E_OK if every frame reached the sink
+ */
+static Std_ReturnType Bench_Run(uint32_t read)
+{
+    static const Tacho_PoolSink_t sink = { Bench_SinkFrame, NULL_PTR, NULL_PTR };
+    Tacho_Pool_t pool;
+    uint32_t decoded = 0;
+    uint32_t s;
+    uint64_t t0;
+    double seconds;
+    char name[32];
+
+    Tacho_PoolInit(&pool, Bench_Ctx, Bench_Count, &sink, NULL_PTR);
+    for (s = 0; s < Bench_Count; s++)
+    {
+        Bench_Decoded[s] = 0;
+        Bench_FedAt[s] = 0;
+    }
+
+    t0 = Bench_Nanos();
+    Bench_Feed(&pool, read, FALSE);
+    seconds = (double) (Bench_Nanos() - t0) * 1e-9;
+
+    /* Same frames again, timed */
+    Bench_Samples = 0;
+    Bench_Feed(&pool, read, TRUE);
+    qsort(Bench_Latency, Bench_Samples, sizeof(Bench_Latency[0]), Bench_Compare);
+
+    for (s = 0; s < Bench_Count; s++)
+    {
+        decoded += Bench_Decoded[s];
+    }
+
+    if (BENCH_BYTE_PATH == read)
+    {
+        (void) snprintf(name, sizeof(name), "RxNotif+Task/%u", (unsigned) BENCH_BUDGET);
+    }
+    else
+    {
+        (void) snprintf(name, sizeof(name), "RxBlock %u B", (unsigned) read);
+    }
+    printf("%-16s %8.1f MB/s %6.2f Mframes/s  read to sink p50 %8u ns p99 %8u ns  %u/%u frames\n",
+           name, (double) Bench_Len * Bench_Count / seconds * 1e-6,
+           (double) Bench_Count * BENCH_FRAMES / seconds * 1e-6,
+           (unsigned) ((0U < Bench_Samples) ? Bench_Latency[Bench_Samples / 2U] : 0U),
+           (unsigned) ((0U < Bench_Samples) ? Bench_Latency[(Bench_Samples * 99U) / 100U] : 0U),
+           (unsigned) decoded, (unsigned) (2U * Bench_Count * BENCH_FRAMES));
+
+    return (2U * Bench_Count * BENCH_FRAMES == decoded) ? E_OK : E_NOT_OK;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t streams = (1 < argc) ? (uint32_t) strtoul(argv[1], NULL, 0) : BENCH_MAX_STREAMS;
+    Std_ReturnType op_status = E_OK;
+    uint32_t k;
+    uint32_t i;
+
+    Bench_Count = (uint16_t) MAX(1U, MIN(streams, BENCH_MAX_STREAMS));
+    for (k = 0; k < BENCH_FRAMES; k++)
+    {
+        Bench_Len += Bench_Encode(TACHO_STANDARD_VDO, k, &Bench_Data[Bench_Len], BENCH_MAX_FRAME);
+    }
+    printf("%u streams x %u VDO frames (%u bytes), %u bytes per context\n", (unsigned) Bench_Count,
+           (unsigned) BENCH_FRAMES, (unsigned) Bench_Len, (unsigned) sizeof(Tacho_Ctx_t));
+
+    for (i = 0; i < sizeof(Bench_Reads) / sizeof(Bench_Reads[0]); i++)
+    {
+        op_status |= Bench_Run(Bench_Reads[i]);
+    }
+
+    return (E_OK == op_status) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
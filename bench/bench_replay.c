@@ -0,0 +1,383 @@
+/**
+ * @file bench_replay.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Parallel replay of a raw D8 capture
+ *
+ * The capture is mmap()ed, cut into one chunk per thread at frame
+ * boundaries found with Tacho_FindFrame(), and each chunk is decoded by its
+ * own context with Tacho_CtxRxBlock(). Frames are collected through the
+ * frame_notif binding and emitted in capture order once every worker is
+ * done; here emitting folds each frame into an order-sensitive hash, which
+ * must be the same for every thread count.
+ *
+ * Without a file, a synthetic capture is generated (frames with junk bytes
+ * in between and one frame in 50 corrupted) and the frame count is also
+ * checked against the number of intact frames.
+ *
+ * Usage: bench_replay [capture_file [max_threads]]
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE  /* mmap(), sysconf(_SC_NPROCESSORS_ONLN) */
+#endif
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "std_types.h"
+#include "tacho_countries.h"
+#include "tacho.h"
+#include "tacho_d8.h"
+#include "tacho_ctx.h"
+#include "bench_util.h"
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#define BENCH_SYNTHETIC_SIZE (64UL << 20)  /**< Synthetic capture length in bytes */
+#define BENCH_CORRUPT_PERIOD 50U  /**< One synthetic frame in this many is corrupted */
+/*
+ * Corrupted bytes are taken among the fixed fields of both protocols: a
+ * corrupted length byte would move the checksum, which then matches once
+ * in 256 times, and the frame would take the next one with it.
+ */
+#define BENCH_CORRUPT_FIRST 5U  /**< First byte that may be corrupted */
+#define BENCH_CORRUPT_END 34U  /**< End of the bytes that may be corrupted */
+#define BENCH_JUNK_PERIOD 37U  /**< Junk bytes follow one synthetic frame in this many */
+#define BENCH_MAX_JUNK 20U  /**< Maximum junk bytes in a row */
+#define BENCH_MAX_THREADS 64U  /**< Maximum number of worker threads */
+#define BENCH_HASH_INIT 1469598103934665603ULL  /**< FNV-1a offset basis */
+#define BENCH_HASH_PRIME 1099511628211ULL  /**< FNV-1a prime */
+
+/******************************************************************************/
+/*    PRIVATE TYPES                                                           */
+/******************************************************************************/
+
+/** Chunk decoded by one worker thread */
+typedef struct
+{
+    Tacho_Ctx_t ctx;  /**< Decoder context of the chunk */
+    const uint8_t *buf;  /**< First byte of the chunk */
+    uint32_t len;  /**< Chunk length in bytes */
+    uint64_t *frames;  /**< Hash of each decoded frame, in chunk order */
+    uint32_t count;  /**< Number of decoded frames */
+    uint32_t size;  /**< Room in frames */
+} Bench_Job_t;
+
+/******************************************************************************/
+/*    PRIVATE DATA                                                            */
+/******************************************************************************/
+
+static Tacho_Standard_t Bench_Standard;  /**< Protocol of the capture */
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+/**
+ * Folds bytes into an FNV-1a hash
+ * @param hash Hash so far
+ * @param data[in] Bytes
+ * @param len Number of bytes
+ * @return New hash
+ */
+static uint64_t Bench_Hash(uint64_t hash, const void *data, uint32_t len)
+{
+    const uint8_t *p = (const uint8_t *) data;
+    uint32_t i;
+
+    for (i = 0; i < len; i++)
+    {
+        hash = (hash ^ p[i]) * BENCH_HASH_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * read_protocol binding: every context starts on the capture protocol
+ * @param ctx Decoder context
+ * @param data[out] Protocol
+ * @return E_OK
+ */
+static Std_ReturnType Bench_ReadProtocol(Tacho_Ctx_t *ctx, uint8_t *data)
+{
+    (void) ctx;
+    *data = (uint8_t) Bench_Standard;
+    return E_OK;
+}
+
+/**
+ * frame_notif binding: records a hash of the decoded frame
+ * Stoneridge driver IDs are left out: each message carries one of them, so
+ * a chunk only knows them once it has seen the corresponding messages. The
+ * bytes of an absent VDO card are stale, only present cards count.
+ * @param ctx Decoder context
+ */
+static void Bench_FrameNotif(Tacho_Ctx_t *ctx)
+{
+    Bench_Job_t *job = (Bench_Job_t *) ctx->user;
+    const Tacho_Frame_t *frame = &ctx->frame;
+    uint64_t hash = BENCH_HASH_INIT;
+    uint8_t i;
+
+    hash = Bench_Hash(hash, &frame->working_state, 1);
+    hash = Bench_Hash(hash, &frame->driver1_state, 1);
+    hash = Bench_Hash(hash, &frame->driver2_state, 1);
+    hash = Bench_Hash(hash, &frame->tacho_status, 1);
+    hash = Bench_Hash(hash, &frame->speed_msb, 1);
+    hash = Bench_Hash(hash, &frame->speed_lsb, 1);
+    if (TACHO_STANDARD_VDO == Bench_Standard)
+    {
+        for (i = 0; i < TACHO_MAX_DRIVERS; i++)
+        {
+            if ('\0' != frame->driver[i].cardnr[0])
+            {
+                hash = Bench_Hash(hash, &frame->driver[i], sizeof(frame->driver[i]));
+            }
+        }
+        hash = Bench_Hash(hash, &frame->vdo.time, sizeof(frame->vdo.time));
+        hash = Bench_Hash(hash, &frame->vdo.odometer, sizeof(frame->vdo.odometer));
+        hash = Bench_Hash(hash, &frame->vdo.trip, sizeof(frame->vdo.trip));
+        hash = Bench_Hash(hash, frame->vdo.vin.data, frame->vdo.vin.length);
+        hash = Bench_Hash(hash, frame->vdo.cstr.data, frame->vdo.cstr.length);
+    }
+
+    if (job->count == job->size)
+    {
+        job->size = (0U == job->size) ? 4096U : (2U * job->size);
+        job->frames = (uint64_t *) realloc(job->frames, job->size * sizeof(job->frames[0]));
+        if (NULL == job->frames)
+        {
+            abort();
+        }
+    }
+    job->frames[job->count++] = hash;
+}
+
+/** Bindings of the worker contexts */
+static const Tacho_CtxConfig_t Bench_Config =
+{
+    .read_protocol = Bench_ReadProtocol,
+    .frame_notif = Bench_FrameNotif,
+};
+
+/**
+ * Worker thread: decodes one chunk
+ * @param arg Chunk (Bench_Job_t)
+ * @return NULL
+ */
+static void *Bench_Worker(void *arg)
+{
+    Bench_Job_t *job = (Bench_Job_t *) arg;
+
+    Tacho_CtxInit(&job->ctx, &Bench_Config, job);
+    Tacho_CtxRxBlock(&job->ctx, job->buf, job->len);
+    return NULL;
+}
+
+/**
+ * Replays a capture
+ * @param buf[in] Capture
+ * @param len Capture length in bytes
+ * @param threads Number of worker threads
+ * @param frames[out] Number of decoded frames
+ * @return Order-sensitive hash of the decoded frames
+ */
+static uint64_t Bench_Replay(const uint8_t *buf, uint32_t len, uint32_t threads, uint32_t *frames)
+{
+    static Bench_Job_t jobs[BENCH_MAX_THREADS];
+    pthread_t thread[BENCH_MAX_THREADS];
+    uint32_t cut[BENCH_MAX_THREADS + 1U];
+    uint64_t hash = BENCH_HASH_INIT;
+    uint32_t hint;
+    uint32_t i;
+    uint32_t k;
+
+    /* Cut at the first complete frame after each equal share */
+    cut[0] = 0;
+    cut[threads] = len;
+    for (i = 1; i < threads; i++)
+    {
+        hint = (uint32_t) (((uint64_t) len * i) / threads);
+        hint = MAX(hint, cut[i - 1U]);
+        cut[i] = hint + Tacho_FindFrame(Bench_Standard, &buf[hint], len - hint);
+    }
+
+    for (i = 0; i < threads; i++)
+    {
+        jobs[i].buf = &buf[cut[i]];
+        jobs[i].len = cut[i + 1U] - cut[i];
+        jobs[i].count = 0;
+        if (0 != pthread_create(&thread[i], NULL, Bench_Worker, &jobs[i]))
+        {
+            abort();
+        }
+    }
+
+    /* Emit the frames in capture order */
+    *frames = 0;
+    for (i = 0; i < threads; i++)
+    {
+        (void) pthread_join(thread[i], NULL);
+        for (k = 0; k < jobs[i].count; k++)
+        {
+            hash = Bench_Hash(hash, &jobs[i].frames[k], sizeof(jobs[i].frames[k]));
+        }
+        *frames += jobs[i].count;
+    }
+    return hash;
+}
+
+/**
+ * Generates a synthetic capture
+ * @param standard Protocol
+ * @param out[out] Capture
+ * @param size Size of out in bytes
+ * @param intact[out] Number of intact frames
+ * @return Capture length in bytes
+ */
+static uint32_t Bench_Generate(Tacho_Standard_t standard, uint8_t *out, uint32_t size, uint32_t *intact)
+{
+    uint32_t rng = 0x1234567UL;
+    uint32_t len = 0;
+    uint32_t k;
+    uint16_t n;
+    uint32_t junk;
+
+    *intact = 0;
+    for (k = 0; size - len >= BENCH_MAX_FRAME + BENCH_MAX_JUNK; k++)
+    {
+        n = Bench_Encode(standard, k, &out[len], BENCH_MAX_FRAME);
+        if (0U == (k % BENCH_CORRUPT_PERIOD))
+        {
+            out[len + BENCH_CORRUPT_FIRST + (Bench_Rand(&rng) % (BENCH_CORRUPT_END - BENCH_CORRUPT_FIRST))] ^= 0x10U;
+        }
+        else
+        {
+            (*intact)++;
+        }
+        len += n;
+
+        /* Junk never contains start sequence bytes, so it cannot hide a frame */
+        if (0U == (k % BENCH_JUNK_PERIOD))
+        {
+            for (junk = 1U + (Bench_Rand(&rng) % BENCH_MAX_JUNK); junk > 0U; junk--)
+            {
+                out[len++] = (uint8_t) (Bench_Rand(&rng) % 0x50U);
+            }
+        }
+    }
+    return len;
+}
+
+/**
+ * Replays a capture with 1, 2, 4... threads
+ * @param name Capture name
+ * @param buf[in] Capture
+ * @param len Capture length in bytes
+ * @param max_threads Maximum number of threads
+ * @param expected Expected number of frames, 0 if not known
+ * @return E_OK if every run gave the same frames
+ */
+static Std_ReturnType Bench_Run(const char *name, const uint8_t *buf, uint32_t len, uint32_t max_threads, uint32_t expected)
+{
+    Std_ReturnType op_status = E_OK;
+    uint64_t first_hash = 0;
+    uint64_t hash;
+    uint64_t t0;
+    double single = 0.0;
+    double seconds;
+    uint32_t frames;
+    uint32_t threads;
+
+    for (threads = 1; threads <= max_threads; threads *= 2U)
+    {
+        t0 = Bench_Nanos();
+        hash = Bench_Replay(buf, len, threads, &frames);
+        seconds = (double) (Bench_Nanos() - t0) * 1e-9;
+        if (1U == threads)
+        {
+            single = seconds;
+            first_hash = hash;
+        }
+        printf("%-10s %2u threads %9u frames  hash %016llx %6.2f GB/s %5.2fx\n", name, (unsigned) threads,
+               (unsigned) frames, (unsigned long long) hash, (double) len / seconds * 1e-9, single / seconds);
+        if ( (hash != first_hash) || ( (0U != expected) && (frames != expected) ) )
+        {
+            op_status = E_NOT_OK;
+        }
+    }
+    if (E_OK != op_status)
+    {
+        printf("%-10s FAILED (expected %u frames, same hash for every run)\n", name, (unsigned) expected);
+    }
+    return op_status;
+}
+
+int main(int argc, char **argv)
+{
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t max_threads = (2 < argc) ? (uint32_t) strtoul(argv[2], NULL, 0) : 8U;
+    Std_ReturnType op_status = E_OK;
+    struct stat st;
+    uint8_t *buf;
+    uint32_t len;
+    uint32_t intact;
+    int fd;
+
+    max_threads = MIN(MAX(max_threads, 1U), BENCH_MAX_THREADS);
+    printf("%ld cores online\n", cores);
+
+    if (1 < argc)
+    {
+        fd = open(argv[1], O_RDONLY);
+        if ( (0 > fd) || (0 != fstat(fd, &st)) || (0 == st.st_size) || (0xFFFFFFFFLL < (long long) st.st_size) )
+        {
+            printf("cannot open %s\n", argv[1]);
+            return EXIT_FAILURE;
+        }
+        len = (uint32_t) st.st_size;
+        buf = (uint8_t *) mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+        (void) close(fd);
+        if (MAP_FAILED == buf)
+        {
+            printf("cannot map %s\n", argv[1]);
+            return EXIT_FAILURE;
+        }
+        if (len == Tacho_DetectFrame(buf, len, &Bench_Standard))
+        {
+            printf("no frame in %s\n", argv[1]);
+            return EXIT_FAILURE;
+        }
+        op_status = Bench_Run(argv[1], buf, len, max_threads, 0);
+        (void) munmap(buf, len);
+    }
+    else
+    {
+        buf = (uint8_t *) malloc(BENCH_SYNTHETIC_SIZE);
+        if (NULL == buf)
+        {
+            return EXIT_FAILURE;
+        }
+        Bench_Standard = TACHO_STANDARD_VDO;
+        len = Bench_Generate(Bench_Standard, buf, BENCH_SYNTHETIC_SIZE, &intact);
+        op_status |= Bench_Run("VDO", buf, len, max_threads, intact);
+        Bench_Standard = TACHO_STANDARD_STONERIDGE;
+        len = Bench_Generate(Bench_Standard, buf, BENCH_SYNTHETIC_SIZE, &intact);
+        op_status |= Bench_Run("Stoneridge", buf, len, max_threads, intact);
+        free(buf);
+    }
+
+    return (E_OK == op_status) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
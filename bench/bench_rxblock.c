@@ -0,0 +1,160 @@
+/**
+ * @file bench_rxblock.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Byte path (Tacho_CtxRxNotif() + Tacho_CtxTask()) against block path
+ * (Tacho_CtxRxBlock()) on the same streams
+ *
+ * The block path is fed in chunks of several sizes, like read() returns
+ * them on a gateway. Results are in ns/byte; frames are counted through the
+ * frame_notif binding and a run that loses any frame is reported as failed.
+ *
+ * Usage: bench_rxblock [repetitions]
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "std_types.h"
+#include "tacho_countries.h"
+#include "tacho.h"
+#include "tacho_d8.h"
+#include "tacho_ctx.h"
+#include "bench_util.h"
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#define BENCH_STREAM_SIZE (1UL << 20)  /**< Stream length in bytes */
+#define BENCH_TASK_PERIOD (TACHO_RX_QUEUE_SIZE / 2U)  /**< Bytes received between two task runs (byte path) */
+#define BENCH_BYTE_PATH 0U  /**< Chunk size standing for the byte path */
+
+/******************************************************************************/
+/*    PRIVATE DATA                                                            */
+/******************************************************************************/
+
+static uint8_t Bench_Data[BENCH_STREAM_SIZE];  /**< Stream being fed */
+static uint32_t Bench_Decoded;  /**< Frames reported by frame_notif */
+static Tacho_Ctx_t Bench_Ctx;  /**< Decoder under test */
+
+/** Chunk sizes, BENCH_BYTE_PATH first */
+static const uint32_t Bench_Chunks[] = {BENCH_BYTE_PATH, 16U, 64U, 256U, 1024U, 4096U};
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+/**
+ * frame_notif binding: counts decoded frames
+ * @param ctx Decoder context
+ */
+static void Bench_FrameNotif(Tacho_Ctx_t *ctx)
+{
+    (void) ctx;
+    Bench_Decoded++;
+}
+
+/** Bindings of the decoder under test */
+static const Tacho_CtxConfig_t Bench_Config =
+{
+    .frame_notif = Bench_FrameNotif,
+};
+
+/**
+ * Feeds a stream once
+ * @param len Stream length in bytes
+ * @param chunk Chunk size, BENCH_BYTE_PATH for the byte path
+ */
+static void Bench_Feed(uint32_t len, uint32_t chunk)
+{
+    uint32_t i;
+
+    if (BENCH_BYTE_PATH == chunk)
+    {
+        for (i = 0; i < len; i++)
+        {
+            Tacho_CtxRxNotif(&Bench_Ctx, Bench_Data[i]);
+            if ((BENCH_TASK_PERIOD - 1U) == (i % BENCH_TASK_PERIOD))
+            {
+                Tacho_CtxTask(&Bench_Ctx);
+            }
+        }
+        Tacho_CtxTask(&Bench_Ctx);
+        return;
+    }
+
+    for (i = 0; i < len; i += chunk)
+    {
+        Tacho_CtxRxBlock(&Bench_Ctx, &Bench_Data[i], MIN(chunk, len - i));
+    }
+}
+
+/**
+ * Benchmarks one protocol on every path
+ * @param name Protocol name
+ * @param standard Protocol
+ * @param reps Number of timed passes over the stream
+ * @return E_OK if every frame was decoded
+ */
+static Std_ReturnType Bench_Run(const char *name, Tacho_Standard_t standard, uint32_t reps)
+{
+    uint32_t frames;
+    uint32_t len = Bench_Stream(standard, 0, Bench_Data, sizeof(Bench_Data), &frames);
+    Std_ReturnType op_status = E_OK;
+    double byte_ns = 0.0;
+    double ns;
+    uint64_t t0;
+    uint32_t c;
+    uint32_t i;
+
+    for (c = 0; c < sizeof(Bench_Chunks) / sizeof(Bench_Chunks[0]); c++)
+    {
+        Tacho_CtxInit(&Bench_Ctx, &Bench_Config, NULL_PTR);
+        if (E_OK != Bench_Select(&Bench_Ctx, standard))
+        {
+            printf("%-10s protocol not selected\n", name);
+            return E_NOT_OK;
+        }
+        Bench_Feed(len, Bench_Chunks[c]);
+
+        Bench_Decoded = 0;
+        t0 = Bench_Nanos();
+        for (i = 0; i < reps; i++)
+        {
+            Bench_Feed(len, Bench_Chunks[c]);
+        }
+        ns = (double) (Bench_Nanos() - t0) / ((double) len * reps);
+
+        if (BENCH_BYTE_PATH == Bench_Chunks[c])
+        {
+            byte_ns = ns;
+            printf("%-10s byte path        %6.2f ns/byte", name, ns);
+        }
+        else
+        {
+            printf("%-10s block %5u bytes %6.2f ns/byte %5.1fx", name, (unsigned) Bench_Chunks[c], ns, byte_ns / ns);
+        }
+        printf("  %u/%u frames\n", (unsigned) Bench_Decoded, (unsigned) (frames * reps));
+        if (Bench_Decoded != frames * reps)
+        {
+            op_status = E_NOT_OK;
+        }
+    }
+    return op_status;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t reps = (1 < argc) ? (uint32_t) strtoul(argv[1], NULL, 0) : 20U;
+    Std_ReturnType op_status = E_OK;
+
+    op_status |= Bench_Run("VDO", TACHO_STANDARD_VDO, reps);
+    op_status |= Bench_Run("Stoneridge", TACHO_STANDARD_STONERIDGE, reps);
+
+    return (E_OK == op_status) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
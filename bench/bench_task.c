@@ -0,0 +1,175 @@
+/**
+ * @file bench_task.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Decoder throughput of the default link (Tacho_RxNotif() + Tacho_Task())
+ *
+ * Feeds a synthetic VDO stream (70, 88 and 106 byte frames) and a synthetic
+ * Stoneridge stream byte per byte, as the UART interrupt does, running the
+ * task every half reception buffer, and reports frames/s, bytes/s and CPU
+ * cycles per byte. Frames are counted with TACHO_CFG_STATS; a run where the
+ * decoder lost or rejected any frame is reported as failed.
+ * The engine is picked at build time, so the Makefile builds this program
+ * once per engine: bench_task with the frame engine, which takes frame
+ * bodies from the reception buffer in bulk, and bench_task_bytewise with
+ * the legacy per-byte engines (TACHO_CFG_VDO_BYTEWISE, TACHO_CFG_SR_BYTEWISE).
+ *
+ * Usage: bench_task [repetitions]
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "std_types.h"
+#include "tacho_countries.h"
+#include "tacho.h"
+#include "tacho_d8.h"
+#include "tacho_ctx.h"
+#include "bench_util.h"
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#define BENCH_STREAM_SIZE (1UL << 20)  /**< Stream length in bytes */
+#define BENCH_TASK_PERIOD (TACHO_RX_QUEUE_SIZE / 2U)  /**< Bytes received between two task runs */
+
+/******************************************************************************/
+/*    PRIVATE DATA                                                            */
+/******************************************************************************/
+
+static uint8_t Bench_Data[BENCH_STREAM_SIZE];  /**< Stream being fed */
+
+#if (TACHO_CFG_VDO_BYTEWISE == STD_ON) && (TACHO_CFG_SR_BYTEWISE == STD_ON)
+static const char Bench_Engine[] = "bytewise";
+#elif (TACHO_CFG_VDO_BYTEWISE == STD_OFF) && (TACHO_CFG_SR_BYTEWISE == STD_OFF)
+static const char Bench_Engine[] = "frame";
+#else
+static const char Bench_Engine[] = "mixed";
+#endif
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+/**
+ * Selects a protocol the way a baudrate mismatch does, with framing errors
+ * @param standard Protocol to select
+ * @return E_OK if selected
+ */
+static Std_ReturnType Bench_SelectDefault(Tacho_Standard_t standard)
+{
+    uint32_t i;
+    uint32_t j;
+
+    for (i = 0; (i < BENCH_MAX_SWITCH) && (standard != Tacho_GetSelectedStandard()); i++)
+    {
+        for (j = 0; j < BENCH_FRAMING_ERRORS; j++)
+        {
+            Tacho_ErrorNotif();
+        }
+        Tacho_Task();
+    }
+    return (standard == Tacho_GetSelectedStandard()) ? E_OK : E_NOT_OK;
+}
+
+/**
+ * Feeds a stream once
+ * @param len Stream length in bytes
+ */
+static void Bench_Feed(uint32_t len)
+{
+    uint32_t i;
+
+    for (i = 0; i < len; i++)
+    {
+        Tacho_RxNotif(Bench_Data[i]);
+        if ((BENCH_TASK_PERIOD - 1U) == (i % BENCH_TASK_PERIOD))
+        {
+            Tacho_Task();
+        }
+    }
+    Tacho_Task();
+}
+
+/**
+ * Decoded frames so far
+ * @return TACHO_STAT_FRAMES
+ */
+static uint32_t Bench_Frames(void)
+{
+    Tacho_Stats_t stats;
+
+    (void) Tacho_GetStats(&stats);
+    return stats.counter[TACHO_STAT_FRAMES];
+}
+
+/**
+ * Benchmarks one protocol
+ * @param name Protocol name
+ * @param standard Protocol
+ * @param reps Number of timed passes over the stream
+ * @return E_OK if every frame was decoded
+ */
+static Std_ReturnType Bench_Run(const char *name, Tacho_Standard_t standard, uint32_t reps)
+{
+    uint32_t frames;
+    uint32_t len = Bench_Stream(standard, 0, Bench_Data, sizeof(Bench_Data), &frames);
+    uint32_t decoded;
+    uint64_t t0;
+    uint64_t c0;
+    double seconds;
+    double cycles;
+    uint32_t i;
+
+    if (E_OK != Bench_SelectDefault(standard))
+    {
+        printf("%-10s %-8s protocol not selected\n", name, Bench_Engine);
+        return E_NOT_OK;
+    }
+
+    /* Warm up caches and branch predictors */
+    Bench_Feed(len);
+
+    decoded = Bench_Frames();
+    t0 = Bench_Nanos();
+    c0 = Bench_Cycles();
+    for (i = 0; i < reps; i++)
+    {
+        Bench_Feed(len);
+    }
+    cycles = (double) (Bench_Cycles() - c0);
+    seconds = (double) (Bench_Nanos() - t0) * 1e-9;
+    decoded = Bench_Frames() - decoded;
+
+    printf("%-10s %-8s %7u B/frame %12.0f frames/s %8.2f MB/s ", name, Bench_Engine, (unsigned) (len / frames),
+           (double) decoded / seconds, (double) len * reps / seconds * 1e-6);
+    if (0.0 < cycles)
+    {
+        printf("%7.2f cycles/byte", cycles / ((double) len * reps));
+    }
+    else
+    {
+        printf("    n/a cycles/byte");
+    }
+    printf("  %u/%u frames\n", (unsigned) decoded, (unsigned) (frames * reps));
+
+    return (decoded == frames * reps) ? E_OK : E_NOT_OK;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t reps = (1 < argc) ? (uint32_t) strtoul(argv[1], NULL, 0) : 20U;
+    Std_ReturnType op_status = E_OK;
+
+    Tacho_Init();
+    op_status |= Bench_Run("VDO", TACHO_STANDARD_VDO, reps);
+    op_status |= Bench_Run("Stoneridge", TACHO_STANDARD_STONERIDGE, reps);
+    Tacho_DeInit();
+
+    return (E_OK == op_status) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
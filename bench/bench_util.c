@@ -0,0 +1,232 @@
+/**
+ * @file bench_util.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Synthetic D8 streams and timers shared by the host benchmarks and tests
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200112L  /* clock_gettime() under -std=c99 */
+#endif
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "std_types.h"
+#include "tacho_countries.h"
+#include "tacho.h"
+#include "tacho_d8.h"
+#include "tacho_ctx.h"
+#include "tacho_encode.h"
+#include "bench_util.h"
+
+/******************************************************************************/
+/*    PRIVATE DATA                                                            */
+/******************************************************************************/
+
+/** Stoneridge messages, in sending order */
+static const uint8_t Bench_SrMsg[TACHO_SR_PARTS] =
+{
+    TACHO_SR_MSG_VIN, TACHO_SR_MSG_DIN1, TACHO_SR_MSG_DIN2, TACHO_SR_MSG_VRN
+};
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+/**
+ * Pseudo-random generator (xorshift32)
+ * @param state[in,out] Generator state, not 0
+ * @return Next value
+ */
+uint32_t Bench_Rand(uint32_t *state)
+{
+    uint32_t x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/**
+ * Sets a VDO clock
+ * @param time[out] Clock in frame resolution
+ * @param seconds Seconds since 1985-01-01 00:00:00 UTC
+ */
+void Bench_SetTime(Tacho_DateTime_t *time, uint32_t seconds)
+{
+    /* Civil date from a day count (days since 0000-03-01) */
+    uint32_t days = (seconds / 86400UL) + 724947UL;
+    uint32_t era = days / 146097UL;
+    uint32_t doe = days - (era * 146097UL);
+    uint32_t yoe = (doe - (doe / 1460U) + (doe / 36524UL) - (doe / 146096UL)) / 365U;
+    uint32_t doy = doe - ((365U * yoe) + (yoe / 4U) - (yoe / 100U));
+    uint32_t mp = ((5U * doy) + 2U) / 153U;
+    uint32_t day = doy - (((153U * mp) + 2U) / 5U) + 1U;
+    uint32_t month = (mp < 10U) ? (mp + 3U) : (mp - 9U);
+    uint32_t year = (era * 400U) + yoe + ((month <= 2U) ? 1U : 0U);
+
+    time->seconds = (uint8_t) ((seconds % 60U) * 4U);
+    time->minutes = (uint8_t) ((seconds / 60U) % 60U);
+    time->hours = (uint8_t) ((seconds / 3600U) % 24U);
+    time->month = (uint8_t) month;
+    time->day = (uint8_t) (((day - 1U) * 4U) + 1U);
+    time->year = (uint8_t) (year - 1985U);
+    time->local_min_offset = 125U;
+    time->local_hour_offset = 125U;
+}
+
+/**
+ * Content of frame k of a stream
+ * @param standard Protocol of the stream
+ * @param k Frame number
+ * @param frame[out] Real-time data, driver IDs and (VDO) clock and distances
+ */
+void Bench_Frame(Tacho_Standard_t standard, uint32_t k, Tacho_Frame_t *frame)
+{
+    uint32_t rng = (k * 2654435761UL) | 1U;
+    uint32_t cards = TACHO_MAX_DRIVERS;
+
+    memset(frame, 0, sizeof(*frame));
+    /* Mostly steady states, like a real vehicle */
+    frame->working_state = (uint8_t) ((0U == (k & 0x3FU)) ? Bench_Rand(&rng) : 0x21U);
+    frame->driver1_state = (uint8_t) ((0U == (k & 0x7FU)) ? Bench_Rand(&rng) : 0x03U);
+    frame->driver2_state = 0x00U;
+    frame->tacho_status = 0x00U;
+    frame->speed_msb = (uint8_t) ((k / 16U) % 90U);
+    frame->speed_lsb = (uint8_t) Bench_Rand(&rng);
+
+    if (TACHO_STANDARD_VDO == standard)
+    {
+        cards = Bench_Rand(&rng) % (TACHO_MAX_DRIVERS + 1U);
+        Bench_SetTime(&frame->vdo.time, BENCH_TIME_BASE + k);
+        frame->vdo.odometer = 200000000UL + (k * 3U);
+        frame->vdo.trip = k * 3U;
+        frame->vdo.k_factor = 8000U;
+    }
+    if (0U < cards)
+    {
+        memcpy(frame->driver[0].country, "RO ", TACHO_MAX_COUNTRY_CODE);
+        memcpy(frame->driver[0].cardnr, "0000000000086H10", TACHO_MAX_CARD_NR);
+    }
+    if (1U < cards)
+    {
+        memcpy(frame->driver[1].country, "D  ", TACHO_MAX_COUNTRY_CODE);
+        memcpy(frame->driver[1].cardnr, "DF00000012345678", TACHO_MAX_CARD_NR);
+    }
+}
+
+/**
+ * Encodes frame k of a stream
+ * @param standard Protocol of the stream
+ * @param k Frame number
+ * @param out[out] Encoded frame
+ * @param size Size of out in bytes
+ * @return Frame length, 0 if it does not fit
+ */
+uint16_t Bench_Encode(Tacho_Standard_t standard, uint32_t k, uint8_t *out, uint16_t size)
+{
+    Tacho_Frame_t frame;
+    uint8_t msg_id;
+
+    Bench_Frame(standard, k, &frame);
+    if (TACHO_STANDARD_VDO == standard)
+    {
+        return Tacho_EncodeVdo(&frame, (const uint8_t *) BENCH_VIN, BENCH_VIN_LEN,
+                               (const uint8_t *) BENCH_CSTR, BENCH_CSTR_LEN, out, size);
+    }
+
+    msg_id = Bench_SrMsg[k % TACHO_SR_PARTS];
+    if (TACHO_SR_MSG_VRN == msg_id)
+    {
+        return Tacho_EncodeStoneridge(&frame, msg_id, (const uint8_t *) BENCH_VRN, BENCH_VRN_LEN, out, size);
+    }
+    return Tacho_EncodeStoneridge(&frame, msg_id, (const uint8_t *) BENCH_VIN, BENCH_VIN_LEN, out, size);
+}
+
+/**
+ * Fills a buffer with consecutive frames
+ * @param standard Protocol of the stream
+ * @param first Number of the first frame
+ * @param out[out] Stream
+ * @param size Size of out in bytes
+ * @param frames[out] Number of frames written
+ * @return Stream length in bytes
+ */
+uint32_t Bench_Stream(Tacho_Standard_t standard, uint32_t first, uint8_t *out, uint32_t size, uint32_t *frames)
+{
+    uint8_t frame[BENCH_MAX_FRAME];
+    uint32_t len = 0;
+    uint32_t k = first;
+    uint16_t n;
+
+    for (;;)
+    {
+        n = Bench_Encode(standard, k, frame, sizeof(frame));
+        if ( (0U == n) || (size - len < n) )
+        {
+            break;
+        }
+        memcpy(&out[len], frame, n);
+        len += n;
+        k++;
+    }
+    *frames = k - first;
+    return len;
+}
+
+/**
+ * Selects a protocol on a context the way a baudrate mismatch does, with
+ * framing errors
+ * @param ctx Decoder context
+ * @param standard Protocol to select
+ * @return E_OK if selected
+ */
+Std_ReturnType Bench_Select(Tacho_Ctx_t *ctx, Tacho_Standard_t standard)
+{
+    uint32_t i;
+    uint32_t j;
+
+    for (i = 0; (i < BENCH_MAX_SWITCH) && (standard != Tacho_CtxGetSelectedStandard(ctx)); i++)
+    {
+        for (j = 0; j < BENCH_FRAMING_ERRORS; j++)
+        {
+            Tacho_CtxErrorNotif(ctx);
+        }
+        Tacho_CtxTask(ctx);
+    }
+    return (standard == Tacho_CtxGetSelectedStandard(ctx)) ? E_OK : E_NOT_OK;
+}
+
+/**
+ * Monotonic time
+ * @return Nanoseconds since an arbitrary point
+ */
+uint64_t Bench_Nanos(void)
+{
+    struct timespec now;
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t) now.tv_sec * 1000000000ULL) + (uint64_t) now.tv_nsec;
+}
+
+/**
+ * CPU cycle counter
+ * @return Time stamp counter, 0 on architectures without one
+ */
+uint64_t Bench_Cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,49 @@
+/**
+ * @file bench_util.h
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Synthetic D8 streams and timers shared by the host benchmarks and tests
+ *
+ * Frames are built with tacho_encode.c from a frame number, so that a
+ * stream is the same on every run and a test can rebuild any frame it
+ * expects the decoder to report. VDO frames carry a UTC clock one second
+ * apart starting at BENCH_TIME_BASE and 0, 1 or 2 cards; Stoneridge frames
+ * cycle through the VIN, DIN1, DIN2 and VRN messages.
+ */
+
+#ifndef BENCH_UTIL_H
+#define	BENCH_UTIL_H
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#define BENCH_VIN "WDB9634031L717729"  /**< VIN of every frame */
+#define BENCH_VIN_LEN 17U
+#define BENCH_CSTR "\x01" "123TEST      "  /**< VDO custom string of every frame */
+#define BENCH_CSTR_LEN 14U
+#define BENCH_VRN "RO B-123-ABC"  /**< Stoneridge VRN of every frame */
+#define BENCH_VRN_LEN 12U
+
+#define BENCH_TIME_BASE 1306800000UL  /**< Clock of frame 0, seconds since 1985 (2026-05-31) */
+
+#define BENCH_MAX_FRAME 128U  /**< Room for any encoded frame */
+
+#define BENCH_FRAMING_ERRORS 5U  /**< Framing errors making the task count a failed attempt */
+#define BENCH_MAX_SWITCH 16U  /**< Task runs allowed to select a protocol */
+
+/******************************************************************************/
+/*    PUBLIC FUNCTIONS                                                        */
+/******************************************************************************/
+
+uint32_t Bench_Rand(uint32_t *state);
+void Bench_SetTime(Tacho_DateTime_t *time, uint32_t seconds);
+void Bench_Frame(Tacho_Standard_t standard, uint32_t k, Tacho_Frame_t *frame);
+uint16_t Bench_Encode(Tacho_Standard_t standard, uint32_t k, uint8_t *out, uint16_t size);
+uint32_t Bench_Stream(Tacho_Standard_t standard, uint32_t first, uint8_t *out, uint32_t size, uint32_t *frames);
+Std_ReturnType Bench_Select(Tacho_Ctx_t *ctx, Tacho_Standard_t standard);
+uint64_t Bench_Nanos(void);
+uint64_t Bench_Cycles(void);
+
+#endif	/* BENCH_UTIL_H */
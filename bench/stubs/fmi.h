@@ -0,0 +1,18 @@
+/**
+ * @file fmi.h
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Host stub of the FMI event dispatcher used by the default link
+ */
+
+#ifndef FMI_H
+#define	FMI_H
+
+/******************************************************************************/
+/*    PUBLIC FUNCTIONS                                                        */
+/******************************************************************************/
+
+void FMI_process_j1939_event(uint8_t event);
+
+#endif	/* FMI_H */
@@ -0,0 +1,26 @@
+/**
+ * @file fram.h
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Host stub of the FRAM driver used by the default link
+ */
+
+#ifndef FRAM_H
+#define	FRAM_H
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#define FRAM_SIZE 8192U  /**< Memory size in bytes */
+#define FRAM_MEMADDR_TACHO_PROTO 0x0010U  /**< Selected D8 protocol */
+
+/******************************************************************************/
+/*    PUBLIC FUNCTIONS                                                        */
+/******************************************************************************/
+
+Std_ReturnType FRAM_ReadByte(uint16_t addr, uint8_t *data);
+Std_ReturnType FRAM_WriteByte(uint16_t addr, uint8_t data);
+
+#endif	/* FRAM_H */
@@ -0,0 +1,24 @@
+/**
+ * @file j1939app.h
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Host stub of the J1939 application layer used by the default link
+ */
+
+#ifndef J1939APP_H
+#define	J1939APP_H
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#define J1939_EVENT_TCO1_AVAILABLE 1U  /**< New TCO1 content */
+
+/******************************************************************************/
+/*    PUBLIC FUNCTIONS                                                        */
+/******************************************************************************/
+
+uint8_t *j1939_get_cached_tco1_content_p(void);
+
+#endif	/* J1939APP_H */
@@ -0,0 +1,85 @@
+/**
+ * @file stubs.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Host stubs of the UART2, J1939, FMI and FRAM services of the default link
+ *
+ * The UART only records the baudrate: host programs feed Tacho_RxNotif() and
+ * Tacho_ErrorNotif() themselves. The FRAM is a RAM array, cleared at start.
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#include "std_types.h"
+#include "usart2.h"
+#include "j1939app.h"
+#include "fmi.h"
+#include "fram.h"
+#include "stubs.h"
+
+/******************************************************************************/
+/*    PUBLIC DATA                                                             */
+/******************************************************************************/
+
+uint16_t Stub_Baudrate;  /**< Last baudrate set */
+uint32_t Stub_FmiEvents;  /**< FMI events received */
+uint8_t Stub_Fram[FRAM_SIZE];  /**< FRAM content */
+
+/******************************************************************************/
+/*    PRIVATE DATA                                                            */
+/******************************************************************************/
+
+static uint8_t Stub_Tco1[8];  /**< TCO1 received on J1939 (never written) */
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+void USART2_init(void (*rx_notif)(uint8_t rx_byte), void (*error_notif)(void))
+{
+    (void) rx_notif;
+    (void) error_notif;
+}
+
+void USART2_close(void)
+{
+}
+
+void USART2_set_baudrate(uint16_t baudrate)
+{
+    Stub_Baudrate = baudrate;
+}
+
+uint8_t *j1939_get_cached_tco1_content_p(void)
+{
+    return Stub_Tco1;
+}
+
+void FMI_process_j1939_event(uint8_t event)
+{
+    (void) event;
+    Stub_FmiEvents++;
+}
+
+Std_ReturnType FRAM_ReadByte(uint16_t addr, uint8_t *data)
+{
+    if (FRAM_SIZE <= addr)
+    {
+        return E_NOT_OK;
+    }
+    *data = Stub_Fram[addr];
+    return E_OK;
+}
+
+Std_ReturnType FRAM_WriteByte(uint16_t addr, uint8_t data)
+{
+    if (FRAM_SIZE <= addr)
+    {
+        return E_NOT_OK;
+    }
+    Stub_Fram[addr] = data;
+    return E_OK;
+}
@@ -0,0 +1,20 @@
+/**
+ * @file stubs.h
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * State of the host stubs, for benchmarks and tests
+ */
+
+#ifndef STUBS_H
+#define	STUBS_H
+
+/******************************************************************************/
+/*    PUBLIC DATA                                                             */
+/******************************************************************************/
+
+extern uint16_t Stub_Baudrate;
+extern uint32_t Stub_FmiEvents;
+extern uint8_t Stub_Fram[];
+
+#endif	/* STUBS_H */
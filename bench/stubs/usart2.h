@@ -0,0 +1,20 @@
+/**
+ * @file usart2.h
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Host stub of the UART2 driver used by the default link
+ */
+
+#ifndef USART2_H
+#define	USART2_H
+
+/******************************************************************************/
+/*    PUBLIC FUNCTIONS                                                        */
+/******************************************************************************/
+
+void USART2_init(void (*rx_notif)(uint8_t rx_byte), void (*error_notif)(void));
+void USART2_close(void);
+void USART2_set_baudrate(uint16_t baudrate);
+
+#endif	/* USART2_H */
@@ -10,13 +10,22 @@
 /*    INCLUDED FILES                                                          */
 /******************************************************************************/
 
+#include <stddef.h>
+#include <string.h>
 #include "std_types.h"
+#include "tacho_countries.h"
+#include "tacho.h"
+#include "tacho_d8.h"
+#include "tacho_ctx.h"
+#include "tacho_atomic.h"
+#include "tacho_checksum.h"
+#include "tacho_sync.h"
+#if (TACHO_CFG_HW_BINDINGS == STD_ON)
 #include "usart2.h"
 #include "j1939app.h"
 #include "fmi.h"
-#include "tacho_countries.h"
-#include "tacho.h"
 #include "fram.h"
+#endif
 
 /******************************************************************************/
 /*    DEFINITIONS                                                             */
@@ -28,27 +37,71 @@
 /** Maximum number of failed attempts before switching to another protocol */
 #define TACHO_MAX_FAILED_ATTEMPTS 2
 
-#define TACHO_RX_QUEUE_SIZE 128  /**< Reception buffer size in bytes */
-#define TACHO_MAX_DRIVERS 2  /**< Maximum number of drivers */
-#define TACHO_MAX_CARD_NR 16  /**< Max driver card number in bytes */
-
-/* VDO-related defines */
-#define TACHO_VDO_SEQSZ 5  /**< VDO Start Sequence Size */
-#define TACHO_VDO_CRC_INIT 0x49  /**< CRC-8 initialization value for VDO */
-#define TACHO_VDO_CC_POS 1  /**< Country code byte position in VDO's DIN */
-
-/* Stoneridge-related defines */
-#define TACHO_SR_SEQSZ 3  /**< Stoneridge Start Sequence Size */
-#define TACHO_SR_MSG_LEN_MIN 45  /**< Minimum Stoneridge SRE message length */
-#define TACHO_SR_MSG_LEN_MAX 48  /**< Maximum Stoneridge SRE message length */
+/* With only the frame decoding engine built the handler is known at compile time and can be inlined */
+#if (TACHO_CFG_VDO_BYTEWISE == STD_OFF) && (TACHO_CFG_SR_BYTEWISE == STD_OFF)
+#define TACHO_RUN_HANDLER(_ctx,_b) Tacho_FrameHandler((_ctx), (_b))
+#else
+#define TACHO_RUN_HANDLER(_ctx,_b) (*(_ctx)->handler)((_ctx), (_b))
+#endif
+
+#define TACHO_RX_QUEUE_MASK (TACHO_RX_QUEUE_SIZE - 1)  /**< Reception buffer index mask */
+#define TACHO_HISTORY_MASK (TACHO_HISTORY_SIZE - 1)  /**< History ring index mask */
+
+#define TACHO_WS_REST 0  /**< Working state: break/rest */
+#define TACHO_WS_DRIVE 3  /**< Working state: driving */
+
+/* J1939 messages taken by the CAN reception path */
+#define TACHO_CAN_PGN_TCO1 0xFE6CUL  /**< Tachograph (TCO1, PGN 65132) */
+#define TACHO_CAN_PGN_DI 0xFE6BUL  /**< Driver identification (DI, PGN 65131) */
+#define TACHO_CAN_PF_TP_CM 0xEC  /**< Transport protocol connection management (PGN 60416) */
+#define TACHO_CAN_PF_TP_DT 0xEB  /**< Transport protocol data transfer (PGN 60160) */
+#define TACHO_CAN_GLOBAL 0xFF  /**< Global destination address */
+#define TACHO_CAN_TP_BAM 32  /**< TP.CM control byte: broadcast announce message */
+#define TACHO_CAN_TP_DT_SIZE 7  /**< Message bytes per TP.DT packet */
+
+#define TACHO_FUSION_FIELDS 6  /**< TCO1 fields fused independently */
+
+#define TACHO_JOURNAL_VERSION 1  /**< Journal record format version */
+#define TACHO_JOURNAL_FIELDS 6  /**< Cached fields persisted after the protocol byte */
+
+/* 256-entry table generators (one entry per byte value) */
+#define TACHO_LUT_ROW(_e,_r) \
+    _e((_r) + 0x0), _e((_r) + 0x1), _e((_r) + 0x2), _e((_r) + 0x3), \
+    _e((_r) + 0x4), _e((_r) + 0x5), _e((_r) + 0x6), _e((_r) + 0x7), \
+    _e((_r) + 0x8), _e((_r) + 0x9), _e((_r) + 0xA), _e((_r) + 0xB), \
+    _e((_r) + 0xC), _e((_r) + 0xD), _e((_r) + 0xE), _e((_r) + 0xF)
+#define TACHO_LUT(_e) \
+    TACHO_LUT_ROW(_e, 0x00), TACHO_LUT_ROW(_e, 0x10), TACHO_LUT_ROW(_e, 0x20), TACHO_LUT_ROW(_e, 0x30), \
+    TACHO_LUT_ROW(_e, 0x40), TACHO_LUT_ROW(_e, 0x50), TACHO_LUT_ROW(_e, 0x60), TACHO_LUT_ROW(_e, 0x70), \
+    TACHO_LUT_ROW(_e, 0x80), TACHO_LUT_ROW(_e, 0x90), TACHO_LUT_ROW(_e, 0xA0), TACHO_LUT_ROW(_e, 0xB0), \
+    TACHO_LUT_ROW(_e, 0xC0), TACHO_LUT_ROW(_e, 0xD0), TACHO_LUT_ROW(_e, 0xE0), TACHO_LUT_ROW(_e, 0xF0)
+
+#define TACHO_WS_ENTRY(_b) { (_b) & 0x07, ((_b) >> 3) & 0x07, ((_b) >> 6) & 0x03 }
+#define TACHO_DS_ENTRY(_b) { (_b) & 0x0F, ((_b) >> 4) & 0x03, ((_b) >> 6) & 0x03 }
+
+/* Statistics hooks, compiled out with TACHO_CFG_STATS */
+#if (TACHO_CFG_STATS == STD_ON)
+#define TACHO_STAT_INC(_ctx,_id) Tacho_StatInc((_ctx), (_id))
+#define TACHO_STAT_LOST(_ctx) ((_ctx)->stats.lost = TRUE)
+#define TACHO_STAT_FRAME_START(_ctx) ((_ctx)->stats.frame_start = Tacho_StatTime(_ctx))
+#define TACHO_STAT_BLOCK_START(_ctx) Tacho_StatBlockStart(_ctx)
+#define TACHO_STAT_DECODE_START(_ctx) Tacho_StatDecodeStart(_ctx)
+#define TACHO_STAT_FRAME_DONE(_ctx) Tacho_StatFrameDone(_ctx)
+#define TACHO_STAT_BAD_HEADER(_ctx,_f,_n) Tacho_StatBadHeader((_ctx), (_f), (_n))
+#else
+#define TACHO_STAT_INC(_ctx,_id)
+#define TACHO_STAT_LOST(_ctx)
+#define TACHO_STAT_FRAME_START(_ctx)
+#define TACHO_STAT_BLOCK_START(_ctx)
+#define TACHO_STAT_DECODE_START(_ctx)
+#define TACHO_STAT_FRAME_DONE(_ctx)
+#define TACHO_STAT_BAD_HEADER(_ctx,_f,_n)
+#endif
 
 /******************************************************************************/
 /*    PRIVATE TYPES                                                           */
 /******************************************************************************/
 
-/** Tachograph type handler callback function */
-typedef bool_t (*Tacho_Handler_t)(uint8_t rx_byte);
-
 /** Driver index */
 typedef enum
 {
@@ -56,172 +109,243 @@ typedef enum
     TACHO_DRIVER2
 } Tacho_DriverIdx_t;
 
-/** VDO-related field position in frame */
-typedef enum
-{
-    TACHO_VDO_WORKING_STATE = 14,
-    TACHO_VDO_DRV1_STATE = 15,
-    TACHO_VDO_DRV2_STATE = 16,
-    TACHO_VDO_STATUS = 17,
-    TACHO_VDO_SPEED_LSB = 18,
-    TACHO_VDO_SPEED_MSB = 19,
-    TACHO_VDO_VIN_LENGTH = 34
-} Tacho_VdoFields_t;
-
-/** Stoneridge-related field position in frame */
-typedef enum
-{
-    TACHO_SR_MSG_LEN = 3,
-    TACHO_SR_MSG_ID = 4,
-    TACHO_SR_WORKING_STATE = 9,
-    TACHO_SR_DRV1_STATE = 10,
-    TACHO_SR_DRV2_STATE = 11,
-    TACHO_SR_STATUS = 12,
-    TACHO_SR_SPEED_MSB = 13,
-    TACHO_SR_SPEED_LSB = 14,
-    TACHO_SR_CUSTOM = 30  /**< VIN, DIN1, DIN2 or VRN & RMS position (depends on message type) */
-} Tacho_SrFields_t;
-
-/** Stoneridge Message Identifier */
-typedef enum
-{
-    TACHO_SR_MSG_VIN = 0x01,
-    TACHO_SR_MSG_DIN1 = 0x02,
-    TACHO_SR_MSG_DIN2 = 0x04,
-    TACHO_SR_MSG_VRN = 0x08,
-    TACHO_SR_MSG_TYPES = 4  /**< Total Stoneridge message types */
-} Tacho_StoneridgeMsgID_t;
-
-/** Circular buffer used for reception */
-typedef struct
-{
-    uint8_t data[TACHO_RX_QUEUE_SIZE];
-    uint8_t *head;
-    uint8_t *tail;
-    uint8_t *buffer_start;
-    uint8_t *buffer_end;
-    uint8_t count;  /**< Total number of bytes received and unprocessed, yet */
-    uint16_t error_counter;  /**< Total number of framing errors */
-    uint8_t failed_attempts;  /**< Total number of consecutive failed attempts */
-} Tacho_RxQueue_t;
-
-/** Driver ID (DIN) = Issuing member state + CardNumber */
-typedef struct
-{
-    uint8_t country[TACHO_MAX_COUNTRY_CODE];
-    uint8_t cardnr[TACHO_MAX_CARD_NR];
-} Tacho_DriverID_t;
-
-/** Real-time data received from Tachograph */
-typedef struct
-{
-    uint8_t working_state;
-    uint8_t driver1_state;
-    uint8_t driver2_state;
-    uint8_t tacho_status;
-    uint8_t speed_msb;
-    uint8_t speed_lsb;
-    Tacho_DriverID_t driver[TACHO_MAX_DRIVERS];
-} Tacho_Frame_t;
-
-/** Cached data */
-typedef struct
-{
-    uint8_t tco1[TACHO_TCO1_SIZE];  /**< Reconstructed TCO1 */
-    uint8_t tco1_cmn[TACHO_TCO1_SIZE];  /**< TCO1 common collected data from J1939 and D8 */
-    uint8_t di[2 * TACHO_MAX_DRIVER_ID + 1];  /**< Cached DIN1 + DIN2 + delimiters (and zero terminator) */
-} Tacho_CachedData_t;
-
-/** Protocol configuration */
-typedef struct
-{
-    uint8_t *start_seq;  /**< Start sequence */
-    uint8_t start_sz;  /**< Start sequence size */
-    uint16_t baudRate;  /**< UART baudrate for specified protocol */
-} Tacho_Protocol_t;
-
-/** VDO-specific internal data */
-typedef struct
-{
-    uint8_t index;  /**< Current position in frame */
-    uint8_t cstr_pos;  /**< Start of custom string byte position */
-    uint8_t drv1_pos;  /**< Start of Driver1 ID byte position */
-    uint8_t drv2_pos;  /**< Start of Driver2 ID byte position */
-    uint8_t crc8_pos;  /**< CRC8 position */
-    uint8_t crc8_value;  /**< CRC8 computed value */
-} Tacho_VdoData_t;
-
-/** Stoneridge-specific internal data */
-typedef struct
-{
-    uint8_t index;  /**< Current position in frame */
-    uint8_t drv1_pos;  /**< Start of Driver1 ID byte position */
-    uint8_t drv2_pos;  /**< Start of Driver2 ID byte position */
-    uint8_t crc8_pos;  /**< CRC8 position */
-    uint8_t crc8_value;  /**< CRC8 computed value */
-} Tacho_SrData_t;
+/** Reception buffer size must be a power of two that fits the 16-bit indices */
+typedef char Tacho_RxQueueSizeCheck[
+    ( (TACHO_RX_QUEUE_SIZE & TACHO_RX_QUEUE_MASK) == 0 && TACHO_RX_QUEUE_SIZE <= 32768 ) ? 1 : -1];
+
+#if (TACHO_CFG_HISTORY == STD_ON)
+/** History ring size must be a power of two that fits the 16-bit indices */
+typedef char Tacho_HistorySizeCheck[
+    ( (TACHO_HISTORY_SIZE & TACHO_HISTORY_MASK) == 0 && TACHO_HISTORY_SIZE <= 32768 ) ? 1 : -1];
+#endif
+
+#if (TACHO_CFG_DRIVING_TIME == STD_ON)
+/** A card must always be free to track the cards of a new frame */
+typedef char Tacho_DrivingCardsCheck[
+    ( TACHO_DRIVING_CARDS > TACHO_MAX_DRIVERS && TACHO_DRIVING_CARDS < 256 ) ? 1 : -1];
+#endif
+
+#if (TACHO_CFG_JOURNAL == STD_ON)
+/* The default context keeps its journal in FRAM the firmware map reserves for it */
+#if !defined(TACHO_JOURNAL_FRAM_ADDR) || !defined(TACHO_JOURNAL_FRAM_SIZE)
+#error "TACHO_CFG_JOURNAL: define TACHO_JOURNAL_FRAM_ADDR and TACHO_JOURNAL_FRAM_SIZE (FRAM reserved for the journal)"
+#endif
+
+/** Both journal slots must be addressable with 16 bits */
+typedef char Tacho_JournalSizeCheck[
+    ( TACHO_JOURNAL_SIZE <= 0xFFFFU ) ? 1 : -1];
+
+/** The reserved FRAM must hold both journal slots */
+typedef char Tacho_JournalFramCheck[
+    ( TACHO_JOURNAL_FRAM_SIZE >= TACHO_JOURNAL_SIZE ) ? 1 : -1];
+#endif
 
 /******************************************************************************/
 /*    PRIVATE DATA                                                            */
 /******************************************************************************/
 
-static Tacho_RxQueue_t Tacho_RxQueue;  /**< Reception buffer */
-static Tacho_Frame_t Tacho_Frame;  /**< Tacho frame data (TCO1 + DIN) */
-static Tacho_CachedData_t Tacho_CachedData;  /**< Data storage after succesful read */
-static Tacho_VdoData_t vdo;  /**< VDO-related internal data */
-static Tacho_SrData_t sr;  /**< Stoneridge-related internal data */
-
 /** Protocol configuration parameters */
 static const Tacho_Protocol_t Tacho_Protocol[TACHO_STANDARD_MAX] =
 {
     /* VDO */
     {
-        (uint8_t[TACHO_VDO_SEQSZ]) {0x55, 0x44, 0x54, 0x43, 0x4F},
+        (uint8_t[TACHO_VDO_SEQSZ]) {TACHO_VDO_START_SEQ},
         TACHO_VDO_SEQSZ,
         10400  /**< Baudrate */
     },
     /* Stoneridge */
     {
-        (uint8_t[TACHO_SR_SEQSZ]) {0xFF, 0xFF, 0xFF},
+        (uint8_t[TACHO_SR_SEQSZ]) {TACHO_SR_START_SEQ},
         TACHO_SR_SEQSZ,
         1200  /**< Baudrate */
     }
 };
 
-/** Current selected protocol */
-static Tacho_Standard_t Tacho_SelectedStandard = TACHO_STANDARD_VDO;
+#if (TACHO_CFG_TCO1_FUSION == STD_ON)
+/** First byte and size of each TCO1 field fused independently */
+static const uint8_t Tacho_FusionField[TACHO_FUSION_FIELDS][2] =
+{
+    { TACHO_TCO1_WORKING_STATE, 1 },
+    { TACHO_TCO1_DRV1_STATE, 1 },
+    { TACHO_TCO1_DRV2_STATE, 1 },
+    { TACHO_TCO1_STATUS, 1 },
+    { TACHO_TCO1_RB4, 2 },
+    { TACHO_TCO1_SPEED_LSB, 2 }
+};
+#endif
+
+#if (TACHO_CFG_JOURNAL == STD_ON)
+/** Cached fields persisted by the journal (offset in Tacho_CachedData_t, size) */
+static const uint16_t Tacho_JournalField[TACHO_JOURNAL_FIELDS][2] =
+{
+    { offsetof(Tacho_CachedData_t, tco1), TACHO_TCO1_SIZE },
+    { offsetof(Tacho_CachedData_t, tco1_cmn), TACHO_TCO1_SIZE },
+    { offsetof(Tacho_CachedData_t, di), TACHO_MAX_DI_MSG },
+    { offsetof(Tacho_CachedData_t, vin), TACHO_MAX_VIN },
+    { offsetof(Tacho_CachedData_t, vdo.vin.length), 1 },
+    { offsetof(Tacho_CachedData_t, sr), offsetof(Tacho_SrSnapshot_t, frames) }  /* vehicle data, not the ages */
+};
+
+/** Journal record header */
+static const uint8_t Tacho_JournalHeader[TACHO_JOURNAL_HEADER_SIZE] =
+{
+    'T', 'J', TACHO_JOURNAL_VERSION, (uint8_t) TACHO_JOURNAL_DATA_SIZE, (uint8_t) (TACHO_JOURNAL_DATA_SIZE >> 8)
+};
+#endif
+
+/** Working state byte decoding table */
+static const Tacho_WorkingState_t Tacho_WorkingStateLut[256] = { TACHO_LUT(TACHO_WS_ENTRY) };
 
-/** Pointer to the currently selected protocol */
-static const Tacho_Protocol_t *Tacho_Proto = NULL;
+/** Driver state byte decoding table */
+static const Tacho_DriverState_t Tacho_DriverStateLut[256] = { TACHO_LUT(TACHO_DS_ENTRY) };
 
-/** Pointer to the currently selected handler function */
-static Tacho_Handler_t Tacho_Handler = NULL_PTR;
+/** Change thresholds of a newly initialized context */
+static const Tacho_Thresholds_t Tacho_DefaultThresholds = TACHO_THRESHOLDS_DEFAULT;
+
+/** Default context (used by the single-link API) */
+static Tacho_Ctx_t Tacho_DefaultCtx;
 
 /******************************************************************************/
 /*    PRIVATE FUNCTIONS                                                       */
 /******************************************************************************/
 
-static void Tacho_SelectStandard(Tacho_Standard_t standard, bool_t updateMemory);
-static void Tacho_CopyToCache(void);
-static void Tacho_NotifyFrameReceived(uint8_t *tco1_data);
-static bool_t Tacho_QueueAddByte(uint8_t rx_byte);
-static bool_t Tacho_FetchByte(uint8_t *byte_val);
-static void Tacho_ClearRxQueue(void);
-static Std_ReturnType Tacho_ReadMemory(Tacho_Standard_t *protocol);
-static Std_ReturnType Tacho_SetMemory(Tacho_Standard_t protocol);
+static void Tacho_SelectStandard(Tacho_Ctx_t *ctx, Tacho_Standard_t standard, bool_t updateMemory);
+static void Tacho_SelectHandler(Tacho_Ctx_t *ctx, Tacho_Standard_t standard);
+static uint8_t Tacho_SyncAccepted(Tacho_Ctx_t *ctx, uint8_t state);
+static bool_t Tacho_SyncByte(Tacho_Ctx_t *ctx, uint8_t rx_byte);
+static void Tacho_CopyToCache(Tacho_Ctx_t *ctx);
+static void Tacho_CacheWriteBegin(Tacho_Ctx_t *ctx);
+static void Tacho_CacheWriteEnd(Tacho_Ctx_t *ctx);
+static void Tacho_FrameReceived(Tacho_Ctx_t *ctx);
+#if (TACHO_CFG_HISTORY == STD_ON)
+static void Tacho_HistoryPush(Tacho_Ctx_t *ctx);
+#endif
+#if (TACHO_CFG_DRIVING_TIME == STD_ON)
+static void Tacho_DrivingUpdate(Tacho_Ctx_t *ctx);
+static uint8_t Tacho_DrivingCard(Tacho_Driving_t *driving, const Tacho_DriverID_t *driver, uint32_t now);
+static void Tacho_DrivingAccount(Tacho_DrivingTime_t *card, uint8_t state, uint32_t seconds);
+static void Tacho_DrivingEndRest(Tacho_DrivingTime_t *card);
+#endif
+#if (TACHO_CFG_CAN_RX == STD_ON)
+static void Tacho_CanTpCm(Tacho_Ctx_t *ctx, const uint8_t *data);
+static void Tacho_CanTpDt(Tacho_Ctx_t *ctx, const uint8_t *data);
+static void Tacho_CanDiWrite(Tacho_Ctx_t *ctx, uint16_t pos, const uint8_t *data, uint8_t count);
+static void Tacho_CanDiEnd(Tacho_Ctx_t *ctx, uint16_t size);
+#endif
+static uint32_t Tacho_GetU32(const uint8_t *data);
+static void Tacho_NotifyFrameReceived(Tacho_Ctx_t *ctx, Tacho_Source_t source, const uint8_t *tco1_data);
+#if (TACHO_CFG_TCO1_FUSION == STD_ON)
+static void Tacho_FuseTco1(Tacho_Ctx_t *ctx, Tacho_Source_t source, const uint8_t *tco1_data, uint8_t *fused);
+static bool_t Tacho_FusionFieldValid(const uint8_t *tco1, uint8_t field);
+#endif
+static uint16_t Tacho_Tco1Changes(Tacho_Ctx_t *ctx, const uint8_t *tco1_data);
+static uint32_t Tacho_AbsDiff32(uint32_t a, uint32_t b);
+static bool_t Tacho_QueueAddByte(Tacho_Ctx_t *ctx, uint8_t rx_byte);
+static bool_t Tacho_FetchByte(Tacho_Ctx_t *ctx, uint8_t *byte_val);
+static void Tacho_ClearRxQueue(Tacho_Ctx_t *ctx);
+static uint32_t Tacho_BlockResume(Tacho_Ctx_t *ctx, const uint8_t *buf, uint32_t len);
+static void Tacho_BlockRetry(Tacho_Ctx_t *ctx, uint16_t first, uint16_t kept);
+#if (TACHO_CFG_VDO_BYTEWISE == STD_OFF) || (TACHO_CFG_SR_BYTEWISE == STD_OFF)
+static void Tacho_FrameInit(Tacho_Ctx_t *ctx);
+static bool_t Tacho_FrameHandler(Tacho_Ctx_t *ctx, uint8_t rx_byte);
+static void Tacho_FrameLookback(Tacho_Ctx_t *ctx);
+#endif
+static bool_t Tacho_NextByte(Tacho_Ctx_t *ctx, uint8_t *byte_val);
+#if (TACHO_CFG_VDO_BYTEWISE == STD_OFF) || (TACHO_CFG_SR_BYTEWISE == STD_OFF)
+static uint16_t Tacho_NextBlock(Tacho_Ctx_t *ctx, uint8_t *dst, uint16_t max);
+#endif
+#if (TACHO_CFG_WAKEUP == STD_ON)
+static void Tacho_WakeupArm(Tacho_Ctx_t *ctx);
+static uint16_t Tacho_WakeupNeed(Tacho_Ctx_t *ctx);
+static void Tacho_Wakeup(Tacho_Ctx_t *ctx);
+#endif
+static uint16_t Tacho_FrameLength(Tacho_Standard_t standard, const uint8_t *frame, uint16_t avail);
+static bool_t Tacho_FrameCheck(Tacho_Standard_t standard, const uint8_t *frame, uint16_t length);
+static bool_t Tacho_DecodeFrame(Tacho_Ctx_t *ctx, const uint8_t *frame, uint16_t length);
+static Std_ReturnType Tacho_ReadMemory(Tacho_Ctx_t *ctx, Tacho_Standard_t *protocol);
+static Std_ReturnType Tacho_SetMemory(Tacho_Ctx_t *ctx, Tacho_Standard_t protocol);
+#if (TACHO_CFG_JOURNAL == STD_ON)
+static uint32_t Tacho_JournalTime(Tacho_Ctx_t *ctx);
+static uint16_t Tacho_JournalCrc(Tacho_Ctx_t *ctx);
+static Std_ReturnType Tacho_JournalWrite(Tacho_Ctx_t *ctx, uint16_t crc);
+static Std_ReturnType Tacho_JournalRestore(Tacho_Ctx_t *ctx);
+static Std_ReturnType Tacho_JournalReadSlot(Tacho_Ctx_t *ctx, uint8_t slot);
+#endif
+
+/* Default context bindings */
+#if (TACHO_CFG_HW_BINDINGS == STD_ON)
+static void Tacho_DefaultSetBaudrate(Tacho_Ctx_t *ctx, uint16_t baudrate);
+static Std_ReturnType Tacho_DefaultReadProtocol(Tacho_Ctx_t *ctx, uint8_t *data);
+static Std_ReturnType Tacho_DefaultWriteProtocol(Tacho_Ctx_t *ctx, uint8_t data);
+#if (TACHO_CFG_JOURNAL == STD_ON)
+static Std_ReturnType Tacho_DefaultReadNvm(Tacho_Ctx_t *ctx, uint16_t addr, uint8_t *buf, uint16_t len);
+static Std_ReturnType Tacho_DefaultWriteNvm(Tacho_Ctx_t *ctx, uint16_t addr, const uint8_t *buf, uint16_t len);
+#endif
+static void Tacho_DefaultTco1Notif(Tacho_Ctx_t *ctx);
+#endif
 
 /* VDO-specific functions*/
-static void Tacho_VdoInitHandler(void);
-static bool_t Tacho_VdoHandler(uint8_t rx_byte);
-static void Tacho_VdoCheckDIN(uint8_t rx_byte);
+#if (TACHO_CFG_VDO_BYTEWISE == STD_ON)
+static void Tacho_VdoInitHandler(Tacho_Ctx_t *ctx);
+static bool_t Tacho_VdoHandler(Tacho_Ctx_t *ctx, uint8_t rx_byte);
+static void Tacho_VdoCheckDIN(Tacho_Ctx_t *ctx, uint8_t rx_byte);
 static void Tacho_VdoCopyDIN(uint8_t pos, uint8_t rx_byte, uint8_t *country, uint8_t *cardnr);
+#endif
+static uint16_t Tacho_VdoFrameLength(const uint8_t *frame, uint16_t avail);
+static bool_t Tacho_VdoFrameCheck(const uint8_t *frame, uint16_t length);
+static bool_t Tacho_VdoDecodeFrame(Tacho_Ctx_t *ctx, const uint8_t *frame, uint16_t length);
+static void Tacho_VdoDecodeDIN(const uint8_t *field, Tacho_DriverID_t *driver);
+static void Tacho_VdoDecodeInfo(const uint8_t *frame, Tacho_VdoInfo_t *info);
+static void Tacho_VdoCopyToCache(Tacho_Ctx_t *ctx);
 
 /* Stoneridge-specific functions */
-static void Tacho_StoneridgeInitHandler(void);
-static bool_t Tacho_StoneridgeHandler(uint8_t rx_byte);
-static bool_t Tacho_StoneridgeMsgProcess(uint8_t rx_byte);
-static void Tacho_StoneridgeCheckDIN(uint8_t rx_byte);
-static void Tacho_StoneridgeCopyDIN(uint8_t pos, uint8_t rx_byte, uint8_t *country, uint8_t *cardnr);
+#if (TACHO_CFG_SR_BYTEWISE == STD_ON)
+static void Tacho_StoneridgeInitHandler(Tacho_Ctx_t *ctx);
+static bool_t Tacho_StoneridgeHandler(Tacho_Ctx_t *ctx, uint8_t rx_byte);
+static bool_t Tacho_StoneridgeMsgProcess(Tacho_Ctx_t *ctx, uint8_t rx_byte);
+static void Tacho_StoneridgeCheckDIN(Tacho_Ctx_t *ctx, uint8_t rx_byte);
+static void Tacho_StoneridgeCopyDIN(Tacho_Ctx_t *ctx, uint8_t pos, uint8_t rx_byte, uint8_t *country, uint8_t *cardnr);
+#endif
+static bool_t Tacho_StoneridgeMsgValid(uint8_t msg_id);
+static uint16_t Tacho_StoneridgeFrameLength(const uint8_t *frame, uint16_t avail);
+static bool_t Tacho_StoneridgeFrameCheck(const uint8_t *frame, uint16_t length);
+static bool_t Tacho_StoneridgeDecodeFrame(Tacho_Ctx_t *ctx, const uint8_t *frame, uint16_t length);
+static void Tacho_StoneridgeDecodeDIN(const uint8_t *field, uint8_t size, Tacho_DriverID_t *driver);
+static void Tacho_StoneridgeUpdateSnapshot(Tacho_Ctx_t *ctx, uint8_t msg_id, const uint8_t *field, uint8_t size);
+static bool_t Tacho_StoneridgeSnapshotEqual(const Tacho_SrSnapshot_t *a, const Tacho_SrSnapshot_t *b);
+
+/* Statistics */
+#if (TACHO_CFG_STATS == STD_ON)
+static void Tacho_StatInc(Tacho_Ctx_t *ctx, Tacho_StatCounter_t id);
+static uint32_t Tacho_StatTime(Tacho_Ctx_t *ctx);
+static void Tacho_StatBlockStart(Tacho_Ctx_t *ctx);
+static void Tacho_StatDecodeStart(Tacho_Ctx_t *ctx);
+static void Tacho_StatFrameDone(Tacho_Ctx_t *ctx);
+static void Tacho_StatBadHeader(Tacho_Ctx_t *ctx, const uint8_t *frame, uint16_t avail);
+static void Tacho_StatRecord(volatile uint32_t *hist, uint32_t ticks);
+#endif
+
+#if (TACHO_CFG_HW_BINDINGS == STD_ON)
+/** Platform bindings of the default context */
+static const Tacho_CtxConfig_t Tacho_DefaultConfig =
+{
+    Tacho_DefaultSetBaudrate,
+    Tacho_DefaultReadProtocol,
+    Tacho_DefaultWriteProtocol,
+    Tacho_DefaultTco1Notif,
+    NULL_PTR,
+    NULL_PTR,
+    NULL_PTR,
+#if (TACHO_CFG_JOURNAL == STD_ON)
+    Tacho_DefaultReadNvm,
+    Tacho_DefaultWriteNvm,
+#else
+    NULL_PTR,
+    NULL_PTR,
+#endif
+    NULL_PTR
+};
+#endif
 
 /******************************************************************************/
 /*    IMPLEMENTATION                                                          */
@@ -232,25 +356,12 @@ static void Tacho_StoneridgeCopyDIN(uint8_t pos, uint8_t rx_byte, uint8_t *count
  */
 void Tacho_Init(void)
 {
-    Std_ReturnType op_status = E_NOT_OK;
-    Tacho_Standard_t protocol = TACHO_STANDARD_MAX;
-
-    Tacho_RxQueue.buffer_start = &Tacho_RxQueue.data[0];
-    Tacho_RxQueue.buffer_end = &Tacho_RxQueue.data[TACHO_RX_QUEUE_SIZE - 1];
-
+#if (TACHO_CFG_HW_BINDINGS == STD_ON)
     USART2_init(Tacho_RxNotif, Tacho_ErrorNotif);
-
-    op_status = Tacho_ReadMemory(&protocol);
-    if (E_OK == op_status)
-    {
-        /* Select last saved Tachograph protocol */
-        Tacho_SelectStandard(protocol, FALSE);
-    }
-    else
-    {
-        /* Default to VDO */
-        Tacho_SelectStandard(TACHO_STANDARD_VDO, TRUE);
-    }
+    Tacho_CtxInit(&Tacho_DefaultCtx, &Tacho_DefaultConfig, NULL_PTR);
+#else
+    Tacho_CtxInit(&Tacho_DefaultCtx, NULL_PTR, NULL_PTR);
+#endif
 }
 
 /**
@@ -258,7 +369,10 @@ void Tacho_Init(void)
  */
 void Tacho_DeInit(void)
 {
+    (void) Tacho_CtxJournalFlush(&Tacho_DefaultCtx);
+#if (TACHO_CFG_HW_BINDINGS == STD_ON)
     USART2_close();
+#endif
 }
 
 /**
@@ -267,7 +381,7 @@ void Tacho_DeInit(void)
  */
 uint8_t *tacho_get_cached_tco1_content_p(void)
 {
-    return (uint8_t *) Tacho_CachedData.tco1_cmn;
+    return Tacho_CtxGetCachedTco1(&Tacho_DefaultCtx);
 }
 
 /**
@@ -276,7 +390,38 @@ uint8_t *tacho_get_cached_tco1_content_p(void)
  */
 uint8_t *tacho_get_cached_di_content_p(void)
 {
-    return (uint8_t *) Tacho_CachedData.di;
+    return Tacho_CtxGetCachedDI(&Tacho_DefaultCtx);
+}
+
+/**
+ * Decoder statistics of the default link
+ * @param out[out] Statistics
+ * @return E_OK, E_NOT_OK if statistics are compiled out (TACHO_CFG_STATS)
+ */
+Std_ReturnType Tacho_GetStats(Tacho_Stats_t *out)
+{
+    return Tacho_CtxGetStats(&Tacho_DefaultCtx, out);
+}
+
+/**
+ * Pops the oldest decoded frames of the default link
+ * @param out[out] Array of at least max frames
+ * @param max Maximum number of frames to pop
+ * @return Number of frames written to out
+ */
+uint16_t Tacho_PopFrames(Tacho_HistFrame_t *out, uint16_t max)
+{
+    return Tacho_CtxPopFrames(&Tacho_DefaultCtx, out, max);
+}
+
+/**
+ * Consistent copy of the cached data, safe to call from any thread or interrupt level
+ * @param out[out] Snapshot
+ * @return E_OK if a consistent copy was taken, E_NOT_OK if the decoder kept writing
+ */
+Std_ReturnType Tacho_ReadSnapshot(Tacho_Snapshot_t *out)
+{
+    return Tacho_CtxReadSnapshot(&Tacho_DefaultCtx, out);
 }
 
 /**
@@ -285,7 +430,16 @@ uint8_t *tacho_get_cached_di_content_p(void)
  */
 Tacho_Standard_t Tacho_GetSelectedStandard(void)
 {
-    return Tacho_SelectedStandard;
+    return Tacho_CtxGetSelectedStandard(&Tacho_DefaultCtx);
+}
+
+/**
+ * Number of received bytes dropped because the reception buffer was full
+ * @return Free-running dropped byte counter
+ */
+uint32_t Tacho_GetDroppedBytes(void)
+{
+    return Tacho_CtxGetDroppedBytes(&Tacho_DefaultCtx);
 }
 
 /**
@@ -293,691 +447,3458 @@ Tacho_Standard_t Tacho_GetSelectedStandard(void)
  */
 void Tacho_Task(void)
 {
-    static bool_t perform_sync = TRUE;
-    static uint8_t index = 0;
-    uint8_t rx_byte = 0xFF;
+    Tacho_CtxTask(&Tacho_DefaultCtx);
+}
 
-    /* Check for framing errors and select another standard if needed */
-    if (TACHO_MAX_FRAMING_ERRORS <= Tacho_RxQueue.error_counter)
-    {
-        Tacho_RxQueue.failed_attempts++;
-        if (TACHO_MAX_FAILED_ATTEMPTS <= Tacho_RxQueue.failed_attempts)
-        {
-            if (TACHO_STANDARD_VDO == Tacho_SelectedStandard)
-            {
-                Tacho_SelectStandard(TACHO_STANDARD_STONERIDGE, TRUE);
-            }
-            else
-            {
-                Tacho_SelectStandard(TACHO_STANDARD_VDO, TRUE);
-            }
-            /* Terminate Task for now and wait for a new set of data */
-            return;
-        }
-    }
-    Tacho_RxQueue.error_counter = 0;
+/**
+ * Called each time a byte is received
+ * @param rx_byte Byte value
+ */
+void Tacho_RxNotif(uint8_t rx_byte)
+{
+    Tacho_CtxRxNotif(&Tacho_DefaultCtx, rx_byte);
+}
+
+/**
+ * Called each time a block of bytes is received
+ * @param buf[in] Received bytes
+ * @param len Number of bytes in buf
+ */
+void Tacho_RxBlock(const uint8_t *buf, uint32_t len)
+{
+    Tacho_CtxRxBlock(&Tacho_DefaultCtx, buf, len);
+}
+
+/**
+ * Callead each time a framing error occurs
+ */
+void Tacho_ErrorNotif(void)
+{
+    Tacho_CtxErrorNotif(&Tacho_DefaultCtx);
+}
+
+#if (TACHO_CFG_HW_BINDINGS == STD_ON)
+/**
+ * Called by the J1939 when a TCO1 message has been read on CAN
+ * @param event Should always be J1939_EVENT_TCO1_AVAILABLE
+ */
+void Tacho_process_j1939_event(uint8_t event)
+{
+    uint8_t *p_data;
 
-    while (Tacho_FetchByte(&rx_byte))
+    switch (event)
     {
-        if (perform_sync)
-        {
-            /* Search for start of frame */
-            if (Tacho_Proto->start_seq[index] == rx_byte)
-            {
-                index++;
-                if (Tacho_Proto->start_sz <= index)
-                {
-                    perform_sync = FALSE;
-                }
-            }
-            else
-            {
-                index = 0;
-            }
-        }
-        else
-        {
-             /* Sync OK - take next step: run handler (if not null :) */
-            if (NULL_PTR != Tacho_Handler)
-            {
-                if ( (*Tacho_Handler)(rx_byte) )
-                {
-                    /* Frame done or frame error - must re-sync */
-                    perform_sync = TRUE;
-                    index = 0;
-                }
-            }
-        }
+    case (J1939_EVENT_TCO1_AVAILABLE):
+        p_data = j1939_get_cached_tco1_content_p();
+        Tacho_CtxProcessTco1(&Tacho_DefaultCtx, p_data);
+        break;
+
+    default:
+        break;
     }
 }
+#endif
 
 /**
- * Reads last known Tachograph protocol from FRAM memory
- * @param protocol[out] Pointer to protocol type info
- * @return E_OK if data was read from FRAM successfully, E_NOT_OK otherwise
+ * Called whenever a DI message from J1939 is received
+ * @param di[in] Driver identification from J1939
+ */
+void Tacho_process_j1939_di(uint8_t *di)
+{
+    Tacho_CtxProcessDI(&Tacho_DefaultCtx, di);
+}
+
+/**
+ * Called for each frame received on the CAN bus of the default link
+ * @param id 29-bit extended identifier
+ * @param data[in] Frame data
+ * @param dlc Number of bytes in data
+ */
+void Tacho_CanRx(uint32_t id, const uint8_t *data, uint8_t dlc)
+{
+    Tacho_CtxCanRx(&Tacho_DefaultCtx, id, data, dlc);
+}
+
+/**
+ * Initializes a decoder context and selects the last known protocol
+ * @param ctx Decoder context
+ * @param config Platform bindings (must outlive the context)
+ * @param user Opaque pointer stored in the context for the application
  */
-static Std_ReturnType Tacho_ReadMemory(Tacho_Standard_t *protocol)
+void Tacho_CtxInit(Tacho_Ctx_t *ctx, const Tacho_CtxConfig_t *config, void *user)
 {
     Std_ReturnType op_status = E_NOT_OK;
-    uint8_t data;
+    Tacho_Standard_t protocol = TACHO_STANDARD_MAX;
+    uint8_t *raw = (uint8_t *) ctx;
+    uint32_t i;
 
-    if (NULL != protocol)
+    for (i = 0; i < sizeof(Tacho_Ctx_t); i++)
     {
-        *protocol = TACHO_STANDARD_MAX;
-        if (E_OK == FRAM_ReadByte(FRAM_MEMADDR_TACHO_PROTO, &data))
-        {
-            if (data < TACHO_STANDARD_MAX)
-            {
-                *protocol = (Tacho_Standard_t) data;
-                op_status = E_OK;
-            }
-        }
+        raw[i] = 0;
     }
-    return op_status;
+
+    ctx->config = config;
+    ctx->user = user;
+    ctx->perform_sync = TRUE;
+    ctx->thresholds = Tacho_DefaultThresholds;
+
+#if (TACHO_CFG_JOURNAL == STD_ON)
+    /* Last known TCO1, DI and vehicle data are available before the first frame */
+    ctx->journal.last_write = Tacho_JournalTime(ctx);
+    (void) Tacho_JournalRestore(ctx);
+#endif
+
+    op_status = Tacho_ReadMemory(ctx, &protocol);
+    if (E_OK == op_status)
+    {
+        /* Select last saved Tachograph protocol */
+        Tacho_SelectStandard(ctx, protocol, FALSE);
+    }
+    else
+    {
+        /* Default to VDO */
+        Tacho_SelectStandard(ctx, TACHO_STANDARD_VDO, TRUE);
+    }
+
+#if (TACHO_CFG_WAKEUP == STD_ON)
+    Tacho_WakeupArm(ctx);
+#endif
 }
 
 /**
- * Saves determined Tachograph protocol in FRAM memory
- * @param protocol[in] Protocol type to be written in memory
- * @return E_OK if data was saved in FRAM successfully, E_NOT_OK otherwise
+ * Get most recent TCO1 data of a context
+ * @param ctx Decoder context
+ * @return Pointer to an array of 8 bytes representing a reconstructed TCO1 message
  */
-static Std_ReturnType Tacho_SetMemory(Tacho_Standard_t protocol)
+uint8_t *Tacho_CtxGetCachedTco1(Tacho_Ctx_t *ctx)
 {
-    Std_ReturnType op_status = E_NOT_OK;
+    return (uint8_t *) ctx->cached.tco1_cmn;
+}
 
-    if (protocol < TACHO_STANDARD_MAX)
+/**
+ * Get most recent driver ID data of a context
+ * @param ctx Decoder context
+ * @return Pointer to an array where the 2 driver IDs are stored
+ */
+uint8_t *Tacho_CtxGetCachedDI(Tacho_Ctx_t *ctx)
+{
+    return (uint8_t *) ctx->cached.di;
+}
+
+/**
+ * Get the last complete Stoneridge vehicle snapshot of a context
+ * @param ctx Decoder context
+ * @return Pointer to the published snapshot (valid is 0 until every part was received)
+ */
+const Tacho_SrSnapshot_t *Tacho_CtxGetSrSnapshot(Tacho_Ctx_t *ctx)
+{
+    return &ctx->cached.sr;
+}
+
+/**
+ * Checks whether every Stoneridge snapshot part (VIN, DIN1, DIN2, VRN) was received
+ * @param ctx Decoder context
+ * @return TRUE if a complete snapshot is available, FALSE otherwise
+ */
+bool_t Tacho_CtxSrSnapshotComplete(Tacho_Ctx_t *ctx)
+{
+    return (bool_t) (TACHO_SR_PART_ALL == ctx->cached.sr.valid);
+}
+
+/**
+ * Age of a Stoneridge snapshot part
+ * @param ctx Decoder context
+ * @param part Snapshot part
+ * @return Stoneridge frames decoded since the part was last received
+ *  (0 = latest frame), TACHO_SR_AGE_NONE if it was never received
+ */
+uint16_t Tacho_CtxGetSrPartAge(Tacho_Ctx_t *ctx, Tacho_SrPart_t part)
+{
+    const Tacho_SrSnapshot_t *snap = &ctx->sr_snap;
+
+    if ( (TACHO_SR_PARTS <= part) || (0 == (snap->valid & TACHO_SR_PART_MASK(part))) )
     {
-        op_status = FRAM_WriteByte(FRAM_MEMADDR_TACHO_PROTO, (uint8_t) protocol);
+        return TACHO_SR_AGE_NONE;
     }
-    return op_status;
+    return (uint16_t) (snap->frames - snap->stamp[part]);
 }
 
 /**
- * Copies the DIN fields from the D8 VDO frame to the corresponding buffers
- *
- * @param pos Position in the DIN field
- * @param rx_byte Received byte from D8 serial output
- * @param country Pointer to country code buffer
- * @param cardnr Pointer to card number buffer
+ * Get most recent VDO-only data of a context (time, distances, VIN...)
+ * @param ctx Decoder context
+ * @return Pointer to the cached data; views point into the cache
  */
-static void Tacho_VdoCopyDIN(uint8_t pos, uint8_t rx_byte, uint8_t *country, uint8_t *cardnr)
+const Tacho_VdoInfo_t *Tacho_CtxGetCachedVdo(Tacho_Ctx_t *ctx)
 {
-    uint8_t *readCode;
-    uint8_t i;
+    return &ctx->cached.vdo;
+}
 
-    if (pos == TACHO_VDO_CC_POS)
+/**
+ * Takes a consistent copy of the cached data without blocking the decoder
+ * The cache is copied between two reads of its sequence counter and the copy
+ * is retried if a write section was open or closed meanwhile. A reader that
+ * preempted the decoder in the middle of a write cannot wait for it, hence the
+ * bounded number of attempts.
+ * @param ctx Decoder context
+ * @param out[out] Snapshot; VDO views point into out->data
+ * @return E_OK if a consistent copy was taken, E_NOT_OK after TACHO_SNAPSHOT_RETRIES torn attempts
+ */
+Std_ReturnType Tacho_CtxReadSnapshot(Tacho_Ctx_t *ctx, Tacho_Snapshot_t *out)
+{
+    uint16_t begin;
+    uint16_t end;
+    uint8_t attempt;
+
+    for (attempt = 0; attempt < TACHO_SNAPSHOT_RETRIES; attempt++)
     {
-        readCode = Tacho_GetCountryCode(rx_byte);
-        for (i = 0; i < TACHO_MAX_COUNTRY_CODE; i++)
+        begin = TACHO_LOAD_ACQUIRE(&ctx->cached_seq);
+        if (0 != (begin & 1))
         {
-            country[i] = readCode[i];
+            continue;
         }
-    }
-    else if (pos > TACHO_VDO_CC_POS)
-    {
-        pos -= (TACHO_VDO_CC_POS + 1);
-        if (pos < TACHO_MAX_CARD_NR)
+
+        out->data = ctx->cached;
+        TACHO_FENCE_ACQUIRE();
+        end = TACHO_LOAD_RELAXED(&ctx->cached_seq);
+        if (begin == end)
         {
-            cardnr[pos] = rx_byte;
+            out->generation = (uint16_t) (begin >> 1);
+            out->data.vdo.vin.data = out->data.vin;
+            out->data.vdo.cstr.data = out->data.cstr;
+            return E_OK;
         }
     }
+
+    return E_NOT_OK;
 }
 
 /**
- * Checks if received byte contains data from a VDO DIN field
- * @param rx_byte Received byte from D8 serial output
+ * Checks whether a context has received bytes its task has not decoded yet
+ * @param ctx Decoder context
+ * @return TRUE if Tacho_CtxTask() has bytes to process, FALSE otherwise
  */
-static void Tacho_VdoCheckDIN(uint8_t rx_byte)
+bool_t Tacho_CtxRxPending(Tacho_Ctx_t *ctx)
 {
-    uint8_t pos;
+    return (bool_t) ( (ctx->lookback.head < ctx->lookback.count) ||
+                      (TACHO_LOAD_ACQUIRE(&ctx->rx_queue.prod.p.tail) != ctx->rx_queue.cons.c.head) );
+}
 
-    if (vdo.drv1_pos == vdo.index)
-    {
-        if (rx_byte == 0)
-        {
-            /* DIN1 field is empty */
-            Tacho_Frame.driver[TACHO_DRIVER1].cardnr[0] = '\0';
-        }
-    }
-    else if ( (vdo.drv1_pos < vdo.index) && (vdo.index < vdo.drv2_pos) )
-    {
-        /* Index points within the boundaries of the DIN1 field */
-        pos = vdo.index - vdo.drv1_pos - 1;
-        Tacho_VdoCopyDIN(
-            pos,
-            rx_byte,
-            Tacho_Frame.driver[TACHO_DRIVER1].country,
-            Tacho_Frame.driver[TACHO_DRIVER1].cardnr
-        );
-    }
-    else if (vdo.drv2_pos == vdo.index)
+/**
+ * Number of received bytes dropped because the reception buffer of a context was full
+ * @param ctx Decoder context
+ * @return Free-running dropped byte counter
+ */
+uint32_t Tacho_CtxGetDroppedBytes(Tacho_Ctx_t *ctx)
+{
+    return TACHO_LOAD_RELAXED(&ctx->rx_queue.prod.p.dropped);
+}
+
+/**
+ * Reads the statistics of a context
+ * Counters run freely; each value is read atomically but the set is not a
+ * single snapshot.
+ * @param ctx Decoder context
+ * @param out[out] Statistics
+ * @return E_OK, E_NOT_OK if statistics are compiled out (TACHO_CFG_STATS)
+ */
+Std_ReturnType Tacho_CtxGetStats(Tacho_Ctx_t *ctx, Tacho_Stats_t *out)
+{
+#if (TACHO_CFG_STATS == STD_ON)
+    uint8_t i;
+
+    for (i = 0; i < TACHO_STAT_DROPPED; i++)
     {
-        if (rx_byte == 0)
-        {
-            /* DIN2 field is empty */
-            Tacho_Frame.driver[TACHO_DRIVER2].cardnr[0] = '\0';
-        }
+        out->counter[i] = TACHO_LOAD_RELAXED(&ctx->stats.counter[i]);
     }
-    else if ( (vdo.drv2_pos < vdo.index) && (vdo.index < vdo.crc8_pos) )
+    out->counter[TACHO_STAT_DROPPED] = TACHO_LOAD_RELAXED(&ctx->rx_queue.prod.p.dropped);
+    out->counter[TACHO_STAT_FRAMING] = TACHO_LOAD_RELAXED(&ctx->rx_queue.prod.p.error_counter);
+    for (i = 0; i < TACHO_HIST_BUCKETS; i++)
     {
-        /* Index points within the boundaries of the DIN2 field */
-        pos = vdo.index - vdo.drv2_pos - 1;
-        Tacho_VdoCopyDIN(
-            pos,
-            rx_byte,
-            Tacho_Frame.driver[TACHO_DRIVER2].country,
-            Tacho_Frame.driver[TACHO_DRIVER2].cardnr
-        );
+        out->decode_time[i] = TACHO_LOAD_RELAXED(&ctx->stats.decode_time[i]);
+        out->latency[i] = TACHO_LOAD_RELAXED(&ctx->stats.latency[i]);
     }
+    return E_OK;
+#else
+    (void) ctx;
+    (void) out;
+    return E_NOT_OK;
+#endif
 }
 
 /**
- * Initializes internal data for the VDO protocol
+ * Driving and rest times of the cards seen on the default link
+ * @param out[out] Array of at least max entries
+ * @param max Maximum number of entries
+ * @return Number of entries written to out
  */
-static void Tacho_VdoInitHandler(void)
+uint8_t Tacho_GetDrivingTimes(Tacho_DrivingTime_t *out, uint8_t max)
 {
-    vdo.index = TACHO_VDO_SEQSZ;
-    vdo.crc8_value = TACHO_VDO_CRC_INIT;
-    vdo.cstr_pos = 0xFF;
-    vdo.drv1_pos = 0xFF;
-    vdo.drv2_pos = 0xFF;
-    vdo.crc8_pos = 0xFF;
+    return Tacho_CtxGetDrivingTimes(&Tacho_DefaultCtx, out, max);
 }
 
 /**
- * Handles data coming from a VDO-type Tachograph
- * @param rx_byte Received byte from D8 serial output
- * @return TRUE if end of frame detected
- *  FALSE if frame is still being processed
+ * Pops the oldest decoded frames of a context, in decoding order
+ * Meant for a consumer running less often than frames arrive; may be called
+ * from another thread than the decoder (one consumer per context). Lost
+ * frames show up as gaps in seq.
+ * @param ctx Decoder context
+ * @param out[out] Array of at least max frames
+ * @param max Maximum number of frames to pop
+ * @return Number of frames written to out (0 if the history is compiled out)
  */
-static bool_t Tacho_VdoHandler(uint8_t rx_byte)
+uint16_t Tacho_CtxPopFrames(Tacho_Ctx_t *ctx, Tacho_HistFrame_t *out, uint16_t max)
 {
-    switch (vdo.index)
+#if (TACHO_CFG_HISTORY == STD_ON)
+    Tacho_History_t *hist = &ctx->history;
+    uint16_t head = hist->head;
+    uint16_t tail = TACHO_LOAD_ACQUIRE(&hist->tail);
+    uint16_t count;
+    uint16_t i;
+#if (TACHO_CFG_HISTORY_OVERWRITE == STD_ON)
+    uint16_t stale;
+#endif
+
+    if ((uint16_t) (tail - head) > TACHO_HISTORY_SIZE)
     {
-    case TACHO_VDO_WORKING_STATE:
-        Tacho_Frame.working_state = rx_byte;
+        /* Overrun - the oldest entries were overwritten */
+        head = (uint16_t) (tail - TACHO_HISTORY_SIZE);
+    }
+    count = MIN((uint16_t) (tail - head), max);
+    for (i = 0; i < count; i++)
+    {
+        out[i] = hist->entry[(uint16_t) (head + i) & TACHO_HISTORY_MASK];
+    }
+
+#if (TACHO_CFG_HISTORY_OVERWRITE == STD_ON)
+    /* Drop the entries the decoder started overwriting while they were copied */
+    TACHO_FENCE_ACQUIRE();
+    stale = (uint16_t) (TACHO_LOAD_RELAXED(&hist->reserve) - TACHO_HISTORY_SIZE - head);
+    if ( (stale < 0x8000U) && (0 < stale) )
+    {
+        stale = MIN(stale, count);
+        memmove(out, &out[stale], (count - stale) * sizeof(Tacho_HistFrame_t));
+        TACHO_STORE_RELEASE(&hist->head, (uint16_t) (head + count));
+        return (uint16_t) (count - stale);
+    }
+#endif
+
+    TACHO_STORE_RELEASE(&hist->head, (uint16_t) (head + count));
+    return count;
+#else
+    (void) ctx;
+    (void) out;
+    (void) max;
+    return 0;
+#endif
+}
+
+/**
+ * Takes a consistent copy of the driving and rest times of the cards seen on a context
+ * The accumulators are updated inside a cache write section, so they are
+ * read like Tacho_CtxReadSnapshot() reads the cache and may be called from
+ * another thread than the decoder.
+ * @param ctx Decoder context
+ * @param out[out] Array of at least max entries, cards inserted first
+ * @param max Maximum number of entries
+ * @return Number of entries written to out (0 if the accumulators are
+ *  compiled out, the context has no get_time binding or
+ *  TACHO_SNAPSHOT_RETRIES attempts overlapped a write)
+ */
+uint8_t Tacho_CtxGetDrivingTimes(Tacho_Ctx_t *ctx, Tacho_DrivingTime_t *out, uint8_t max)
+{
+#if (TACHO_CFG_DRIVING_TIME == STD_ON)
+    Tacho_Driving_t *driving = &ctx->driving;
+    uint16_t begin;
+    uint8_t attempt;
+    uint8_t count;
+    uint8_t pass;
+    uint8_t i;
+
+    for (attempt = 0; attempt < TACHO_SNAPSHOT_RETRIES; attempt++)
+    {
+        begin = TACHO_LOAD_ACQUIRE(&ctx->cached_seq);
+        if (0 != (begin & 1))
+        {
+            continue;
+        }
+
+        count = 0;
+        for (pass = 0; pass < 2; pass++)
+        {
+            for (i = 0; (i < driving->count) && (count < max); i++)
+            {
+                if (driving->card[i].inserted == (bool_t) (0 == pass))
+                {
+                    out[count++] = driving->card[i];
+                }
+            }
+        }
+        TACHO_FENCE_ACQUIRE();
+        if (begin == TACHO_LOAD_RELAXED(&ctx->cached_seq))
+        {
+            return count;
+        }
+    }
+#else
+    (void) ctx;
+    (void) out;
+    (void) max;
+#endif
+
+    return 0;
+}
+
+/**
+ * Current selected D8 protocol of a context
+ * @param ctx Decoder context
+ * @return VDO or Stoneridge
+ */
+Tacho_Standard_t Tacho_CtxGetSelectedStandard(Tacho_Ctx_t *ctx)
+{
+    return ctx->standard;
+}
+
+/**
+ * Processes the bytes received on a context (called periodically)
+ * @param ctx Decoder context
+ */
+void Tacho_CtxTask(Tacho_Ctx_t *ctx)
+{
+    Tacho_RxQueueConsumer_t *cons = &ctx->rx_queue.cons;
+    uint8_t rx_byte = 0xFF;
+    uint16_t error_counter;
+    uint16_t errors;
+
+    /* Framing errors received since the previous Task call */
+    error_counter = TACHO_LOAD_RELAXED(&ctx->rx_queue.prod.p.error_counter);
+    errors = (uint16_t) (error_counter - cons->c.error_seen);
+    cons->c.error_seen = error_counter;
+
+    /* Check for framing errors and select another standard if needed */
+    if (TACHO_MAX_FRAMING_ERRORS <= errors)
+    {
+        cons->c.failed_attempts++;
+        if (TACHO_MAX_FAILED_ATTEMPTS <= cons->c.failed_attempts)
+        {
+            if (TACHO_STANDARD_VDO == ctx->standard)
+            {
+                Tacho_SelectStandard(ctx, TACHO_STANDARD_STONERIDGE, TRUE);
+            }
+            else
+            {
+                Tacho_SelectStandard(ctx, TACHO_STANDARD_VDO, TRUE);
+            }
+            Tacho_CtxJournalTask(ctx);
+#if (TACHO_CFG_WAKEUP == STD_ON)
+            Tacho_WakeupArm(ctx);
+#endif
+            /* Terminate Task for now and wait for a new set of data */
+            return;
+        }
+    }
+
+    while (Tacho_NextByte(ctx, &rx_byte))
+    {
+        if (ctx->perform_sync)
+        {
+            /* Search for start of frame */
+            if (FALSE == Tacho_SyncByte(ctx, rx_byte))
+            {
+                continue;
+            }
+        }
+
+        /* Sync OK - take next step: run handler (if not null :) */
+        if (NULL_PTR != ctx->handler)
+        {
+            if ( TACHO_RUN_HANDLER(ctx, rx_byte) )
+            {
+                /* Frame done or frame error - must re-sync */
+                ctx->perform_sync = TRUE;
+                ctx->sync_state = 0;
+            }
+        }
+    }
+
+    /* After decoding, so the frames of this run are saved once the period is over */
+    Tacho_CtxJournalTask(ctx);
+#if (TACHO_CFG_WAKEUP == STD_ON)
+    Tacho_WakeupArm(ctx);
+#endif
+}
+
+/**
+ * Enables or disables automatic protocol selection on a context
+ * When enabled, every start sequence of a known protocol is accepted and the
+ * decoder follows it, without touching the baudrate or persistent memory.
+ * Meant for replaying captures; on a live link the framing errors of the
+ * wrong baudrate still drive the protocol selection.
+ * @param ctx Decoder context
+ * @param enable TRUE to follow the start sequences found in the data
+ */
+void Tacho_CtxSetAutoStandard(Tacho_Ctx_t *ctx, bool_t enable)
+{
+    ctx->auto_standard = enable;
+}
+
+/**
+ * Sets the change reporting thresholds of a context
+ * @param ctx Decoder context
+ * @param thresholds[in] New thresholds (copied)
+ */
+void Tacho_CtxSetThresholds(Tacho_Ctx_t *ctx, const Tacho_Thresholds_t *thresholds)
+{
+    ctx->thresholds = *thresholds;
+}
+
+/**
+ * Start sequence of a context protocol recognized at an automaton state
+ * @param ctx Decoder context
+ * @param state Automaton state
+ * @return Protocol whose start sequence ends at state, TACHO_SYNC_NONE if none
+ *  (or if the protocol is not the selected one and auto selection is off)
+ */
+static uint8_t Tacho_SyncAccepted(Tacho_Ctx_t *ctx, uint8_t state)
+{
+    uint8_t id = Tacho_SyncMatch(state);
+
+    if ( (id == (uint8_t) ctx->standard) || ( ctx->auto_standard && (id < TACHO_STANDARD_MAX) ) )
+    {
+        return id;
+    }
+    return TACHO_SYNC_NONE;
+}
+
+/**
+ * Feeds a byte to the start sequence automaton of a context
+ * A completed start sequence is only accepted once the next byte does not
+ * complete another one, so in a run of 0xFF the frame starts after the last
+ * three.
+ * @param ctx Decoder context
+ * @param rx_byte Received byte
+ * @return TRUE if rx_byte is the first byte following a start sequence
+ *  (sync is then complete), FALSE otherwise
+ */
+static bool_t Tacho_SyncByte(Tacho_Ctx_t *ctx, uint8_t rx_byte)
+{
+    uint8_t matched = Tacho_SyncAccepted(ctx, ctx->sync_state);
+    uint8_t state = Tacho_SyncNext(ctx->sync_state, rx_byte);
+
+    if ( (TACHO_SYNC_NONE != matched) && (TACHO_SYNC_NONE == Tacho_SyncAccepted(ctx, state)) )
+    {
+        if (matched != (uint8_t) ctx->standard)
+        {
+            Tacho_SelectHandler(ctx, (Tacho_Standard_t) matched);
+        }
+        ctx->perform_sync = FALSE;
+        ctx->sync_state = 0;
+        TACHO_STAT_FRAME_START(ctx);
+        return TRUE;
+    }
+
+    if (0 == state)
+    {
+        /* Byte is not part of any start sequence */
+        TACHO_STAT_LOST(ctx);
+    }
+    ctx->sync_state = state;
+    return FALSE;
+}
+
+/**
+ * Reads last known Tachograph protocol from persistent memory
+ * @param ctx Decoder context
+ * @param protocol[out] Pointer to protocol type info
+ * @return E_OK if data was read from memory successfully, E_NOT_OK otherwise
+ */
+static Std_ReturnType Tacho_ReadMemory(Tacho_Ctx_t *ctx, Tacho_Standard_t *protocol)
+{
+    Std_ReturnType op_status = E_NOT_OK;
+    uint8_t data;
+
+    if (NULL != protocol)
+    {
+        *protocol = TACHO_STANDARD_MAX;
+#if (TACHO_CFG_JOURNAL == STD_ON)
+        if (ctx->journal.restored)
+        {
+            *protocol = (Tacho_Standard_t) ctx->journal.protocol;
+            return E_OK;
+        }
+#endif
+        if ( (NULL_PTR != ctx->config) && (NULL_PTR != ctx->config->read_protocol) )
+        {
+            if (E_OK == ctx->config->read_protocol(ctx, &data))
+            {
+                if (data < TACHO_STANDARD_MAX)
+                {
+                    *protocol = (Tacho_Standard_t) data;
+                    op_status = E_OK;
+                }
+            }
+        }
+#if (TACHO_CFG_JOURNAL == STD_ON)
+        /* No journal yet: carry the protocol saved by read_protocol over */
+        ctx->journal.protocol = (uint8_t) *protocol;
+#endif
+    }
+    return op_status;
+}
+
+/**
+ * Saves determined Tachograph protocol in persistent memory
+ * @param ctx Decoder context
+ * @param protocol[in] Protocol type to be written in memory
+ * @return E_OK if data was saved in memory successfully, E_NOT_OK otherwise
+ */
+static Std_ReturnType Tacho_SetMemory(Tacho_Ctx_t *ctx, Tacho_Standard_t protocol)
+{
+    Std_ReturnType op_status = E_NOT_OK;
+
+    if (protocol < TACHO_STANDARD_MAX)
+    {
+#if (TACHO_CFG_JOURNAL == STD_ON)
+        /* Saved with the next journal record: protocol flapping costs no extra write */
+        ctx->journal.protocol = (uint8_t) protocol;
+        op_status = E_OK;
+#else
+        if ( (NULL_PTR != ctx->config) && (NULL_PTR != ctx->config->write_protocol) )
+        {
+            op_status = ctx->config->write_protocol(ctx, (uint8_t) protocol);
+        }
+#endif
+    }
+    return op_status;
+}
+
+/**
+ * Writes the cached data to persistent memory at once if it changed since
+ * the last journal record (e.g. before a controlled shutdown)
+ * @param ctx Decoder context
+ * @return E_OK if the journal holds the current data, E_NOT_OK if the write
+ *  failed or TACHO_CFG_JOURNAL is STD_OFF
+ */
+Std_ReturnType Tacho_CtxJournalFlush(Tacho_Ctx_t *ctx)
+{
+#if (TACHO_CFG_JOURNAL == STD_ON)
+    uint16_t crc = Tacho_JournalCrc(ctx);
+
+    ctx->journal.last_write = Tacho_JournalTime(ctx);
+    if (crc == ctx->journal.crc)
+    {
+        return E_OK;
+    }
+    return Tacho_JournalWrite(ctx, crc);
+#else
+    (void) ctx;
+
+    return E_NOT_OK;
+#endif
+}
+
+/**
+ * Writes a journal record if the cached data changed, at most once every
+ * TACHO_JOURNAL_PERIOD (called periodically)
+ * Tacho_CtxTask(), Tacho_CtxRxBlock() and Tacho_CtxCanRx() call it after
+ * decoding. A context whose reception may go quiet (event-driven task, block
+ * or CAN reception) must also be given periodic calls from the thread
+ * writing its cache, or the last change is only saved when data comes again.
+ * @param ctx Decoder context
+ */
+void Tacho_CtxJournalTask(Tacho_Ctx_t *ctx)
+{
+#if (TACHO_CFG_JOURNAL == STD_ON)
+    Tacho_Journal_t *journal = &ctx->journal;
+    uint32_t now;
+    uint16_t crc;
+
+    journal->tasks++;
+    now = Tacho_JournalTime(ctx);
+    if ((uint32_t) (now - journal->last_write) < TACHO_JOURNAL_PERIOD)
+    {
+        return;
+    }
+
+    /* All the changes of a period are coalesced into a single record */
+    journal->last_write = now;
+    crc = Tacho_JournalCrc(ctx);
+    if (crc != journal->crc)
+    {
+        (void) Tacho_JournalWrite(ctx, crc);
+    }
+#else
+    (void) ctx;
+#endif
+}
+
+/**
+ * Tells whether the cache of a context was restored from the journal
+ * @param ctx Decoder context
+ * @return TRUE if Tacho_CtxInit() found a valid journal record, the cached
+ *  data then being the last one saved before the reset until new frames arrive
+ */
+bool_t Tacho_CtxJournalRestored(Tacho_Ctx_t *ctx)
+{
+#if (TACHO_CFG_JOURNAL == STD_ON)
+    return ctx->journal.restored;
+#else
+    (void) ctx;
+
+    return FALSE;
+#endif
+}
+
+#if (TACHO_CFG_JOURNAL == STD_ON)
+
+/**
+ * Journal clock
+ * @param ctx Decoder context
+ * @return get_time ticks, Tacho_CtxJournalTask() calls without a get_time binding
+ */
+static uint32_t Tacho_JournalTime(Tacho_Ctx_t *ctx)
+{
+    if ( (NULL_PTR != ctx->config) && (NULL_PTR != ctx->config->get_time) )
+    {
+        return ctx->config->get_time(ctx);
+    }
+    return ctx->journal.tasks;
+}
+
+/**
+ * CRC of the header and data of a journal record, computed on the cache
+ * @param ctx Decoder context
+ * @return CRC before the sequence number
+ */
+static uint16_t Tacho_JournalCrc(Tacho_Ctx_t *ctx)
+{
+    const uint8_t *cached = (const uint8_t *) &ctx->cached;
+    uint16_t crc;
+    uint8_t i;
+
+    crc = Tacho_ChecksumCrc16(Tacho_JournalHeader, TACHO_JOURNAL_HEADER_SIZE, 0xFFFF);
+    crc = Tacho_ChecksumCrc16(&ctx->journal.protocol, 1, crc);
+    for (i = 0; i < TACHO_JOURNAL_FIELDS; i++)
+    {
+        crc = Tacho_ChecksumCrc16(&cached[Tacho_JournalField[i][0]], Tacho_JournalField[i][1], crc);
+    }
+    return crc;
+}
+
+/**
+ * Writes a journal record in the slot not holding the last one
+ * The tail goes last: a write cut by a reset leaves a CRC mismatch in that
+ * slot and the previous record intact in the other one.
+ * @param ctx Decoder context
+ * @param crc Tacho_JournalCrc() of the data
+ * @return E_OK if the record was written, E_NOT_OK otherwise
+ */
+static Std_ReturnType Tacho_JournalWrite(Tacho_Ctx_t *ctx, uint16_t crc)
+{
+    Tacho_Journal_t *journal = &ctx->journal;
+    const uint8_t *cached = (const uint8_t *) &ctx->cached;
+    Std_ReturnType op_status = E_NOT_OK;
+    uint8_t slot = (uint8_t) (journal->slot ^ 1U);
+    uint16_t seq = (uint16_t) (journal->seq + 1U);
+    uint16_t addr = (uint16_t) (slot * TACHO_JOURNAL_SLOT_SIZE);
+    uint16_t record_crc;
+    uint8_t tail[TACHO_JOURNAL_TAIL_SIZE];
+    uint8_t i;
+
+    if ( (NULL_PTR == ctx->config) || (NULL_PTR == ctx->config->write_nvm) )
+    {
+        return E_NOT_OK;
+    }
+
+    op_status = ctx->config->write_nvm(ctx, addr, Tacho_JournalHeader, TACHO_JOURNAL_HEADER_SIZE);
+    addr += TACHO_JOURNAL_HEADER_SIZE;
+    if (E_OK == op_status)
+    {
+        op_status = ctx->config->write_nvm(ctx, addr, &journal->protocol, 1);
+        addr++;
+    }
+    for (i = 0; (i < TACHO_JOURNAL_FIELDS) && (E_OK == op_status); i++)
+    {
+        op_status = ctx->config->write_nvm(ctx, addr, &cached[Tacho_JournalField[i][0]], Tacho_JournalField[i][1]);
+        addr += Tacho_JournalField[i][1];
+    }
+
+    tail[0] = (uint8_t) seq;
+    tail[1] = (uint8_t) (seq >> 8);
+    record_crc = Tacho_ChecksumCrc16(tail, 2, crc);
+    tail[2] = (uint8_t) record_crc;
+    tail[3] = (uint8_t) (record_crc >> 8);
+    if (E_OK == op_status)
+    {
+        op_status = ctx->config->write_nvm(ctx, addr, tail, TACHO_JOURNAL_TAIL_SIZE);
+    }
+
+    if (E_OK == op_status)
+    {
+        journal->slot = slot;
+        journal->seq = seq;
+        journal->crc = crc;
+    }
+    return op_status;
+}
+
+/**
+ * Restores the protocol and cached data from the newest valid journal record
+ * @param ctx Decoder context
+ * @return E_OK if a record was restored, E_NOT_OK otherwise (cached fields cleared)
+ */
+static Std_ReturnType Tacho_JournalRestore(Tacho_Ctx_t *ctx)
+{
+    Tacho_Journal_t *journal = &ctx->journal;
+    uint8_t *cached = (uint8_t *) &ctx->cached;
+    uint8_t tail[TACHO_JOURNAL_TAIL_SIZE];
+    uint16_t seq[2];
+    uint8_t newest;
+    uint8_t i;
+
+    if ( (NULL_PTR == ctx->config) || (NULL_PTR == ctx->config->read_nvm) )
+    {
+        return E_NOT_OK;
+    }
+
+    for (i = 0; i < 2; i++)
+    {
+        seq[i] = 0;
+        if (E_OK == ctx->config->read_nvm(ctx, (uint16_t) ((i + 1U) * TACHO_JOURNAL_SLOT_SIZE - TACHO_JOURNAL_TAIL_SIZE),
+                                          tail, TACHO_JOURNAL_TAIL_SIZE))
+        {
+            seq[i] = (uint16_t) (tail[0] | (tail[1] << 8));
+        }
+    }
+
+    /* Newest record first (sequence numbers wrap), the other one if it is torn */
+    newest = ((int16_t) (seq[1] - seq[0]) > 0) ? 1 : 0;
+    if ( (E_OK == Tacho_JournalReadSlot(ctx, newest)) || (E_OK == Tacho_JournalReadSlot(ctx, (uint8_t) (newest ^ 1U))) )
+    {
+        if (0 != ctx->cached.vdo.vin.length)
+        {
+            ctx->cached.vdo.vin.data = ctx->cached.vin;
+        }
+        journal->restored = TRUE;
+        return E_OK;
+    }
+
+    /* Drop what the failed reads left in the cache, next record over the oldest slot */
+    for (i = 0; i < TACHO_JOURNAL_FIELDS; i++)
+    {
+        memset(&cached[Tacho_JournalField[i][0]], 0, Tacho_JournalField[i][1]);
+    }
+    journal->protocol = 0;
+    journal->slot = newest;
+    journal->seq = seq[newest];
+    return E_NOT_OK;
+}
+
+/**
+ * Reads a journal slot into the cache and checks it
+ * @param ctx Decoder context
+ * @param slot Journal slot (0 or 1)
+ * @return E_OK if the slot holds a valid record, E_NOT_OK otherwise
+ */
+static Std_ReturnType Tacho_JournalReadSlot(Tacho_Ctx_t *ctx, uint8_t slot)
+{
+    Tacho_Journal_t *journal = &ctx->journal;
+    uint8_t *cached = (uint8_t *) &ctx->cached;
+    Std_ReturnType op_status = E_NOT_OK;
+    uint16_t addr = (uint16_t) (slot * TACHO_JOURNAL_SLOT_SIZE);
+    uint16_t crc;
+    uint8_t buf[TACHO_JOURNAL_HEADER_SIZE];
+    uint8_t i;
+
+    op_status = ctx->config->read_nvm(ctx, addr, buf, TACHO_JOURNAL_HEADER_SIZE);
+    if ( (E_OK != op_status) || (0 != memcmp(buf, Tacho_JournalHeader, TACHO_JOURNAL_HEADER_SIZE)) )
+    {
+        return E_NOT_OK;
+    }
+    addr += TACHO_JOURNAL_HEADER_SIZE;
+    op_status = ctx->config->read_nvm(ctx, addr, &journal->protocol, 1);
+    addr++;
+    for (i = 0; (i < TACHO_JOURNAL_FIELDS) && (E_OK == op_status); i++)
+    {
+        op_status = ctx->config->read_nvm(ctx, addr, &cached[Tacho_JournalField[i][0]], Tacho_JournalField[i][1]);
+        addr += Tacho_JournalField[i][1];
+    }
+    if (E_OK == op_status)
+    {
+        op_status = ctx->config->read_nvm(ctx, addr, buf, TACHO_JOURNAL_TAIL_SIZE);
+    }
+    if ( (E_OK != op_status) || (TACHO_STANDARD_MAX <= journal->protocol) )
+    {
+        return E_NOT_OK;
+    }
+
+    crc = Tacho_JournalCrc(ctx);
+    if (Tacho_ChecksumCrc16(buf, 2, crc) != (uint16_t) (buf[2] | (buf[3] << 8)))
+    {
+        return E_NOT_OK;
+    }
+    journal->slot = slot;
+    journal->seq = (uint16_t) (buf[0] | (buf[1] << 8));
+    journal->crc = crc;
+    return E_OK;
+}
+
+#endif
+
+#if (TACHO_CFG_HW_BINDINGS == STD_ON)
+
+/**
+ * Default context binding: UART2 baudrate
+ * @param ctx Decoder context
+ * @param baudrate New baudrate
+ */
+static void Tacho_DefaultSetBaudrate(Tacho_Ctx_t *ctx, uint16_t baudrate)
+{
+    (void) ctx;
+    USART2_set_baudrate(baudrate);
+}
+
+/**
+ * Default context binding: reads last known protocol from FRAM memory
+ * @param ctx Decoder context
+ * @param data[out] Stored protocol byte
+ * @return E_OK if data was read from FRAM successfully, E_NOT_OK otherwise
+ */
+static Std_ReturnType Tacho_DefaultReadProtocol(Tacho_Ctx_t *ctx, uint8_t *data)
+{
+    (void) ctx;
+    return FRAM_ReadByte(FRAM_MEMADDR_TACHO_PROTO, data);
+}
+
+/**
+ * Default context binding: saves protocol in FRAM memory
+ * @param ctx Decoder context
+ * @param data Protocol byte
+ * @return E_OK if data was saved in FRAM successfully, E_NOT_OK otherwise
+ */
+static Std_ReturnType Tacho_DefaultWriteProtocol(Tacho_Ctx_t *ctx, uint8_t data)
+{
+    (void) ctx;
+    return FRAM_WriteByte(FRAM_MEMADDR_TACHO_PROTO, data);
+}
+
+#if (TACHO_CFG_JOURNAL == STD_ON)
+/**
+ * Default context binding: reads the journal from FRAM memory
+ * @param ctx Decoder context
+ * @param addr Journal offset
+ * @param buf[out] Bytes read
+ * @param len Number of bytes
+ * @return E_OK if all bytes were read from FRAM successfully, E_NOT_OK otherwise
+ */
+static Std_ReturnType Tacho_DefaultReadNvm(Tacho_Ctx_t *ctx, uint16_t addr, uint8_t *buf, uint16_t len)
+{
+    Std_ReturnType op_status = E_OK;
+    uint16_t i;
+
+    (void) ctx;
+    for (i = 0; (i < len) && (E_OK == op_status); i++)
+    {
+        op_status = FRAM_ReadByte((uint16_t) (TACHO_JOURNAL_FRAM_ADDR + addr + i), &buf[i]);
+    }
+    return op_status;
+}
+
+/**
+ * Default context binding: writes the journal in FRAM memory
+ * @param ctx Decoder context
+ * @param addr Journal offset
+ * @param buf[in] Bytes to write
+ * @param len Number of bytes
+ * @return E_OK if all bytes were saved in FRAM successfully, E_NOT_OK otherwise
+ */
+static Std_ReturnType Tacho_DefaultWriteNvm(Tacho_Ctx_t *ctx, uint16_t addr, const uint8_t *buf, uint16_t len)
+{
+    Std_ReturnType op_status = E_OK;
+    uint16_t i;
+
+    (void) ctx;
+    for (i = 0; (i < len) && (E_OK == op_status); i++)
+    {
+        op_status = FRAM_WriteByte((uint16_t) (TACHO_JOURNAL_FRAM_ADDR + addr + i), buf[i]);
+    }
+    return op_status;
+}
+#endif
+
+/**
+ * Default context binding: fires the FMI event
+ * @param ctx Decoder context
+ */
+static void Tacho_DefaultTco1Notif(Tacho_Ctx_t *ctx)
+{
+    (void) ctx;
+    FMI_process_j1939_event(J1939_EVENT_TCO1_AVAILABLE);
+}
+
+#endif
+
+#if (TACHO_CFG_VDO_BYTEWISE == STD_ON)
+
+/**
+ * Copies the DIN fields from the D8 VDO frame to the corresponding buffers
+ *
+ * @param pos Position in the DIN field
+ * @param rx_byte Received byte from D8 serial output
+ * @param country Pointer to country code buffer
+ * @param cardnr Pointer to card number buffer
+ */
+static void Tacho_VdoCopyDIN(uint8_t pos, uint8_t rx_byte, uint8_t *country, uint8_t *cardnr)
+{
+    uint8_t *readCode;
+    uint8_t i;
+
+    if (pos == TACHO_VDO_CC_POS)
+    {
+        readCode = Tacho_GetCountryCode(rx_byte);
+        for (i = 0; i < TACHO_MAX_COUNTRY_CODE; i++)
+        {
+            country[i] = readCode[i];
+        }
+    }
+    else if (pos > TACHO_VDO_CC_POS)
+    {
+        pos -= (TACHO_VDO_CC_POS + 1);
+        if (pos < TACHO_MAX_CARD_NR)
+        {
+            cardnr[pos] = rx_byte;
+        }
+    }
+}
+
+/**
+ * Checks if received byte contains data from a VDO DIN field
+ * @param ctx Decoder context
+ * @param rx_byte Received byte from D8 serial output
+ */
+static void Tacho_VdoCheckDIN(Tacho_Ctx_t *ctx, uint8_t rx_byte)
+{
+    uint8_t pos;
+
+    if (ctx->vdo.drv1_pos == ctx->vdo.index)
+    {
+        if (rx_byte == 0)
+        {
+            /* DIN1 field is empty */
+            ctx->frame.driver[TACHO_DRIVER1].cardnr[0] = '\0';
+        }
+    }
+    else if ( (ctx->vdo.drv1_pos < ctx->vdo.index) && (ctx->vdo.index < ctx->vdo.drv2_pos) )
+    {
+        /* Index points within the boundaries of the DIN1 field */
+        pos = ctx->vdo.index - ctx->vdo.drv1_pos - 1;
+        Tacho_VdoCopyDIN(
+            pos,
+            rx_byte,
+            ctx->frame.driver[TACHO_DRIVER1].country,
+            ctx->frame.driver[TACHO_DRIVER1].cardnr
+        );
+    }
+    else if (ctx->vdo.drv2_pos == ctx->vdo.index)
+    {
+        if (rx_byte == 0)
+        {
+            /* DIN2 field is empty */
+            ctx->frame.driver[TACHO_DRIVER2].cardnr[0] = '\0';
+        }
+    }
+    else if ( (ctx->vdo.drv2_pos < ctx->vdo.index) && (ctx->vdo.index < ctx->vdo.crc8_pos) )
+    {
+        /* Index points within the boundaries of the DIN2 field */
+        pos = ctx->vdo.index - ctx->vdo.drv2_pos - 1;
+        Tacho_VdoCopyDIN(
+            pos,
+            rx_byte,
+            ctx->frame.driver[TACHO_DRIVER2].country,
+            ctx->frame.driver[TACHO_DRIVER2].cardnr
+        );
+    }
+}
+
+/**
+ * Initializes internal data for the VDO protocol
+ * @param ctx Decoder context
+ */
+static void Tacho_VdoInitHandler(Tacho_Ctx_t *ctx)
+{
+    ctx->vdo.index = TACHO_VDO_SEQSZ;
+    ctx->vdo.crc8_value = TACHO_VDO_CRC_INIT;
+    ctx->vdo.cstr_pos = 0xFF;
+    ctx->vdo.drv1_pos = 0xFF;
+    ctx->vdo.drv2_pos = 0xFF;
+    ctx->vdo.crc8_pos = 0xFF;
+}
+
+/**
+ * Handles data coming from a VDO-type Tachograph
+ * @param ctx Decoder context
+ * @param rx_byte Received byte from D8 serial output
+ * @return TRUE if end of frame detected
+ *  FALSE if frame is still being processed
+ */
+static bool_t Tacho_VdoHandler(Tacho_Ctx_t *ctx, uint8_t rx_byte)
+{
+    switch (ctx->vdo.index)
+    {
+    case TACHO_VDO_WORKING_STATE:
+        ctx->frame.working_state = rx_byte;
+        break;
+
+    case TACHO_VDO_DRV1_STATE:
+        ctx->frame.driver1_state = rx_byte;
+        break;
+
+    case TACHO_VDO_DRV2_STATE:
+        ctx->frame.driver2_state = rx_byte;
+        break;
+
+    case TACHO_VDO_STATUS:
+        ctx->frame.tacho_status = rx_byte;
+        break;
+
+    case TACHO_VDO_SPEED_LSB:
+        ctx->frame.speed_lsb = rx_byte;
+        break;
+
+    case TACHO_VDO_SPEED_MSB:
+        ctx->frame.speed_msb = rx_byte;
+        break;
+
+    case TACHO_VDO_VIN_LENGTH:
+        ctx->vdo.cstr_pos = TACHO_VDO_VIN_LENGTH + rx_byte + 1;
+        break;
+
+    default:
+        break;
+    }
+
+    Tacho_VdoCheckDIN(ctx, rx_byte);
+
+    if (ctx->vdo.cstr_pos == ctx->vdo.index)
+    {
+        ctx->vdo.drv1_pos = ctx->vdo.cstr_pos + rx_byte + 1;
+    }
+    else if (ctx->vdo.drv1_pos == ctx->vdo.index)
+    {
+        ctx->vdo.drv2_pos = ctx->vdo.drv1_pos + rx_byte + 1;
+    }
+    else if (ctx->vdo.drv2_pos == ctx->vdo.index)
+    {
+        ctx->vdo.crc8_pos = ctx->vdo.drv2_pos + rx_byte + 1;
+    }
+    else if (ctx->vdo.crc8_pos == ctx->vdo.index)
+    {
+        /* End of frame detected */
+        if (rx_byte == ctx->vdo.crc8_value)
+        {
+            /* Checksum OK - frame received correctly */
+            TACHO_STAT_DECODE_START(ctx);
+            Tacho_CacheWriteBegin(ctx);
+            Tacho_CopyToCache(ctx);
+            Tacho_CacheWriteEnd(ctx);
+            Tacho_FrameReceived(ctx);
+        }
+        else
+        {
+            TACHO_STAT_INC(ctx, TACHO_STAT_CHECKSUM);
+        }
+        Tacho_VdoInitHandler(ctx);
+        return TRUE;
+    }
+
+    /* Frame is still being processed */
+    ctx->vdo.crc8_value ^= rx_byte;
+    ctx->vdo.index++;
+    return FALSE;
+}
+
+#endif
+
+/**
+ * Resolves the length of a VDO frame from its VIN, custom string and DIN length bytes
+ * @param frame[in] Frame bytes, starting with the start sequence
+ * @param avail Number of bytes available in frame
+ * @return Total frame length if avail is large enough to resolve it,
+ *  otherwise the number of bytes needed to make progress (> avail);
+ *  0 if the frame exceeds TACHO_FRAME_MAX
+ */
+static uint16_t Tacho_VdoFrameLength(const uint8_t *frame, uint16_t avail)
+{
+    uint16_t pos = TACHO_VDO_VIN_LENGTH;
+    uint8_t section;
+
+    /* VIN, custom string, DIN1 and DIN2 are each preceded by their length */
+    for (section = 0; section < 4; section++)
+    {
+        if (pos >= avail)
+        {
+            return pos + 1;
+        }
+        pos += frame[pos] + 1;
+        if (pos >= TACHO_FRAME_MAX)
+        {
+            return 0;
+        }
+    }
+
+    /* pos now points to the CRC byte */
+    return pos + 1;
+}
+
+/**
+ * Verifies the CRC of a complete VDO frame
+ * @param frame[in] Frame bytes, starting with the start sequence
+ * @param length Frame length as returned by Tacho_VdoFrameLength()
+ * @return TRUE if the CRC is valid, FALSE otherwise
+ */
+static bool_t Tacho_VdoFrameCheck(const uint8_t *frame, uint16_t length)
+{
+    uint8_t crc8_value;
+
+    crc8_value = Tacho_ChecksumXor(&frame[TACHO_VDO_SEQSZ], length - 1 - TACHO_VDO_SEQSZ, TACHO_VDO_CRC_INIT);
+    return (bool_t) (crc8_value == frame[length - 1]);
+}
+
+/**
+ * Decodes the DIN field of a VDO frame
+ * @param field[in] DIN field, starting with its length byte
+ * @param driver[out] Driver ID
+ */
+static void Tacho_VdoDecodeDIN(const uint8_t *field, Tacho_DriverID_t *driver)
+{
+    uint8_t length = field[0];
+    uint8_t *readCode;
+    uint8_t i;
+
+    if (length == 0)
+    {
+        /* DIN field is empty */
+        driver->cardnr[0] = '\0';
+        return;
+    }
+
+    field++;
+    if (length > TACHO_VDO_CC_POS)
+    {
+        readCode = Tacho_GetCountryCode(field[TACHO_VDO_CC_POS]);
+        for (i = 0; i < TACHO_MAX_COUNTRY_CODE; i++)
+        {
+            driver->country[i] = readCode[i];
+        }
+    }
+    for (i = TACHO_VDO_CC_POS + 1; (i < length) && (i - (TACHO_VDO_CC_POS + 1) < TACHO_MAX_CARD_NR); i++)
+    {
+        driver->cardnr[i - (TACHO_VDO_CC_POS + 1)] = field[i];
+    }
+}
+
+/**
+ * Decodes the VDO-only fields of a frame
+ * @param frame[in] Frame bytes, starting with the start sequence
+ * @param info[out] VDO data (views point into frame)
+ */
+static void Tacho_VdoDecodeInfo(const uint8_t *frame, Tacho_VdoInfo_t *info)
+{
+    uint16_t pos;
+
+    info->time.seconds = frame[TACHO_VDO_UTC_SECONDS];
+    info->time.minutes = frame[TACHO_VDO_UTC_MINUTES];
+    info->time.hours = frame[TACHO_VDO_UTC_HOURS];
+    info->time.month = frame[TACHO_VDO_UTC_MONTH];
+    info->time.day = frame[TACHO_VDO_UTC_DAY];
+    info->time.year = frame[TACHO_VDO_UTC_YEAR];
+    info->time.local_min_offset = frame[TACHO_VDO_LOCAL_MIN_OFFSET];
+    info->time.local_hour_offset = frame[TACHO_VDO_LOCAL_HOUR_OFFSET];
+
+    info->odometer = Tacho_GetU32(&frame[TACHO_VDO_ODOMETER]);
+    info->trip = Tacho_GetU32(&frame[TACHO_VDO_TRIP]);
+    info->k_factor = (uint16_t) (frame[TACHO_VDO_K_FACTOR] | ((uint16_t) frame[TACHO_VDO_K_FACTOR + 1] << 8));
+
+    pos = TACHO_VDO_VIN_LENGTH;
+    info->vin.length = frame[pos];
+    info->vin.data = &frame[pos + 1];
+    pos += frame[pos] + 1;
+    info->cstr.length = frame[pos];
+    info->cstr.data = &frame[pos + 1];
+}
+
+/**
+ * Copies the VDO-only fields of the current frame to the cache
+ * VIN and custom string are copied (and truncated if needed) so that the
+ * cached views stay valid.
+ * @param ctx Decoder context
+ */
+static void Tacho_VdoCopyToCache(Tacho_Ctx_t *ctx)
+{
+    const Tacho_VdoInfo_t *info = &ctx->frame.vdo;
+    Tacho_VdoInfo_t *cached = &ctx->cached.vdo;
+    Tacho_Changes_t *changes = &ctx->changes;
+    uint8_t vin_len = MIN(info->vin.length, TACHO_MAX_VIN);
+    uint8_t cstr_len = MIN(info->cstr.length, TACHO_MAX_CSTR);
+
+    if (0 != memcmp(&cached->time, &info->time, sizeof(Tacho_DateTime_t)))
+    {
+        changes->dirty |= TACHO_DIRTY_TIME;
+    }
+    if (Tacho_AbsDiff32(info->odometer, changes->odometer) > ctx->thresholds.distance_deadband)
+    {
+        changes->odometer = info->odometer;
+        changes->dirty |= TACHO_DIRTY_ODOMETER;
+    }
+    if (Tacho_AbsDiff32(info->trip, changes->trip) > ctx->thresholds.distance_deadband)
+    {
+        changes->trip = info->trip;
+        changes->dirty |= TACHO_DIRTY_TRIP;
+    }
+    if (cached->k_factor != info->k_factor)
+    {
+        changes->dirty |= TACHO_DIRTY_K_FACTOR;
+    }
+    if ( (cached->vin.length != vin_len) || (0 != memcmp(ctx->cached.vin, info->vin.data, vin_len)) )
+    {
+        changes->dirty |= TACHO_DIRTY_VIN;
+    }
+    if ( (cached->cstr.length != cstr_len) || (0 != memcmp(ctx->cached.cstr, info->cstr.data, cstr_len)) )
+    {
+        changes->dirty |= TACHO_DIRTY_CSTR;
+    }
+
+    *cached = *info;
+    cached->vin.length = vin_len;
+    cached->vin.data = ctx->cached.vin;
+    memcpy(ctx->cached.vin, info->vin.data, vin_len);
+    cached->cstr.length = cstr_len;
+    cached->cstr.data = ctx->cached.cstr;
+    memcpy(ctx->cached.cstr, info->cstr.data, cstr_len);
+}
+
+/**
+ * Decodes a complete VDO frame
+ * @param ctx Decoder context
+ * @param frame[in] Frame bytes, starting with the start sequence
+ * @param length Frame length as returned by Tacho_VdoFrameLength()
+ * @return TRUE if the checksum is valid and the frame was decoded, FALSE otherwise
+ */
+static bool_t Tacho_VdoDecodeFrame(Tacho_Ctx_t *ctx, const uint8_t *frame, uint16_t length)
+{
+    uint16_t pos;
+
+    if (FALSE == Tacho_VdoFrameCheck(frame, length))
+    {
+        return FALSE;
+    }
+
+    ctx->frame.working_state = frame[TACHO_VDO_WORKING_STATE];
+    ctx->frame.driver1_state = frame[TACHO_VDO_DRV1_STATE];
+    ctx->frame.driver2_state = frame[TACHO_VDO_DRV2_STATE];
+    ctx->frame.tacho_status = frame[TACHO_VDO_STATUS];
+    ctx->frame.speed_lsb = frame[TACHO_VDO_SPEED_LSB];
+    ctx->frame.speed_msb = frame[TACHO_VDO_SPEED_MSB];
+
+    Tacho_VdoDecodeInfo(frame, &ctx->frame.vdo);
+
+    /* Skip VIN and custom string */
+    pos = TACHO_VDO_VIN_LENGTH;
+    pos += frame[pos] + 1;
+    pos += frame[pos] + 1;
+
+    Tacho_VdoDecodeDIN(&frame[pos], &ctx->frame.driver[TACHO_DRIVER1]);
+    pos += frame[pos] + 1;
+    Tacho_VdoDecodeDIN(&frame[pos], &ctx->frame.driver[TACHO_DRIVER2]);
+
+    Tacho_CacheWriteBegin(ctx);
+    Tacho_VdoCopyToCache(ctx);
+    Tacho_CopyToCache(ctx);
+    Tacho_CacheWriteEnd(ctx);
+    Tacho_FrameReceived(ctx);
+    return TRUE;
+}
+
+#if (TACHO_CFG_SR_BYTEWISE == STD_ON)
+
+/**
+ * Copies the DIN fields from the D8 Stoneridge frame to the corresponding buffers
+ *
+ * @param ctx Decoder context
+ * @param pos Position in the DIN field
+ * @param rx_byte Received byte from D8 serial output
+ * @param country Pointer to country code buffer
+ * @param cardnr Pointer to card number buffer
+ */
+static void Tacho_StoneridgeCopyDIN(Tacho_Ctx_t *ctx, uint8_t pos, uint8_t rx_byte, uint8_t *country, uint8_t *cardnr)
+{
+    if ( (rx_byte == 0xFF) && (pos == 0) )
+    {
+        /* DIN field is empty, so skip the field entirely */
+        cardnr[0] = '\0';
+        ctx->sr.drv1_pos = 0xFF;
+        ctx->sr.drv2_pos = 0xFF;
+        return;
+    }
+
+    if (pos < TACHO_MAX_COUNTRY_CODE)
+    {
+        /* Country Code */
+        country[pos] = rx_byte;
+    }
+    else
+    {
+        /* Card Number */
+        cardnr[pos - TACHO_MAX_COUNTRY_CODE] = rx_byte;
+    }
+}
+
+/**
+ * Checks if received byte contains data from a Stoneridge DIN field
+ * @param ctx Decoder context
+ * @param rx_byte Received byte from D8 serial output
+ */
+static void Tacho_StoneridgeCheckDIN(Tacho_Ctx_t *ctx, uint8_t rx_byte)
+{
+    uint8_t pos;
+
+    if ( (ctx->sr.drv1_pos == 0xFF) && (ctx->sr.drv2_pos == 0xFF) )
+    {
+        /* Message doesn't contain DIN1 or DIN2 info or DIN field is empty */
+        return;
+    }
+
+    /* Handle DIN1 */
+    if ( (ctx->sr.drv1_pos <= ctx->sr.index) && (ctx->sr.index < ctx->sr.crc8_pos - 1) )
+    {
+        pos = ctx->sr.index - ctx->sr.drv1_pos;
+        Tacho_StoneridgeCopyDIN(
+            ctx,
+            pos,
+            rx_byte,
+            ctx->frame.driver[TACHO_DRIVER1].country,
+            ctx->frame.driver[TACHO_DRIVER1].cardnr
+        );
+    }
+    /* Handle DIN2 */
+    else if ( (ctx->sr.drv2_pos <= ctx->sr.index) && (ctx->sr.index < ctx->sr.crc8_pos - 1) )
+    {
+        pos = ctx->sr.index - ctx->sr.drv2_pos;
+        Tacho_StoneridgeCopyDIN(
+            ctx,
+            pos,
+            rx_byte,
+            ctx->frame.driver[TACHO_DRIVER2].country,
+            ctx->frame.driver[TACHO_DRIVER2].cardnr
+        );
+    }
+}
+
+/**
+ * Initializes internal data for the Stoneridge protocol
+ * @param ctx Decoder context
+ */
+static void Tacho_StoneridgeInitHandler(Tacho_Ctx_t *ctx)
+{
+    ctx->sr.index = TACHO_SR_SEQSZ;
+    ctx->sr.crc8_value = 0;
+    ctx->sr.drv1_pos = 0xFF;
+    ctx->sr.drv2_pos = 0xFF;
+    ctx->sr.crc8_pos = 0xFF;
+}
+
+/**
+ * Handles data coming from a Stoneridge-type Tachograph
+ * @param ctx Decoder context
+ * @param rx_byte Received byte from D8 serial output
+ * @return TRUE if end of frame detected
+ *  FALSE if frame is still being processed
+ */
+static bool_t Tacho_StoneridgeHandler(Tacho_Ctx_t *ctx, uint8_t rx_byte)
+{
+    switch (ctx->sr.index)
+    {
+    case TACHO_SR_MSG_LEN:
+        if ( (rx_byte < TACHO_SR_MSG_LEN_MIN) || (rx_byte > TACHO_SR_MSG_LEN_MAX) )
+        {
+            /* Message length not in valid range - discard frame */
+            TACHO_STAT_INC(ctx, TACHO_STAT_BAD_LENGTH);
+            Tacho_StoneridgeInitHandler(ctx);
+            return TRUE;
+        }
+        /* Message length OK - compute position of last byte (CRC byte) */
+        ctx->sr.crc8_pos = TACHO_SR_MSG_LEN + rx_byte - 1;
+        break;
+
+    case TACHO_SR_MSG_ID:
+        if (FALSE == Tacho_StoneridgeMsgProcess(ctx, rx_byte))
+        {
+            /* Message ID not valid - discard frame */
+            TACHO_STAT_INC(ctx, TACHO_STAT_BAD_MSG_ID);
+            Tacho_StoneridgeInitHandler(ctx);
+            return TRUE;
+        }
+        break;
+
+    case TACHO_SR_WORKING_STATE:
+        ctx->frame.working_state = rx_byte;
+        break;
+
+    case TACHO_SR_DRV1_STATE:
+        ctx->frame.driver1_state = rx_byte;
+        break;
+
+    case TACHO_SR_DRV2_STATE:
+        ctx->frame.driver2_state = rx_byte;
+        break;
+
+    case TACHO_SR_STATUS:
+        ctx->frame.tacho_status = rx_byte;
+        break;
+
+    case TACHO_SR_SPEED_LSB:
+        ctx->frame.speed_lsb = rx_byte;
+        break;
+
+    case TACHO_SR_SPEED_MSB:
+        ctx->frame.speed_msb = rx_byte;
+        break;
+
+    default:
+        break;
+    }
+
+    Tacho_StoneridgeCheckDIN(ctx, rx_byte);
+
+    if (ctx->sr.crc8_pos == ctx->sr.index)
+    {
+        /* End of frame detected */
+        ctx->sr.crc8_value = ~ctx->sr.crc8_value + 1;
+        if (ctx->sr.crc8_value == rx_byte)
+        {
+            /* Checksum OK - frame received correctly */
+            TACHO_STAT_DECODE_START(ctx);
+            Tacho_CacheWriteBegin(ctx);
+            Tacho_CopyToCache(ctx);
+            Tacho_CacheWriteEnd(ctx);
+            Tacho_FrameReceived(ctx);
+        }
+        else
+        {
+            TACHO_STAT_INC(ctx, TACHO_STAT_CHECKSUM);
+        }
+        Tacho_StoneridgeInitHandler(ctx);
+        return TRUE;
+    }
+
+    ctx->sr.crc8_value += rx_byte;
+    ctx->sr.index++;
+    return FALSE;
+}
+
+/**
+ * Determines message type and prepares DIN1 and DIN2 to be read when needed
+ * @param ctx Decoder context
+ * @param rx_byte Received byte from D8 serial output
+ * @return TRUE if message ID is valid; FALSE otherwise
+ */
+static bool_t Tacho_StoneridgeMsgProcess(Tacho_Ctx_t *ctx, uint8_t rx_byte)
+{
+    bool_t opSuccess = TRUE;
+
+    switch (rx_byte)
+    {
+    case TACHO_SR_MSG_DIN1:
+        ctx->sr.drv1_pos = TACHO_SR_CUSTOM;
+        break;
+
+    case TACHO_SR_MSG_DIN2:
+        ctx->sr.drv2_pos = TACHO_SR_CUSTOM;
+        break;
+
+    case TACHO_SR_MSG_VIN:
+    case TACHO_SR_MSG_VRN:
+        /* Ignore - VIN and VRN not needed (for now) */
+        break;
+
+    default:
+        /* Invalid message ID */
+        opSuccess = FALSE;
+        break;
+    }
+
+    return opSuccess;
+}
+
+#endif
+
+/**
+ * Checks if a Stoneridge message identifier is known
+ * @param msg_id Message identifier
+ * @return TRUE if message ID is valid; FALSE otherwise
+ */
+static bool_t Tacho_StoneridgeMsgValid(uint8_t msg_id)
+{
+    return (bool_t) ( (TACHO_SR_MSG_VIN == msg_id) || (TACHO_SR_MSG_DIN1 == msg_id) ||
+                      (TACHO_SR_MSG_DIN2 == msg_id) || (TACHO_SR_MSG_VRN == msg_id) );
+}
+
+/**
+ * Resolves the length of a Stoneridge frame from its message length byte
+ * @param frame[in] Frame bytes, starting with the start sequence
+ * @param avail Number of bytes available in frame
+ * @return Total frame length if avail is large enough to resolve it,
+ *  otherwise the number of bytes needed to make progress (> avail);
+ *  0 if message length or message ID are not valid
+ */
+static uint16_t Tacho_StoneridgeFrameLength(const uint8_t *frame, uint16_t avail)
+{
+    uint8_t msg_len;
+
+    if (avail <= TACHO_SR_MSG_ID)
+    {
+        return TACHO_SR_MSG_ID + 1;
+    }
+
+    msg_len = frame[TACHO_SR_MSG_LEN];
+    if ( (msg_len < TACHO_SR_MSG_LEN_MIN) || (msg_len > TACHO_SR_MSG_LEN_MAX) )
+    {
+        return 0;
+    }
+    if (FALSE == Tacho_StoneridgeMsgValid(frame[TACHO_SR_MSG_ID]))
+    {
+        return 0;
+    }
+
+    /* Message length counts from the length byte up to the CRC byte */
+    return TACHO_SR_MSG_LEN + msg_len;
+}
+
+/**
+ * Verifies the checksum of a complete Stoneridge frame
+ * @param frame[in] Frame bytes, starting with the start sequence
+ * @param length Frame length as returned by Tacho_StoneridgeFrameLength()
+ * @return TRUE if the checksum is valid, FALSE otherwise
+ */
+static bool_t Tacho_StoneridgeFrameCheck(const uint8_t *frame, uint16_t length)
+{
+    uint8_t crc8_value;
+
+    crc8_value = Tacho_ChecksumSum(&frame[TACHO_SR_MSG_LEN], length - 1 - TACHO_SR_MSG_LEN, 0);
+    crc8_value = ~crc8_value + 1;
+    return (bool_t) (crc8_value == frame[length - 1]);
+}
+
+/**
+ * Decodes the DIN field of a Stoneridge frame
+ * @param field[in] DIN field (country code followed by card number)
+ * @param size Number of bytes in the DIN field
+ * @param driver[out] Driver ID
+ */
+static void Tacho_StoneridgeDecodeDIN(const uint8_t *field, uint8_t size, Tacho_DriverID_t *driver)
+{
+    uint8_t pos;
+
+    if (field[0] == 0xFF)
+    {
+        /* DIN field is empty */
+        driver->cardnr[0] = '\0';
+        return;
+    }
+
+    for (pos = 0; pos < size; pos++)
+    {
+        if (pos < TACHO_MAX_COUNTRY_CODE)
+        {
+            driver->country[pos] = field[pos];
+        }
+        else if (pos - TACHO_MAX_COUNTRY_CODE < TACHO_MAX_CARD_NR)
+        {
+            driver->cardnr[pos - TACHO_MAX_COUNTRY_CODE] = field[pos];
+        }
+    }
+}
+
+/**
+ * Adds the custom field of a Stoneridge message to the vehicle snapshot
+ * The snapshot is published to the cache each time a message arrives once
+ * every part has been received.
+ * @param ctx Decoder context
+ * @param msg_id Message identifier
+ * @param field[in] Custom field (VIN, DIN or RMS + VRN)
+ * @param size Number of bytes in the custom field
+ */
+static void Tacho_StoneridgeUpdateSnapshot(Tacho_Ctx_t *ctx, uint8_t msg_id, const uint8_t *field, uint8_t size)
+{
+    Tacho_SrSnapshot_t *snap = &ctx->sr_snap;
+    Tacho_SrPart_t part;
+
+    snap->frames++;
+    switch (msg_id)
+    {
+    case TACHO_SR_MSG_VIN:
+        part = TACHO_SR_PART_VIN;
+        snap->vin_len = MIN(size, TACHO_MAX_VIN);
+        memcpy(snap->vin, field, snap->vin_len);
+        break;
+
+    case TACHO_SR_MSG_DIN1:
+        part = TACHO_SR_PART_DIN1;
+        snap->driver[TACHO_DRIVER1] = ctx->frame.driver[TACHO_DRIVER1];
         break;
 
-    case TACHO_VDO_DRV1_STATE:
-        Tacho_Frame.driver1_state = rx_byte;
-        break;
+    case TACHO_SR_MSG_DIN2:
+        part = TACHO_SR_PART_DIN2;
+        snap->driver[TACHO_DRIVER2] = ctx->frame.driver[TACHO_DRIVER2];
+        break;
+
+    case TACHO_SR_MSG_VRN:
+        part = TACHO_SR_PART_VRN;
+        if (size < TACHO_MAX_COUNTRY_CODE)
+        {
+            return;
+        }
+        memcpy(snap->rms, field, TACHO_MAX_COUNTRY_CODE);
+        snap->vrn_len = MIN(size - TACHO_MAX_COUNTRY_CODE, TACHO_MAX_VRN);
+        memcpy(snap->vrn, &field[TACHO_MAX_COUNTRY_CODE], snap->vrn_len);
+        break;
+
+    default:
+        return;
+    }
+
+    snap->valid |= TACHO_SR_PART_MASK(part);
+    snap->stamp[part] = snap->frames;
+
+    if (TACHO_SR_PART_ALL == snap->valid)
+    {
+        if (FALSE == Tacho_StoneridgeSnapshotEqual(&ctx->cached.sr, snap))
+        {
+            ctx->changes.dirty |= TACHO_DIRTY_SR_SNAPSHOT;
+        }
+        ctx->cached.sr = *snap;
+    }
+}
+
+/**
+ * Compares the vehicle data of two Stoneridge snapshots (ages are ignored)
+ * @param a[in] First snapshot
+ * @param b[in] Second snapshot
+ * @return TRUE if both carry the same data, FALSE otherwise
+ */
+static bool_t Tacho_StoneridgeSnapshotEqual(const Tacho_SrSnapshot_t *a, const Tacho_SrSnapshot_t *b)
+{
+    return (bool_t) ( (a->valid == b->valid) &&
+                      (a->vin_len == b->vin_len) && (0 == memcmp(a->vin, b->vin, a->vin_len)) &&
+                      (0 == memcmp(a->rms, b->rms, TACHO_MAX_COUNTRY_CODE)) &&
+                      (a->vrn_len == b->vrn_len) && (0 == memcmp(a->vrn, b->vrn, a->vrn_len)) &&
+                      (0 == memcmp(a->driver, b->driver, sizeof(a->driver))) );
+}
+
+/**
+ * Decodes a complete Stoneridge frame
+ * @param ctx Decoder context
+ * @param frame[in] Frame bytes, starting with the start sequence
+ * @param length Frame length as returned by Tacho_StoneridgeFrameLength()
+ * @return TRUE if the checksum is valid and the frame was decoded, FALSE otherwise
+ */
+static bool_t Tacho_StoneridgeDecodeFrame(Tacho_Ctx_t *ctx, const uint8_t *frame, uint16_t length)
+{
+    uint8_t din_size;
+
+    if (FALSE == Tacho_StoneridgeFrameCheck(frame, length))
+    {
+        return FALSE;
+    }
+
+    ctx->frame.working_state = frame[TACHO_SR_WORKING_STATE];
+    ctx->frame.driver1_state = frame[TACHO_SR_DRV1_STATE];
+    ctx->frame.driver2_state = frame[TACHO_SR_DRV2_STATE];
+    ctx->frame.tacho_status = frame[TACHO_SR_STATUS];
+    ctx->frame.speed_lsb = frame[TACHO_SR_SPEED_LSB];
+    ctx->frame.speed_msb = frame[TACHO_SR_SPEED_MSB];
+
+    /* Custom field spans up to the byte preceding the CRC byte (excluded) */
+    din_size = (uint8_t) (length - 2 - TACHO_SR_CUSTOM);
+    switch (frame[TACHO_SR_MSG_ID])
+    {
+    case TACHO_SR_MSG_DIN1:
+        Tacho_StoneridgeDecodeDIN(&frame[TACHO_SR_CUSTOM], din_size, &ctx->frame.driver[TACHO_DRIVER1]);
+        break;
+
+    case TACHO_SR_MSG_DIN2:
+        Tacho_StoneridgeDecodeDIN(&frame[TACHO_SR_CUSTOM], din_size, &ctx->frame.driver[TACHO_DRIVER2]);
+        break;
+
+    default:
+        break;
+    }
+
+    Tacho_CacheWriteBegin(ctx);
+    Tacho_StoneridgeUpdateSnapshot(ctx, frame[TACHO_SR_MSG_ID], &frame[TACHO_SR_CUSTOM], din_size);
+    Tacho_CopyToCache(ctx);
+    Tacho_CacheWriteEnd(ctx);
+    Tacho_FrameReceived(ctx);
+    return TRUE;
+}
+
+/**
+ * Called when data was successfully read
+ * Copies the data received from D8 to a cache for future use. Must be called
+ * inside a cache write section.
+ * @param ctx Decoder context
+ */
+static void Tacho_CopyToCache(Tacho_Ctx_t *ctx)
+{
+    uint8_t di[TACHO_MAX_DI_MSG];
+    uint8_t dindex = 0;
+    uint8_t i, j;
+
+    /* Create cached TCO1 message */
+    ctx->cached.tco1[TACHO_TCO1_WORKING_STATE] = ctx->frame.working_state;
+    ctx->cached.tco1[TACHO_TCO1_DRV1_STATE] = ctx->frame.driver1_state;
+    ctx->cached.tco1[TACHO_TCO1_DRV2_STATE] = ctx->frame.driver2_state;
+    ctx->cached.tco1[TACHO_TCO1_STATUS] = ctx->frame.tacho_status;
+    ctx->cached.tco1[TACHO_TCO1_RB4] = 0xFF;
+    ctx->cached.tco1[TACHO_TCO1_RB5] = 0xFF;
+    ctx->cached.tco1[TACHO_TCO1_SPEED_LSB] = ctx->frame.speed_lsb;
+    ctx->cached.tco1[TACHO_TCO1_SPEED_MSB] = ctx->frame.speed_msb;
+
+    /* Decoded state bitfields */
+    ctx->frame.ws = Tacho_WorkingStateLut[ctx->frame.working_state];
+    ctx->frame.drv_state[TACHO_DRIVER1] = Tacho_DriverStateLut[ctx->frame.driver1_state];
+    ctx->frame.drv_state[TACHO_DRIVER2] = Tacho_DriverStateLut[ctx->frame.driver2_state];
+
+    /* Copy driver ID data */
+    for (i = 0; i < TACHO_MAX_DRIVERS; i++)
+    {
+        if (ctx->frame.driver[i].cardnr[0])
+        {
+            for (j = 0; j < TACHO_MAX_COUNTRY_CODE; j++)
+            {
+                di[dindex++] = ctx->frame.driver[i].country[j];
+            }
+            for (j = 0; j < TACHO_MAX_CARD_NR; j++)
+            {
+                di[dindex++] = ctx->frame.driver[i].cardnr[j];
+            }
+        }
+        di[dindex++] = '*';
+    }
+    di[dindex++] = '\0';
+
+    if (0 != memcmp(ctx->cached.di, di, dindex))
+    {
+        memcpy(ctx->cached.di, di, dindex);
+        ctx->changes.dirty |= TACHO_DIRTY_DI;
+    }
+}
+
+/**
+ * Opens a cache write section
+ * The sequence counter turns odd, so concurrent Tacho_CtxReadSnapshot() calls
+ * discard whatever they copy until the section is closed.
+ * @param ctx Decoder context
+ */
+static void Tacho_CacheWriteBegin(Tacho_Ctx_t *ctx)
+{
+    TACHO_STORE_RELAXED(&ctx->cached_seq, (uint16_t) (TACHO_LOAD_RELAXED(&ctx->cached_seq) + 1));
+    TACHO_FENCE_RELEASE();
+}
+
+/**
+ * Closes a cache write section, publishing the new cache generation
+ * @param ctx Decoder context
+ */
+static void Tacho_CacheWriteEnd(Tacho_Ctx_t *ctx)
+{
+    TACHO_STORE_RELEASE(&ctx->cached_seq, (uint16_t) (TACHO_LOAD_RELAXED(&ctx->cached_seq) + 1));
+}
+
+/**
+ * Reports a D8 frame once it is in the cache: history ring first, then the
+ * frame_notif binding and the TCO1 change notification
+ * @param ctx Decoder context
+ */
+static void Tacho_FrameReceived(Tacho_Ctx_t *ctx)
+{
+    TACHO_STAT_FRAME_DONE(ctx);
+#if (TACHO_CFG_HISTORY == STD_ON)
+    Tacho_HistoryPush(ctx);
+#endif
+#if (TACHO_CFG_DRIVING_TIME == STD_ON)
+    Tacho_CacheWriteBegin(ctx);
+    Tacho_DrivingUpdate(ctx);
+    Tacho_CacheWriteEnd(ctx);
+#endif
+    if ( (NULL_PTR != ctx->config) && (NULL_PTR != ctx->config->frame_notif) )
+    {
+        ctx->config->frame_notif(ctx);
+    }
+    Tacho_NotifyFrameReceived(ctx, TACHO_SOURCE_D8, ctx->cached.tco1);
+}
+
+#if (TACHO_CFG_HISTORY == STD_ON)
+/**
+ * Appends the frame just decoded to the history ring
+ * @param ctx Decoder context
+ */
+static void Tacho_HistoryPush(Tacho_Ctx_t *ctx)
+{
+    Tacho_History_t *hist = &ctx->history;
+    uint16_t tail = hist->tail;
+    Tacho_HistFrame_t *entry;
+
+    hist->seq++;
+#if (TACHO_CFG_HISTORY_OVERWRITE == STD_ON)
+    TACHO_STORE_RELAXED(&hist->reserve, (uint16_t) (tail + 1));
+    TACHO_FENCE_RELEASE();
+#else
+    if ((uint16_t) (tail - TACHO_LOAD_ACQUIRE(&hist->head)) >= TACHO_HISTORY_SIZE)
+    {
+        /* Full - the frame is rejected */
+        return;
+    }
+#endif
+
+    entry = &hist->entry[tail & TACHO_HISTORY_MASK];
+    entry->stamp = 0;
+    if ( (NULL_PTR != ctx->config) && (NULL_PTR != ctx->config->get_time) )
+    {
+        entry->stamp = ctx->config->get_time(ctx);
+    }
+    entry->seq = (uint16_t) (hist->seq - 1);
+    entry->standard = (uint8_t) ctx->standard;
+    memcpy(entry->tco1, ctx->cached.tco1, TACHO_TCO1_SIZE);
+    memcpy(entry->driver, ctx->frame.driver, sizeof(entry->driver));
+#if (TACHO_CFG_VDO_BYTEWISE == STD_OFF)
+    if (TACHO_STANDARD_VDO == ctx->standard)
+    {
+        entry->time = ctx->frame.vdo.time;
+        entry->odometer = ctx->frame.vdo.odometer;
+        entry->trip = ctx->frame.vdo.trip;
+    }
+    else
+#endif
+    {
+        /* Only the VDO frame engine decodes these */
+        memset(&entry->time, 0, sizeof(entry->time));
+        entry->odometer = 0;
+        entry->trip = 0;
+    }
+
+    TACHO_STORE_RELEASE(&hist->tail, (uint16_t) (tail + 1));
+}
+#endif
+
+#if (TACHO_CFG_DRIVING_TIME == STD_ON)
+/**
+ * Accounts the time elapsed since the previous frame to the cards of the
+ * frame just decoded
+ * Each card is accounted in whole seconds to the working state reported for
+ * it by the previous frame; a card coming back is accounted as resting while
+ * it was withdrawn. Gaps longer than TACHO_DRIVING_MAX_GAP between frames
+ * (link lost) are not accounted. Nothing is accounted without a get_time
+ * binding. Must be called inside a cache write section.
+ * @param ctx Decoder context
+ */
+static void Tacho_DrivingUpdate(Tacho_Ctx_t *ctx)
+{
+    Tacho_Driving_t *driving = &ctx->driving;
+    Tacho_DrivingTime_t *card;
+    uint32_t now;
+    uint32_t seconds;
+    uint8_t slot;
+    uint8_t i;
+
+    if ( (NULL_PTR == ctx->config) || (NULL_PTR == ctx->config->get_time) )
+    {
+        /* Frame periods differ between protocols and tachographs: no clock, no totals */
+        return;
+    }
+    now = ctx->config->get_time(ctx);
+
+    /* Cards withdrawn (or moved to the other slot) since the previous frame */
+    for (i = 0; i < driving->count; i++)
+    {
+        card = &driving->card[i];
+        if ( card->inserted &&
+             (0 != memcmp(&ctx->frame.driver[driving->slot[i]], &card->driver, sizeof(Tacho_DriverID_t))) )
+        {
+            card->inserted = FALSE;
+        }
+    }
+
+    for (slot = 0; slot < TACHO_MAX_DRIVERS; slot++)
+    {
+        if (0 == ctx->frame.driver[slot].cardnr[0])
+        {
+            continue;
+        }
+
+        i = Tacho_DrivingCard(driving, &ctx->frame.driver[slot], now);
+        card = &driving->card[i];
+        seconds = (now - driving->seen[i]) / TACHO_DRIVING_TICKS_PER_S;
+        if (FALSE == card->inserted)
+        {
+            Tacho_DrivingAccount(card, TACHO_WS_REST, seconds);
+        }
+        else if (seconds <= TACHO_DRIVING_MAX_GAP)
+        {
+            Tacho_DrivingAccount(card, card->state, seconds);
+        }
+        /* Keep the fraction of a second for the next frame */
+        driving->seen[i] += seconds * TACHO_DRIVING_TICKS_PER_S;
+        driving->slot[i] = slot;
+        card->inserted = TRUE;
+        card->state = (TACHO_DRIVER1 == slot) ? ctx->frame.ws.driver1 : ctx->frame.ws.driver2;
+    }
+}
+
+/**
+ * Finds the accumulators of a driver card, starting new ones if needed
+ * A new card replaces the withdrawn card seen least recently once all
+ * TACHO_DRIVING_CARDS are in use.
+ * @param driving Accumulators of the context
+ * @param driver[in] Driver card
+ * @param now Current time, in get_time ticks
+ * @return Index of the card in driving
+ */
+static uint8_t Tacho_DrivingCard(Tacho_Driving_t *driving, const Tacho_DriverID_t *driver, uint32_t now)
+{
+    uint8_t oldest = TACHO_DRIVING_CARDS;
+    uint8_t i;
+
+    for (i = 0; i < driving->count; i++)
+    {
+        if (0 == memcmp(&driving->card[i].driver, driver, sizeof(Tacho_DriverID_t)))
+        {
+            return i;
+        }
+        if ( (FALSE == driving->card[i].inserted) &&
+             ( (TACHO_DRIVING_CARDS == oldest) ||
+               ((uint32_t) (now - driving->seen[i]) > (uint32_t) (now - driving->seen[oldest])) ) )
+        {
+            oldest = i;
+        }
+    }
+
+    i = (driving->count < TACHO_DRIVING_CARDS) ? driving->count++ : oldest;
+    memset(&driving->card[i], 0, sizeof(Tacho_DrivingTime_t));
+    driving->card[i].driver = *driver;
+    driving->card[i].state = TACHO_WS_REST;
+    driving->card[i].inserted = TRUE;
+    driving->seen[i] = now;
+    return i;
+}
+
+/**
+ * Accounts time spent in a working state to a card
+ * @param card Accumulators of the card
+ * @param state Working state (Tacho_WorkingState_t values)
+ * @param seconds Time spent in state
+ */
+static void Tacho_DrivingAccount(Tacho_DrivingTime_t *card, uint8_t state, uint32_t seconds)
+{
+    if (0 == seconds)
+    {
+        return;
+    }
+
+    if (TACHO_WS_REST == state)
+    {
+        card->rest += seconds;
+        if (card->rest >= TACHO_DRIVING_DAILY_REST)
+        {
+            card->daily_driving = 0;
+            card->continuous_driving = 0;
+        }
+        else if ( (card->rest >= TACHO_DRIVING_BREAK) ||
+                  (card->split_break && (card->rest >= TACHO_DRIVING_SPLIT_SECOND)) )
+        {
+            card->continuous_driving = 0;
+        }
+        return;
+    }
+
+    Tacho_DrivingEndRest(card);
+    if (TACHO_WS_DRIVE == state)
+    {
+        card->continuous_driving += seconds;
+        card->daily_driving += seconds;
+    }
+}
+
+/**
+ * Closes the ongoing rest period of a card
+ * @param card Accumulators of the card
+ */
+static void Tacho_DrivingEndRest(Tacho_DrivingTime_t *card)
+{
+    if (0 == card->rest)
+    {
+        return;
+    }
+
+    if (card->rest >= TACHO_DRIVING_DAILY_REST)
+    {
+        card->last_daily_rest = card->rest;
+        card->split_break = FALSE;
+    }
+    else if ( (card->rest >= TACHO_DRIVING_BREAK) ||
+              (card->split_break && (card->rest >= TACHO_DRIVING_SPLIT_SECOND)) )
+    {
+        card->split_break = FALSE;
+    }
+    else if (card->rest >= TACHO_DRIVING_SPLIT_FIRST)
+    {
+        card->split_break = TRUE;
+    }
+    card->rest = 0;
+}
+#endif
+
+/**
+ * Reads a 32-bit value sent LSB first
+ * @param data[in] First byte
+ * @return Value
+ */
+static uint32_t Tacho_GetU32(const uint8_t *data)
+{
+    return (uint32_t) data[0] | ((uint32_t) data[1] << 8) | ((uint32_t) data[2] << 16) | ((uint32_t) data[3] << 24);
+}
+
+/**
+ * Common notification function called whenever TCO1-related data is
+ * received either on CAN or on the D8 serial output.
+ * Accumulates the TCO1 changes (subject to the hysteresis and deadband
+ * thresholds) with the ones found while caching the frame; if any of them is
+ * part of notify_mask, the TCO1 data is published to tco1_cmn and the
+ * notification callbacks fire with the accumulated change mask.
+ * With TACHO_CFG_TCO1_FUSION, the data compared and published is the fusion
+ * of the last report of every source (see Tacho_FuseTco1()).
+ *
+ * @param ctx Decoder context
+ * @param source Source of tco1_data
+ * @param tco1_data[in] This is the TCO1 8-byte buffer
+ */
+static void Tacho_NotifyFrameReceived(Tacho_Ctx_t *ctx, Tacho_Source_t source, const uint8_t *tco1_data)
+{
+    Tacho_Changes_t *changes = &ctx->changes;
+#if (TACHO_CFG_TCO1_FUSION == STD_ON)
+    uint8_t fused[TACHO_TCO1_SIZE];
+#endif
+    uint16_t tco1_dirty;
+    uint16_t dirty;
+    uint8_t i;
+
+    if (NULL != tco1_data)
+    {
+#if (TACHO_CFG_TCO1_FUSION == STD_ON)
+        Tacho_FuseTco1(ctx, source, tco1_data, fused);
+        tco1_data = fused;
+#else
+        (void) source;
+#endif
+        tco1_dirty = Tacho_Tco1Changes(ctx, tco1_data);
+        changes->dirty |= tco1_dirty;
+        dirty = changes->dirty;
+
+        if (0 != (dirty & ctx->thresholds.notify_mask))
+        {
+            /* Copy to common buffer; state bytes only once past the hysteresis */
+            Tacho_CacheWriteBegin(ctx);
+            for (i = 0; i < TACHO_TCO1_SIZE; i++)
+            {
+                if ( (i >= TACHO_TCO1_RB4) || (0 != (tco1_dirty & (TACHO_DIRTY_WORKING_STATE << i))) )
+                {
+                    ctx->cached.tco1_cmn[i] = tco1_data[i];
+                }
+            }
+            Tacho_CacheWriteEnd(ctx);
+            changes->dirty = 0;
+
+            /* Fire events */
+            if ( (NULL_PTR != ctx->config) && (0 != (dirty & ctx->thresholds.notify_mask & TACHO_DIRTY_TCO1)) &&
+                 (NULL_PTR != ctx->config->tco1_notif) )
+            {
+                ctx->config->tco1_notif(ctx);
+            }
+            if ( (NULL_PTR != ctx->config) && (NULL_PTR != ctx->config->change_notif) )
+            {
+                ctx->config->change_notif(ctx, dirty);
+            }
+        }
+    }
+}
+
+#if (TACHO_CFG_TCO1_FUSION == STD_ON)
+/**
+ * Records the TCO1 report of a source and fuses the last report of every source
+ * Each field is taken from the first source, in Tacho_Source_t priority
+ * order, that reported it valid within the fusion timeout; once every
+ * source went quiet, from the one that reported it valid last. A field no
+ * source reported valid is taken from the report being processed.
+ * @param ctx Decoder context
+ * @param source Source of tco1_data
+ * @param tco1_data[in] Reported TCO1
+ * @param fused[out] Fused TCO1
+ */
+static void Tacho_FuseTco1(Tacho_Ctx_t *ctx, Tacho_Source_t source, const uint8_t *tco1_data, uint8_t *fused)
+{
+    Tacho_Fusion_t *fusion = &ctx->fusion;
+    const Tacho_FusionSource_t *candidate;
+    uint32_t timeout = TACHO_FUSION_TIMEOUT_REPORTS;
+    uint32_t now;
+    uint32_t age;
+    uint32_t best_age;
+    uint8_t field;
+    uint8_t best;
+    uint8_t s;
+    uint8_t i;
+
+    fusion->reports++;
+    now = fusion->reports;
+    if ( (NULL_PTR != ctx->config) && (NULL_PTR != ctx->config->get_time) )
+    {
+        now = ctx->config->get_time(ctx);
+        timeout = TACHO_FUSION_TIMEOUT;
+    }
+    memcpy(fusion->source[source].tco1, tco1_data, TACHO_TCO1_SIZE);
+    fusion->source[source].stamp = now;
+    fusion->source[source].seen = TRUE;
+
+    for (field = 0; field < TACHO_FUSION_FIELDS; field++)
+    {
+        best = (uint8_t) source;
+        best_age = TACHO_TCO1_AGE_NONE;
+        for (s = 0; s < TACHO_SOURCE_MAX; s++)
+        {
+            candidate = &fusion->source[s];
+            if ( candidate->seen && Tacho_FusionFieldValid(candidate->tco1, field) )
+            {
+                age = now - candidate->stamp;
+                if (age <= timeout)
+                {
+                    /* Fresh: the highest priority one wins */
+                    best = s;
+                    break;
+                }
+                if (age < best_age)
+                {
+                    best = s;
+                    best_age = age;
+                }
+            }
+        }
+
+        for (i = Tacho_FusionField[field][0]; i < Tacho_FusionField[field][0] + Tacho_FusionField[field][1]; i++)
+        {
+            fused[i] = fusion->source[best].tco1[i];
+            fusion->from[i] = best;
+        }
+    }
+}
+
+/**
+ * Tells whether a source reported a TCO1 field
+ * @param tco1[in] Reported TCO1
+ * @param field Index in Tacho_FusionField
+ * @return FALSE if the field is "not available" or an error indicator
+ */
+static bool_t Tacho_FusionFieldValid(const uint8_t *tco1, uint8_t field)
+{
+    const uint8_t *value = &tco1[Tacho_FusionField[field][0]];
+
+    if (1 == Tacho_FusionField[field][1])
+    {
+        return (bool_t) (0xFF != value[0]);
+    }
+    /* J1939 2-byte parameters: 0xFB00 and above are reserved, error or not available */
+    return (bool_t) (0xFA >= value[1]);
+}
+#endif
+
+/**
+ * Age of the last TCO1 report of a source
+ * @param ctx Decoder context
+ * @param source TCO1 source
+ * @return get_time ticks since the report (TCO1 reports from any source
+ *  without a get_time binding), TACHO_TCO1_AGE_NONE if the source never
+ *  reported or TACHO_CFG_TCO1_FUSION is STD_OFF
+ */
+uint32_t Tacho_CtxGetTco1Age(Tacho_Ctx_t *ctx, Tacho_Source_t source)
+{
+#if (TACHO_CFG_TCO1_FUSION == STD_ON)
+    uint32_t now = ctx->fusion.reports;
+
+    if ( (TACHO_SOURCE_MAX <= source) || (FALSE == ctx->fusion.source[source].seen) )
+    {
+        return TACHO_TCO1_AGE_NONE;
+    }
+    if ( (NULL_PTR != ctx->config) && (NULL_PTR != ctx->config->get_time) )
+    {
+        now = ctx->config->get_time(ctx);
+    }
+    return now - ctx->fusion.source[source].stamp;
+#else
+    (void) ctx;
+    (void) source;
+
+    return TACHO_TCO1_AGE_NONE;
+#endif
+}
+
+/**
+ * Source a TCO1 byte was last fused from
+ * @param ctx Decoder context
+ * @param index TCO1 byte
+ * @return Source of the byte, TACHO_SOURCE_MAX if no TCO1 was received or
+ *  TACHO_CFG_TCO1_FUSION is STD_OFF
+ */
+Tacho_Source_t Tacho_CtxGetTco1Source(Tacho_Ctx_t *ctx, Tacho_Tco1_Index_t index)
+{
+#if (TACHO_CFG_TCO1_FUSION == STD_ON)
+    if ( (TACHO_TCO1_SIZE <= index) || (0 == ctx->fusion.reports) )
+    {
+        return TACHO_SOURCE_MAX;
+    }
+    return (Tacho_Source_t) ctx->fusion.from[index];
+#else
+    (void) ctx;
+    (void) index;
+
+    return TACHO_SOURCE_MAX;
+#endif
+}
 
-    case TACHO_VDO_DRV2_STATE:
-        Tacho_Frame.driver2_state = rx_byte;
-        break;
+/**
+ * Compares received TCO1 data with the last published one
+ * @param ctx Decoder context
+ * @param tco1_data[in] TCO1 8-byte buffer
+ * @return TACHO_DIRTY_* bits of the TCO1 fields whose change passed the thresholds
+ */
+static uint16_t Tacho_Tco1Changes(Tacho_Ctx_t *ctx, const uint8_t *tco1_data)
+{
+    Tacho_Changes_t *changes = &ctx->changes;
+    const uint8_t *published = ctx->cached.tco1_cmn;
+    uint16_t dirty = 0;
+    uint16_t speed;
+    uint16_t published_speed;
+    uint8_t i;
 
-    case TACHO_VDO_STATUS:
-        Tacho_Frame.tacho_status = rx_byte;
-        break;
+    for (i = 0; i < TACHO_TCO1_RB4; i++)
+    {
+        if (published[i] == tco1_data[i])
+        {
+            changes->count[i] = 0;
+            continue;
+        }
 
-    case TACHO_VDO_SPEED_LSB:
-        Tacho_Frame.speed_lsb = rx_byte;
-        break;
+        if ( (0 == changes->count[i]) || (changes->candidate[i] != tco1_data[i]) )
+        {
+            changes->candidate[i] = tco1_data[i];
+            changes->count[i] = 1;
+        }
+        else if (changes->count[i] < 0xFF)
+        {
+            changes->count[i]++;
+        }
 
-    case TACHO_VDO_SPEED_MSB:
-        Tacho_Frame.speed_msb = rx_byte;
+        if (changes->count[i] > ctx->thresholds.state_hysteresis)
+        {
+            dirty |= (uint16_t) (TACHO_DIRTY_WORKING_STATE << i);
+        }
+    }
+
+    speed = (uint16_t) ((tco1_data[TACHO_TCO1_SPEED_MSB] << 8) | tco1_data[TACHO_TCO1_SPEED_LSB]);
+    published_speed = (uint16_t) ((published[TACHO_TCO1_SPEED_MSB] << 8) | published[TACHO_TCO1_SPEED_LSB]);
+    if ((uint16_t) Tacho_AbsDiff32(speed, published_speed) > ctx->thresholds.speed_deadband)
+    {
+        dirty |= TACHO_DIRTY_SPEED;
+    }
+
+    return dirty;
+}
+
+/**
+ * Distance between two unsigned values
+ * @param a First value
+ * @param b Second value
+ * @return |a - b|
+ */
+static uint32_t Tacho_AbsDiff32(uint32_t a, uint32_t b)
+{
+    return (a > b) ? (a - b) : (b - a);
+}
+
+/**
+ * Called whenever TCO1 data for a context is received from another source (e.g. CAN)
+ * @param ctx Decoder context
+ * @param tco1_data[in] TCO1 8-byte buffer
+ */
+void Tacho_CtxProcessTco1(Tacho_Ctx_t *ctx, uint8_t *tco1_data)
+{
+    Tacho_NotifyFrameReceived(ctx, TACHO_SOURCE_CAN, tco1_data);
+}
+
+/**
+ * Called whenever a DI message for a context is received from another source (e.g. CAN)
+ * @param ctx Decoder context
+ * @param di[in] Null-terminated driver identification
+ */
+void Tacho_CtxProcessDI(Tacho_Ctx_t *ctx, uint8_t *di)
+{
+    uint8_t index = 0;
+
+    Tacho_CacheWriteBegin(ctx);
+    while ( (di[index] != 0) && (index < TACHO_MAX_DI_MSG) )
+    {
+        if (ctx->cached.di[index] != di[index])
+        {
+            ctx->cached.di[index] = di[index];
+            ctx->changes.dirty |= TACHO_DIRTY_DI;
+        }
+        index++;
+    }
+    Tacho_CacheWriteEnd(ctx);
+}
+
+/**
+ * Called for each frame received on the CAN bus of a context
+ * Takes TCO1 and the driver identification from the tachograph
+ * (TACHO_CAN_TACHO_SA) straight from the bus, without a J1939 stack:
+ * TCO1 already has the cached TCO1 layout, and the DI, sent over TP.BAM
+ * when longer than 8 bytes, is reassembled in the cached DI itself. Each
+ * packet is written in its own cache write section, so a snapshot taken
+ * during a transfer that changes the DI may mix both identifications until
+ * the last packet is received; TACHO_DIRTY_DI is raised once it is.
+ * Every other frame is ignored.
+ * @param ctx Decoder context
+ * @param id 29-bit extended identifier (e.g. can_id & CAN_EFF_MASK on SocketCAN)
+ * @param data[in] Frame data
+ * @param dlc Number of bytes in data
+ */
+void Tacho_CtxCanRx(Tacho_Ctx_t *ctx, uint32_t id, const uint8_t *data, uint8_t dlc)
+{
+#if (TACHO_CFG_CAN_RX == STD_ON)
+    uint32_t pgn;
+    uint8_t pf = (uint8_t) (id >> 16);
+    uint8_t ps = (uint8_t) (id >> 8);
+    uint8_t count;
+
+    if (TACHO_CAN_TACHO_SA != (uint8_t) id)
+    {
+        return;
+    }
+
+    pgn = (id >> 8) & 0x3FFFFUL;
+    if ( (TACHO_CAN_PF_TP_CM == pf) || (TACHO_CAN_PF_TP_DT == pf) )
+    {
+        if ( (TACHO_CAN_GLOBAL == ps) && (8 <= dlc) )
+        {
+            if (TACHO_CAN_PF_TP_CM == pf)
+            {
+                Tacho_CanTpCm(ctx, data);
+            }
+            else
+            {
+                Tacho_CanTpDt(ctx, data);
+            }
+        }
+    }
+    else if (TACHO_CAN_PGN_TCO1 == pgn)
+    {
+        if (TACHO_TCO1_SIZE <= dlc)
+        {
+            Tacho_NotifyFrameReceived(ctx, TACHO_SOURCE_CAN, data);
+        }
+    }
+    else if (TACHO_CAN_PGN_DI == pgn)
+    {
+        /* Up to 8 bytes, padded with 0xFF */
+        for (count = 0; (count < dlc) && (0xFF != data[count]); count++)
+        {
+        }
+        ctx->can_bam.size = 0;
+        ctx->can_bam.changed = FALSE;
+        Tacho_CanDiWrite(ctx, 0, data, count);
+        Tacho_CanDiEnd(ctx, count);
+    }
+
+    Tacho_CtxJournalTask(ctx);
+#else
+    (void) ctx;
+    (void) id;
+    (void) data;
+    (void) dlc;
+#endif
+}
+
+#if (TACHO_CFG_CAN_RX == STD_ON)
+/**
+ * Handles a TP.CM broadcast of the tachograph
+ * A BAM of the DI starts a transfer; since a node sends one BAM at a time,
+ * any other BAM drops the transfer in progress.
+ * @param ctx Decoder context
+ * @param data[in] Frame data (8 bytes)
+ */
+static void Tacho_CanTpCm(Tacho_Ctx_t *ctx, const uint8_t *data)
+{
+    Tacho_CanBam_t *bam = &ctx->can_bam;
+    uint32_t pgn = data[5] | ((uint32_t) data[6] << 8) | ((uint32_t) data[7] << 16);
+    uint16_t size = (uint16_t) (data[1] | ((uint16_t) data[2] << 8));
+
+    bam->size = 0;
+    if ( (TACHO_CAN_TP_BAM == data[0]) && (TACHO_CAN_PGN_DI == pgn) && (0 != size) &&
+         (data[3] == (size + TACHO_CAN_TP_DT_SIZE - 1) / TACHO_CAN_TP_DT_SIZE) )
+    {
+        bam->size = size;
+        bam->packets = data[3];
+        bam->next = 1;
+        bam->changed = FALSE;
+    }
+}
+
+/**
+ * Handles a TP.DT broadcast of the tachograph
+ * A packet out of sequence drops the transfer; the bytes already written
+ * stay until the next DI transfer.
+ * @param ctx Decoder context
+ * @param data[in] Frame data (8 bytes)
+ */
+static void Tacho_CanTpDt(Tacho_Ctx_t *ctx, const uint8_t *data)
+{
+    Tacho_CanBam_t *bam = &ctx->can_bam;
+    uint16_t pos;
+
+    if ( (0 == bam->size) || (data[0] != bam->next) )
+    {
+        bam->size = 0;
+        return;
+    }
+
+    pos = (uint16_t) ((data[0] - 1) * TACHO_CAN_TP_DT_SIZE);
+    Tacho_CanDiWrite(ctx, pos, &data[1], (uint8_t) MIN(bam->size - pos, TACHO_CAN_TP_DT_SIZE));
+    if (bam->next == bam->packets)
+    {
+        Tacho_CanDiEnd(ctx, bam->size);
+        bam->size = 0;
+    }
+    else
+    {
+        bam->next++;
+    }
+}
+
+/**
+ * Writes DI message bytes to the cached DI
+ * Bytes past the cached DI size are dropped.
+ * @param ctx Decoder context
+ * @param pos Position of data in the DI message
+ * @param data[in] Message bytes
+ * @param count Number of bytes in data
+ */
+static void Tacho_CanDiWrite(Tacho_Ctx_t *ctx, uint16_t pos, const uint8_t *data, uint8_t count)
+{
+    uint8_t i;
+
+    Tacho_CacheWriteBegin(ctx);
+    for (i = 0; (i < count) && (pos + i < TACHO_MAX_DI_MSG - 1); i++)
+    {
+        if (ctx->cached.di[pos + i] != data[i])
+        {
+            ctx->cached.di[pos + i] = data[i];
+            ctx->can_bam.changed = TRUE;
+        }
+    }
+    Tacho_CacheWriteEnd(ctx);
+}
+
+/**
+ * Terminates the cached DI after a complete DI message
+ * @param ctx Decoder context
+ * @param size Message size in bytes
+ */
+static void Tacho_CanDiEnd(Tacho_Ctx_t *ctx, uint16_t size)
+{
+    uint16_t end = MIN(size, TACHO_MAX_DI_MSG - 1);
+
+    Tacho_CacheWriteBegin(ctx);
+    if (0 != ctx->cached.di[end])
+    {
+        ctx->cached.di[end] = 0;
+        ctx->can_bam.changed = TRUE;
+    }
+    if (ctx->can_bam.changed)
+    {
+        ctx->changes.dirty |= TACHO_DIRTY_DI;
+    }
+    Tacho_CacheWriteEnd(ctx);
+}
+#endif
+
+/**
+ * Switches between tachograph standards
+ * @param ctx Decoder context
+ * @param standard Specified tachograph standard
+ * @param updateMemory Update FRAM memory with new Tachograph type
+ */
+static void Tacho_SelectStandard(Tacho_Ctx_t *ctx, Tacho_Standard_t standard, bool_t updateMemory)
+{
+    Tacho_ClearRxQueue(ctx);
+    Tacho_SelectHandler(ctx, standard);
+
+    if ( (NULL != ctx->proto) && (standard < TACHO_STANDARD_MAX) )
+    {
+        if ( (NULL_PTR != ctx->config) && (NULL_PTR != ctx->config->set_baudrate) )
+        {
+            ctx->config->set_baudrate(ctx, ctx->proto->baudRate);
+        }
+        if (updateMemory)
+        {
+            Tacho_SetMemory(ctx, standard);
+        }
+    }
+}
+
+/**
+ * Points a context to the protocol description and frame handler of a standard
+ * @param ctx Decoder context
+ * @param standard New standard
+ */
+static void Tacho_SelectHandler(Tacho_Ctx_t *ctx, Tacho_Standard_t standard)
+{
+    if ( (NULL_PTR != ctx->proto) && (standard != ctx->standard) )
+    {
+        TACHO_STAT_INC(ctx, TACHO_STAT_SWITCHES);
+    }
+
+    switch (standard)
+    {
+    case TACHO_STANDARD_VDO:
+        ctx->standard = TACHO_STANDARD_VDO;
+        ctx->proto = &Tacho_Protocol[TACHO_STANDARD_VDO];
+#if (TACHO_CFG_VDO_BYTEWISE == STD_ON)
+        ctx->handler = &Tacho_VdoHandler;
+        Tacho_VdoInitHandler(ctx);
+#else
+        ctx->handler = &Tacho_FrameHandler;
+        Tacho_FrameInit(ctx);
+#endif
         break;
 
-    case TACHO_VDO_VIN_LENGTH:
-        vdo.cstr_pos = TACHO_VDO_VIN_LENGTH + rx_byte + 1;
+    case TACHO_STANDARD_STONERIDGE:
+        ctx->standard = TACHO_STANDARD_STONERIDGE;
+        ctx->proto = &Tacho_Protocol[TACHO_STANDARD_STONERIDGE];
+#if (TACHO_CFG_SR_BYTEWISE == STD_ON)
+        ctx->handler = &Tacho_StoneridgeHandler;
+        Tacho_StoneridgeInitHandler(ctx);
+#else
+        ctx->handler = &Tacho_FrameHandler;
+        Tacho_FrameInit(ctx);
+#endif
         break;
 
     default:
         break;
     }
+}
+
+/**
+ * Called each time a byte is received on a context
+ * @param ctx Decoder context
+ * @param rx_byte Byte value
+ */
+void Tacho_CtxRxNotif(Tacho_Ctx_t *ctx, uint8_t rx_byte)
+{
+    Tacho_QueueAddByte(ctx, rx_byte);
+}
+
+/**
+ * Called each time a framing error occurs on a context
+ * @param ctx Decoder context
+ */
+void Tacho_CtxErrorNotif(Tacho_Ctx_t *ctx)
+{
+    Tacho_RxQueueProducer_t *prod = &ctx->rx_queue.prod;
+
+    TACHO_STORE_RELAXED(&prod->p.error_counter, (uint16_t) (prod->p.error_counter + 1));
+
+#if (TACHO_CFG_WAKEUP == STD_ON)
+    /* Enough framing errors for the task to count a failed attempt */
+    if (TACHO_MAX_FRAMING_ERRORS == (uint16_t) (prod->p.error_counter - ctx->rx_queue.cons.c.error_seen))
+    {
+        Tacho_Wakeup(ctx);
+    }
+#endif
+}
+
+/**
+ * Called each time a block of bytes is received on a context
+ * Start sequences are searched with the automaton of the byte path, so the
+ * context follows the protocol of the data when auto selection is on, and
+ * frames are decoded straight from buf; only a frame split across two
+ * blocks is copied into the context's spill buffer.
+ * Must not be mixed with Tacho_CtxRxNotif() on the same context.
+ *
+ * @param ctx Decoder context
+ * @param buf[in] Received bytes
+ * @param len Number of bytes in buf
+ */
+void Tacho_CtxRxBlock(Tacho_Ctx_t *ctx, const uint8_t *buf, uint32_t len)
+{
+    uint32_t pos = 0;
+    uint32_t start;
+    uint32_t avail;
+    uint16_t length;
+
+    TACHO_STAT_BLOCK_START(ctx);
+
+    while (pos < len)
+    {
+        if (0 < ctx->spill.count)
+        {
+            /* Frame carried over (resumed from the same byte again after a rejection) */
+            pos += Tacho_BlockResume(ctx, &buf[pos], len - pos);
+            continue;
+        }
+
+        /* Search for start of frame; the automaton state carries over to the next block */
+        while ( (pos < len) && (FALSE == Tacho_SyncByte(ctx, buf[pos])) )
+        {
+            pos++;
+        }
+        if (pos >= len)
+        {
+            break;
+        }
+
+        if (pos < ctx->proto->start_sz)
+        {
+            /* Start sequence begun in the previous block: its bytes are known */
+            memcpy(ctx->spill.data, ctx->proto->start_seq, ctx->proto->start_sz);
+            ctx->spill.count = ctx->proto->start_sz;
+            continue;
+        }
+        start = pos - ctx->proto->start_sz;
+        avail = len - start;
+
+        length = Tacho_FrameLength(ctx->standard, &buf[start], (uint16_t) MIN(avail, TACHO_FRAME_MAX));
+        if (0 == length)
+        {
+            /* Invalid frame header - the next frame may start inside it */
+            TACHO_STAT_BAD_HEADER(ctx, &buf[start], (uint16_t) MIN(avail, TACHO_FRAME_MAX));
+            TACHO_STAT_LOST(ctx);
+            pos = start + 1;
+        }
+        else if (length <= avail)
+        {
+            /* The next frame may start inside a rejected one */
+            pos = Tacho_DecodeFrame(ctx, &buf[start], length) ? (start + length) : (start + 1);
+        }
+        else
+        {
+            /* Frame continues in the next block */
+            memcpy(ctx->spill.data, &buf[start], avail);
+            ctx->spill.count = (uint16_t) avail;
+            break;
+        }
+    }
+
+    Tacho_CtxJournalTask(ctx);
+}
 
-    Tacho_VdoCheckDIN(rx_byte);
+/**
+ * Completes the frame kept in the spill buffer with bytes from a new block
+ * @param ctx Decoder context
+ * @param buf[in] Received bytes
+ * @param len Number of bytes in buf
+ * @return Number of bytes of buf consumed (0 if the frame was rejected)
+ */
+static uint32_t Tacho_BlockResume(Tacho_Ctx_t *ctx, const uint8_t *buf, uint32_t len)
+{
+    Tacho_Spill_t *spill = &ctx->spill;
+    uint16_t kept = spill->count;
+    uint32_t pos = 0;
+    uint32_t chunk;
+    uint16_t length;
 
-    if (vdo.cstr_pos == vdo.index)
+    for (;;)
     {
-        vdo.drv1_pos = vdo.cstr_pos + rx_byte + 1;
+        length = Tacho_FrameLength(ctx->standard, spill->data, spill->count);
+        if (0 == length)
+        {
+            /* Invalid frame header */
+            TACHO_STAT_BAD_HEADER(ctx, spill->data, spill->count);
+            TACHO_STAT_LOST(ctx);
+            Tacho_BlockRetry(ctx, 1, kept);
+            return 0;
+        }
+        if (length <= spill->count)
+        {
+            if (FALSE == Tacho_DecodeFrame(ctx, spill->data, length))
+            {
+                Tacho_BlockRetry(ctx, 1, kept);
+                return 0;
+            }
+            if (length < kept)
+            {
+                /* Frame found by a retry ended inside the carried-over bytes */
+                Tacho_BlockRetry(ctx, length, kept);
+                return 0;
+            }
+            spill->count = 0;
+            return pos;
+        }
+        if (pos >= len)
+        {
+            return pos;
+        }
+        chunk = MIN((uint32_t) (length - spill->count), len - pos);
+        memcpy(&spill->data[spill->count], &buf[pos], chunk);
+        spill->count += (uint16_t) chunk;
+        pos += chunk;
     }
-    else if (vdo.drv1_pos == vdo.index)
+}
+
+/**
+ * Searches the spilled bytes following a rejected or decoded frame
+ * Only the bytes carried over from earlier blocks are searched here; the
+ * automaton state then carries over to the bytes taken from the current
+ * block, which the caller searches again.
+ * @param ctx Decoder context
+ * @param first First spilled byte to search
+ * @param kept Number of spilled bytes carried over from earlier blocks
+ */
+static void Tacho_BlockRetry(Tacho_Ctx_t *ctx, uint16_t first, uint16_t kept)
+{
+    Tacho_Spill_t *spill = &ctx->spill;
+    uint16_t start;
+    uint16_t pos;
+
+    ctx->sync_state = 0;
+    for (pos = first; pos < kept; pos++)
     {
-        vdo.drv2_pos = vdo.drv1_pos + rx_byte + 1;
+        if (Tacho_SyncByte(ctx, spill->data[pos]))
+        {
+            /* Complete start sequence inside the carried-over bytes */
+            start = (uint16_t) (pos - ctx->proto->start_sz);
+            memmove(spill->data, &spill->data[start], kept - start);
+            spill->count = (uint16_t) (kept - start);
+            return;
+        }
     }
-    else if (vdo.drv2_pos == vdo.index)
+    spill->count = 0;
+}
+
+/**
+ * Locates the first complete frame with a valid checksum in a buffer
+ * Meant to split a raw D8 capture into chunks that can be decoded
+ * independently (e.g. by one context per thread): a chunk starting at the
+ * returned offset begins on a frame boundary, and a start sequence appearing
+ * inside frame data is not mistaken for one unless a whole valid frame
+ * happens to start there.
+ *
+ * @param standard Capture protocol
+ * @param buf[in] Capture bytes
+ * @param len Number of bytes in buf
+ * @return Offset of the frame start sequence, len if no complete frame was found
+ */
+uint32_t Tacho_FindFrame(Tacho_Standard_t standard, const uint8_t *buf, uint32_t len)
+{
+    const Tacho_Protocol_t *proto;
+    const uint8_t *found;
+    uint32_t pos = 0;
+    uint32_t avail;
+
+    if (TACHO_STANDARD_MAX <= standard)
     {
-        vdo.crc8_pos = vdo.drv2_pos + rx_byte + 1;
+        return len;
     }
-    else if (vdo.crc8_pos == vdo.index)
+    proto = &Tacho_Protocol[standard];
+
+    while (pos < len)
     {
-        /* End of frame detected */
-        if (rx_byte == vdo.crc8_value)
+        found = (const uint8_t *) memchr(&buf[pos], proto->start_seq[0], len - pos);
+        if (NULL_PTR == found)
         {
-            /* Checksum OK - frame received correctly */
-            Tacho_CopyToCache();
-            Tacho_NotifyFrameReceived(Tacho_CachedData.tco1);
+            break;
         }
-        Tacho_VdoInitHandler();
-        return TRUE;
+        pos = (uint32_t) (found - buf);
+        avail = len - pos;
+
+        if ( (avail >= proto->start_sz) && (0 == memcmp(&buf[pos], proto->start_seq, proto->start_sz)) &&
+             (0 != Tacho_ValidFrameLength(standard, &buf[pos], avail)) )
+        {
+            return pos;
+        }
+        pos++;
     }
 
-    /* Frame is still being processed */
-    vdo.crc8_value ^= rx_byte;
-    vdo.index++;
-    return FALSE;
+    return len;
 }
 
 /**
- * Copies the DIN fields from the D8 Stoneridge frame to the corresponding buffers
- *
- * @param pos Position in the DIN field
- * @param rx_byte Received byte from D8 serial output
- * @param country Pointer to country code buffer
- * @param cardnr Pointer to card number buffer
+ * Locates the first complete frame of any known protocol in a buffer
+ * Runs the start sequence automaton over buf, so the protocol of a capture
+ * does not have to be known up front.
+ * @param buf[in] Capture bytes
+ * @param len Number of bytes in buf
+ * @param standard[out] Protocol of the frame found (left untouched if none)
+ * @return Offset of the frame start sequence, len if no complete frame was found
  */
-static void Tacho_StoneridgeCopyDIN(uint8_t pos, uint8_t rx_byte, uint8_t *country, uint8_t *cardnr)
+uint32_t Tacho_DetectFrame(const uint8_t *buf, uint32_t len, Tacho_Standard_t *standard)
 {
-    if ( (rx_byte == 0xFF) && (pos == 0) )
+    uint8_t state = 0;
+    uint8_t id;
+    uint32_t pos;
+    uint32_t start;
+
+    for (pos = 0; pos < len; pos++)
     {
-        /* DIN field is empty, so skip the field entirely */
-        cardnr[0] = '\0';
-        sr.drv1_pos = 0xFF;
-        sr.drv2_pos = 0xFF;
-        return;
+        state = Tacho_SyncNext(state, buf[pos]);
+        id = Tacho_SyncMatch(state);
+        if (id >= TACHO_STANDARD_MAX)
+        {
+            continue;
+        }
+
+        start = pos + 1 - Tacho_Protocol[id].start_sz;
+        if (0 != Tacho_ValidFrameLength((Tacho_Standard_t) id, &buf[start], len - start))
+        {
+            *standard = (Tacho_Standard_t) id;
+            return start;
+        }
     }
 
-    if (pos < TACHO_MAX_COUNTRY_CODE)
+    return len;
+}
+
+/**
+ * Length of the frame at the start of a buffer
+ * The start sequence itself is not checked (see Tacho_FindFrame() and
+ * Tacho_DetectFrame() to locate one).
+ * @param standard Frame protocol
+ * @param buf[in] Frame bytes, starting with the start sequence
+ * @param len Number of bytes in buf
+ * @return Frame length, 0 if the frame is incomplete or its checksum is invalid
+ */
+uint16_t Tacho_ValidFrameLength(Tacho_Standard_t standard, const uint8_t *buf, uint32_t len)
+{
+    uint16_t length;
+
+    length = Tacho_FrameLength(standard, buf, (uint16_t) MIN(len, TACHO_FRAME_MAX));
+    if ( (0 == length) || (length > len) || (FALSE == Tacho_FrameCheck(standard, buf, length)) )
     {
-        /* Country Code */
-        country[pos] = rx_byte;
+        return 0;
     }
-    else
+    return length;
+}
+
+#if (TACHO_CFG_VDO_BYTEWISE == STD_OFF) || (TACHO_CFG_SR_BYTEWISE == STD_OFF)
+
+/**
+ * Prepares the reception frame buffer for the next frame of the selected protocol
+ * @param ctx Decoder context
+ */
+static void Tacho_FrameInit(Tacho_Ctx_t *ctx)
+{
+    Tacho_RxFrame_t *rx_frame = &ctx->rx_frame;
+    uint8_t i;
+
+    /* Keep the start sequence so that frame offsets match the field positions */
+    for (i = 0; i < ctx->proto->start_sz; i++)
     {
-        /* Card Number */
-        cardnr[pos - TACHO_MAX_COUNTRY_CODE] = rx_byte;
+        rx_frame->data[i] = ctx->proto->start_seq[i];
     }
+    rx_frame->count = ctx->proto->start_sz;
+    rx_frame->needed = ctx->proto->start_sz;
 }
 
 /**
- * Checks if received byte contains data from a Stoneridge DIN field
+ * Handles data coming from the Tachograph after synchronization
+ * Bytes are buffered until the frame is complete; the layout is only
+ * re-resolved once a byte it depends on has arrived, then the frame is
+ * decoded at once. The bytes up to that point are taken from the reception
+ * buffer in bulk rather than one handler call per byte.
+ *
+ * @param ctx Decoder context
  * @param rx_byte Received byte from D8 serial output
+ * @return TRUE if end of frame detected
+ *  FALSE if frame is still being processed
  */
-static void Tacho_StoneridgeCheckDIN(uint8_t rx_byte)
+static bool_t Tacho_FrameHandler(Tacho_Ctx_t *ctx, uint8_t rx_byte)
 {
-    uint8_t pos;
+    Tacho_RxFrame_t *rx_frame = &ctx->rx_frame;
 
-    if ( (sr.drv1_pos == 0xFF) && (sr.drv2_pos == 0xFF) )
+    rx_frame->data[rx_frame->count++] = rx_byte;
+    for (;;)
     {
-        /* Message doesn't contain DIN1 or DIN2 info or DIN field is empty */
-        return;
+        if (rx_frame->count < rx_frame->needed)
+        {
+            rx_frame->count += Tacho_NextBlock(ctx, &rx_frame->data[rx_frame->count],
+                                               rx_frame->needed - rx_frame->count);
+            if (rx_frame->count < rx_frame->needed)
+            {
+                /* Frame is still being processed */
+                return FALSE;
+            }
+        }
+
+        rx_frame->needed = Tacho_FrameLength(ctx->standard, rx_frame->data, rx_frame->count);
+        if (rx_frame->count >= rx_frame->needed)
+        {
+            break;
+        }
+        /* Layout byte or end of frame not received yet */
     }
 
-    /* Handle DIN1 */
-    if ( (sr.drv1_pos <= sr.index) && (sr.index < sr.crc8_pos - 1) )
+    if (0 != rx_frame->needed)
     {
-        pos = sr.index - sr.drv1_pos;
-        Tacho_StoneridgeCopyDIN(
-            pos,
-            rx_byte,
-            Tacho_Frame.driver[TACHO_DRIVER1].country,
-            Tacho_Frame.driver[TACHO_DRIVER1].cardnr
-        );
+        /* End of frame detected */
+        if (FALSE == Tacho_DecodeFrame(ctx, rx_frame->data, rx_frame->needed))
+        {
+            Tacho_FrameLookback(ctx);
+        }
     }
-    /* Handle DIN2 */
-    else if ( (sr.drv2_pos <= sr.index) && (sr.index < sr.crc8_pos - 1) )
+    else
     {
-        pos = sr.index - sr.drv2_pos;
-        Tacho_StoneridgeCopyDIN(
-            pos,
-            rx_byte,
-            Tacho_Frame.driver[TACHO_DRIVER2].country,
-            Tacho_Frame.driver[TACHO_DRIVER2].cardnr
-        );
+        TACHO_STAT_BAD_HEADER(ctx, rx_frame->data, rx_frame->count);
+        Tacho_FrameLookback(ctx);
     }
+    Tacho_FrameInit(ctx);
+    return TRUE;
 }
 
 /**
- * Initializes internal data for the Stoneridge protocol
+ * Queues the bytes of a rejected frame for another start sequence search
+ * The start sequence found may have been a false one inside the payload of
+ * a real frame, whose start is then among the bytes already consumed. They
+ * are fed again (ahead of the bytes still to be fed from an earlier
+ * rejection) starting right after the false start. Every rejection gives
+ * back one byte less than it took, so the lookback never exceeds
+ * TACHO_FRAME_MAX - 1 bytes.
+ * @param ctx Decoder context
  */
-static void Tacho_StoneridgeInitHandler(void)
+static void Tacho_FrameLookback(Tacho_Ctx_t *ctx)
 {
-    sr.index = TACHO_SR_SEQSZ;
-    sr.crc8_value = 0;
-    sr.drv1_pos = 0xFF;
-    sr.drv2_pos = 0xFF;
-    sr.crc8_pos = 0xFF;
+    Tacho_RxFrame_t *rx_frame = &ctx->rx_frame;
+    Tacho_Lookback_t *lookback = &ctx->lookback;
+    uint16_t pending = lookback->count - lookback->head;
+    uint16_t replay = rx_frame->count - 1;
+
+    memmove(&lookback->data[replay], &lookback->data[lookback->head], pending);
+    memcpy(lookback->data, &rx_frame->data[1], replay);
+    lookback->head = 0;
+    lookback->count = replay + pending;
 }
 
+#endif
+
 /**
- * Handles data coming from a Stoneridge-type Tachograph
- * @param rx_byte Received byte from D8 serial output
- * @return TRUE if end of frame detected
- *  FALSE if frame is still being processed
+ * Resolves the length of a frame
+ * @param standard Frame protocol
+ * @param frame[in] Frame bytes, starting with the start sequence
+ * @param avail Number of bytes available in frame
+ * @return See Tacho_VdoFrameLength() and Tacho_StoneridgeFrameLength()
  */
-static bool_t Tacho_StoneridgeHandler(uint8_t rx_byte)
+static uint16_t Tacho_FrameLength(Tacho_Standard_t standard, const uint8_t *frame, uint16_t avail)
 {
-    switch (sr.index)
-    {
-    case TACHO_SR_MSG_LEN:
-        if ( (rx_byte < TACHO_SR_MSG_LEN_MIN) || (rx_byte > TACHO_SR_MSG_LEN_MAX) )
-        {
-            /* Message length not in valid range - discard frame */
-            Tacho_StoneridgeInitHandler();
-            return TRUE;
-        }
-        /* Message length OK - compute position of last byte (CRC byte) */
-        sr.crc8_pos = TACHO_SR_MSG_LEN + rx_byte - 1;
-        break;
+    uint16_t length = 0;
 
-    case TACHO_SR_MSG_ID:
-        if (FALSE == Tacho_StoneridgeMsgProcess(rx_byte))
-        {
-            /* Message ID not valid - discard frame */
-            Tacho_StoneridgeInitHandler();
-            return TRUE;
-        }
+    switch (standard)
+    {
+    case TACHO_STANDARD_VDO:
+        length = Tacho_VdoFrameLength(frame, avail);
         break;
 
-    case TACHO_SR_WORKING_STATE:
-        Tacho_Frame.working_state = rx_byte;
+    case TACHO_STANDARD_STONERIDGE:
+        length = Tacho_StoneridgeFrameLength(frame, avail);
         break;
 
-    case TACHO_SR_DRV1_STATE:
-        Tacho_Frame.driver1_state = rx_byte;
+    default:
         break;
+    }
 
-    case TACHO_SR_DRV2_STATE:
-        Tacho_Frame.driver2_state = rx_byte;
-        break;
+    return length;
+}
 
-    case TACHO_SR_STATUS:
-        Tacho_Frame.tacho_status = rx_byte;
-        break;
+/**
+ * Verifies the checksum of a complete frame
+ * @param standard Frame protocol
+ * @param frame[in] Frame bytes, starting with the start sequence
+ * @param length Frame length as returned by Tacho_FrameLength()
+ * @return TRUE if the checksum is valid, FALSE otherwise
+ */
+static bool_t Tacho_FrameCheck(Tacho_Standard_t standard, const uint8_t *frame, uint16_t length)
+{
+    bool_t opSuccess = FALSE;
 
-    case TACHO_SR_SPEED_LSB:
-        Tacho_Frame.speed_lsb = rx_byte;
+    switch (standard)
+    {
+    case TACHO_STANDARD_VDO:
+        opSuccess = Tacho_VdoFrameCheck(frame, length);
         break;
 
-    case TACHO_SR_SPEED_MSB:
-        Tacho_Frame.speed_msb = rx_byte;
+    case TACHO_STANDARD_STONERIDGE:
+        opSuccess = Tacho_StoneridgeFrameCheck(frame, length);
         break;
 
     default:
         break;
     }
 
-    Tacho_StoneridgeCheckDIN(rx_byte);
-
-    if (sr.crc8_pos == sr.index)
-    {
-        /* End of frame detected */
-        sr.crc8_value = ~sr.crc8_value + 1;
-        if (sr.crc8_value == rx_byte)
-        {
-            /* Checksum OK - frame received correctly */
-            Tacho_CopyToCache();
-            Tacho_NotifyFrameReceived(Tacho_CachedData.tco1);
-        }
-        Tacho_StoneridgeInitHandler();
-        return TRUE;
-    }
-
-    sr.crc8_value += rx_byte;
-    sr.index++;
-    return FALSE;
+    return opSuccess;
 }
 
 /**
- * Determines message type and prepares DIN1 and DIN2 to be read when needed
- * @param rx_byte Received byte from D8 serial output
- * @return TRUE if message ID is valid; FALSE otherwise
+ * Decodes a complete frame of the selected protocol
+ * @param ctx Decoder context
+ * @param frame[in] Frame bytes, starting with the start sequence
+ * @param length Frame length
+ * @return TRUE if the frame was decoded, FALSE otherwise
  */
-static bool_t Tacho_StoneridgeMsgProcess(uint8_t rx_byte)
+static bool_t Tacho_DecodeFrame(Tacho_Ctx_t *ctx, const uint8_t *frame, uint16_t length)
 {
-    bool_t opSuccess = TRUE;
+    bool_t opSuccess = FALSE;
 
-    switch (rx_byte)
+    TACHO_STAT_DECODE_START(ctx);
+    switch (ctx->standard)
     {
-    case TACHO_SR_MSG_DIN1:
-        sr.drv1_pos = TACHO_SR_CUSTOM;
-        break;
-
-    case TACHO_SR_MSG_DIN2:
-        sr.drv2_pos = TACHO_SR_CUSTOM;
+    case TACHO_STANDARD_VDO:
+        opSuccess = Tacho_VdoDecodeFrame(ctx, frame, length);
         break;
 
-    case TACHO_SR_MSG_VIN:
-    case TACHO_SR_MSG_VRN:
-        /* Ignore - VIN and VRN not needed (for now) */
+    case TACHO_STANDARD_STONERIDGE:
+        opSuccess = Tacho_StoneridgeDecodeFrame(ctx, frame, length);
         break;
 
     default:
-        /* Invalid message ID */
-        opSuccess = FALSE;
         break;
     }
 
+    if (FALSE == opSuccess)
+    {
+        TACHO_STAT_INC(ctx, TACHO_STAT_CHECKSUM);
+    }
     return opSuccess;
 }
 
 /**
- * Called when data was successfully read
- * Copies the data received from D8 to a cache for future use
+ * Clears the reception buffer
+ * Only consumer-owned data is touched, so this is safe while bytes are
+ * still being received.
+ * @param ctx Decoder context
  */
-static void Tacho_CopyToCache(void)
+static void Tacho_ClearRxQueue(Tacho_Ctx_t *ctx)
 {
-    uint8_t dindex = 0;
-    uint8_t i, j;
+    Tacho_RxQueue_t *queue = &ctx->rx_queue;
+
+    ctx->spill.count = 0;
+    ctx->lookback.head = 0;
+    ctx->lookback.count = 0;
+    queue->cons.c.error_seen = TACHO_LOAD_RELAXED(&queue->prod.p.error_counter);
+    queue->cons.c.failed_attempts = 0;
+    TACHO_STORE_RELEASE(&queue->cons.c.head, TACHO_LOAD_ACQUIRE(&queue->prod.p.tail));
+}
 
-    /* Create cached TCO1 message */
-    Tacho_CachedData.tco1[TACHO_TCO1_WORKING_STATE] = Tacho_Frame.working_state;
-    Tacho_CachedData.tco1[TACHO_TCO1_DRV1_STATE] = Tacho_Frame.driver1_state;
-    Tacho_CachedData.tco1[TACHO_TCO1_DRV2_STATE] = Tacho_Frame.driver2_state;
-    Tacho_CachedData.tco1[TACHO_TCO1_STATUS] = Tacho_Frame.tacho_status;
-    Tacho_CachedData.tco1[TACHO_TCO1_RB4] = 0xFF;
-    Tacho_CachedData.tco1[TACHO_TCO1_RB5] = 0xFF;
-    Tacho_CachedData.tco1[TACHO_TCO1_SPEED_LSB] = Tacho_Frame.speed_lsb;
-    Tacho_CachedData.tco1[TACHO_TCO1_SPEED_MSB] = Tacho_Frame.speed_msb;
+/**
+ * Add byte to reception buffer (producer side)
+ * @param ctx Decoder context
+ * @param rx_byte Byte value
+ * @return TRUE if byte has been added successfully, FALSE if the buffer is full
+ */
+static bool_t Tacho_QueueAddByte(Tacho_Ctx_t *ctx, uint8_t rx_byte)
+{
+    Tacho_RxQueue_t *queue = &ctx->rx_queue;
+    uint16_t tail = queue->prod.p.tail;
+    uint16_t head = TACHO_LOAD_ACQUIRE(&queue->cons.c.head);
 
-    /* Copy driver ID data */
-    for (i = 0; i < TACHO_MAX_DRIVERS; i++)
+    if (TACHO_RX_QUEUE_SIZE <= (uint16_t) (tail - head))
     {
-        if (Tacho_Frame.driver[i].cardnr[0])
-        {
-            for (j = 0; j < TACHO_MAX_COUNTRY_CODE; j++)
-            {
-                Tacho_CachedData.di[dindex++] = Tacho_Frame.driver[i].country[j];
-            }
-            for (j = 0; j < TACHO_MAX_CARD_NR; j++)
-            {
-                Tacho_CachedData.di[dindex++] = Tacho_Frame.driver[i].cardnr[j];
-            }
-        }
-        Tacho_CachedData.di[dindex++] = '*';
+        /* Buffer full - account for the lost byte */
+        TACHO_STORE_RELAXED(&queue->prod.p.dropped, queue->prod.p.dropped + 1);
+        return FALSE;
+    }
+
+    queue->data[tail & TACHO_RX_QUEUE_MASK] = rx_byte;
+    TACHO_STORE_RELEASE(&queue->prod.p.tail, (uint16_t) (tail + 1));
+
+#if (TACHO_CFG_WAKEUP == STD_ON)
+    /* Pairs with the fence of Tacho_WakeupArm(): either side sees the other's index */
+    TACHO_FENCE_FULL();
+    if ((uint16_t) (tail + 1) == TACHO_LOAD_RELAXED(&queue->cons.c.wake_at))
+    {
+        Tacho_Wakeup(ctx);
     }
-    Tacho_CachedData.di[dindex++] = '\0';
+#endif
+    return TRUE;
 }
 
 /**
- * Common notification function called whenever TCO1-related data is
- * received either on CAN or on the D8 serial output.
- * In turn will call the FMI notification function if new data is available.
- *
- * @param tco1_data[in] This is the TCO1 8-byte buffer
+ * Read & remove byte from reception buffer (consumer side)
+ * @param ctx Decoder context
+ * @param byte_val[out] Holds the popped byte if dequeue is successful
+ * @return TRUE if byte has been read/removed successfully, FALSE otherwise
  */
-static void Tacho_NotifyFrameReceived(uint8_t *tco1_data)
+static bool_t Tacho_FetchByte(Tacho_Ctx_t *ctx, uint8_t *byte_val)
 {
-    bool_t dataChanged = FALSE;
-    uint8_t i;
+    Tacho_RxQueue_t *queue = &ctx->rx_queue;
+    uint16_t head = queue->cons.c.head;
 
-    if (NULL != tco1_data)
+    if (TACHO_LOAD_ACQUIRE(&queue->prod.p.tail) == head)
     {
-        /* Only check if the first 4 bytes have changed */
-        for (i = 0; i < TACHO_TCO1_RB4; i++)
-        {
-            if (Tacho_CachedData.tco1_cmn[i] != tco1_data[i])
-            {
-                dataChanged = TRUE;
-            }
-        }
-
-        if (dataChanged)
-        {
-            /* Copy to common buffer and fire event */
-            for (i = 0; i < TACHO_TCO1_SIZE; i++)
-            {
-                Tacho_CachedData.tco1_cmn[i] = tco1_data[i];
-            }
-            FMI_process_j1939_event(J1939_EVENT_TCO1_AVAILABLE);
-        }
+        return FALSE;
     }
+
+    *byte_val = queue->data[head & TACHO_RX_QUEUE_MASK];
+    TACHO_STORE_RELEASE(&queue->cons.c.head, (uint16_t) (head + 1));
+    return TRUE;
 }
 
 /**
- * Called by the J1939 when a TCO1 message has been read on CAN
- * @param event Should always be J1939_EVENT_TCO1_AVAILABLE
+ * Get next byte for the decoder: rejected frame bytes first, then the reception buffer
+ * @param ctx Decoder context
+ * @param byte_val[out] Pointer to the byte
+ * @return TRUE if a byte was available, FALSE otherwise
  */
-void Tacho_process_j1939_event(uint8_t event)
+static bool_t Tacho_NextByte(Tacho_Ctx_t *ctx, uint8_t *byte_val)
 {
-    uint8_t *p_data;
+    Tacho_Lookback_t *lookback = &ctx->lookback;
 
-    switch (event)
+    if (lookback->head < lookback->count)
     {
-    case (J1939_EVENT_TCO1_AVAILABLE):
-        p_data = j1939_get_cached_tco1_content_p();
-        Tacho_NotifyFrameReceived(p_data);
-        break;
-
-    default:
-        break;
+        *byte_val = lookback->data[lookback->head++];
+        return TRUE;
     }
+    return Tacho_FetchByte(ctx, byte_val);
 }
 
+#if (TACHO_CFG_VDO_BYTEWISE == STD_OFF) || (TACHO_CFG_SR_BYTEWISE == STD_OFF)
+
 /**
- * Called whenever a DI message from J1939 is received
- * @param di[in] Driver identification from J1939
+ * Get up to max bytes for the decoder, in the same order as Tacho_NextByte()
+ * @param ctx Decoder context
+ * @param dst[out] Destination buffer
+ * @param max Maximum number of bytes to copy
+ * @return Number of bytes copied
  */
-void Tacho_process_j1939_di(uint8_t *di)
+static uint16_t Tacho_NextBlock(Tacho_Ctx_t *ctx, uint8_t *dst, uint16_t max)
 {
-    uint8_t index = 0;
-    while ( (di[index] != 0) && (index < TACHO_MAX_DI_MSG) )
+    Tacho_Lookback_t *lookback = &ctx->lookback;
+    Tacho_RxQueue_t *queue = &ctx->rx_queue;
+    uint16_t head;
+    uint16_t copied;
+    uint16_t chunk;
+    uint16_t first;
+
+    copied = MIN((uint16_t) (lookback->count - lookback->head), max);
+    memcpy(dst, &lookback->data[lookback->head], copied);
+    lookback->head += copied;
+
+    head = queue->cons.c.head;
+    chunk = MIN((uint16_t) (TACHO_LOAD_ACQUIRE(&queue->prod.p.tail) - head), (uint16_t) (max - copied));
+    if (0 < chunk)
     {
-        Tacho_CachedData.di[index] = di[index];
-        index++;
+        /* At most two copies around the end of the ring */
+        first = MIN(chunk, (uint16_t) (TACHO_RX_QUEUE_SIZE - (head & TACHO_RX_QUEUE_MASK)));
+
+        memcpy(&dst[copied], &queue->data[head & TACHO_RX_QUEUE_MASK], first);
+        memcpy(&dst[copied + first], queue->data, chunk - first);
+        copied += chunk;
+        TACHO_STORE_RELEASE(&queue->cons.c.head, (uint16_t) (head + chunk));
     }
+
+    return copied;
 }
 
+#endif
+
+#if (TACHO_CFG_WAKEUP == STD_ON)
+
 /**
- * Switches between tachograph standards
- * @param standard Specified tachograph standard
- * @param updateMemory Update FRAM memory with new Tachograph type
+ * Sets the reception buffer write index at which the task is woken (consumer side)
+ * Called once the task has taken every queued byte. Bytes received while
+ * the watermark is set may reach it before the producer can see it: the
+ * task is then woken from here.
+ * @param ctx Decoder context
  */
-static void Tacho_SelectStandard(Tacho_Standard_t standard, bool_t updateMemory)
+static void Tacho_WakeupArm(Tacho_Ctx_t *ctx)
 {
-    Tacho_ClearRxQueue();
+    Tacho_RxQueue_t *queue = &ctx->rx_queue;
+    uint16_t head = queue->cons.c.head;
+    uint16_t need = Tacho_WakeupNeed(ctx);
 
-    switch (standard)
+    TACHO_STORE_RELAXED(&queue->cons.c.wake_at, (uint16_t) (head + need));
+    TACHO_FENCE_FULL();
+    if ((uint16_t) (TACHO_LOAD_ACQUIRE(&queue->prod.p.tail) - head) >= need)
     {
-    case TACHO_STANDARD_VDO:
-        Tacho_SelectedStandard = TACHO_STANDARD_VDO;
-        Tacho_Proto = &Tacho_Protocol[TACHO_STANDARD_VDO];
-        Tacho_Handler = &Tacho_VdoHandler;
-        Tacho_VdoInitHandler();
-        break;
+        Tacho_Wakeup(ctx);
+    }
+}
 
-    case TACHO_STANDARD_STONERIDGE:
-        Tacho_SelectedStandard = TACHO_STANDARD_STONERIDGE;
-        Tacho_Proto = &Tacho_Protocol[TACHO_STANDARD_STONERIDGE];
-        Tacho_Handler = &Tacho_StoneridgeHandler;
-        Tacho_StoneridgeInitHandler();
-        break;
+/**
+ * Number of bytes the decoder needs before it can make progress
+ * In sync, the start sequence and the header up to the first byte the
+ * frame length depends on (VDO VIN length, Stoneridge message length and
+ * ID); in a frame, the rest of it once its length is resolved. The legacy
+ * byte-wise engines and a partly matched start sequence take every byte.
+ * @param ctx Decoder context
+ * @return Number of bytes, 1 to TACHO_RX_QUEUE_SIZE
+ */
+static uint16_t Tacho_WakeupNeed(Tacho_Ctx_t *ctx)
+{
+    uint16_t need = 1;
 
-    default:
-        break;
-    }
+#if (TACHO_CFG_VDO_BYTEWISE == STD_OFF) || (TACHO_CFG_SR_BYTEWISE == STD_OFF)
+    Tacho_RxFrame_t *rx_frame = &ctx->rx_frame;
 
-    if ( (NULL != Tacho_Proto) && (standard < TACHO_STANDARD_MAX) )
+    if ( (&Tacho_FrameHandler == ctx->handler) && (NULL_PTR != ctx->proto) )
     {
-        USART2_set_baudrate(Tacho_Proto->baudRate);
-        if (updateMemory)
+        if (FALSE == ctx->perform_sync)
+        {
+            need = (uint16_t) (rx_frame->needed - rx_frame->count);
+        }
+        else if (0 == ctx->sync_state)
         {
-            Tacho_SetMemory(standard);
+            /* rx_frame holds the start sequence only (Tacho_FrameInit()) */
+            need = Tacho_FrameLength(ctx->standard, rx_frame->data, ctx->proto->start_sz);
         }
     }
+#else
+    (void) ctx;
+#endif
+
+    if (0 == need)
+    {
+        need = 1;
+    }
+    return MIN(need, TACHO_RX_QUEUE_SIZE);
 }
 
 /**
- * Called each time a byte is received
- * @param rx_byte Byte value
+ * Calls the wakeup binding of a context
+ * @param ctx Decoder context
  */
-void Tacho_RxNotif(uint8_t rx_byte)
+static void Tacho_Wakeup(Tacho_Ctx_t *ctx)
 {
-    Tacho_QueueAddByte(rx_byte);
+    if ( (NULL_PTR != ctx->config) && (NULL_PTR != ctx->config->wakeup) )
+    {
+        ctx->config->wakeup(ctx);
+    }
 }
 
+#endif
+
+#if (TACHO_CFG_STATS == STD_ON)
+
 /**
- * Callead each time a framing error occurs
+ * Increments a decoder counter
+ * Only the decoder writes the counters, so a relaxed load and store are
+ * enough for readers on other threads to never see a torn value.
+ * @param ctx Decoder context
+ * @param id Counter
  */
-void Tacho_ErrorNotif(void)
+static void Tacho_StatInc(Tacho_Ctx_t *ctx, Tacho_StatCounter_t id)
 {
-    Tacho_RxQueue.error_counter++;
+    TACHO_STORE_RELAXED(&ctx->stats.counter[id], TACHO_LOAD_RELAXED(&ctx->stats.counter[id]) + 1);
 }
 
 /**
- * Clears the reception buffer
+ * Reads the timestamp binding of a context
+ * @param ctx Decoder context
+ * @return Current time, 0 if the context has no get_time binding
  */
-static void Tacho_ClearRxQueue(void)
+static uint32_t Tacho_StatTime(Tacho_Ctx_t *ctx)
 {
-    Tacho_RxQueue.count = 0;
-    Tacho_RxQueue.error_counter = 0;
-    Tacho_RxQueue.failed_attempts = 0;
-    Tacho_RxQueue.head = Tacho_RxQueue.buffer_start;
-    Tacho_RxQueue.tail = Tacho_RxQueue.buffer_start;
+    if ( (NULL_PTR != ctx->config) && (NULL_PTR != ctx->config->get_time) )
+    {
+        return ctx->config->get_time(ctx);
+    }
+    return 0;
 }
 
 /**
- * Add byte to reception buffer
- * @param rx_byte Byte value
- * @return TRUE if byte has been added successfully, FALSE otherwise
+ * Stamps the frames starting in a new reception block
+ * A frame continuing in the spill buffer keeps the stamp of the block it started in.
+ * @param ctx Decoder context
  */
-static bool_t Tacho_QueueAddByte(uint8_t rx_byte)
+static void Tacho_StatBlockStart(Tacho_Ctx_t *ctx)
 {
-    bool_t opSuccess = FALSE;
-
-    if (TACHO_RX_QUEUE_SIZE > Tacho_RxQueue.count)
+    if (0 == ctx->spill.count)
     {
-        opSuccess = TRUE;
-        Tacho_RxQueue.count++;
-        *Tacho_RxQueue.tail = rx_byte;
-        if (Tacho_RxQueue.buffer_end == Tacho_RxQueue.tail)
-        {
-            Tacho_RxQueue.tail = Tacho_RxQueue.buffer_start;
-        }
-        else
-        {
-            Tacho_RxQueue.tail++;
-        }
+        ctx->stats.frame_start = Tacho_StatTime(ctx);
     }
+}
 
-    return opSuccess;
+/**
+ * Called when a complete frame is handed to the decoder
+ * @param ctx Decoder context
+ */
+static void Tacho_StatDecodeStart(Tacho_Ctx_t *ctx)
+{
+    if (ctx->stats.lost)
+    {
+        ctx->stats.lost = FALSE;
+        Tacho_StatInc(ctx, TACHO_STAT_RESYNC);
+    }
+    ctx->stats.decode_start = Tacho_StatTime(ctx);
 }
 
 /**
- * Read & remove byte from reception buffer
- * @param byte_val[out] Holds the popped byte if dequeue is successful
- * @return TRUE if byte has been read/removed successfully, FALSE otherwise
+ * Called when a decoded frame is about to be notified
+ * @param ctx Decoder context
  */
-static bool_t Tacho_FetchByte(uint8_t *byte_val)
+static void Tacho_StatFrameDone(Tacho_Ctx_t *ctx)
 {
-    bool_t opSuccess = FALSE;
+    uint32_t now;
 
-    if (0 < Tacho_RxQueue.count)
+    Tacho_StatInc(ctx, TACHO_STAT_FRAMES);
+    if ( (NULL_PTR != ctx->config) && (NULL_PTR != ctx->config->get_time) )
     {
-        opSuccess = TRUE;
-        Tacho_RxQueue.count--;
-        *byte_val = *Tacho_RxQueue.head;
+        now = ctx->config->get_time(ctx);
+        Tacho_StatRecord(ctx->stats.decode_time, now - ctx->stats.decode_start);
+        Tacho_StatRecord(ctx->stats.latency, now - ctx->stats.frame_start);
+    }
+}
 
-        if (Tacho_RxQueue.buffer_end == Tacho_RxQueue.head)
-        {
-            Tacho_RxQueue.head = Tacho_RxQueue.buffer_start;
-        }
-        else
+/**
+ * Counts a frame rejected by Tacho_FrameLength()
+ * @param ctx Decoder context
+ * @param frame[in] Frame bytes, starting with the start sequence
+ * @param avail Number of bytes available in frame
+ */
+static void Tacho_StatBadHeader(Tacho_Ctx_t *ctx, const uint8_t *frame, uint16_t avail)
+{
+    uint8_t msg_len;
+
+    if ( (TACHO_STANDARD_STONERIDGE == ctx->standard) && (avail > TACHO_SR_MSG_LEN) )
+    {
+        msg_len = frame[TACHO_SR_MSG_LEN];
+        if ( (msg_len >= TACHO_SR_MSG_LEN_MIN) && (msg_len <= TACHO_SR_MSG_LEN_MAX) )
         {
-            Tacho_RxQueue.head++;
+            Tacho_StatInc(ctx, TACHO_STAT_BAD_MSG_ID);
+            return;
         }
     }
+    Tacho_StatInc(ctx, TACHO_STAT_BAD_LENGTH);
+}
 
-    return opSuccess;
+/**
+ * Adds a duration to a log2-bucketed histogram
+ * @param hist[inout] TACHO_HIST_BUCKETS buckets
+ * @param ticks Duration
+ */
+static void Tacho_StatRecord(volatile uint32_t *hist, uint32_t ticks)
+{
+    uint8_t bucket = 0;
+
+    while ( (0 != ticks) && (bucket < (TACHO_HIST_BUCKETS - 1)) )
+    {
+        ticks >>= 1;
+        bucket++;
+    }
+    TACHO_STORE_RELAXED(&hist[bucket], TACHO_LOAD_RELAXED(&hist[bucket]) + 1);
 }
+
+#endif
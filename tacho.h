@@ -19,6 +19,14 @@
 /** Size of DI field in bytes */
 #define TACHO_MAX_DI_MSG (2 * TACHO_MAX_DRIVER_ID + 1)
 
+/**
+ * Default context bound to UART2, FRAM, FMI and J1939 (STD_ON), or to no
+ * platform service at all (STD_OFF, e.g. host builds)
+ */
+#ifndef TACHO_CFG_HW_BINDINGS
+#define TACHO_CFG_HW_BINDINGS STD_ON
+#endif
+
 /******************************************************************************/
 /*    PUBLIC TYPES                                                            */
 /******************************************************************************/
@@ -45,12 +53,21 @@ typedef enum
     TACHO_STANDARD_MAX
 } Tacho_Standard_t;
 
+/* Defined in tacho_ctx.h */
+struct Tacho_Snapshot;
+struct Tacho_Stats;
+struct Tacho_HistFrame;
+struct Tacho_DrivingTime;
+
 /******************************************************************************/
 /*    PUBLIC FUNCTIONS                                                        */
 /******************************************************************************/
 
+#if (TACHO_CFG_HW_BINDINGS == STD_ON)
 void Tacho_process_j1939_event(uint8_t event);
+#endif
 void Tacho_process_j1939_di(uint8_t *di);
+void Tacho_CanRx(uint32_t id, const uint8_t *data, uint8_t dlc);
 uint8_t *tacho_get_cached_tco1_content_p(void);
 uint8_t *tacho_get_cached_di_content_p(void);
 
@@ -58,7 +75,16 @@ void Tacho_Init(void);
 void Tacho_DeInit(void);
 void Tacho_Task(void);
 void Tacho_RxNotif(uint8_t rx_byte);
+void Tacho_RxBlock(const uint8_t *buf, uint32_t len);
 void Tacho_ErrorNotif(void);
 Tacho_Standard_t Tacho_GetSelectedStandard(void);
+uint32_t Tacho_GetDroppedBytes(void);
+Std_ReturnType Tacho_ReadSnapshot(struct Tacho_Snapshot *out);
+Std_ReturnType Tacho_GetStats(struct Tacho_Stats *out);
+uint16_t Tacho_PopFrames(struct Tacho_HistFrame *out, uint16_t max);
+uint8_t Tacho_GetDrivingTimes(struct Tacho_DrivingTime *out, uint8_t max);
+uint32_t Tacho_FindFrame(Tacho_Standard_t standard, const uint8_t *buf, uint32_t len);
+uint32_t Tacho_DetectFrame(const uint8_t *buf, uint32_t len, Tacho_Standard_t *standard);
+uint16_t Tacho_ValidFrameLength(Tacho_Standard_t standard, const uint8_t *buf, uint32_t len);
 
 #endif	/* TACHO_H */
@@ -0,0 +1,61 @@
+/**
+ * @file tacho_atomic.h
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Tachograph interpreter - memory ordering primitives
+ *
+ * Used for data shared between the reception path (UART interrupt or
+ * producer thread) and the decoder task. On targets without the GCC
+ * __atomic builtins (e.g. single-core PIC24) volatile accesses plus a
+ * compiler barrier are sufficient.
+ */
+
+#ifndef TACHO_ATOMIC_H
+#define	TACHO_ATOMIC_H
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#if defined(__ATOMIC_ACQUIRE)
+
+#define TACHO_LOAD_RELAXED(_p) __atomic_load_n((_p), __ATOMIC_RELAXED)
+#define TACHO_LOAD_ACQUIRE(_p) __atomic_load_n((_p), __ATOMIC_ACQUIRE)
+#define TACHO_STORE_RELAXED(_p,_v) __atomic_store_n((_p), (_v), __ATOMIC_RELAXED)
+#define TACHO_STORE_RELEASE(_p,_v) __atomic_store_n((_p), (_v), __ATOMIC_RELEASE)
+#define TACHO_FENCE_ACQUIRE() __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#define TACHO_FENCE_RELEASE() __atomic_thread_fence(__ATOMIC_RELEASE)
+#define TACHO_FENCE_FULL() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+#else
+
+#if defined(__GNUC__)
+#define TACHO_COMPILER_BARRIER() __asm__ __volatile__ ("" ::: "memory")
+#else
+#define TACHO_COMPILER_BARRIER()
+#endif
+
+#define TACHO_LOAD_RELAXED(_p) (*(_p))
+#define TACHO_LOAD_ACQUIRE(_p) Tacho_LoadAcquire16(_p)
+#define TACHO_STORE_RELAXED(_p,_v) (*(_p) = (_v))
+#define TACHO_STORE_RELEASE(_p,_v) do { TACHO_COMPILER_BARRIER(); *(_p) = (_v); } while (0)
+#define TACHO_FENCE_ACQUIRE() TACHO_COMPILER_BARRIER()
+#define TACHO_FENCE_RELEASE() TACHO_COMPILER_BARRIER()
+#define TACHO_FENCE_FULL() TACHO_COMPILER_BARRIER()
+
+/**
+ * Acquire load of a 16-bit value (single-core fallback)
+ * @param p Pointer to the shared value
+ * @return Loaded value
+ */
+static inline uint16_t Tacho_LoadAcquire16(volatile const uint16_t *p)
+{
+    uint16_t value = *p;
+    TACHO_COMPILER_BARRIER();
+    return value;
+}
+
+#endif
+
+#endif	/* TACHO_ATOMIC_H */
@@ -0,0 +1,330 @@
+/**
+ * @file tacho_checksum.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Tachograph frame checksums (VDO XOR, Stoneridge sum) and the CRC-16 of
+ * persisted data
+ *
+ * Both checksums are byte-wise reductions, so they are computed over as many
+ * bytes per iteration as the target allows; the remaining tail is handled
+ * one byte at a time.
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#include <string.h>
+#include "std_types.h"
+#include "tacho_checksum.h"
+
+#if (TACHO_CFG_CHECKSUM_KERNEL == TACHO_CHECKSUM_KERNEL_SSE2)
+#include <emmintrin.h>
+#elif (TACHO_CFG_CHECKSUM_KERNEL == TACHO_CHECKSUM_KERNEL_NEON)
+#include <arm_neon.h>
+#endif
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+/** Words summed before the 16-bit lanes of the word kernel could overflow */
+#define TACHO_CHECKSUM_WORD_BATCH 128
+
+/******************************************************************************/
+/*    PRIVATE FUNCTIONS                                                       */
+/******************************************************************************/
+
+static uint8_t Tacho_XorBulk(const uint8_t **buf, uint32_t *len);
+static uint8_t Tacho_SumBulk(const uint8_t **buf, uint32_t *len);
+
+/******************************************************************************/
+/*    PRIVATE DATA                                                            */
+/******************************************************************************/
+
+/** CRC-16/CCITT remainders of the 16 values of a nibble */
+static const uint16_t Tacho_Crc16Nibble[16] =
+{
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+/**
+ * XOR of all bytes in a buffer (VDO frame checksum)
+ * @param buf[in] Data
+ * @param len Number of bytes
+ * @param init Initial checksum value
+ * @return init XOR buf[0] XOR ... XOR buf[len - 1]
+ */
+uint8_t Tacho_ChecksumXor(const uint8_t *buf, uint32_t len, uint8_t init)
+{
+    uint8_t value = init;
+
+    value ^= Tacho_XorBulk(&buf, &len);
+    while (0 < len)
+    {
+        value ^= *buf++;
+        len--;
+    }
+
+    return value;
+}
+
+/**
+ * Modulo-256 sum of all bytes in a buffer (Stoneridge frame checksum before negation)
+ * @param buf[in] Data
+ * @param len Number of bytes
+ * @param init Initial checksum value
+ * @return (init + buf[0] + ... + buf[len - 1]) mod 256
+ */
+uint8_t Tacho_ChecksumSum(const uint8_t *buf, uint32_t len, uint8_t init)
+{
+    uint8_t value = init;
+
+    value += Tacho_SumBulk(&buf, &len);
+    while (0 < len)
+    {
+        value += *buf++;
+        len--;
+    }
+
+    return value;
+}
+
+/**
+ * CRC-16/CCITT (polynomial 0x1021, MSB first) of a buffer
+ * Computed a nibble at a time: persisted records are small and rarely
+ * written, so a 16-entry table is enough.
+ * @param buf[in] Data
+ * @param len Number of bytes
+ * @param init Initial CRC (0xFFFF, or the CRC of the preceding data)
+ * @return CRC of buf
+ */
+uint16_t Tacho_ChecksumCrc16(const uint8_t *buf, uint32_t len, uint16_t init)
+{
+    uint16_t crc = init;
+
+    while (0 < len)
+    {
+        crc = (uint16_t) ((crc << 4) ^ Tacho_Crc16Nibble[(crc >> 12) ^ (*buf >> 4)]);
+        crc = (uint16_t) ((crc << 4) ^ Tacho_Crc16Nibble[(crc >> 12) ^ (*buf & 0x0F)]);
+        buf++;
+        len--;
+    }
+
+    return crc;
+}
+
+#if (TACHO_CFG_CHECKSUM_KERNEL == TACHO_CHECKSUM_KERNEL_SSE2)
+
+/**
+ * XOR-reduces the largest multiple of 16 bytes of a buffer
+ * @param buf[inout] Data, advanced past the processed bytes
+ * @param len[inout] Number of bytes, decreased by the processed bytes
+ * @return XOR of the processed bytes
+ */
+static uint8_t Tacho_XorBulk(const uint8_t **buf, uint32_t *len)
+{
+    const uint8_t *p = *buf;
+    uint32_t n = *len;
+    __m128i acc = _mm_setzero_si128();
+
+    for (; n >= 16; n -= 16, p += 16)
+    {
+        acc = _mm_xor_si128(acc, _mm_loadu_si128((const __m128i *) p));
+    }
+    acc = _mm_xor_si128(acc, _mm_srli_si128(acc, 8));
+    acc = _mm_xor_si128(acc, _mm_srli_si128(acc, 4));
+    acc = _mm_xor_si128(acc, _mm_srli_si128(acc, 2));
+    acc = _mm_xor_si128(acc, _mm_srli_si128(acc, 1));
+
+    *buf = p;
+    *len = n;
+    return (uint8_t) _mm_cvtsi128_si32(acc);
+}
+
+/**
+ * Sums the largest multiple of 16 bytes of a buffer
+ * @param buf[inout] Data, advanced past the processed bytes
+ * @param len[inout] Number of bytes, decreased by the processed bytes
+ * @return Modulo-256 sum of the processed bytes
+ */
+static uint8_t Tacho_SumBulk(const uint8_t **buf, uint32_t *len)
+{
+    const uint8_t *p = *buf;
+    uint32_t n = *len;
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc = _mm_setzero_si128();
+
+    for (; n >= 16; n -= 16, p += 16)
+    {
+        /* Sum of absolute differences against zero = sum of 8 bytes per 64-bit lane */
+        acc = _mm_add_epi64(acc, _mm_sad_epu8(_mm_loadu_si128((const __m128i *) p), zero));
+    }
+
+    *buf = p;
+    *len = n;
+    return (uint8_t) (_mm_cvtsi128_si32(acc) + _mm_cvtsi128_si32(_mm_srli_si128(acc, 8)));
+}
+
+#elif (TACHO_CFG_CHECKSUM_KERNEL == TACHO_CHECKSUM_KERNEL_NEON)
+
+/**
+ * XOR-reduces the largest multiple of 16 bytes of a buffer
+ * @param buf[inout] Data, advanced past the processed bytes
+ * @param len[inout] Number of bytes, decreased by the processed bytes
+ * @return XOR of the processed bytes
+ */
+static uint8_t Tacho_XorBulk(const uint8_t **buf, uint32_t *len)
+{
+    const uint8_t *p = *buf;
+    uint32_t n = *len;
+    uint8x16_t acc = vdupq_n_u8(0);
+    uint8_t lanes[16];
+    uint8_t value = 0;
+    uint8_t i;
+
+    for (; n >= 16; n -= 16, p += 16)
+    {
+        acc = veorq_u8(acc, vld1q_u8(p));
+    }
+    vst1q_u8(lanes, acc);
+    for (i = 0; i < 16; i++)
+    {
+        value ^= lanes[i];
+    }
+
+    *buf = p;
+    *len = n;
+    return value;
+}
+
+/**
+ * Sums the largest multiple of 16 bytes of a buffer
+ * @param buf[inout] Data, advanced past the processed bytes
+ * @param len[inout] Number of bytes, decreased by the processed bytes
+ * @return Modulo-256 sum of the processed bytes
+ */
+static uint8_t Tacho_SumBulk(const uint8_t **buf, uint32_t *len)
+{
+    const uint8_t *p = *buf;
+    uint32_t n = *len;
+    uint16x8_t acc = vdupq_n_u16(0);
+    uint16_t lanes[8];
+    uint8_t value = 0;
+    uint8_t i;
+
+    for (; n >= 16; n -= 16, p += 16)
+    {
+        /* Lanes wrap modulo 65536, which keeps the modulo-256 sum intact */
+        acc = vpadalq_u8(acc, vld1q_u8(p));
+    }
+    vst1q_u16(lanes, acc);
+    for (i = 0; i < 8; i++)
+    {
+        value += (uint8_t) lanes[i];
+    }
+
+    *buf = p;
+    *len = n;
+    return value;
+}
+
+#elif (TACHO_CFG_CHECKSUM_KERNEL == TACHO_CHECKSUM_KERNEL_WORD)
+
+/**
+ * XOR-reduces the largest multiple of 4 bytes of a buffer
+ * @param buf[inout] Data, advanced past the processed bytes
+ * @param len[inout] Number of bytes, decreased by the processed bytes
+ * @return XOR of the processed bytes
+ */
+static uint8_t Tacho_XorBulk(const uint8_t **buf, uint32_t *len)
+{
+    const uint8_t *p = *buf;
+    uint32_t n = *len;
+    uint32_t acc = 0;
+    uint32_t word;
+
+    for (; n >= sizeof(word); n -= sizeof(word), p += sizeof(word))
+    {
+        memcpy(&word, p, sizeof(word));
+        acc ^= word;
+    }
+    acc ^= acc >> 16;
+    acc ^= acc >> 8;
+
+    *buf = p;
+    *len = n;
+    return (uint8_t) acc;
+}
+
+/**
+ * Sums the largest multiple of 4 bytes of a buffer
+ * Even and odd bytes are accumulated in separate 16-bit lanes, which are
+ * folded before they can carry into each other.
+ * @param buf[inout] Data, advanced past the processed bytes
+ * @param len[inout] Number of bytes, decreased by the processed bytes
+ * @return Modulo-256 sum of the processed bytes
+ */
+static uint8_t Tacho_SumBulk(const uint8_t **buf, uint32_t *len)
+{
+    const uint8_t *p = *buf;
+    uint32_t n = *len;
+    uint32_t acc;
+    uint32_t word;
+    uint8_t value = 0;
+    uint8_t batch;
+
+    while (n >= sizeof(word))
+    {
+        acc = 0;
+        for (batch = 0; (batch < TACHO_CHECKSUM_WORD_BATCH) && (n >= sizeof(word)); batch++)
+        {
+            memcpy(&word, p, sizeof(word));
+            acc += word & 0x00FF00FFUL;
+            acc += (word >> 8) & 0x00FF00FFUL;
+            n -= sizeof(word);
+            p += sizeof(word);
+        }
+        value += (uint8_t) (acc + (acc >> 16));
+    }
+
+    *buf = p;
+    *len = n;
+    return value;
+}
+
+#else
+
+/**
+ * No bulk processing - everything is left to the byte loop
+ * @param buf[inout] Data
+ * @param len[inout] Number of bytes
+ * @return 0
+ */
+static uint8_t Tacho_XorBulk(const uint8_t **buf, uint32_t *len)
+{
+    (void) buf;
+    (void) len;
+    return 0;
+}
+
+/**
+ * No bulk processing - everything is left to the byte loop
+ * @param buf[inout] Data
+ * @param len[inout] Number of bytes
+ * @return 0
+ */
+static uint8_t Tacho_SumBulk(const uint8_t **buf, uint32_t *len)
+{
+    (void) buf;
+    (void) len;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,42 @@
+/**
+ * @file tacho_checksum.h
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Tachograph frame checksums (VDO XOR, Stoneridge sum)
+ */
+
+#ifndef TACHO_CHECKSUM_H
+#define	TACHO_CHECKSUM_H
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#define TACHO_CHECKSUM_KERNEL_SCALAR 0  /**< One byte per iteration */
+#define TACHO_CHECKSUM_KERNEL_WORD 1  /**< 32-bit word per iteration */
+#define TACHO_CHECKSUM_KERNEL_SSE2 2  /**< 16 bytes per iteration (x86) */
+#define TACHO_CHECKSUM_KERNEL_NEON 3  /**< 16 bytes per iteration (ARM) */
+
+/** Checksum kernel, picked from the target capabilities unless overridden */
+#ifndef TACHO_CFG_CHECKSUM_KERNEL
+#if defined(__SSE2__)
+#define TACHO_CFG_CHECKSUM_KERNEL TACHO_CHECKSUM_KERNEL_SSE2
+#elif defined(__ARM_NEON)
+#define TACHO_CFG_CHECKSUM_KERNEL TACHO_CHECKSUM_KERNEL_NEON
+#elif defined(__XC16__)
+#define TACHO_CFG_CHECKSUM_KERNEL TACHO_CHECKSUM_KERNEL_SCALAR
+#else
+#define TACHO_CFG_CHECKSUM_KERNEL TACHO_CHECKSUM_KERNEL_WORD
+#endif
+#endif
+
+/******************************************************************************/
+/*    PUBLIC FUNCTIONS                                                        */
+/******************************************************************************/
+
+uint8_t Tacho_ChecksumXor(const uint8_t *buf, uint32_t len, uint8_t init);
+uint8_t Tacho_ChecksumSum(const uint8_t *buf, uint32_t len, uint8_t init);
+uint16_t Tacho_ChecksumCrc16(const uint8_t *buf, uint32_t len, uint16_t init);
+
+#endif	/* TACHO_CHECKSUM_H */
@@ -0,0 +1,674 @@
+/**
+ * @file tacho_column.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Columnar storage of decoded frames
+ *
+ * Driver IDs are stored once per block in a dictionary; the driver columns
+ * hold dictionary indexes. A driver is considered present when the first
+ * byte of its card number is not zero.
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#include <string.h>
+#include "std_types.h"
+#include "tacho_countries.h"
+#include "tacho.h"
+#include "tacho_d8.h"
+#include "tacho_ctx.h"
+#include "tacho_column.h"
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#define TACHO_COLUMN_HEADER_SIZE 6  /**< Magic, version, number of columns, number of frames */
+#define TACHO_COLUMN_DIN_SIZE (TACHO_MAX_COUNTRY_CODE + TACHO_MAX_CARD_NR)  /**< Dictionary entry size */
+
+/******************************************************************************/
+/*    PRIVATE TYPES                                                           */
+/******************************************************************************/
+
+/** Output buffer of the block writer */
+typedef struct
+{
+    uint8_t *out;  /**< Block being written */
+    uint32_t size;  /**< Size of out */
+    uint32_t pos;  /**< Next byte to write */
+    bool_t ok;  /**< FALSE once a write did not fit */
+} Tacho_ColumnWriter_t;
+
+/** Dictionary of the driver IDs of a block */
+typedef struct
+{
+    const Tacho_DriverID_t *entry[TACHO_COLUMN_MAX_DINS];  /**< Distinct driver IDs, in order of appearance */
+    uint8_t count;  /**< Number of entries */
+} Tacho_ColumnDict_t;
+
+/** Reading position in a column */
+typedef struct
+{
+    const uint8_t *pos;  /**< Next run */
+    const uint8_t *end;  /**< End of the column */
+    uint32_t value;  /**< Last value returned */
+    uint32_t delta;  /**< Delta of the current run */
+    uint32_t run;  /**< Values left in the current run */
+} Tacho_ColumnCursor_t;
+
+/******************************************************************************/
+/*    PRIVATE FUNCTIONS                                                       */
+/******************************************************************************/
+
+static bool_t Tacho_ColumnDinPresent(const Tacho_DriverID_t *driver);
+static uint8_t Tacho_ColumnDinIndex(Tacho_ColumnDict_t *dict, const Tacho_DriverID_t *driver, bool_t add);
+static uint32_t Tacho_ColumnValue(const Tacho_HistFrame_t *frame, Tacho_ColumnId_t id, Tacho_ColumnDict_t *dict);
+static void Tacho_ColumnStore(const Tacho_ColumnBlock_t *block, Tacho_HistFrame_t *frame, Tacho_ColumnId_t id, uint32_t value);
+static void Tacho_ColumnPutByte(Tacho_ColumnWriter_t *writer, uint8_t value);
+static void Tacho_ColumnPutVarint(Tacho_ColumnWriter_t *writer, uint32_t value);
+static void Tacho_ColumnPutRun(Tacho_ColumnWriter_t *writer, uint32_t delta, uint32_t run);
+static uint32_t Tacho_ColumnGetU32(const uint8_t *buf);
+static bool_t Tacho_ColumnGetVarint(const uint8_t **pos, const uint8_t *end, uint32_t *value);
+static void Tacho_ColumnCursorInit(const Tacho_ColumnBlock_t *block, Tacho_ColumnId_t id, Tacho_ColumnCursor_t *cursor);
+static bool_t Tacho_ColumnCursorNext(Tacho_ColumnCursor_t *cursor, uint32_t *value);
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+/**
+ * Writes frames as one columnar block
+ * @param frames[in] Frames, oldest first
+ * @param count Number of frames
+ * @param out[out] Block
+ * @param size Size of out
+ * @return Size of the block, 0 if it does not fit in out or the frames
+ *  carry more than TACHO_COLUMN_MAX_DINS distinct driver IDs
+ */
+uint32_t Tacho_ColumnWrite(const Tacho_HistFrame_t *frames, uint16_t count, uint8_t *out, uint32_t size)
+{
+    Tacho_ColumnWriter_t writer;
+    Tacho_ColumnDict_t dict;
+    uint32_t dir;
+    uint32_t start;
+    uint32_t value;
+    uint32_t prev;
+    uint32_t delta;
+    uint32_t run;
+    uint16_t i;
+    uint8_t d;
+    uint8_t id;
+
+    /* Dictionary first, so that the driver columns can refer to it */
+    dict.count = 0;
+    for (i = 0; i < count; i++)
+    {
+        for (d = 0; d < TACHO_MAX_DRIVERS; d++)
+        {
+            if ( Tacho_ColumnDinPresent(&frames[i].driver[d]) &&
+                 (TACHO_COLUMN_NO_DIN == Tacho_ColumnDinIndex(&dict, &frames[i].driver[d], TRUE)) )
+            {
+                return 0;
+            }
+        }
+    }
+
+    writer.out = out;
+    writer.size = size;
+    writer.pos = 0;
+    writer.ok = TRUE;
+
+    Tacho_ColumnPutByte(&writer, 'T');
+    Tacho_ColumnPutByte(&writer, 'C');
+    Tacho_ColumnPutByte(&writer, TACHO_COLUMN_VERSION);
+    Tacho_ColumnPutByte(&writer, TACHO_COLUMN_COUNT);
+    Tacho_ColumnPutByte(&writer, (uint8_t) count);
+    Tacho_ColumnPutByte(&writer, (uint8_t) (count >> 8));
+    dir = writer.pos;
+    for (i = 0; i < (4 * TACHO_COLUMN_COUNT); i++)
+    {
+        Tacho_ColumnPutByte(&writer, 0);
+    }
+
+    for (id = 0; id < TACHO_COLUMN_COUNT; id++)
+    {
+        start = writer.pos;
+        if (TACHO_COLUMN_DIN_DICT == id)
+        {
+            for (d = 0; d < dict.count; d++)
+            {
+                for (i = 0; i < TACHO_MAX_COUNTRY_CODE; i++)
+                {
+                    Tacho_ColumnPutByte(&writer, dict.entry[d]->country[i]);
+                }
+                for (i = 0; i < TACHO_MAX_CARD_NR; i++)
+                {
+                    Tacho_ColumnPutByte(&writer, dict.entry[d]->cardnr[i]);
+                }
+            }
+        }
+        else
+        {
+            /* Runs of equal deltas */
+            prev = 0;
+            delta = 0;
+            run = 0;
+            for (i = 0; i < count; i++)
+            {
+                value = Tacho_ColumnValue(&frames[i], (Tacho_ColumnId_t) id, &dict);
+                if ( (0 < run) && ((uint32_t) (value - prev) != delta) )
+                {
+                    Tacho_ColumnPutRun(&writer, delta, run);
+                    run = 0;
+                }
+                delta = value - prev;
+                prev = value;
+                run++;
+            }
+            if (0 < run)
+            {
+                Tacho_ColumnPutRun(&writer, delta, run);
+            }
+        }
+
+        if (FALSE == writer.ok)
+        {
+            return 0;
+        }
+        value = writer.pos - start;
+        out[dir++] = (uint8_t) value;
+        out[dir++] = (uint8_t) (value >> 8);
+        out[dir++] = (uint8_t) (value >> 16);
+        out[dir++] = (uint8_t) (value >> 24);
+    }
+
+    return writer.pos;
+}
+
+/**
+ * Opens a block for reading
+ * Columns appended by a later format version are skipped.
+ * @param buf[in] Block (must stay valid while the block is read)
+ * @param size Number of bytes available in buf
+ * @param block[out] Opened block
+ * @return E_OK, E_NOT_OK if buf does not start with a valid block
+ */
+Std_ReturnType Tacho_ColumnOpen(const uint8_t *buf, uint32_t size, Tacho_ColumnBlock_t *block)
+{
+    uint32_t pos;
+    uint32_t column_size;
+    uint8_t columns;
+    uint8_t id;
+
+    if ( (TACHO_COLUMN_HEADER_SIZE > size) || ('T' != buf[0]) || ('C' != buf[1]) ||
+         (TACHO_COLUMN_VERSION != buf[2]) || (TACHO_COLUMN_COUNT > buf[3]) )
+    {
+        return E_NOT_OK;
+    }
+    columns = buf[3];
+    pos = TACHO_COLUMN_HEADER_SIZE + (4U * columns);
+    if (pos > size)
+    {
+        return E_NOT_OK;
+    }
+
+    block->count = (uint16_t) (buf[4] | ((uint16_t) buf[5] << 8));
+    for (id = 0; id < columns; id++)
+    {
+        column_size = Tacho_ColumnGetU32(&buf[TACHO_COLUMN_HEADER_SIZE + (4U * id)]);
+        if (column_size > (size - pos))
+        {
+            return E_NOT_OK;
+        }
+        if (id < TACHO_COLUMN_COUNT)
+        {
+            block->column[id] = &buf[pos];
+            block->column_size[id] = column_size;
+        }
+        pos += column_size;
+    }
+    block->size = pos;
+
+    return E_OK;
+}
+
+/**
+ * Decodes one column of a block without touching the other ones
+ * @param block[in] Opened block
+ * @param id Column to decode (any but TACHO_COLUMN_DIN_DICT)
+ * @param out[out] One value per frame
+ * @param max Capacity of out
+ * @return Number of values decoded (less than the number of frames if max
+ *  is too small or the column is damaged)
+ */
+uint16_t Tacho_ColumnRead(const Tacho_ColumnBlock_t *block, Tacho_ColumnId_t id, uint32_t *out, uint16_t max)
+{
+    Tacho_ColumnCursor_t cursor;
+    uint16_t limit = MIN(block->count, max);
+    uint16_t i;
+
+    if (TACHO_COLUMN_DIN_DICT <= id)
+    {
+        return 0;
+    }
+
+    Tacho_ColumnCursorInit(block, id, &cursor);
+    for (i = 0; i < limit; i++)
+    {
+        if (FALSE == Tacho_ColumnCursorNext(&cursor, &out[i]))
+        {
+            break;
+        }
+    }
+
+    return i;
+}
+
+/**
+ * Driver ID of a block's dictionary
+ * @param block[in] Opened block
+ * @param index Value of a driver column
+ * @param driver[out] Driver ID (zeroed for TACHO_COLUMN_NO_DIN)
+ * @return E_OK, E_NOT_OK if index is not in the dictionary
+ */
+Std_ReturnType Tacho_ColumnGetDin(const Tacho_ColumnBlock_t *block, uint8_t index, Tacho_DriverID_t *driver)
+{
+    const uint8_t *entry;
+
+    if (TACHO_COLUMN_NO_DIN == index)
+    {
+        memset(driver, 0, sizeof(*driver));
+        return E_OK;
+    }
+    if ( ((uint32_t) (index + 1) * TACHO_COLUMN_DIN_SIZE) > block->column_size[TACHO_COLUMN_DIN_DICT] )
+    {
+        return E_NOT_OK;
+    }
+
+    entry = &block->column[TACHO_COLUMN_DIN_DICT][(uint32_t) index * TACHO_COLUMN_DIN_SIZE];
+    memcpy(driver->country, entry, TACHO_MAX_COUNTRY_CODE);
+    memcpy(driver->cardnr, &entry[TACHO_MAX_COUNTRY_CODE], TACHO_MAX_CARD_NR);
+    return E_OK;
+}
+
+/**
+ * Rebuilds the frames of a block
+ * @param block[in] Opened block
+ * @param out[out] Frames, oldest first
+ * @param max Capacity of out
+ * @return Number of frames rebuilt (less than the number of frames if max
+ *  is too small or a column is damaged)
+ */
+uint16_t Tacho_ColumnDecode(const Tacho_ColumnBlock_t *block, Tacho_HistFrame_t *out, uint16_t max)
+{
+    Tacho_ColumnCursor_t cursor;
+    uint16_t limit = MIN(block->count, max);
+    uint32_t value;
+    uint16_t i;
+    uint8_t id;
+
+    memset(out, 0, (size_t) limit * sizeof(*out));
+    for (id = 0; id < TACHO_COLUMN_DIN_DICT; id++)
+    {
+        Tacho_ColumnCursorInit(block, (Tacho_ColumnId_t) id, &cursor);
+        for (i = 0; i < limit; i++)
+        {
+            if (FALSE == Tacho_ColumnCursorNext(&cursor, &value))
+            {
+                limit = i;
+                break;
+            }
+            Tacho_ColumnStore(block, &out[i], (Tacho_ColumnId_t) id, value);
+        }
+    }
+
+    return limit;
+}
+
+/**
+ * Checks whether a driver card is inserted
+ * @param driver[in] Driver ID
+ * @return TRUE if the card number is not empty
+ */
+static bool_t Tacho_ColumnDinPresent(const Tacho_DriverID_t *driver)
+{
+    return (bool_t) (0 != driver->cardnr[0]);
+}
+
+/**
+ * Looks up a driver ID in a block dictionary
+ * @param dict Dictionary
+ * @param driver[in] Driver ID
+ * @param add TRUE to add the driver ID if it is not found
+ * @return Index of the driver ID, TACHO_COLUMN_NO_DIN if not found (or the
+ *  dictionary is full)
+ */
+static uint8_t Tacho_ColumnDinIndex(Tacho_ColumnDict_t *dict, const Tacho_DriverID_t *driver, bool_t add)
+{
+    uint8_t i;
+
+    for (i = 0; i < dict->count; i++)
+    {
+        if (0 == memcmp(dict->entry[i], driver, sizeof(*driver)))
+        {
+            return i;
+        }
+    }
+    if ( (FALSE == add) || (TACHO_COLUMN_MAX_DINS <= dict->count) )
+    {
+        return TACHO_COLUMN_NO_DIN;
+    }
+
+    dict->entry[dict->count] = driver;
+    return dict->count++;
+}
+
+/**
+ * Value of a frame field as stored in its column
+ * @param frame[in] Frame
+ * @param id Column
+ * @param dict Dictionary of the block
+ * @return Column value
+ */
+static uint32_t Tacho_ColumnValue(const Tacho_HistFrame_t *frame, Tacho_ColumnId_t id, Tacho_ColumnDict_t *dict)
+{
+    uint32_t value = 0;
+
+    switch (id)
+    {
+    case TACHO_COLUMN_STAMP:
+        value = frame->stamp;
+        break;
+
+    case TACHO_COLUMN_SEQ:
+        value = frame->seq;
+        break;
+
+    case TACHO_COLUMN_STANDARD:
+        value = frame->standard;
+        break;
+
+    case TACHO_COLUMN_WORKING_STATE:
+    case TACHO_COLUMN_DRV1_STATE:
+    case TACHO_COLUMN_DRV2_STATE:
+    case TACHO_COLUMN_STATUS:
+    case TACHO_COLUMN_RB4:
+    case TACHO_COLUMN_RB5:
+        value = frame->tco1[TACHO_TCO1_WORKING_STATE + (id - TACHO_COLUMN_WORKING_STATE)];
+        break;
+
+    case TACHO_COLUMN_SPEED:
+        value = frame->tco1[TACHO_TCO1_SPEED_LSB] | ((uint32_t) frame->tco1[TACHO_TCO1_SPEED_MSB] << 8);
+        break;
+
+    case TACHO_COLUMN_DRIVER1:
+    case TACHO_COLUMN_DRIVER2:
+        value = TACHO_COLUMN_NO_DIN;
+        if (Tacho_ColumnDinPresent(&frame->driver[id - TACHO_COLUMN_DRIVER1]))
+        {
+            value = Tacho_ColumnDinIndex(dict, &frame->driver[id - TACHO_COLUMN_DRIVER1], FALSE);
+        }
+        break;
+
+    case TACHO_COLUMN_TIME:
+        value = frame->time.seconds | ((uint32_t) frame->time.minutes << 8) | ((uint32_t) frame->time.hours << 16);
+        break;
+
+    case TACHO_COLUMN_DATE:
+        value = frame->time.month | ((uint32_t) frame->time.day << 8) | ((uint32_t) frame->time.year << 16);
+        break;
+
+    case TACHO_COLUMN_OFFSET:
+        value = frame->time.local_min_offset | ((uint32_t) frame->time.local_hour_offset << 8);
+        break;
+
+    case TACHO_COLUMN_ODOMETER:
+        value = frame->odometer;
+        break;
+
+    case TACHO_COLUMN_TRIP:
+        value = frame->trip;
+        break;
+
+    default:
+        break;
+    }
+
+    return value;
+}
+
+/**
+ * Stores a column value into the corresponding frame field
+ * @param block[in] Block the value comes from (for the DIN dictionary)
+ * @param frame[out] Frame
+ * @param id Column
+ * @param value Column value
+ */
+static void Tacho_ColumnStore(const Tacho_ColumnBlock_t *block, Tacho_HistFrame_t *frame, Tacho_ColumnId_t id, uint32_t value)
+{
+    switch (id)
+    {
+    case TACHO_COLUMN_STAMP:
+        frame->stamp = value;
+        break;
+
+    case TACHO_COLUMN_SEQ:
+        frame->seq = (uint16_t) value;
+        break;
+
+    case TACHO_COLUMN_STANDARD:
+        frame->standard = (uint8_t) value;
+        break;
+
+    case TACHO_COLUMN_WORKING_STATE:
+    case TACHO_COLUMN_DRV1_STATE:
+    case TACHO_COLUMN_DRV2_STATE:
+    case TACHO_COLUMN_STATUS:
+    case TACHO_COLUMN_RB4:
+    case TACHO_COLUMN_RB5:
+        frame->tco1[TACHO_TCO1_WORKING_STATE + (id - TACHO_COLUMN_WORKING_STATE)] = (uint8_t) value;
+        break;
+
+    case TACHO_COLUMN_SPEED:
+        frame->tco1[TACHO_TCO1_SPEED_LSB] = (uint8_t) value;
+        frame->tco1[TACHO_TCO1_SPEED_MSB] = (uint8_t) (value >> 8);
+        break;
+
+    case TACHO_COLUMN_DRIVER1:
+    case TACHO_COLUMN_DRIVER2:
+        (void) Tacho_ColumnGetDin(block, (uint8_t) value, &frame->driver[id - TACHO_COLUMN_DRIVER1]);
+        break;
+
+    case TACHO_COLUMN_TIME:
+        frame->time.seconds = (uint8_t) value;
+        frame->time.minutes = (uint8_t) (value >> 8);
+        frame->time.hours = (uint8_t) (value >> 16);
+        break;
+
+    case TACHO_COLUMN_DATE:
+        frame->time.month = (uint8_t) value;
+        frame->time.day = (uint8_t) (value >> 8);
+        frame->time.year = (uint8_t) (value >> 16);
+        break;
+
+    case TACHO_COLUMN_OFFSET:
+        frame->time.local_min_offset = (uint8_t) value;
+        frame->time.local_hour_offset = (uint8_t) (value >> 8);
+        break;
+
+    case TACHO_COLUMN_ODOMETER:
+        frame->odometer = value;
+        break;
+
+    case TACHO_COLUMN_TRIP:
+        frame->trip = value;
+        break;
+
+    default:
+        break;
+    }
+}
+
+/**
+ * Appends a byte to a block
+ * @param writer Block writer
+ * @param value Byte
+ */
+static void Tacho_ColumnPutByte(Tacho_ColumnWriter_t *writer, uint8_t value)
+{
+    if (writer->pos < writer->size)
+    {
+        writer->out[writer->pos++] = value;
+    }
+    else
+    {
+        writer->ok = FALSE;
+    }
+}
+
+/**
+ * Appends an unsigned varint (7 bits per byte, least significant first) to a block
+ * @param writer Block writer
+ * @param value Value
+ */
+static void Tacho_ColumnPutVarint(Tacho_ColumnWriter_t *writer, uint32_t value)
+{
+    while (0x80 <= value)
+    {
+        Tacho_ColumnPutByte(writer, (uint8_t) (value | 0x80));
+        value >>= 7;
+    }
+    Tacho_ColumnPutByte(writer, (uint8_t) value);
+}
+
+/**
+ * Appends a run of equal deltas to a column
+ * The delta is zigzag coded (small negative deltas get small codes too).
+ * The first byte holds a continuation bit, the 6 low bits of the code and,
+ * in bit 0, whether a run length follows, so a single value only costs its
+ * delta; the rest of the code follows as a varint.
+ * @param writer Block writer
+ * @param delta Difference between consecutive values (modulo 2^32)
+ * @param run Number of values
+ */
+static void Tacho_ColumnPutRun(Tacho_ColumnWriter_t *writer, uint32_t delta, uint32_t run)
+{
+    uint32_t code = (delta << 1) ^ (0 - (delta >> 31));
+    uint8_t first = (uint8_t) ((code & 0x3F) << 1);
+
+    if (1 != run)
+    {
+        first |= 0x01;
+    }
+    if (0x3F < code)
+    {
+        Tacho_ColumnPutByte(writer, (uint8_t) (first | 0x80));
+        Tacho_ColumnPutVarint(writer, code >> 6);
+    }
+    else
+    {
+        Tacho_ColumnPutByte(writer, first);
+    }
+    if (1 != run)
+    {
+        Tacho_ColumnPutVarint(writer, run);
+    }
+}
+
+/**
+ * Reads a little endian 32-bit value
+ * @param buf[in] Value bytes
+ * @return Value
+ */
+static uint32_t Tacho_ColumnGetU32(const uint8_t *buf)
+{
+    return buf[0] | ((uint32_t) buf[1] << 8) | ((uint32_t) buf[2] << 16) | ((uint32_t) buf[3] << 24);
+}
+
+/**
+ * Reads an unsigned varint
+ * @param pos[inout] Read position, advanced past the varint
+ * @param end[in] End of the data
+ * @param value[out] Value
+ * @return TRUE if a complete varint was read, FALSE otherwise
+ */
+static bool_t Tacho_ColumnGetVarint(const uint8_t **pos, const uint8_t *end, uint32_t *value)
+{
+    const uint8_t *p = *pos;
+    uint32_t result = 0;
+    uint8_t shift;
+
+    for (shift = 0; (p < end) && (shift < 32); shift += 7)
+    {
+        result |= (uint32_t) (*p & 0x7F) << shift;
+        if (0 == (*p++ & 0x80))
+        {
+            *pos = p;
+            *value = result;
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+/**
+ * Prepares the reading of a column
+ * @param block[in] Opened block
+ * @param id Column
+ * @param cursor[out] Reading position
+ */
+static void Tacho_ColumnCursorInit(const Tacho_ColumnBlock_t *block, Tacho_ColumnId_t id, Tacho_ColumnCursor_t *cursor)
+{
+    cursor->pos = block->column[id];
+    cursor->end = &block->column[id][block->column_size[id]];
+    cursor->value = 0;
+    cursor->delta = 0;
+    cursor->run = 0;
+}
+
+/**
+ * Reads the next value of a column
+ * @param cursor Reading position
+ * @param value[out] Value
+ * @return TRUE if a value was read, FALSE at the end of the column
+ */
+static bool_t Tacho_ColumnCursorNext(Tacho_ColumnCursor_t *cursor, uint32_t *value)
+{
+    uint32_t code;
+    uint32_t rest;
+    uint8_t first;
+
+    while (0 == cursor->run)
+    {
+        /* See Tacho_ColumnPutRun() */
+        if (cursor->pos >= cursor->end)
+        {
+            return FALSE;
+        }
+        first = *cursor->pos++;
+        code = (first >> 1) & 0x3F;
+        if (0 != (first & 0x80))
+        {
+            if (FALSE == Tacho_ColumnGetVarint(&cursor->pos, cursor->end, &rest))
+            {
+                return FALSE;
+            }
+            code |= rest << 6;
+        }
+        cursor->run = 1;
+        if ( (0 != (first & 0x01)) && (FALSE == Tacho_ColumnGetVarint(&cursor->pos, cursor->end, &cursor->run)) )
+        {
+            return FALSE;
+        }
+        cursor->delta = (code >> 1) ^ (0 - (code & 1));
+    }
+
+    cursor->value += cursor->delta;
+    cursor->run--;
+    *value = cursor->value;
+    return TRUE;
+}
@@ -0,0 +1,87 @@
+/**
+ * @file tacho_column.h
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Columnar storage of decoded frames
+ *
+ * A block holds up to 65535 history frames (Tacho_HistFrame_t) stored column
+ * by column, so that a query only reads the columns it needs. Every column
+ * except the DIN dictionary holds one 32-bit value per frame, encoded as
+ * runs of equal deltas: a zigzag varint delta, followed by a varint run
+ * length unless the run is a single value. A slowly changing value (state
+ * bytes, date, drivers) or one growing at a constant rate (sequence number,
+ * odometer at constant speed) costs a couple of bytes per run rather than
+ * per frame.
+ *
+ * Block layout (little endian):
+ *  - 'T' 'C', version, number of columns, number of frames (16-bit)
+ *  - size of each column (32-bit), in Tacho_ColumnId_t order
+ *  - column data, in the same order
+ * The reader works in place on a memory buffer, e.g. an mmap()ed file of
+ * concatenated blocks.
+ */
+
+#ifndef TACHO_COLUMN_H
+#define	TACHO_COLUMN_H
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+/** Maximum number of distinct driver IDs in a block */
+#ifndef TACHO_COLUMN_MAX_DINS
+#define TACHO_COLUMN_MAX_DINS 32
+#endif
+
+#define TACHO_COLUMN_VERSION 1  /**< Block format version */
+#define TACHO_COLUMN_NO_DIN 0xFF  /**< Driver column value when no card is inserted */
+
+/******************************************************************************/
+/*    PUBLIC TYPES                                                            */
+/******************************************************************************/
+
+/** Columns of a block */
+typedef enum
+{
+    TACHO_COLUMN_STAMP,  /**< Tacho_HistFrame_t.stamp */
+    TACHO_COLUMN_SEQ,  /**< Tacho_HistFrame_t.seq */
+    TACHO_COLUMN_STANDARD,  /**< Tacho_HistFrame_t.standard */
+    TACHO_COLUMN_WORKING_STATE,  /**< TCO1 byte TACHO_TCO1_WORKING_STATE */
+    TACHO_COLUMN_DRV1_STATE,  /**< TCO1 byte TACHO_TCO1_DRV1_STATE */
+    TACHO_COLUMN_DRV2_STATE,  /**< TCO1 byte TACHO_TCO1_DRV2_STATE */
+    TACHO_COLUMN_STATUS,  /**< TCO1 byte TACHO_TCO1_STATUS */
+    TACHO_COLUMN_RB4,  /**< TCO1 byte TACHO_TCO1_RB4 */
+    TACHO_COLUMN_RB5,  /**< TCO1 byte TACHO_TCO1_RB5 */
+    TACHO_COLUMN_SPEED,  /**< TCO1 speed, 1/256 km/h/bit */
+    TACHO_COLUMN_DRIVER1,  /**< Index of driver 1 in the DIN dictionary, TACHO_COLUMN_NO_DIN if no card */
+    TACHO_COLUMN_DRIVER2,  /**< Index of driver 2 in the DIN dictionary, TACHO_COLUMN_NO_DIN if no card */
+    TACHO_COLUMN_TIME,  /**< seconds | minutes << 8 | hours << 16 */
+    TACHO_COLUMN_DATE,  /**< month | day << 8 | year << 16 */
+    TACHO_COLUMN_OFFSET,  /**< local_min_offset | local_hour_offset << 8 */
+    TACHO_COLUMN_ODOMETER,  /**< Tacho_HistFrame_t.odometer */
+    TACHO_COLUMN_TRIP,  /**< Tacho_HistFrame_t.trip */
+    TACHO_COLUMN_DIN_DICT,  /**< Distinct driver IDs of the block, country then card number */
+    TACHO_COLUMN_COUNT  /**< Number of columns */
+} Tacho_ColumnId_t;
+
+/** Block opened for reading (points into the block) */
+typedef struct
+{
+    const uint8_t *column[TACHO_COLUMN_COUNT];  /**< Start of each column */
+    uint32_t column_size[TACHO_COLUMN_COUNT];  /**< Size of each column in bytes */
+    uint32_t size;  /**< Size of the whole block (offset of the next one) */
+    uint16_t count;  /**< Number of frames */
+} Tacho_ColumnBlock_t;
+
+/******************************************************************************/
+/*    PUBLIC FUNCTIONS                                                        */
+/******************************************************************************/
+
+uint32_t Tacho_ColumnWrite(const Tacho_HistFrame_t *frames, uint16_t count, uint8_t *out, uint32_t size);
+Std_ReturnType Tacho_ColumnOpen(const uint8_t *buf, uint32_t size, Tacho_ColumnBlock_t *block);
+uint16_t Tacho_ColumnRead(const Tacho_ColumnBlock_t *block, Tacho_ColumnId_t id, uint32_t *out, uint16_t max);
+Std_ReturnType Tacho_ColumnGetDin(const Tacho_ColumnBlock_t *block, uint8_t index, Tacho_DriverID_t *driver);
+uint16_t Tacho_ColumnDecode(const Tacho_ColumnBlock_t *block, Tacho_HistFrame_t *out, uint16_t max);
+
+#endif	/* TACHO_COLUMN_H */
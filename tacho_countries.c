@@ -17,7 +17,83 @@
 /*    DEFINITIONS                                                             */
 /******************************************************************************/
 
-#define TACHO_COUNTRY_ENTRIES 60
+/**
+ * Known nations: X(nation code, country code letters, entry name)
+ * Country codes are padded with spaces to TACHO_MAX_COUNTRY_CODE letters.
+ * Both look-up tables below are generated from this list.
+ */
+#define TACHO_COUNTRY_LIST(X) \
+    X(0x00, ' ', ' ', ' ', NONE)  /* No information available */ \
+    X(0x01, 'A', ' ', ' ', A)     /* Austria */ \
+    X(0x02, 'A', 'L', ' ', AL)    /* Albania */ \
+    X(0x03, 'A', 'N', 'D', AND)   /* Andorra */ \
+    X(0x04, 'A', 'R', 'M', ARM)   /* Armenia */ \
+    X(0x05, 'A', 'Z', ' ', AZ)    /* Azerbaijan */ \
+    X(0x06, 'B', ' ', ' ', B)     /* Belgium */ \
+    X(0x07, 'B', 'G', ' ', BG)    /* Bulgaria */ \
+    X(0x08, 'B', 'I', 'H', BIH)   /* Bosnia Herzegovina */ \
+    X(0x09, 'B', 'Y', ' ', BY)    /* Belarus */ \
+    X(0x0A, 'C', 'H', ' ', CH)    /* Switzerland */ \
+    X(0x0B, 'C', 'Y', ' ', CY)    /* Cyprus */ \
+    X(0x0C, 'C', 'Z', ' ', CZ)    /* Czech Republic */ \
+    X(0x0D, 'D', ' ', ' ', D)     /* Germany */ \
+    X(0x0E, 'D', 'K', ' ', DK)    /* Denmark */ \
+    X(0x0F, 'E', ' ', ' ', E)     /* Spain */ \
+    X(0x10, 'E', 'S', 'T', EST)   /* Estonia */ \
+    X(0x11, 'F', ' ', ' ', F)     /* France */ \
+    X(0x12, 'F', 'I', 'N', FIN)   /* Finland */ \
+    X(0x13, 'F', 'L', ' ', FL)    /* Liechtenstein */ \
+    X(0x14, 'F', 'O', ' ', FO)    /* Faroe Islands */ \
+    X(0x15, 'U', 'K', ' ', UK)    /* United Kingdom */ \
+    X(0x16, 'G', 'E', ' ', GE)    /* Georgia */ \
+    X(0x17, 'G', 'R', ' ', GR)    /* Greece */ \
+    X(0x18, 'H', ' ', ' ', H)     /* Hungary */ \
+    X(0x19, 'H', 'R', ' ', HR)    /* Croatia */ \
+    X(0x1A, 'I', ' ', ' ', I)     /* Italy */ \
+    X(0x1B, 'I', 'R', 'L', IRL)   /* Ireland */ \
+    X(0x1C, 'I', 'S', ' ', IS)    /* Iceland */ \
+    X(0x1D, 'K', 'Z', ' ', KZ)    /* Kazakhstan */ \
+    X(0x1E, 'L', ' ', ' ', L)     /* Luxembourg */ \
+    X(0x1F, 'L', 'T', ' ', LT)    /* Lithuania */ \
+    X(0x20, 'L', 'V', ' ', LV)    /* Latvia */ \
+    X(0x21, 'M', ' ', ' ', M)     /* Malta */ \
+    X(0x22, 'M', 'C', ' ', MC)    /* Monaco */ \
+    X(0x23, 'M', 'D', ' ', MD)    /* Moldova */ \
+    X(0x24, 'M', 'K', ' ', MK)    /* Macedonia (FYROM) */ \
+    X(0x25, 'N', ' ', ' ', N)     /* Norway */ \
+    X(0x26, 'N', 'L', ' ', NL)    /* Netherlands */ \
+    X(0x27, 'P', ' ', ' ', P)     /* Portugal */ \
+    X(0x28, 'P', 'L', ' ', PL)    /* Poland */ \
+    X(0x29, 'R', 'O', ' ', RO)    /* Romania */ \
+    X(0x2A, 'R', 'S', 'M', RSM)   /* San Marino */ \
+    X(0x2B, 'R', 'U', 'S', RUS)   /* Russia */ \
+    X(0x2C, 'S', ' ', ' ', S)     /* Sweden */ \
+    X(0x2D, 'S', 'K', ' ', SK)    /* Slovakia */ \
+    X(0x2E, 'S', 'L', 'O', SLO)   /* Slovenia */ \
+    X(0x2F, 'T', 'M', ' ', TM)    /* Turkmenistan */ \
+    X(0x30, 'T', 'R', ' ', TR)    /* Turkey */ \
+    X(0x31, 'U', 'A', ' ', UA)    /* Ukraine */ \
+    X(0x32, 'V', ' ', ' ', V)     /* Vatican City */ \
+    X(0x33, 'Y', 'U', ' ', YU)    /* Yugoslavia (Code no longer in use since 2003) */ \
+    X(0x34, 'M', 'N', 'E', MNE)   /* Montenegro */ \
+    X(0x35, 'S', 'R', 'B', SRB)   /* Serbia */ \
+    X(0x36, 'U', 'Z', ' ', UZ)    /* Uzbekistan */ \
+    X(0x37, 'T', 'J', ' ', TJ)    /* Tajikistan */ \
+    X(0xFD, 'E', 'C', ' ', EC)    /* European Community */ \
+    X(0xFE, 'E', 'U', 'R', EUR)   /* Rest of Europe */ \
+    X(0xFF, 'W', 'L', 'D', WLD)   /* Rest of the World */
+
+/** Reserved for Future Use (also used for default return value) */
+#define TACHO_COUNTRY_RFU_CODE 0x38
+
+/**
+ * Perfect hash of a country code: no two entries of TACHO_COUNTRY_LIST
+ * (RFU included) share a slot, which Tacho_CountryCheckTables() enforces
+ * at compile time.
+ */
+#define TACHO_COUNTRY_HASH(_c0, _c1, _c2) ( (uint8_t) ( (_c0) * 17 + (_c1) * 155 + (_c2) ) )
+
+#define TACHO_COUNTRY_TABLE_SIZE 256  /**< One slot per nation code / hash value */
 
 /******************************************************************************/
 /*    PRIVATE TYPES                                                           */
@@ -29,90 +105,108 @@ typedef struct
     uint8_t country[TACHO_MAX_COUNTRY_CODE];
 } Tacho_Country_t;
 
+/** Position of each nation in Tacho_Countries (0 is the RFU default) */
+typedef enum
+{
+    TACHO_COUNTRY_IDX_RFU,
+#define TACHO_COUNTRY_IDX(_code, _c0, _c1, _c2, _name) TACHO_COUNTRY_IDX_##_name,
+    TACHO_COUNTRY_LIST(TACHO_COUNTRY_IDX)
+#undef TACHO_COUNTRY_IDX
+    TACHO_COUNTRY_ENTRIES
+} Tacho_CountryIdx_t;
+
 /******************************************************************************/
 /*    PRIVATE DATA                                                            */
 /******************************************************************************/
 
 static const Tacho_Country_t Tacho_Countries[TACHO_COUNTRY_ENTRIES] =
 {
-    {0x00, "   "},  /* No information available */
-    {0x01, "A  "},  /* Austria */
-    {0x02, "AL "},  /* Albania */
-    {0x03, "AND"},  /* Andorra */
-    {0x04, "ARM"},  /* Armenia */
-    {0x05, "AZ "},  /* Azerbaijan */
-    {0x06, "B  "},  /* Belgium */
-    {0x07, "BG "},  /* Bulgaria */
-    {0x08, "BIH"},  /* Bosnia Herzegovina */
-    {0x09, "BY "},  /* Belarus */
-    {0x0A, "CH "},  /* Switzerland */
-    {0x0B, "CY "},  /* Cyprus */
-    {0x0C, "CZ "},  /* Czech Republic */
-    {0x0D, "D  "},  /* Germany */
-    {0x0E, "DK "},  /* Denmark */
-    {0x0F, "E  "},  /* Spain */
-    {0x10, "EST"},  /* Estonia */
-    {0x11, "F  "},  /* France */
-    {0x12, "FIN"},  /* Finland */
-    {0x13, "FL "},  /* Liechtenstein */
-    {0x14, "FO "},  /* Faroe Islands */
-    {0x15, "UK "},  /* United Kingdom */
-    {0x16, "GE "},  /* Georgia */
-    {0x17, "GR "},  /* Greece */
-    {0x18, "H  "},  /* Hungary */
-    {0x19, "HR "},  /* Croatia */
-    {0x1A, "I  "},  /* Italy */
-    {0x1B, "IRL"},  /* Ireland */
-    {0x1C, "IS "},  /* Iceland */
-    {0x1D, "KZ "},  /* Kazakhstan */
-    {0x1E, "L  "},  /* Luxembourg */
-    {0x1F, "LT "},  /* Lithuania */
-    {0x20, "LV "},  /* Latvia */
-    {0x21, "M  "},  /* Malta */
-    {0x22, "MC "},  /* Monaco */
-    {0x23, "MD "},  /* Moldova */
-    {0x24, "MK "},  /* Macedonia (FYROM) */
-    {0x25, "N  "},  /* Norway */
-    {0x26, "NL "},  /* Netherlands */
-    {0x27, "P  "},  /* Portugal */
-    {0x28, "PL "},  /* Poland */
-    {0x29, "RO "},  /* Romania */
-    {0x2A, "RSM"},  /* San Marino */
-    {0x2B, "RUS"},  /* Russia */
-    {0x2C, "S  "},  /* Sweden */
-    {0x2D, "SK "},  /* Slovakia */
-    {0x2E, "SLO"},  /* Slovenia */
-    {0x2F, "TM "},  /* Turkmenistan */
-    {0x30, "TR "},  /* Turkey */
-    {0x31, "UA "},  /* Ukraine */
-    {0x32, "V  "},  /* Vatican City */
-    {0x33, "YU "},  /* Yugoslavia (Code no longer in use since 2003) */
-    {0x34, "MNE"},  /* Montenegro */
-    {0x35, "SRB"},  /* Serbia */
-    {0x36, "UZ "},  /* Uzbekistan */
-    {0x37, "TJ "},  /* Tajikistan */
-    {0xFD, "EC "},  /* European Community */
-    {0xFE, "EUR"},  /* Rest of Europe */
-    {0xFF, "WLD"},  /* Rest of the World */
-
-    {0x38, "RFU"}  /* Reserved for Future Use (also used for default return value) */
+    {TACHO_COUNTRY_RFU_CODE, {'R', 'F', 'U'}},
+#define TACHO_COUNTRY_ENTRY(_code, _c0, _c1, _c2, _name) {_code, {_c0, _c1, _c2}},
+    TACHO_COUNTRY_LIST(TACHO_COUNTRY_ENTRY)
+#undef TACHO_COUNTRY_ENTRY
+};
+
+/** Nation code -> Tacho_Countries index (unknown codes map to RFU) */
+static const uint8_t Tacho_CountryByCode[TACHO_COUNTRY_TABLE_SIZE] =
+{
+#define TACHO_COUNTRY_BY_CODE(_code, _c0, _c1, _c2, _name) [_code] = TACHO_COUNTRY_IDX_##_name,
+    TACHO_COUNTRY_LIST(TACHO_COUNTRY_BY_CODE)
+#undef TACHO_COUNTRY_BY_CODE
+};
+
+/** Country code hash -> Tacho_Countries index (empty slots point to RFU) */
+static const uint8_t Tacho_CountryByHash[TACHO_COUNTRY_TABLE_SIZE] =
+{
+    [TACHO_COUNTRY_HASH('R', 'F', 'U')] = TACHO_COUNTRY_IDX_RFU,
+#define TACHO_COUNTRY_BY_HASH(_code, _c0, _c1, _c2, _name) [TACHO_COUNTRY_HASH(_c0, _c1, _c2)] = TACHO_COUNTRY_IDX_##_name,
+    TACHO_COUNTRY_LIST(TACHO_COUNTRY_BY_HASH)
+#undef TACHO_COUNTRY_BY_HASH
 };
 
 /******************************************************************************/
 /*    IMPLEMENTATION                                                          */
 /******************************************************************************/
 
+/**
+ * Country code of a nation
+ * @param code Nation code (issuing member state)
+ * @return Pointer to the TACHO_MAX_COUNTRY_CODE letters of the country code ("RFU" if unknown)
+ */
 uint8_t *Tacho_GetCountryCode(uint8_t code)
 {
-    uint8_t i = 0;
+    return (uint8_t *) Tacho_Countries[Tacho_CountryByCode[code]].country;
+}
+
+/**
+ * Nation code of a country code (reverse of Tacho_GetCountryCode)
+ * @param country[in] TACHO_MAX_COUNTRY_CODE letters, padded with spaces
+ * @param code[out] Nation code
+ * @return E_OK if the country code is known, E_NOT_OK otherwise
+ */
+Std_ReturnType Tacho_GetNationCode(const uint8_t *country, uint8_t *code)
+{
+    const Tacho_Country_t *entry;
+
+    entry = &Tacho_Countries[Tacho_CountryByHash[TACHO_COUNTRY_HASH(country[0], country[1], country[2])]];
+    if ( (entry->country[0] != country[0]) ||
+         (entry->country[1] != country[1]) ||
+         (entry->country[2] != country[2]) )
+    {
+        return E_NOT_OK;
+    }
+
+    *code = entry->code;
+    return E_OK;
+}
 
-    for (i = 0; i < TACHO_COUNTRY_ENTRIES; i++)
+/**
+ * Compile-time check of the look-up tables, never called
+ * A nation code listed twice, or two country codes sharing a hash slot,
+ * make duplicate case labels, which every C compiler rejects (a designated
+ * initializer would silently keep the last entry).
+ * @param code Any nation code
+ * @param hash Any hash value
+ */
+static inline void Tacho_CountryCheckTables(uint8_t code, uint8_t hash)
+{
+    switch (code)
     {
-        if (Tacho_Countries[i].code == code)
-        {
-            return (uint8_t *) Tacho_Countries[i].country;
-        }
+    case TACHO_COUNTRY_RFU_CODE:
+#define TACHO_COUNTRY_CODE_CASE(_code, _c0, _c1, _c2, _name) case _code:
+    TACHO_COUNTRY_LIST(TACHO_COUNTRY_CODE_CASE)
+#undef TACHO_COUNTRY_CODE_CASE
+    default:
+        break;
     }
 
-    return (uint8_t *) Tacho_Countries[TACHO_COUNTRY_ENTRIES - 1].country;
+    switch (hash)
+    {
+    case TACHO_COUNTRY_HASH('R', 'F', 'U'):
+#define TACHO_COUNTRY_HASH_CASE(_code, _c0, _c1, _c2, _name) case TACHO_COUNTRY_HASH(_c0, _c1, _c2):
+    TACHO_COUNTRY_LIST(TACHO_COUNTRY_HASH_CASE)
+#undef TACHO_COUNTRY_HASH_CASE
+    default:
+        break;
+    }
 }
@@ -20,5 +20,6 @@
 /******************************************************************************/
 
 uint8_t *Tacho_GetCountryCode(uint8_t code);
+Std_ReturnType Tacho_GetNationCode(const uint8_t *country, uint8_t *code);
 
 #endif	/* TACHO_COUNTRIES_H */
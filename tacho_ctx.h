@@ -0,0 +1,687 @@
+/**
+ * @file tacho_ctx.h
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Tachograph interpreter - decoder context
+ *
+ * Every piece of decoder state lives in a Tacho_Ctx_t, so any number of
+ * independent D8 links can be decoded in the same address space. A context
+ * must not be moved or copied after Tacho_CtxInit().
+ *
+ * The cache is written by the execution context running Tacho_CtxTask()
+ * (or Tacho_CtxRxBlock()), which must also be the one calling
+ * Tacho_CtxProcessTco1() and Tacho_CtxProcessDI(); any other thread or
+ * interrupt level reads it through Tacho_CtxReadSnapshot().
+ */
+
+#ifndef TACHO_CTX_H
+#define	TACHO_CTX_H
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+/** Reception buffer size in bytes (power of two, at most 32768) */
+#ifndef TACHO_RX_QUEUE_SIZE
+#define TACHO_RX_QUEUE_SIZE 256
+#endif
+
+/** Distance kept between producer and consumer data of the reception buffer */
+#ifndef TACHO_CACHE_LINE_SIZE
+#if defined(__XC16__)
+#define TACHO_CACHE_LINE_SIZE 2
+#else
+#define TACHO_CACHE_LINE_SIZE 64
+#endif
+#endif
+
+#define TACHO_MAX_DRIVERS 2  /**< Maximum number of drivers */
+#define TACHO_MAX_CARD_NR 16  /**< Max driver card number in bytes */
+#define TACHO_FRAME_MAX 255  /**< Largest D8 frame accepted by the frame decoders, in bytes */
+#define TACHO_MAX_VIN 17  /**< Cached VIN size in bytes */
+#define TACHO_MAX_CSTR 32  /**< Cached VDO custom string size in bytes */
+#define TACHO_MAX_VRN 16  /**< Stoneridge vehicle registration number size in bytes */
+
+/* Change mask bits (see Tacho_CtxConfig_t.change_notif) */
+#define TACHO_DIRTY_WORKING_STATE 0x0001U  /**< TCO1 working state byte */
+#define TACHO_DIRTY_DRV1_STATE 0x0002U  /**< TCO1 driver 1 state byte */
+#define TACHO_DIRTY_DRV2_STATE 0x0004U  /**< TCO1 driver 2 state byte */
+#define TACHO_DIRTY_STATUS 0x0008U  /**< TCO1 tachograph status byte */
+#define TACHO_DIRTY_SPEED 0x0010U  /**< TCO1 vehicle speed (beyond speed_deadband) */
+#define TACHO_DIRTY_DI 0x0020U  /**< Driver IDs */
+#define TACHO_DIRTY_TIME 0x0040U  /**< VDO date and time */
+#define TACHO_DIRTY_ODOMETER 0x0080U  /**< VDO total distance (beyond distance_deadband) */
+#define TACHO_DIRTY_TRIP 0x0100U  /**< VDO trip distance (beyond distance_deadband) */
+#define TACHO_DIRTY_K_FACTOR 0x0200U  /**< VDO K-factor */
+#define TACHO_DIRTY_VIN 0x0400U  /**< VDO VIN */
+#define TACHO_DIRTY_CSTR 0x0800U  /**< VDO custom string */
+#define TACHO_DIRTY_SR_SNAPSHOT 0x1000U  /**< Published Stoneridge snapshot */
+#define TACHO_DIRTY_TCO1_STATES 0x000FU  /**< All TCO1 state bytes */
+#define TACHO_DIRTY_TCO1 0x001FU  /**< All TCO1 fields */
+
+/** Attempts made by Tacho_CtxReadSnapshot() before giving up on a busy writer */
+#ifndef TACHO_SNAPSHOT_RETRIES
+#define TACHO_SNAPSHOT_RETRIES 8
+#endif
+
+/** Change thresholds matching the historical behaviour: only TCO1 state bytes notify */
+#define TACHO_THRESHOLDS_DEFAULT { TACHO_DIRTY_TCO1_STATES, 0xFFFF, 0, 0 }
+
+/**
+ * Decoding engines: STD_OFF buffers a complete frame and decodes it at
+ * once, STD_ON selects the legacy per-byte state machine of the protocol
+ */
+#ifndef TACHO_CFG_VDO_BYTEWISE
+#define TACHO_CFG_VDO_BYTEWISE STD_OFF
+#endif
+#ifndef TACHO_CFG_SR_BYTEWISE
+#define TACHO_CFG_SR_BYTEWISE STD_OFF
+#endif
+
+/** Decoder statistics (Tacho_CtxGetStats), STD_OFF compiles them out */
+#ifndef TACHO_CFG_STATS
+#define TACHO_CFG_STATS STD_OFF
+#endif
+
+/** Decoded frame history ring (Tacho_CtxPopFrames), STD_OFF compiles it out */
+#ifndef TACHO_CFG_HISTORY
+#define TACHO_CFG_HISTORY STD_OFF
+#endif
+
+/** Number of frames kept in the history ring (power of two) */
+#ifndef TACHO_HISTORY_SIZE
+#define TACHO_HISTORY_SIZE 32
+#endif
+
+/** Full history ring policy: STD_ON overwrites the oldest frame, STD_OFF rejects the new one */
+#ifndef TACHO_CFG_HISTORY_OVERWRITE
+#define TACHO_CFG_HISTORY_OVERWRITE STD_ON
+#endif
+
+/** Driving and rest time accumulators (Tacho_CtxGetDrivingTimes), STD_OFF compiles them out */
+#ifndef TACHO_CFG_DRIVING_TIME
+#define TACHO_CFG_DRIVING_TIME STD_OFF
+#endif
+
+/** Driver cards tracked at once (more than TACHO_MAX_DRIVERS; the least recently seen card is forgotten) */
+#ifndef TACHO_DRIVING_CARDS
+#define TACHO_DRIVING_CARDS 4
+#endif
+
+/** get_time ticks per second (without a get_time binding nothing is accounted) */
+#ifndef TACHO_DRIVING_TICKS_PER_S
+#define TACHO_DRIVING_TICKS_PER_S 1000UL
+#endif
+
+/** Longest gap between two frames still accounted to the last working state, in seconds */
+#ifndef TACHO_DRIVING_MAX_GAP
+#define TACHO_DRIVING_MAX_GAP 60UL
+#endif
+
+/* EU 561/2006 thresholds, in seconds */
+#define TACHO_DRIVING_BREAK 2700UL  /**< Break resetting the continuous driving time */
+#define TACHO_DRIVING_SPLIT_FIRST 900UL  /**< First part of a split break */
+#define TACHO_DRIVING_SPLIT_SECOND 1800UL  /**< Second part of a split break */
+#define TACHO_DRIVING_DAILY_REST 32400UL  /**< Shortest (reduced) daily rest */
+
+/** Raw J1939 CAN frame reception (Tacho_CtxCanRx), STD_OFF compiles it out */
+#ifndef TACHO_CFG_CAN_RX
+#define TACHO_CFG_CAN_RX STD_OFF
+#endif
+
+/** J1939 source address of the tachograph (TCO1 and DI are only taken from it) */
+#ifndef TACHO_CAN_TACHO_SA
+#define TACHO_CAN_TACHO_SA 0xEE
+#endif
+
+/** Per-source TCO1 fusion between CAN and the D8 link, STD_OFF publishes the last report of any source */
+#ifndef TACHO_CFG_TCO1_FUSION
+#define TACHO_CFG_TCO1_FUSION STD_OFF
+#endif
+
+/** Silence after which a TCO1 source loses its priority, in get_time ticks */
+#ifndef TACHO_FUSION_TIMEOUT
+#define TACHO_FUSION_TIMEOUT 250UL
+#endif
+
+/** Same without a get_time binding, in TCO1 reports received from the other sources */
+#ifndef TACHO_FUSION_TIMEOUT_REPORTS
+#define TACHO_FUSION_TIMEOUT_REPORTS 2UL
+#endif
+
+/**
+ * Journaled persistence of the protocol and of the last cached TCO1, DI,
+ * VDO VIN and Stoneridge snapshot (read_nvm/write_nvm bindings), STD_OFF
+ * only persists the protocol through read_protocol/write_protocol. STD_ON
+ * needs TACHO_JOURNAL_FRAM_ADDR and TACHO_JOURNAL_FRAM_SIZE, the FRAM the
+ * firmware reserves for the journal of the default context.
+ */
+#ifndef TACHO_CFG_JOURNAL
+#define TACHO_CFG_JOURNAL STD_OFF
+#endif
+
+/** Minimum time between two journal writes, in get_time ticks (in Tacho_CtxJournalTask() calls without a get_time binding) */
+#ifndef TACHO_JOURNAL_PERIOD
+#define TACHO_JOURNAL_PERIOD 1000UL
+#endif
+
+/**
+ * Event-driven task: the reception path calls the wakeup binding once enough
+ * bytes are queued for the decoder to make progress (rest of the expected
+ * frame, or up to the byte its length depends on), STD_OFF leaves
+ * Tacho_CtxTask() to be polled
+ */
+#ifndef TACHO_CFG_WAKEUP
+#define TACHO_CFG_WAKEUP STD_OFF
+#endif
+
+/** Histogram buckets: 0 holds 0 ticks, b holds [2^(b-1), 2^b) ticks, the last one is open-ended */
+#define TACHO_HIST_BUCKETS 16
+
+/******************************************************************************/
+/*    PUBLIC TYPES                                                            */
+/******************************************************************************/
+
+struct Tacho_Ctx;
+
+/** Tachograph type handler callback function */
+typedef bool_t (*Tacho_Handler_t)(struct Tacho_Ctx *ctx, uint8_t rx_byte);
+
+/** Reception buffer data owned by the producer (Rx interrupt or thread) */
+typedef union
+{
+    struct
+    {
+        volatile uint16_t tail;  /**< Free-running write index */
+        volatile uint16_t error_counter;  /**< Free-running number of framing errors */
+        volatile uint32_t dropped;  /**< Free-running number of bytes dropped because the buffer was full */
+    } p;
+    uint8_t line[TACHO_CACHE_LINE_SIZE];
+} Tacho_RxQueueProducer_t;
+
+/** Reception buffer data owned by the consumer (decoder task) */
+typedef union
+{
+    struct
+    {
+        volatile uint16_t head;  /**< Free-running read index */
+        uint16_t error_seen;  /**< Producer error_counter value at the last Task call */
+        uint8_t failed_attempts;  /**< Total number of consecutive failed attempts */
+#if (TACHO_CFG_WAKEUP == STD_ON)
+        volatile uint16_t wake_at;  /**< Write index at which the producer wakes the task */
+#endif
+    } c;
+    uint8_t line[TACHO_CACHE_LINE_SIZE];
+} Tacho_RxQueueConsumer_t;
+
+/**
+ * Single-producer/single-consumer ring used for reception
+ * Indices run freely and are masked on access, so head == tail means empty
+ * and tail - head == TACHO_RX_QUEUE_SIZE means full.
+ */
+typedef struct
+{
+    Tacho_RxQueueProducer_t prod;
+    Tacho_RxQueueConsumer_t cons;
+    uint8_t data[TACHO_RX_QUEUE_SIZE];
+} Tacho_RxQueue_t;
+
+/** Driver ID (DIN) = Issuing member state + CardNumber */
+typedef struct
+{
+    uint8_t country[TACHO_MAX_COUNTRY_CODE];
+    uint8_t cardnr[TACHO_MAX_CARD_NR];
+} Tacho_DriverID_t;
+
+/** Zero-copy view of a variable-length frame field */
+typedef struct
+{
+    const uint8_t *data;  /**< First byte of the field, NULL if the field is absent */
+    uint8_t length;  /**< Number of bytes */
+} Tacho_View_t;
+
+/** Working state byte (TCO1 byte 1) */
+typedef struct
+{
+    uint8_t driver1;  /**< Driver 1 working state (0 rest, 1 available, 2 work, 3 drive, 6 error, 7 n/a) */
+    uint8_t driver2;  /**< Driver 2 working state */
+    uint8_t motion;  /**< Vehicle motion (0 not moving, 1 moving, 2 error, 3 n/a) */
+} Tacho_WorkingState_t;
+
+/** Driver state byte (TCO1 bytes 2 and 3) */
+typedef struct
+{
+    uint8_t time_state;  /**< Driver time related states */
+    uint8_t card;  /**< Driver card present (0 no, 1 yes, 2 error, 3 n/a) */
+    uint8_t overspeed;  /**< Overspeed (driver 1 byte only) */
+} Tacho_DriverState_t;
+
+/** UTC date and time sent by VDO tachographs, in frame resolution */
+typedef struct
+{
+    uint8_t seconds;  /**< 0.25 s/bit */
+    uint8_t minutes;
+    uint8_t hours;
+    uint8_t month;
+    uint8_t day;  /**< 0.25 day/bit, 0 = null */
+    uint8_t year;  /**< Years since 1985 */
+    uint8_t local_min_offset;  /**< 1 min/bit, -125 min offset */
+    uint8_t local_hour_offset;  /**< 1 h/bit, -125 h offset */
+} Tacho_DateTime_t;
+
+/** Data only sent by VDO tachographs */
+typedef struct
+{
+    Tacho_DateTime_t time;  /**< UTC date and time */
+    uint32_t odometer;  /**< High resolution total vehicle distance, 5 m/bit */
+    uint32_t trip;  /**< High resolution trip distance, 5 m/bit */
+    uint16_t k_factor;  /**< K-factor */
+    Tacho_View_t vin;  /**< Vehicle identification number */
+    Tacho_View_t cstr;  /**< Custom string */
+} Tacho_VdoInfo_t;
+
+/** Parts of the Stoneridge vehicle snapshot (one per message type) */
+typedef enum
+{
+    TACHO_SR_PART_VIN,
+    TACHO_SR_PART_DIN1,
+    TACHO_SR_PART_DIN2,
+    TACHO_SR_PART_VRN,
+    TACHO_SR_PARTS
+} Tacho_SrPart_t;
+
+#define TACHO_SR_PART_MASK(_p) ((uint8_t) (1U << (_p)))  /**< Validity bit of a snapshot part */
+#define TACHO_SR_PART_ALL ((uint8_t) ((1U << TACHO_SR_PARTS) - 1U))  /**< All snapshot parts valid */
+#define TACHO_SR_AGE_NONE 0xFFFF  /**< Age of a part never received */
+
+/** Sources of TCO1 data, by decreasing priority (CAN reports every 50 ms, D8 every second or slower) */
+typedef enum
+{
+    TACHO_SOURCE_CAN,  /**< J1939 TCO1 (Tacho_CtxCanRx(), Tacho_CtxProcessTco1()) */
+    TACHO_SOURCE_D8,  /**< Decoded D8 frames */
+    TACHO_SOURCE_MAX
+} Tacho_Source_t;
+
+#define TACHO_TCO1_AGE_NONE 0xFFFFFFFFUL  /**< Age of a source never heard */
+
+/**
+ * Vehicle data assembled from Stoneridge messages
+ * Each message carries only one of VIN, DIN1, DIN2 or VRN + RMS; ages count
+ * Stoneridge frames (modulo 65536), 0 meaning the latest frame.
+ */
+typedef struct
+{
+    uint8_t vin[TACHO_MAX_VIN];  /**< Vehicle identification number */
+    uint8_t vin_len;  /**< Number of bytes in vin */
+    uint8_t rms[TACHO_MAX_COUNTRY_CODE];  /**< Registering member state */
+    uint8_t vrn[TACHO_MAX_VRN];  /**< Vehicle registration number */
+    uint8_t vrn_len;  /**< Number of bytes in vrn */
+    Tacho_DriverID_t driver[TACHO_MAX_DRIVERS];  /**< Driver IDs (empty card number if no card) */
+    uint8_t valid;  /**< TACHO_SR_PART_MASK() of the parts received */
+    uint16_t frames;  /**< Stoneridge frames decoded */
+    uint16_t stamp[TACHO_SR_PARTS];  /**< Value of frames when each part was last received */
+} Tacho_SrSnapshot_t;
+
+/** Real-time data received from Tachograph */
+typedef struct
+{
+    uint8_t working_state;
+    uint8_t driver1_state;
+    uint8_t driver2_state;
+    uint8_t tacho_status;
+    uint8_t speed_msb;
+    uint8_t speed_lsb;
+    Tacho_DriverID_t driver[TACHO_MAX_DRIVERS];
+    Tacho_WorkingState_t ws;  /**< Decoded working_state */
+    Tacho_DriverState_t drv_state[TACHO_MAX_DRIVERS];  /**< Decoded driver1_state and driver2_state */
+    Tacho_VdoInfo_t vdo;  /**< VDO frame engine only; views point into the frame and are
+                               valid until the context receives more data */
+} Tacho_Frame_t;
+
+/** Cached data */
+typedef struct
+{
+    uint8_t tco1[TACHO_TCO1_SIZE];  /**< Reconstructed TCO1 */
+    uint8_t tco1_cmn[TACHO_TCO1_SIZE];  /**< TCO1 common collected data from J1939 and D8 */
+    uint8_t di[TACHO_MAX_DI_MSG];  /**< Cached DIN1 + DIN2 + delimiters (and zero terminator) */
+    Tacho_VdoInfo_t vdo;  /**< VDO data, views pointing to vin and cstr */
+    uint8_t vin[TACHO_MAX_VIN];  /**< Cached VIN */
+    uint8_t cstr[TACHO_MAX_CSTR];  /**< Cached custom string */
+    Tacho_SrSnapshot_t sr;  /**< Last complete Stoneridge snapshot (valid == 0 until then) */
+} Tacho_CachedData_t;
+
+/** Protocol configuration */
+typedef struct
+{
+    uint8_t *start_seq;  /**< Start sequence */
+    uint8_t start_sz;  /**< Start sequence size */
+    uint16_t baudRate;  /**< UART baudrate for specified protocol */
+} Tacho_Protocol_t;
+
+#if (TACHO_CFG_VDO_BYTEWISE == STD_ON)
+/** VDO-specific internal data (per-byte engine) */
+typedef struct
+{
+    uint8_t index;  /**< Current position in frame */
+    uint8_t cstr_pos;  /**< Start of custom string byte position */
+    uint8_t drv1_pos;  /**< Start of Driver1 ID byte position */
+    uint8_t drv2_pos;  /**< Start of Driver2 ID byte position */
+    uint8_t crc8_pos;  /**< CRC8 position */
+    uint8_t crc8_value;  /**< CRC8 computed value */
+} Tacho_VdoData_t;
+#endif
+
+#if (TACHO_CFG_SR_BYTEWISE == STD_ON)
+/** Stoneridge-specific internal data (per-byte engine) */
+typedef struct
+{
+    uint8_t index;  /**< Current position in frame */
+    uint8_t drv1_pos;  /**< Start of Driver1 ID byte position */
+    uint8_t drv2_pos;  /**< Start of Driver2 ID byte position */
+    uint8_t crc8_pos;  /**< CRC8 position */
+    uint8_t crc8_value;  /**< CRC8 computed value */
+} Tacho_SrData_t;
+#endif
+
+/** Frame being assembled by the reception handler (frame decoding engine) */
+typedef struct
+{
+    uint8_t data[TACHO_FRAME_MAX];  /**< Frame received so far (start sequence included) */
+    uint16_t count;  /**< Number of bytes in data */
+    uint16_t needed;  /**< Bytes needed before the layout can progress (frame length once resolved) */
+} Tacho_RxFrame_t;
+
+/** Bytes of a rejected frame fed again to the start sequence search (frame decoding engine) */
+typedef struct
+{
+    uint8_t data[TACHO_FRAME_MAX];  /**< Bytes following the false start */
+    uint16_t head;  /**< Next byte to feed */
+    uint16_t count;  /**< Number of bytes in data */
+} Tacho_Lookback_t;
+
+/** Partial frame kept between two Tacho_CtxRxBlock() calls */
+typedef struct
+{
+    uint8_t data[TACHO_FRAME_MAX];  /**< Frame bytes received so far (start sequence included) */
+    uint16_t count;  /**< Number of valid bytes in data */
+} Tacho_Spill_t;
+
+/** Consistent copy of the cached data */
+typedef struct Tacho_Snapshot
+{
+    uint16_t generation;  /**< Number of cache write sections (modulo 32768) the copy reflects */
+    Tacho_CachedData_t data;  /**< Cached data (views point into this copy) */
+} Tacho_Snapshot_t;
+
+/** Decoded frame kept in the history ring */
+typedef struct Tacho_HistFrame
+{
+    uint32_t stamp;  /**< get_time value when the frame was decoded (0 without binding) */
+    uint16_t seq;  /**< Decoded frame number (modulo 65536); gaps reveal overwritten or rejected frames */
+    uint8_t standard;  /**< Tacho_Standard_t of the frame */
+    uint8_t tco1[TACHO_TCO1_SIZE];  /**< Reconstructed TCO1 */
+    Tacho_DriverID_t driver[TACHO_MAX_DRIVERS];  /**< Driver IDs (empty card number if no card) */
+    Tacho_DateTime_t time;  /**< VDO date and time (VDO frame engine only, 0 otherwise) */
+    uint32_t odometer;  /**< VDO total vehicle distance, 5 m/bit (VDO frame engine only, 0 otherwise) */
+    uint32_t trip;  /**< VDO trip distance, 5 m/bit (VDO frame engine only, 0 otherwise) */
+} Tacho_HistFrame_t;
+
+#if (TACHO_CFG_HISTORY == STD_ON)
+/**
+ * Single-producer/single-consumer ring of decoded frames
+ * Indices run freely like the reception buffer ones. When overwriting,
+ * reserve runs one ahead of tail while an entry is written, so the
+ * consumer can drop entries that were overwritten under it.
+ */
+typedef struct
+{
+    Tacho_HistFrame_t entry[TACHO_HISTORY_SIZE];
+    volatile uint16_t tail;  /**< Free-running index of the next entry to publish (decoder) */
+    volatile uint16_t reserve;  /**< Free-running index past the entry being written (decoder) */
+    volatile uint16_t head;  /**< Free-running index of the next entry to pop (consumer) */
+    uint16_t seq;  /**< Decoded frame counter (decoder) */
+} Tacho_History_t;
+#endif
+
+/**
+ * Driving and rest time of a driver card, in seconds
+ * Time is accounted to the working state the tachograph reported for the
+ * card's slot; time spent with the card withdrawn counts as rest.
+ */
+typedef struct Tacho_DrivingTime
+{
+    Tacho_DriverID_t driver;  /**< Driver card */
+    uint32_t continuous_driving;  /**< Driving since the last break of TACHO_DRIVING_BREAK (or split break) */
+    uint32_t daily_driving;  /**< Driving since the last daily rest */
+    uint32_t rest;  /**< Ongoing rest or break, 0 when the last accounted state was not rest */
+    uint32_t last_daily_rest;  /**< Last completed rest of at least TACHO_DRIVING_DAILY_REST */
+    uint8_t state;  /**< Working state last reported for the card (Tacho_WorkingState_t values) */
+    bool_t inserted;  /**< Card present in the last frame */
+    bool_t split_break;  /**< First part of a split break taken since the continuous driving started */
+} Tacho_DrivingTime_t;
+
+#if (TACHO_CFG_DRIVING_TIME == STD_ON)
+/** Driving and rest time accumulators of a context (written by the decoder only) */
+typedef struct
+{
+    Tacho_DrivingTime_t card[TACHO_DRIVING_CARDS];  /**< Tracked cards */
+    uint32_t seen[TACHO_DRIVING_CARDS];  /**< Time up to which each card was accounted, in get_time ticks */
+    uint8_t slot[TACHO_DRIVING_CARDS];  /**< Slot each inserted card was seen in */
+    uint8_t count;  /**< Number of tracked cards */
+} Tacho_Driving_t;
+#endif
+
+#if (TACHO_CFG_TCO1_FUSION == STD_ON)
+/** Last TCO1 report of a source */
+typedef struct
+{
+    uint8_t tco1[TACHO_TCO1_SIZE];  /**< Reported TCO1 */
+    uint32_t stamp;  /**< Fusion clock at the report */
+    bool_t seen;  /**< The source reported at least once */
+} Tacho_FusionSource_t;
+
+/**
+ * TCO1 fusion state of a context
+ * The fusion clock is the get_time binding, or the number of TCO1 reports
+ * received without it.
+ */
+typedef struct
+{
+    Tacho_FusionSource_t source[TACHO_SOURCE_MAX];  /**< Last report of each source */
+    uint8_t from[TACHO_TCO1_SIZE];  /**< Source of each byte of the last fused TCO1 */
+    uint32_t reports;  /**< TCO1 reports received */
+} Tacho_Fusion_t;
+#endif
+
+/*
+ * Journal: two slots, each holding a record made of a header ('T' 'J',
+ * version, data size), the protocol byte, the persisted cached fields, a
+ * sequence number and a CRC-16 of the whole record (offsetof() needs <stddef.h>)
+ */
+#define TACHO_JOURNAL_HEADER_SIZE 5U  /**< Journal record header size in bytes */
+#define TACHO_JOURNAL_DATA_SIZE \
+    (1U + 2U * TACHO_TCO1_SIZE + TACHO_MAX_DI_MSG + TACHO_MAX_VIN + 1U + offsetof(Tacho_SrSnapshot_t, frames))  /**< Journal record data size in bytes */
+#define TACHO_JOURNAL_TAIL_SIZE 4U  /**< Sequence number and CRC size in bytes */
+#define TACHO_JOURNAL_SLOT_SIZE (TACHO_JOURNAL_HEADER_SIZE + TACHO_JOURNAL_DATA_SIZE + TACHO_JOURNAL_TAIL_SIZE)  /**< Journal slot size in bytes */
+#define TACHO_JOURNAL_SIZE (2U * TACHO_JOURNAL_SLOT_SIZE)  /**< Persistent memory used by the journal of a context */
+
+#if (TACHO_CFG_JOURNAL == STD_ON)
+/** Journal state of a context */
+typedef struct
+{
+    uint32_t last_write;  /**< Journal clock at the last write attempt */
+    uint32_t tasks;  /**< Tacho_CtxJournalTask() calls (journal clock without a get_time binding) */
+    uint16_t seq;  /**< Sequence number of the last record written or restored */
+    uint16_t crc;  /**< CRC of the data of that record */
+    uint8_t slot;  /**< Slot of that record */
+    uint8_t protocol;  /**< Protocol to persist */
+    bool_t restored;  /**< The cache was restored from the journal at init */
+} Tacho_Journal_t;
+#endif
+
+#if (TACHO_CFG_CAN_RX == STD_ON)
+/** J1939 TP.BAM transfer of the driver identification being received */
+typedef struct
+{
+    uint16_t size;  /**< Message size in bytes, 0 when no transfer is in progress */
+    uint8_t packets;  /**< Number of TP.DT packets of the transfer */
+    uint8_t next;  /**< Sequence number of the next TP.DT packet */
+    bool_t changed;  /**< The transfer changed a cached DI byte */
+} Tacho_CanBam_t;
+#endif
+
+/** Decoder event counters */
+typedef enum
+{
+    TACHO_STAT_FRAMES,  /**< Frames decoded with a valid checksum */
+    TACHO_STAT_CHECKSUM,  /**< Frames rejected by their checksum */
+    TACHO_STAT_BAD_LENGTH,  /**< Frames rejected by their length (Stoneridge message length, VDO oversize) */
+    TACHO_STAT_BAD_MSG_ID,  /**< Stoneridge frames rejected by their message ID */
+    TACHO_STAT_RESYNC,  /**< Start sequences found after discarding data */
+    TACHO_STAT_SWITCHES,  /**< Protocol switches */
+    /* Kept by the reception buffer */
+    TACHO_STAT_DROPPED,  /**< Bytes dropped because the reception buffer was full */
+    TACHO_STAT_FRAMING,  /**< Framing errors reported by the UART */
+    TACHO_STAT_COUNTERS
+} Tacho_StatCounter_t;
+
+/** Decoder statistics; times are in ticks of the get_time binding */
+typedef struct Tacho_Stats
+{
+    uint32_t counter[TACHO_STAT_COUNTERS];  /**< Free-running event counters */
+    uint32_t decode_time[TACHO_HIST_BUCKETS];  /**< Complete frame handed to the decoder until notification */
+    uint32_t latency[TACHO_HIST_BUCKETS];  /**< Frame start seen by the decoder until notification */
+} Tacho_Stats_t;
+
+#if (TACHO_CFG_STATS == STD_ON)
+/** Statistics gathered by a context (written by the decoder only) */
+typedef struct
+{
+    volatile uint32_t counter[TACHO_STAT_DROPPED];  /**< Counters kept by the decoder */
+    volatile uint32_t decode_time[TACHO_HIST_BUCKETS];  /**< Decode time histogram */
+    volatile uint32_t latency[TACHO_HIST_BUCKETS];  /**< Latency histogram */
+    uint32_t frame_start;  /**< Timestamp of the current frame start */
+    uint32_t decode_start;  /**< Timestamp of the current frame decoding start */
+    bool_t lost;  /**< Data discarded since the last frame start */
+} Tacho_StatsData_t;
+#endif
+
+/** Change reporting thresholds */
+typedef struct
+{
+    uint16_t notify_mask;  /**< TACHO_DIRTY_* changes that trigger a notification */
+    uint16_t speed_deadband;  /**< Speed changes up to this value are ignored, 1/256 km/h/bit (0xFFFF: never) */
+    uint32_t distance_deadband;  /**< Distance changes up to this value are ignored, 5 m/bit */
+    uint8_t state_hysteresis;  /**< Extra consecutive TCO1 updates a new state byte value must last */
+} Tacho_Thresholds_t;
+
+/** Change tracking state */
+typedef struct
+{
+    uint16_t dirty;  /**< Changes not notified yet */
+    uint8_t candidate[TACHO_TCO1_RB4];  /**< New TCO1 state byte values waiting for the hysteresis */
+    uint8_t count[TACHO_TCO1_RB4];  /**< Consecutive TCO1 updates carrying the candidate value */
+    uint32_t odometer;  /**< Last reported VDO total distance */
+    uint32_t trip;  /**< Last reported VDO trip distance */
+} Tacho_Changes_t;
+
+/**
+ * Platform bindings of a decoder context
+ * Any callback may be NULL if the corresponding service is not available.
+ */
+typedef struct
+{
+    void (*set_baudrate)(struct Tacho_Ctx *ctx, uint16_t baudrate);  /**< Reconfigure the UART */
+    Std_ReturnType (*read_protocol)(struct Tacho_Ctx *ctx, uint8_t *data);  /**< Read last known protocol */
+    Std_ReturnType (*write_protocol)(struct Tacho_Ctx *ctx, uint8_t data);  /**< Save determined protocol */
+    void (*tco1_notif)(struct Tacho_Ctx *ctx);  /**< New TCO1 data available in tco1_cmn */
+    void (*frame_notif)(struct Tacho_Ctx *ctx);  /**< Frame decoded, data available in frame and cached */
+    void (*change_notif)(struct Tacho_Ctx *ctx, uint16_t dirty);  /**< TACHO_DIRTY_* changes since the last notification */
+    uint32_t (*get_time)(struct Tacho_Ctx *ctx);  /**< Free-running timestamp (statistics, frame history) */
+    Std_ReturnType (*read_nvm)(struct Tacho_Ctx *ctx, uint16_t addr, uint8_t *buf, uint16_t len);  /**< Read persistent memory (journal) */
+    Std_ReturnType (*write_nvm)(struct Tacho_Ctx *ctx, uint16_t addr, const uint8_t *buf, uint16_t len);  /**< Write persistent memory (journal) */
+    void (*wakeup)(struct Tacho_Ctx *ctx);  /**< Run Tacho_CtxTask() (called from the reception path, TACHO_CFG_WAKEUP) */
+} Tacho_CtxConfig_t;
+
+/** Decoder context (one per D8 link) */
+typedef struct Tacho_Ctx
+{
+    Tacho_RxQueue_t rx_queue;  /**< Reception buffer */
+    Tacho_Frame_t frame;  /**< Tacho frame data (TCO1 + DIN) */
+    Tacho_CachedData_t cached;  /**< Data storage after succesful read */
+    volatile uint16_t cached_seq;  /**< Cache sequence counter, odd while cached is being written */
+#if (TACHO_CFG_VDO_BYTEWISE == STD_ON)
+    Tacho_VdoData_t vdo;  /**< VDO-related internal data */
+#endif
+#if (TACHO_CFG_SR_BYTEWISE == STD_ON)
+    Tacho_SrData_t sr;  /**< Stoneridge-related internal data */
+#endif
+    Tacho_Thresholds_t thresholds;  /**< Change reporting thresholds */
+    Tacho_Changes_t changes;  /**< Change tracking state */
+#if (TACHO_CFG_STATS == STD_ON)
+    Tacho_StatsData_t stats;  /**< Decoder statistics */
+#endif
+#if (TACHO_CFG_HISTORY == STD_ON)
+    Tacho_History_t history;  /**< Decoded frame history */
+#endif
+#if (TACHO_CFG_DRIVING_TIME == STD_ON)
+    Tacho_Driving_t driving;  /**< Driving and rest time accumulators */
+#endif
+#if (TACHO_CFG_TCO1_FUSION == STD_ON)
+    Tacho_Fusion_t fusion;  /**< TCO1 fusion state */
+#endif
+#if (TACHO_CFG_JOURNAL == STD_ON)
+    Tacho_Journal_t journal;  /**< Persistence state */
+#endif
+#if (TACHO_CFG_CAN_RX == STD_ON)
+    Tacho_CanBam_t can_bam;  /**< Driver identification transfer on CAN */
+#endif
+    Tacho_SrSnapshot_t sr_snap;  /**< Stoneridge snapshot being assembled */
+    Tacho_RxFrame_t rx_frame;  /**< Frame being assembled by the reception handler */
+    Tacho_Lookback_t lookback;  /**< Rejected frame bytes to search again */
+    Tacho_Spill_t spill;  /**< Partial frame of the block reception path */
+    Tacho_Standard_t standard;  /**< Current selected protocol */
+    const Tacho_Protocol_t *proto;  /**< Pointer to the currently selected protocol */
+    Tacho_Handler_t handler;  /**< Pointer to the currently selected handler function */
+    bool_t perform_sync;  /**< Searching for the start of frame */
+    uint8_t sync_state;  /**< Start sequence automaton state */
+    bool_t auto_standard;  /**< Follow the protocol of the start sequences found */
+    const Tacho_CtxConfig_t *config;  /**< Platform bindings */
+    void *user;  /**< Opaque pointer owned by the application */
+} Tacho_Ctx_t;
+
+/******************************************************************************/
+/*    PUBLIC FUNCTIONS                                                        */
+/******************************************************************************/
+
+void Tacho_CtxInit(Tacho_Ctx_t *ctx, const Tacho_CtxConfig_t *config, void *user);
+void Tacho_CtxTask(Tacho_Ctx_t *ctx);
+void Tacho_CtxRxNotif(Tacho_Ctx_t *ctx, uint8_t rx_byte);
+void Tacho_CtxErrorNotif(Tacho_Ctx_t *ctx);
+void Tacho_CtxRxBlock(Tacho_Ctx_t *ctx, const uint8_t *buf, uint32_t len);
+void Tacho_CtxSetAutoStandard(Tacho_Ctx_t *ctx, bool_t enable);
+void Tacho_CtxSetThresholds(Tacho_Ctx_t *ctx, const Tacho_Thresholds_t *thresholds);
+void Tacho_CtxProcessTco1(Tacho_Ctx_t *ctx, uint8_t *tco1_data);
+void Tacho_CtxProcessDI(Tacho_Ctx_t *ctx, uint8_t *di);
+void Tacho_CtxCanRx(Tacho_Ctx_t *ctx, uint32_t id, const uint8_t *data, uint8_t dlc);
+uint32_t Tacho_CtxGetTco1Age(Tacho_Ctx_t *ctx, Tacho_Source_t source);
+Tacho_Source_t Tacho_CtxGetTco1Source(Tacho_Ctx_t *ctx, Tacho_Tco1_Index_t index);
+uint8_t *Tacho_CtxGetCachedTco1(Tacho_Ctx_t *ctx);
+uint8_t *Tacho_CtxGetCachedDI(Tacho_Ctx_t *ctx);
+const Tacho_VdoInfo_t *Tacho_CtxGetCachedVdo(Tacho_Ctx_t *ctx);
+Std_ReturnType Tacho_CtxReadSnapshot(Tacho_Ctx_t *ctx, Tacho_Snapshot_t *out);
+const Tacho_SrSnapshot_t *Tacho_CtxGetSrSnapshot(Tacho_Ctx_t *ctx);
+bool_t Tacho_CtxSrSnapshotComplete(Tacho_Ctx_t *ctx);
+uint16_t Tacho_CtxGetSrPartAge(Tacho_Ctx_t *ctx, Tacho_SrPart_t part);
+bool_t Tacho_CtxRxPending(Tacho_Ctx_t *ctx);
+uint32_t Tacho_CtxGetDroppedBytes(Tacho_Ctx_t *ctx);
+Std_ReturnType Tacho_CtxGetStats(Tacho_Ctx_t *ctx, Tacho_Stats_t *out);
+uint16_t Tacho_CtxPopFrames(Tacho_Ctx_t *ctx, Tacho_HistFrame_t *out, uint16_t max);
+uint8_t Tacho_CtxGetDrivingTimes(Tacho_Ctx_t *ctx, Tacho_DrivingTime_t *out, uint8_t max);
+Tacho_Standard_t Tacho_CtxGetSelectedStandard(Tacho_Ctx_t *ctx);
+void Tacho_CtxJournalTask(Tacho_Ctx_t *ctx);
+Std_ReturnType Tacho_CtxJournalFlush(Tacho_Ctx_t *ctx);
+bool_t Tacho_CtxJournalRestored(Tacho_Ctx_t *ctx);
+
+#endif	/* TACHO_CTX_H */
@@ -0,0 +1,79 @@
+/**
+ * @file tacho_d8.h
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Tachograph D8 serial output frame layout (VDO and Stoneridge)
+ */
+
+#ifndef TACHO_D8_H
+#define	TACHO_D8_H
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+/* VDO-related defines */
+#define TACHO_VDO_SEQSZ 5  /**< VDO Start Sequence Size */
+#define TACHO_VDO_START_SEQ 0x55, 0x44, 0x54, 0x43, 0x4F  /**< VDO Start Sequence ("UDTCO") */
+#define TACHO_VDO_CRC_INIT 0x49  /**< CRC-8 initialization value for VDO */
+#define TACHO_VDO_CC_POS 1  /**< Country code byte position in VDO's DIN */
+
+/* Stoneridge-related defines */
+#define TACHO_SR_SEQSZ 3  /**< Stoneridge Start Sequence Size */
+#define TACHO_SR_START_SEQ 0xFF, 0xFF, 0xFF  /**< Stoneridge Start Sequence */
+#define TACHO_SR_MSG_LEN_MIN 45  /**< Minimum Stoneridge SRE message length */
+#define TACHO_SR_MSG_LEN_MAX 48  /**< Maximum Stoneridge SRE message length */
+
+/******************************************************************************/
+/*    PUBLIC TYPES                                                            */
+/******************************************************************************/
+
+/** VDO-related field position in frame */
+typedef enum
+{
+    TACHO_VDO_UTC_SECONDS = 6,
+    TACHO_VDO_UTC_MINUTES = 7,
+    TACHO_VDO_UTC_HOURS = 8,
+    TACHO_VDO_UTC_MONTH = 9,
+    TACHO_VDO_UTC_DAY = 10,
+    TACHO_VDO_UTC_YEAR = 11,
+    TACHO_VDO_LOCAL_MIN_OFFSET = 12,
+    TACHO_VDO_LOCAL_HOUR_OFFSET = 13,
+    TACHO_VDO_WORKING_STATE = 14,
+    TACHO_VDO_DRV1_STATE = 15,
+    TACHO_VDO_DRV2_STATE = 16,
+    TACHO_VDO_STATUS = 17,
+    TACHO_VDO_SPEED_LSB = 18,
+    TACHO_VDO_SPEED_MSB = 19,
+    TACHO_VDO_ODOMETER = 20,  /**< 4 bytes, LSB first */
+    TACHO_VDO_TRIP = 24,  /**< 4 bytes, LSB first */
+    TACHO_VDO_K_FACTOR = 28,  /**< 2 bytes, LSB first */
+    TACHO_VDO_VIN_LENGTH = 34
+} Tacho_VdoFields_t;
+
+/** Stoneridge-related field position in frame */
+typedef enum
+{
+    TACHO_SR_MSG_LEN = 3,
+    TACHO_SR_MSG_ID = 4,
+    TACHO_SR_WORKING_STATE = 9,
+    TACHO_SR_DRV1_STATE = 10,
+    TACHO_SR_DRV2_STATE = 11,
+    TACHO_SR_STATUS = 12,
+    TACHO_SR_SPEED_MSB = 13,
+    TACHO_SR_SPEED_LSB = 14,
+    TACHO_SR_CUSTOM = 30  /**< VIN, DIN1, DIN2 or VRN & RMS position (depends on message type) */
+} Tacho_SrFields_t;
+
+/** Stoneridge Message Identifier */
+typedef enum
+{
+    TACHO_SR_MSG_VIN = 0x01,
+    TACHO_SR_MSG_DIN1 = 0x02,
+    TACHO_SR_MSG_DIN2 = 0x04,
+    TACHO_SR_MSG_VRN = 0x08,
+    TACHO_SR_MSG_TYPES = 4  /**< Total Stoneridge message types */
+} Tacho_StoneridgeMsgID_t;
+
+#endif	/* TACHO_D8_H */
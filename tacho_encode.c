@@ -0,0 +1,228 @@
+/**
+ * @file tacho_encode.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Tachograph D8 frame encoder (VDO and Stoneridge)
+ *
+ * A driver is considered present when the first byte of its card number is
+ * not zero. Fields the decoder does not interpret are left zero; the VIN and
+ * custom string are passed explicitly (the views of Tacho_Frame_t are
+ * ignored).
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#include <string.h>
+#include "std_types.h"
+#include "tacho_countries.h"
+#include "tacho.h"
+#include "tacho_d8.h"
+#include "tacho_ctx.h"
+#include "tacho_checksum.h"
+#include "tacho_encode.h"
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#define TACHO_VDO_CARD_TYPE 0x04  /**< Card type byte preceding the nation code in VDO's DIN */
+#define TACHO_VDO_DIN_SIZE (TACHO_VDO_CC_POS + 1 + TACHO_MAX_CARD_NR)  /**< Size of a present VDO DIN */
+#define TACHO_SR_ENCODE_MSG_LEN TACHO_SR_MSG_LEN_MAX  /**< Message length of encoded Stoneridge frames */
+#define TACHO_SR_EMPTY_DIN 0xFF  /**< Stoneridge DIN field filler when no card is inserted */
+
+/******************************************************************************/
+/*    PRIVATE FUNCTIONS                                                       */
+/******************************************************************************/
+
+static uint16_t Tacho_EncodeVdoDIN(const Tacho_DriverID_t *driver, uint8_t *out);
+static void Tacho_EncodeU32(uint32_t value, uint8_t *out);
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+/**
+ * Builds a VDO frame
+ * Frames are 70, 88 or 106 bytes long for no, one or two cards with a 17-byte
+ * VIN and a 14-byte custom string.
+ * @param frame[in] Real-time data and driver IDs
+ * @param vin[in] Vehicle identification number
+ * @param vin_len Number of bytes in vin
+ * @param cstr[in] Custom string
+ * @param cstr_len Number of bytes in cstr
+ * @param out[out] Encoded frame
+ * @param size Size of out in bytes
+ * @return Frame length, 0 if the frame does not fit in out or in TACHO_FRAME_MAX
+ */
+uint16_t Tacho_EncodeVdo(const Tacho_Frame_t *frame, const uint8_t *vin, uint8_t vin_len,
+                         const uint8_t *cstr, uint8_t cstr_len, uint8_t *out, uint16_t size)
+{
+    static const uint8_t start_seq[TACHO_VDO_SEQSZ] = {TACHO_VDO_START_SEQ};
+    uint8_t din[TACHO_MAX_DRIVERS][TACHO_VDO_DIN_SIZE + 1];
+    uint16_t din_len[TACHO_MAX_DRIVERS];
+    uint16_t length;
+    uint16_t pos;
+    uint8_t i;
+
+    length = TACHO_VDO_VIN_LENGTH + 1 + vin_len + 1 + cstr_len + 1;
+    for (i = 0; i < TACHO_MAX_DRIVERS; i++)
+    {
+        din_len[i] = Tacho_EncodeVdoDIN(&frame->driver[i], din[i]);
+        length += din_len[i];
+    }
+    if ( (length > size) || (length > TACHO_FRAME_MAX) )
+    {
+        return 0;
+    }
+
+    memset(out, 0, TACHO_VDO_VIN_LENGTH);
+    memcpy(out, start_seq, TACHO_VDO_SEQSZ);
+    out[TACHO_VDO_WORKING_STATE] = frame->working_state;
+    out[TACHO_VDO_DRV1_STATE] = frame->driver1_state;
+    out[TACHO_VDO_DRV2_STATE] = frame->driver2_state;
+    out[TACHO_VDO_STATUS] = frame->tacho_status;
+    out[TACHO_VDO_SPEED_LSB] = frame->speed_lsb;
+    out[TACHO_VDO_SPEED_MSB] = frame->speed_msb;
+    out[TACHO_VDO_UTC_SECONDS] = frame->vdo.time.seconds;
+    out[TACHO_VDO_UTC_MINUTES] = frame->vdo.time.minutes;
+    out[TACHO_VDO_UTC_HOURS] = frame->vdo.time.hours;
+    out[TACHO_VDO_UTC_MONTH] = frame->vdo.time.month;
+    out[TACHO_VDO_UTC_DAY] = frame->vdo.time.day;
+    out[TACHO_VDO_UTC_YEAR] = frame->vdo.time.year;
+    out[TACHO_VDO_LOCAL_MIN_OFFSET] = frame->vdo.time.local_min_offset;
+    out[TACHO_VDO_LOCAL_HOUR_OFFSET] = frame->vdo.time.local_hour_offset;
+    Tacho_EncodeU32(frame->vdo.odometer, &out[TACHO_VDO_ODOMETER]);
+    Tacho_EncodeU32(frame->vdo.trip, &out[TACHO_VDO_TRIP]);
+    out[TACHO_VDO_K_FACTOR] = (uint8_t) frame->vdo.k_factor;
+    out[TACHO_VDO_K_FACTOR + 1] = (uint8_t) (frame->vdo.k_factor >> 8);
+
+    pos = TACHO_VDO_VIN_LENGTH;
+    out[pos++] = vin_len;
+    memcpy(&out[pos], vin, vin_len);
+    pos += vin_len;
+    out[pos++] = cstr_len;
+    memcpy(&out[pos], cstr, cstr_len);
+    pos += cstr_len;
+    for (i = 0; i < TACHO_MAX_DRIVERS; i++)
+    {
+        memcpy(&out[pos], din[i], din_len[i]);
+        pos += din_len[i];
+    }
+
+    out[pos] = Tacho_ChecksumXor(&out[TACHO_VDO_SEQSZ], pos - TACHO_VDO_SEQSZ, TACHO_VDO_CRC_INIT);
+    return length;
+}
+
+/**
+ * Builds a Stoneridge frame
+ * VIN and VRN messages carry text in the custom field, DIN messages carry
+ * the ID of the corresponding driver.
+ * @param frame[in] Real-time data and driver IDs
+ * @param msg_id Message identifier (Tacho_StoneridgeMsgID_t)
+ * @param text[in] VIN or VRN text (ignored for DIN messages, may be NULL)
+ * @param text_len Number of bytes in text, truncated to the custom field size
+ * @param out[out] Encoded frame
+ * @param size Size of out in bytes
+ * @return Frame length, 0 if the frame does not fit in out or msg_id is not known
+ */
+uint16_t Tacho_EncodeStoneridge(const Tacho_Frame_t *frame, uint8_t msg_id,
+                                const uint8_t *text, uint8_t text_len, uint8_t *out, uint16_t size)
+{
+    static const uint8_t start_seq[TACHO_SR_SEQSZ] = {TACHO_SR_START_SEQ};
+    const uint16_t length = TACHO_SR_MSG_LEN + TACHO_SR_ENCODE_MSG_LEN;
+    const uint8_t custom_size = (uint8_t) (length - 1 - TACHO_SR_CUSTOM);
+    const Tacho_DriverID_t *driver;
+    uint8_t *custom;
+    uint8_t sum;
+
+    if (length > size)
+    {
+        return 0;
+    }
+
+    memset(out, 0, length);
+    memcpy(out, start_seq, TACHO_SR_SEQSZ);
+    out[TACHO_SR_MSG_LEN] = TACHO_SR_ENCODE_MSG_LEN;
+    out[TACHO_SR_MSG_ID] = msg_id;
+    out[TACHO_SR_WORKING_STATE] = frame->working_state;
+    out[TACHO_SR_DRV1_STATE] = frame->driver1_state;
+    out[TACHO_SR_DRV2_STATE] = frame->driver2_state;
+    out[TACHO_SR_STATUS] = frame->tacho_status;
+    out[TACHO_SR_SPEED_MSB] = frame->speed_msb;
+    out[TACHO_SR_SPEED_LSB] = frame->speed_lsb;
+
+    custom = &out[TACHO_SR_CUSTOM];
+    switch (msg_id)
+    {
+    case TACHO_SR_MSG_VIN:
+    case TACHO_SR_MSG_VRN:
+        memset(custom, ' ', custom_size);
+        memcpy(custom, text, MIN(text_len, custom_size));
+        break;
+
+    case TACHO_SR_MSG_DIN1:
+    case TACHO_SR_MSG_DIN2:
+        driver = &frame->driver[(TACHO_SR_MSG_DIN1 == msg_id) ? 0 : 1];
+        if (driver->cardnr[0] == '\0')
+        {
+            memset(custom, TACHO_SR_EMPTY_DIN, custom_size);
+        }
+        else
+        {
+            memset(custom, ' ', custom_size);
+            memcpy(custom, driver->country, TACHO_MAX_COUNTRY_CODE);
+            memcpy(&custom[TACHO_MAX_COUNTRY_CODE], driver->cardnr, TACHO_MAX_CARD_NR);
+        }
+        break;
+
+    default:
+        return 0;
+    }
+
+    sum = Tacho_ChecksumSum(&out[TACHO_SR_MSG_LEN], length - 1 - TACHO_SR_MSG_LEN, 0);
+    out[length - 1] = (uint8_t) (~sum + 1);
+    return length;
+}
+
+/**
+ * Builds the DIN field of a VDO frame
+ * @param driver[in] Driver ID
+ * @param out[out] DIN field, starting with its length byte
+ * @return Number of bytes written (1 if no card is inserted)
+ */
+static uint16_t Tacho_EncodeVdoDIN(const Tacho_DriverID_t *driver, uint8_t *out)
+{
+    uint8_t code;
+
+    if (driver->cardnr[0] == '\0')
+    {
+        out[0] = 0;
+        return 1;
+    }
+
+    if (E_OK != Tacho_GetNationCode(driver->country, &code))
+    {
+        code = 0;
+    }
+    out[0] = TACHO_VDO_DIN_SIZE;
+    out[1] = TACHO_VDO_CARD_TYPE;
+    out[1 + TACHO_VDO_CC_POS] = code;
+    memcpy(&out[2 + TACHO_VDO_CC_POS], driver->cardnr, TACHO_MAX_CARD_NR);
+    return TACHO_VDO_DIN_SIZE + 1;
+}
+
+/**
+ * Writes a 32-bit value LSB first
+ * @param value Value
+ * @param out[out] First byte
+ */
+static void Tacho_EncodeU32(uint32_t value, uint8_t *out)
+{
+    out[0] = (uint8_t) value;
+    out[1] = (uint8_t) (value >> 8);
+    out[2] = (uint8_t) (value >> 16);
+    out[3] = (uint8_t) (value >> 24);
+}
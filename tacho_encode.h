@@ -0,0 +1,24 @@
+/**
+ * @file tacho_encode.h
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Tachograph D8 frame encoder (VDO and Stoneridge)
+ *
+ * Builds valid D8 frames from decoded data, e.g. to feed the decoder from a
+ * host-side simulator or benchmark.
+ */
+
+#ifndef TACHO_ENCODE_H
+#define	TACHO_ENCODE_H
+
+/******************************************************************************/
+/*    PUBLIC FUNCTIONS                                                        */
+/******************************************************************************/
+
+uint16_t Tacho_EncodeVdo(const Tacho_Frame_t *frame, const uint8_t *vin, uint8_t vin_len,
+                         const uint8_t *cstr, uint8_t cstr_len, uint8_t *out, uint16_t size);
+uint16_t Tacho_EncodeStoneridge(const Tacho_Frame_t *frame, uint8_t msg_id,
+                                const uint8_t *text, uint8_t text_len, uint8_t *out, uint16_t size);
+
+#endif	/* TACHO_ENCODE_H */
@@ -0,0 +1,346 @@
+/**
+ * @file tacho_index.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Time index of a raw D8 capture
+ *
+ * A record is only written once the time has grown by at least the index
+ * interval since the previous one: frames whose clock went back (clock
+ * adjusted, capture of another vehicle appended) are not recorded until
+ * the time catches up again.
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#include "std_types.h"
+#include "tacho_countries.h"
+#include "tacho.h"
+#include "tacho_d8.h"
+#include "tacho_ctx.h"
+#include "tacho_index.h"
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#define TACHO_INDEX_EPOCH_YEAR 1985  /**< Year of the D8 date epoch */
+#define TACHO_INDEX_SECONDS_PER_DAY 86400U
+#define TACHO_INDEX_MAX_YEARS 136  /**< Years since the epoch that fit in 32-bit seconds */
+
+/** Number of leap years from year 1 up to year _y included */
+#define TACHO_INDEX_LEAPS(_y) ( ((_y) / 4) - ((_y) / 100) + ((_y) / 400) )
+
+/******************************************************************************/
+/*    PRIVATE FUNCTIONS                                                       */
+/******************************************************************************/
+
+static uint32_t Tacho_IndexFrameTime(const uint8_t *frame);
+static void Tacho_IndexPutRecord(Tacho_IndexBuilder_t *builder, const Tacho_IndexEntry_t *entry);
+static void Tacho_IndexPutU32(uint8_t *buf, uint32_t value);
+static uint32_t Tacho_IndexGetU32(const uint8_t *buf);
+
+/******************************************************************************/
+/*    PRIVATE DATA                                                            */
+/******************************************************************************/
+
+/** Days before the first day of each month in a non-leap year */
+static const uint16_t Tacho_IndexMonthDays[12] = { 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334 };
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+/**
+ * Starts building an index
+ * @param builder Index builder
+ * @param out[out] Index buffer (TACHO_INDEX_HEADER_SIZE bytes, plus
+ *  TACHO_INDEX_RECORD_SIZE bytes per record)
+ * @param size Size of out
+ * @param interval Minimum time between two records in seconds, 0 to record
+ *  every frame
+ */
+void Tacho_IndexInit(Tacho_IndexBuilder_t *builder, uint8_t *out, uint32_t size, uint32_t interval)
+{
+    builder->out = out;
+    builder->size = size;
+    builder->count = 0;
+    builder->interval = interval;
+    builder->last_time = 0;
+    builder->offset = 0;
+    builder->full = (bool_t) (size < TACHO_INDEX_HEADER_SIZE);
+}
+
+/**
+ * Indexes the next bytes of a capture
+ * The bytes after the last complete frame may hold the start of a frame:
+ * they are not consumed, and must be passed again at the start of buf on
+ * the next call (a whole capture may also be passed at once).
+ * @param builder Index builder
+ * @param buf[in] Capture bytes following the ones already consumed
+ * @param len Number of bytes in buf
+ * @param rx_time Receive time of buf in seconds since 1 Jan 1985 00:00 UTC
+ *  (stamps the frames without a clock), TACHO_INDEX_NO_TIME if unknown
+ * @return Number of bytes consumed
+ */
+uint32_t Tacho_IndexAdd(Tacho_IndexBuilder_t *builder, const uint8_t *buf, uint32_t len, uint32_t rx_time)
+{
+    Tacho_IndexEntry_t entry;
+    uint32_t pos = 0;
+    uint32_t start;
+    uint16_t length;
+
+    while (pos < len)
+    {
+        start = pos + Tacho_DetectFrame(&buf[pos], len - pos, &entry.standard);
+        if (start >= len)
+        {
+            break;
+        }
+        length = Tacho_ValidFrameLength(entry.standard, &buf[start], len - start);
+
+        entry.time = TACHO_INDEX_NO_TIME;
+        entry.source = TACHO_INDEX_FRAME_TIME;
+        if (TACHO_STANDARD_VDO == entry.standard)
+        {
+            entry.time = Tacho_IndexFrameTime(&buf[start]);
+        }
+        if (TACHO_INDEX_NO_TIME == entry.time)
+        {
+            entry.time = rx_time;
+            entry.source = TACHO_INDEX_RX_TIME;
+        }
+
+        if ( (TACHO_INDEX_NO_TIME != entry.time) &&
+             ( (0 == builder->count) ||
+               ( (entry.time >= builder->last_time) && (entry.time - builder->last_time >= builder->interval) ) ) )
+        {
+            entry.offset = builder->offset + start;
+            Tacho_IndexPutRecord(builder, &entry);
+        }
+        pos = start + length;
+    }
+
+    /* A frame starting earlier than TACHO_FRAME_MAX - 1 bytes from the end would have been complete */
+    if ( (len > TACHO_FRAME_MAX - 1) && (pos < len - (TACHO_FRAME_MAX - 1)) )
+    {
+        pos = len - (TACHO_FRAME_MAX - 1);
+    }
+    builder->offset += pos;
+
+    return pos;
+}
+
+/**
+ * Completes an index
+ * @param builder Index builder
+ * @return Size of the index in bytes, 0 if out was too small for every record
+ */
+uint32_t Tacho_IndexFinish(Tacho_IndexBuilder_t *builder)
+{
+    uint8_t *out = builder->out;
+
+    if (builder->full)
+    {
+        return 0;
+    }
+
+    out[0] = 'T';
+    out[1] = 'I';
+    out[2] = TACHO_INDEX_VERSION;
+    out[3] = TACHO_INDEX_RECORD_SIZE;
+    Tacho_IndexPutU32(&out[4], builder->interval);
+    Tacho_IndexPutU32(&out[8], builder->count);
+
+    return TACHO_INDEX_HEADER_SIZE + (builder->count * TACHO_INDEX_RECORD_SIZE);
+}
+
+/**
+ * Opens an index for lookups
+ * @param buf[in] Index (must outlive index)
+ * @param size Size of buf in bytes
+ * @param index[out] Opened index
+ * @return E_OK if buf holds a complete index, E_NOT_OK otherwise
+ */
+Std_ReturnType Tacho_IndexOpen(const uint8_t *buf, uint32_t size, Tacho_Index_t *index)
+{
+    uint32_t count;
+
+    if ( (TACHO_INDEX_HEADER_SIZE > size) || ('T' != buf[0]) || ('I' != buf[1]) ||
+         (TACHO_INDEX_VERSION != buf[2]) || (TACHO_INDEX_RECORD_SIZE != buf[3]) )
+    {
+        return E_NOT_OK;
+    }
+    count = Tacho_IndexGetU32(&buf[8]);
+    if (count > (size - TACHO_INDEX_HEADER_SIZE) / TACHO_INDEX_RECORD_SIZE)
+    {
+        return E_NOT_OK;
+    }
+
+    index->record = &buf[TACHO_INDEX_HEADER_SIZE];
+    index->count = count;
+    index->interval = Tacho_IndexGetU32(&buf[4]);
+
+    return E_OK;
+}
+
+/**
+ * Reads a record of an index
+ * @param index[in] Opened index
+ * @param pos Record number
+ * @param entry[out] Record
+ * @return E_OK if the record exists, E_NOT_OK otherwise
+ */
+Std_ReturnType Tacho_IndexGet(const Tacho_Index_t *index, uint32_t pos, Tacho_IndexEntry_t *entry)
+{
+    const uint8_t *record;
+
+    if (pos >= index->count)
+    {
+        return E_NOT_OK;
+    }
+    record = &index->record[pos * TACHO_INDEX_RECORD_SIZE];
+
+    entry->time = Tacho_IndexGetU32(record);
+    entry->offset = Tacho_IndexGetU32(&record[4]) | ((uint64_t) record[8] << 32) | ((uint64_t) record[9] << 40);
+    entry->standard = (Tacho_Standard_t) record[10];
+    entry->source = (Tacho_IndexSource_t) record[11];
+
+    return E_OK;
+}
+
+/**
+ * Finds where to start decoding a capture to reach a given time
+ * Returns the last record before time: decoding from its offset reaches
+ * the first frame at or after time within the index interval (frames
+ * before time are up to the application to skip, see Tacho_IndexTime()).
+ * @param index[in] Opened index
+ * @param time Seconds since 1 Jan 1985 00:00 UTC
+ * @param entry[out] Record to start from (the first one if time precedes it)
+ * @return E_OK if entry was found, E_NOT_OK if the index is empty
+ */
+Std_ReturnType Tacho_IndexSeek(const Tacho_Index_t *index, uint32_t time, Tacho_IndexEntry_t *entry)
+{
+    uint32_t low = 0;
+    uint32_t high = index->count;
+    uint32_t mid;
+
+    /* Find the first record at or after time */
+    while (low < high)
+    {
+        mid = low + ((high - low) / 2);
+        if (Tacho_IndexGetU32(&index->record[mid * TACHO_INDEX_RECORD_SIZE]) < time)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return Tacho_IndexGet(index, (0 != low) ? (low - 1) : 0, entry);
+}
+
+/**
+ * Converts a D8 date and time to index time
+ * @param time[in] Decoded UTC date and time (e.g. Tacho_VdoInfo_t.time)
+ * @return Seconds since 1 Jan 1985 00:00 UTC, TACHO_INDEX_NO_TIME if the
+ *  date or time is not valid (clock not set)
+ */
+uint32_t Tacho_IndexTime(const Tacho_DateTime_t *time)
+{
+    uint32_t year = TACHO_INDEX_EPOCH_YEAR + (uint32_t) time->year;
+    uint32_t days;
+
+    if ( (TACHO_INDEX_MAX_YEARS <= time->year) || (0 == time->day) || (124 < time->day) || (0 == time->month) || (12 < time->month) ||
+         (24 <= time->hours) || (60 <= time->minutes) || (240 <= time->seconds) )
+    {
+        return TACHO_INDEX_NO_TIME;
+    }
+
+    days = (365U * time->year) + TACHO_INDEX_LEAPS(year - 1) - TACHO_INDEX_LEAPS(TACHO_INDEX_EPOCH_YEAR - 1);
+    days += Tacho_IndexMonthDays[time->month - 1];
+    if ( (2 < time->month) && (0 == year % 4) && ( (0 != year % 100) || (0 == year % 400) ) )
+    {
+        days++;
+    }
+    /* 0.25 day/bit, 1 to 4 being the first day of the month */
+    days += ((uint32_t) time->day - 1) / 4;
+
+    return (days * TACHO_INDEX_SECONDS_PER_DAY) + (time->hours * 3600U) + (time->minutes * 60U) + (time->seconds / 4U);
+}
+
+/**
+ * Time of the clock carried by a VDO frame
+ * @param frame[in] Complete VDO frame, starting with the start sequence
+ * @return See Tacho_IndexTime()
+ */
+static uint32_t Tacho_IndexFrameTime(const uint8_t *frame)
+{
+    Tacho_DateTime_t time;
+
+    time.seconds = frame[TACHO_VDO_UTC_SECONDS];
+    time.minutes = frame[TACHO_VDO_UTC_MINUTES];
+    time.hours = frame[TACHO_VDO_UTC_HOURS];
+    time.month = frame[TACHO_VDO_UTC_MONTH];
+    time.day = frame[TACHO_VDO_UTC_DAY];
+    time.year = frame[TACHO_VDO_UTC_YEAR];
+    time.local_min_offset = frame[TACHO_VDO_LOCAL_MIN_OFFSET];
+    time.local_hour_offset = frame[TACHO_VDO_LOCAL_HOUR_OFFSET];
+
+    return Tacho_IndexTime(&time);
+}
+
+/**
+ * Appends a record to an index
+ * @param builder Index builder
+ * @param entry[in] Record
+ */
+static void Tacho_IndexPutRecord(Tacho_IndexBuilder_t *builder, const Tacho_IndexEntry_t *entry)
+{
+    uint8_t *record;
+
+    if ( builder->full ||
+         ( (builder->size - TACHO_INDEX_HEADER_SIZE) / TACHO_INDEX_RECORD_SIZE <= builder->count ) )
+    {
+        builder->full = TRUE;
+        return;
+    }
+    record = &builder->out[TACHO_INDEX_HEADER_SIZE + (builder->count * TACHO_INDEX_RECORD_SIZE)];
+
+    Tacho_IndexPutU32(record, entry->time);
+    Tacho_IndexPutU32(&record[4], (uint32_t) entry->offset);
+    record[8] = (uint8_t) (entry->offset >> 32);
+    record[9] = (uint8_t) (entry->offset >> 40);
+    record[10] = (uint8_t) entry->standard;
+    record[11] = (uint8_t) entry->source;
+
+    builder->count++;
+    builder->last_time = entry->time;
+}
+
+/**
+ * Writes a 32-bit value LSB first
+ * @param buf[out] Destination (4 bytes)
+ * @param value Value
+ */
+static void Tacho_IndexPutU32(uint8_t *buf, uint32_t value)
+{
+    buf[0] = (uint8_t) value;
+    buf[1] = (uint8_t) (value >> 8);
+    buf[2] = (uint8_t) (value >> 16);
+    buf[3] = (uint8_t) (value >> 24);
+}
+
+/**
+ * Reads a 32-bit value sent LSB first
+ * @param buf[in] Source (4 bytes)
+ * @return Value
+ */
+static uint32_t Tacho_IndexGetU32(const uint8_t *buf)
+{
+    return buf[0] | ((uint32_t) buf[1] << 8) | ((uint32_t) buf[2] << 16) | ((uint32_t) buf[3] << 24);
+}
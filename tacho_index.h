@@ -0,0 +1,88 @@
+/**
+ * @file tacho_index.h
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Time index of a raw D8 capture
+ *
+ * The index records the time, byte offset and protocol of the frames of a
+ * capture, at most one record every interval seconds, so that a query for a
+ * given time starts decoding close to it instead of at the start of the
+ * capture. Frames are located the way Tacho_DetectFrame() does (start
+ * sequence automaton, then length and checksum). VDO frames are stamped
+ * with their own UTC clock; frames without a clock (Stoneridge, or a VDO
+ * clock not set) with the receive time given by the application, if any.
+ *
+ * Index layout (little endian), meant to be stored next to the capture:
+ *  - 'T' 'I', version, record size, interval (32-bit), number of records (32-bit)
+ *  - records of TACHO_INDEX_RECORD_SIZE bytes, in capture order:
+ *    time (32-bit), offset (48-bit), protocol, time source
+ * Times only grow from one record to the next, so a lookup is a binary
+ * search working in place on the index (e.g. an mmap()ed sidecar file).
+ */
+
+#ifndef TACHO_INDEX_H
+#define	TACHO_INDEX_H
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#define TACHO_INDEX_VERSION 1  /**< Index format version */
+#define TACHO_INDEX_HEADER_SIZE 12  /**< Size of the index header in bytes */
+#define TACHO_INDEX_RECORD_SIZE 12  /**< Size of a record in bytes */
+#define TACHO_INDEX_NO_TIME 0xFFFFFFFFUL  /**< No receive time available */
+
+/******************************************************************************/
+/*    PUBLIC TYPES                                                            */
+/******************************************************************************/
+
+/** Source of the time of a record */
+typedef enum
+{
+    TACHO_INDEX_FRAME_TIME,  /**< Clock carried by the frame (VDO) */
+    TACHO_INDEX_RX_TIME  /**< Receive time given by the application */
+} Tacho_IndexSource_t;
+
+/** Index record */
+typedef struct
+{
+    uint32_t time;  /**< Seconds since 1 Jan 1985 00:00 UTC (D8 date epoch) */
+    uint64_t offset;  /**< Offset of the frame start sequence in the capture */
+    Tacho_Standard_t standard;  /**< Frame protocol */
+    Tacho_IndexSource_t source;  /**< Source of time */
+} Tacho_IndexEntry_t;
+
+/** Index being built */
+typedef struct
+{
+    uint8_t *out;  /**< Index buffer */
+    uint32_t size;  /**< Size of out */
+    uint32_t count;  /**< Number of records written */
+    uint32_t interval;  /**< Minimum time between two records in seconds (0 records every frame) */
+    uint32_t last_time;  /**< Time of the last record */
+    uint64_t offset;  /**< Capture offset of the next byte passed to Tacho_IndexAdd() */
+    bool_t full;  /**< A record did not fit in out */
+} Tacho_IndexBuilder_t;
+
+/** Index opened for lookups (points into the index) */
+typedef struct
+{
+    const uint8_t *record;  /**< First record */
+    uint32_t count;  /**< Number of records */
+    uint32_t interval;  /**< Interval the index was built with */
+} Tacho_Index_t;
+
+/******************************************************************************/
+/*    PUBLIC FUNCTIONS                                                        */
+/******************************************************************************/
+
+void Tacho_IndexInit(Tacho_IndexBuilder_t *builder, uint8_t *out, uint32_t size, uint32_t interval);
+uint32_t Tacho_IndexAdd(Tacho_IndexBuilder_t *builder, const uint8_t *buf, uint32_t len, uint32_t rx_time);
+uint32_t Tacho_IndexFinish(Tacho_IndexBuilder_t *builder);
+Std_ReturnType Tacho_IndexOpen(const uint8_t *buf, uint32_t size, Tacho_Index_t *index);
+Std_ReturnType Tacho_IndexGet(const Tacho_Index_t *index, uint32_t pos, Tacho_IndexEntry_t *entry);
+Std_ReturnType Tacho_IndexSeek(const Tacho_Index_t *index, uint32_t time, Tacho_IndexEntry_t *entry);
+uint32_t Tacho_IndexTime(const Tacho_DateTime_t *time);
+
+#endif	/* TACHO_INDEX_H */
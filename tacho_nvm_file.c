@@ -0,0 +1,183 @@
+/**
+ * @file tacho_nvm_file.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * File-backed stand-in for the FRAM holding the decoder journal (host builds)
+ *
+ * Every memory file keeps its own size, cut-off and write counter, so
+ * contexts bound to different files never see each other's journal or
+ * power losses. Contexts sharing one file, like the contexts of a target
+ * share its FRAM, need journals at different addresses.
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#include <stdio.h>
+#include "std_types.h"
+#include "tacho_countries.h"
+#include "tacho.h"
+#include "tacho_d8.h"
+#include "tacho_ctx.h"
+#include "tacho_nvm_file.h"
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+/**
+ * Opens a memory file, creating it filled with 0xFF if it does not exist
+ * @param nvm[out] Memory file
+ * @param path File name
+ * @param size Memory size in bytes
+ * @return E_OK if the file is ready, E_NOT_OK otherwise
+ */
+Std_ReturnType Tacho_NvmFileOpen(Tacho_NvmFile_t *nvm, const char *path, uint16_t size)
+{
+    long length;
+
+    nvm->file = fopen(path, "r+b");
+    if (NULL_PTR == nvm->file)
+    {
+        nvm->file = fopen(path, "w+b");
+    }
+    if (NULL_PTR == nvm->file)
+    {
+        return E_NOT_OK;
+    }
+
+    /* Extend a new or shorter file to the memory size */
+    if ( (0 != fseek(nvm->file, 0, SEEK_END)) || (0 > (length = ftell(nvm->file))) )
+    {
+        Tacho_NvmFileClose(nvm);
+        return E_NOT_OK;
+    }
+    for (; length < (long) size; length++)
+    {
+        (void) fputc(0xFF, nvm->file);
+    }
+    if (0 != fflush(nvm->file))
+    {
+        Tacho_NvmFileClose(nvm);
+        return E_NOT_OK;
+    }
+
+    nvm->size = size;
+    nvm->cut = TACHO_NVM_FILE_NO_CUT;
+    nvm->bytes = 0;
+    return E_OK;
+}
+
+/**
+ * Closes a memory file
+ * @param nvm Memory file
+ */
+void Tacho_NvmFileClose(Tacho_NvmFile_t *nvm)
+{
+    if (NULL_PTR != nvm->file)
+    {
+        (void) fclose(nvm->file);
+        nvm->file = NULL_PTR;
+    }
+}
+
+/**
+ * Reads a memory file
+ * @param nvm Memory file
+ * @param addr Memory address
+ * @param buf[out] Bytes read
+ * @param len Number of bytes
+ * @return E_OK if all bytes were read, E_NOT_OK otherwise
+ */
+Std_ReturnType Tacho_NvmFileReadAt(Tacho_NvmFile_t *nvm, uint16_t addr, uint8_t *buf, uint16_t len)
+{
+    if ( (NULL_PTR == nvm->file) || ((uint32_t) addr + len > nvm->size) )
+    {
+        return E_NOT_OK;
+    }
+    if ( (0 != fseek(nvm->file, (long) addr, SEEK_SET)) || (len != fread(buf, 1, len, nvm->file)) )
+    {
+        return E_NOT_OK;
+    }
+    return E_OK;
+}
+
+/**
+ * Writes a memory file (flushed at once)
+ * Past the limit set by Tacho_NvmFileCutAfter() the bytes are dropped, as
+ * if the power was lost in the middle of the write.
+ * @param nvm Memory file
+ * @param addr Memory address
+ * @param buf[in] Bytes to write
+ * @param len Number of bytes
+ * @return E_OK if all bytes were written, E_NOT_OK otherwise
+ */
+Std_ReturnType Tacho_NvmFileWriteAt(Tacho_NvmFile_t *nvm, uint16_t addr, const uint8_t *buf, uint16_t len)
+{
+    uint16_t count = len;
+
+    if ( (NULL_PTR == nvm->file) || ((uint32_t) addr + len > nvm->size) )
+    {
+        return E_NOT_OK;
+    }
+    if (TACHO_NVM_FILE_NO_CUT != nvm->cut)
+    {
+        count = (uint16_t) MIN(len, nvm->cut);
+        nvm->cut -= count;
+    }
+    if ( (0 != fseek(nvm->file, (long) addr, SEEK_SET)) || (count != fwrite(buf, 1, count, nvm->file)) ||
+         (0 != fflush(nvm->file)) )
+    {
+        return E_NOT_OK;
+    }
+    nvm->bytes += count;
+    return (count == len) ? E_OK : E_NOT_OK;
+}
+
+/**
+ * read_nvm binding: reads the memory file of the context
+ * @param ctx Decoder context, its user pointer being a Tacho_NvmFile_t
+ * @param addr Memory address
+ * @param buf[out] Bytes read
+ * @param len Number of bytes
+ * @return See Tacho_NvmFileReadAt()
+ */
+Std_ReturnType Tacho_NvmFileRead(Tacho_Ctx_t *ctx, uint16_t addr, uint8_t *buf, uint16_t len)
+{
+    return Tacho_NvmFileReadAt((Tacho_NvmFile_t *) ctx->user, addr, buf, len);
+}
+
+/**
+ * write_nvm binding: writes the memory file of the context
+ * @param ctx Decoder context, its user pointer being a Tacho_NvmFile_t
+ * @param addr Memory address
+ * @param buf[in] Bytes to write
+ * @param len Number of bytes
+ * @return See Tacho_NvmFileWriteAt()
+ */
+Std_ReturnType Tacho_NvmFileWrite(Tacho_Ctx_t *ctx, uint16_t addr, const uint8_t *buf, uint16_t len)
+{
+    return Tacho_NvmFileWriteAt((Tacho_NvmFile_t *) ctx->user, addr, buf, len);
+}
+
+/**
+ * Simulates a power loss: only the next bytes are still written to a file
+ * @param nvm Memory file
+ * @param bytes Bytes written before the cut, TACHO_NVM_FILE_NO_CUT to write everything again
+ */
+void Tacho_NvmFileCutAfter(Tacho_NvmFile_t *nvm, uint32_t bytes)
+{
+    nvm->cut = bytes;
+}
+
+/**
+ * Bytes written in a memory file since it was opened (wear estimate)
+ * @param nvm[in] Memory file
+ * @return Number of bytes
+ */
+uint32_t Tacho_NvmFileWritten(const Tacho_NvmFile_t *nvm)
+{
+    return nvm->bytes;
+}
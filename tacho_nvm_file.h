@@ -0,0 +1,54 @@
+/**
+ * @file tacho_nvm_file.h
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * File-backed stand-in for the FRAM holding the decoder journal (host builds)
+ *
+ * Each Tacho_NvmFile_t is a memory file owned by the caller, so that the
+ * journal survives the test process like it survives a reset on target.
+ * Tacho_NvmFileRead() and Tacho_NvmFileWrite() are read_nvm and write_nvm
+ * bindings of Tacho_CtxConfig_t working on the memory file the context's
+ * user pointer points to; an application using the user pointer for more
+ * wraps Tacho_NvmFileReadAt() and Tacho_NvmFileWriteAt() instead.
+ * A power loss in the middle of a journal write is simulated by cutting the
+ * writes to a file after a given number of bytes.
+ * Needs <stdio.h>.
+ */
+
+#ifndef TACHO_NVM_FILE_H
+#define	TACHO_NVM_FILE_H
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#define TACHO_NVM_FILE_NO_CUT 0xFFFFFFFFUL  /**< Writes are never cut */
+
+/******************************************************************************/
+/*    PUBLIC TYPES                                                            */
+/******************************************************************************/
+
+/** Memory file */
+typedef struct
+{
+    FILE *file;  /**< Open file, NULL when closed */
+    uint16_t size;  /**< Memory size in bytes */
+    uint32_t cut;  /**< Bytes still written before the simulated power loss */
+    uint32_t bytes;  /**< Bytes written since the file was opened */
+} Tacho_NvmFile_t;
+
+/******************************************************************************/
+/*    PUBLIC FUNCTIONS                                                        */
+/******************************************************************************/
+
+Std_ReturnType Tacho_NvmFileOpen(Tacho_NvmFile_t *nvm, const char *path, uint16_t size);
+void Tacho_NvmFileClose(Tacho_NvmFile_t *nvm);
+Std_ReturnType Tacho_NvmFileReadAt(Tacho_NvmFile_t *nvm, uint16_t addr, uint8_t *buf, uint16_t len);
+Std_ReturnType Tacho_NvmFileWriteAt(Tacho_NvmFile_t *nvm, uint16_t addr, const uint8_t *buf, uint16_t len);
+Std_ReturnType Tacho_NvmFileRead(Tacho_Ctx_t *ctx, uint16_t addr, uint8_t *buf, uint16_t len);
+Std_ReturnType Tacho_NvmFileWrite(Tacho_Ctx_t *ctx, uint16_t addr, const uint8_t *buf, uint16_t len);
+void Tacho_NvmFileCutAfter(Tacho_NvmFile_t *nvm, uint32_t bytes);
+uint32_t Tacho_NvmFileWritten(const Tacho_NvmFile_t *nvm);
+
+#endif	/* TACHO_NVM_FILE_H */
@@ -0,0 +1,192 @@
+/**
+ * @file tacho_pool.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Tachograph decoder pool - many D8 streams serviced by one task
+ *
+ * The contexts of a pool point back to it through their user pointer, which
+ * is how the shared bindings find the sink and the stream index.
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#include "std_types.h"
+#include "tacho_countries.h"
+#include "tacho.h"
+#include "tacho_d8.h"
+#include "tacho_ctx.h"
+#include "tacho_pool.h"
+
+/******************************************************************************/
+/*    PRIVATE FUNCTIONS                                                       */
+/******************************************************************************/
+
+static void Tacho_PoolFrameNotif(Tacho_Ctx_t *ctx);
+static void Tacho_PoolChangeNotif(Tacho_Ctx_t *ctx, uint16_t dirty);
+static uint32_t Tacho_PoolGetTime(Tacho_Ctx_t *ctx);
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+/**
+ * Initializes a pool and the decoder context of each of its streams
+ * The streams have no UART or persistent memory bindings: they start with
+ * VDO and follow the protocol of the data when auto standard is enabled
+ * on their context.
+ * @param pool Decoder pool
+ * @param ctx[in] Storage for count contexts (must outlive the pool)
+ * @param count Number of streams
+ * @param sink[in] Receiver of the decoded data (must outlive the pool)
+ * @param user Opaque pointer stored in the pool for the application
+ */
+void Tacho_PoolInit(Tacho_Pool_t *pool, Tacho_Ctx_t *ctx, uint16_t count, const Tacho_PoolSink_t *sink, void *user)
+{
+    uint16_t i;
+
+    pool->ctx = ctx;
+    pool->count = count;
+    pool->next = 0;
+    pool->sink = sink;
+    pool->user = user;
+
+    pool->config.set_baudrate = NULL_PTR;
+    pool->config.read_protocol = NULL_PTR;
+    pool->config.write_protocol = NULL_PTR;
+    pool->config.tco1_notif = NULL_PTR;
+    pool->config.frame_notif = &Tacho_PoolFrameNotif;
+    pool->config.change_notif = &Tacho_PoolChangeNotif;
+    pool->config.get_time = (NULL_PTR != sink->get_time) ? &Tacho_PoolGetTime : NULL_PTR;
+    pool->config.read_nvm = NULL_PTR;
+    pool->config.write_nvm = NULL_PTR;
+    pool->config.wakeup = NULL_PTR;
+
+    for (i = 0; i < count; i++)
+    {
+        Tacho_CtxInit(&ctx[i], &pool->config, pool);
+    }
+}
+
+/**
+ * Decoder context of a stream
+ * @param pool Decoder pool
+ * @param stream Stream index
+ * @return Context of the stream, NULL_PTR if stream is out of range
+ */
+Tacho_Ctx_t *Tacho_PoolGetCtx(Tacho_Pool_t *pool, uint16_t stream)
+{
+    if (stream >= pool->count)
+    {
+        return NULL_PTR;
+    }
+    return &pool->ctx[stream];
+}
+
+/**
+ * Called each time a byte is received on a stream
+ * The byte is decoded by the next Tacho_PoolTask() call servicing the stream.
+ * @param pool Decoder pool
+ * @param stream Stream index (ignored if out of range)
+ * @param rx_byte Received byte
+ */
+void Tacho_PoolRxNotif(Tacho_Pool_t *pool, uint16_t stream, uint8_t rx_byte)
+{
+    if (stream < pool->count)
+    {
+        Tacho_CtxRxNotif(&pool->ctx[stream], rx_byte);
+    }
+}
+
+/**
+ * Called each time a block of bytes is received on a stream
+ * The block is decoded right away (see Tacho_CtxRxBlock()); a stream must be
+ * fed either through this function or through Tacho_PoolRxNotif().
+ * @param pool Decoder pool
+ * @param stream Stream index (ignored if out of range)
+ * @param buf[in] Received bytes
+ * @param len Number of bytes in buf
+ */
+void Tacho_PoolRxBlock(Tacho_Pool_t *pool, uint16_t stream, const uint8_t *buf, uint32_t len)
+{
+    if (stream < pool->count)
+    {
+        Tacho_CtxRxBlock(&pool->ctx[stream], buf, len);
+    }
+}
+
+/**
+ * Decodes the bytes received through Tacho_PoolRxNotif() (called periodically)
+ * Streams are visited round-robin, starting after the last one serviced by
+ * the previous call, so a budget smaller than the number of busy streams
+ * still services all of them in turn.
+ * @param pool Decoder pool
+ * @param budget Maximum number of streams to service in this call
+ * @return Number of streams serviced
+ */
+uint16_t Tacho_PoolTask(Tacho_Pool_t *pool, uint16_t budget)
+{
+    uint16_t serviced = 0;
+    uint16_t visited;
+    uint16_t stream = pool->next;
+
+    for (visited = 0; (visited < pool->count) && (serviced < budget); visited++)
+    {
+        if (Tacho_CtxRxPending(&pool->ctx[stream]))
+        {
+            Tacho_CtxTask(&pool->ctx[stream]);
+            serviced++;
+        }
+        stream++;
+        if (stream >= pool->count)
+        {
+            stream = 0;
+        }
+    }
+    pool->next = stream;
+
+    return serviced;
+}
+
+/**
+ * Forwards a decoded frame to the sink of the pool owning the context
+ * @param ctx Decoder context
+ */
+static void Tacho_PoolFrameNotif(Tacho_Ctx_t *ctx)
+{
+    Tacho_Pool_t *pool = (Tacho_Pool_t *) ctx->user;
+
+    if (NULL_PTR != pool->sink->frame)
+    {
+        pool->sink->frame(pool, (uint16_t) (ctx - pool->ctx), ctx);
+    }
+}
+
+/**
+ * Forwards the changes of a context to the sink of the pool owning it
+ * @param ctx Decoder context
+ * @param dirty TACHO_DIRTY_* changes since the last notification
+ */
+static void Tacho_PoolChangeNotif(Tacho_Ctx_t *ctx, uint16_t dirty)
+{
+    Tacho_Pool_t *pool = (Tacho_Pool_t *) ctx->user;
+
+    if (NULL_PTR != pool->sink->change)
+    {
+        pool->sink->change(pool, (uint16_t) (ctx - pool->ctx), ctx, dirty);
+    }
+}
+
+/**
+ * Timestamp of the sink of the pool owning a context
+ * @param ctx Decoder context
+ * @return Free-running timestamp
+ */
+static uint32_t Tacho_PoolGetTime(Tacho_Ctx_t *ctx)
+{
+    Tacho_Pool_t *pool = (Tacho_Pool_t *) ctx->user;
+
+    return pool->sink->get_time(pool);
+}
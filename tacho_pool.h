@@ -0,0 +1,55 @@
+/**
+ * @file tacho_pool.h
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Tachograph decoder pool - many D8 streams serviced by one task
+ *
+ * Each stream gets its own decoder context; the contexts share one set of
+ * bindings that forwards decoded data to a sink together with the stream
+ * index. A pool is serviced by a single task: to spread streams over
+ * several threads, give each thread its own pool.
+ */
+
+#ifndef TACHO_POOL_H
+#define	TACHO_POOL_H
+
+/******************************************************************************/
+/*    PUBLIC TYPES                                                            */
+/******************************************************************************/
+
+struct Tacho_Pool;
+
+/**
+ * Receiver of the data decoded by a pool
+ * Any callback may be NULL.
+ */
+typedef struct
+{
+    void (*frame)(struct Tacho_Pool *pool, uint16_t stream, Tacho_Ctx_t *ctx);  /**< Frame decoded, data available in ctx->frame and cached */
+    void (*change)(struct Tacho_Pool *pool, uint16_t stream, Tacho_Ctx_t *ctx, uint16_t dirty);  /**< TACHO_DIRTY_* changes since the last notification */
+    uint32_t (*get_time)(struct Tacho_Pool *pool);  /**< Free-running timestamp (statistics, frame history) */
+} Tacho_PoolSink_t;
+
+/** Decoder pool */
+typedef struct Tacho_Pool
+{
+    Tacho_Ctx_t *ctx;  /**< Contexts, one per stream (storage owned by the application) */
+    uint16_t count;  /**< Number of streams */
+    uint16_t next;  /**< Stream Tacho_PoolTask() looks at first */
+    Tacho_CtxConfig_t config;  /**< Bindings shared by the contexts */
+    const Tacho_PoolSink_t *sink;  /**< Receiver of the decoded data */
+    void *user;  /**< Opaque pointer owned by the application */
+} Tacho_Pool_t;
+
+/******************************************************************************/
+/*    PUBLIC FUNCTIONS                                                        */
+/******************************************************************************/
+
+void Tacho_PoolInit(Tacho_Pool_t *pool, Tacho_Ctx_t *ctx, uint16_t count, const Tacho_PoolSink_t *sink, void *user);
+Tacho_Ctx_t *Tacho_PoolGetCtx(Tacho_Pool_t *pool, uint16_t stream);
+void Tacho_PoolRxNotif(Tacho_Pool_t *pool, uint16_t stream, uint8_t rx_byte);
+void Tacho_PoolRxBlock(Tacho_Pool_t *pool, uint16_t stream, const uint8_t *buf, uint32_t len);
+uint16_t Tacho_PoolTask(Tacho_Pool_t *pool, uint16_t budget);
+
+#endif	/* TACHO_POOL_H */
@@ -0,0 +1,241 @@
+/**
+ * @file tacho_sync.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Tachograph D8 start sequence automaton
+ *
+ * The start sequences are inserted in a trie whose missing transitions are
+ * then resolved through the failure links (Aho-Corasick), giving a complete
+ * transition table. Bytes that appear in no start sequence share input
+ * class 0, which keeps the table small enough for the PIC24.
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#include "std_types.h"
+#include "tacho_countries.h"
+#include "tacho.h"
+#include "tacho_d8.h"
+#include "tacho_sync.h"
+
+/******************************************************************************/
+/*    PRIVATE TYPES                                                           */
+/******************************************************************************/
+
+/** Start sequence */
+typedef struct
+{
+    uint8_t seq[TACHO_SYNC_MAX_SEQ];
+    uint8_t size;
+    uint8_t id;
+} Tacho_SyncPattern_t;
+
+/******************************************************************************/
+/*    PRIVATE DATA                                                            */
+/******************************************************************************/
+
+/* Input classes of the built-in start sequence bytes, in the order Tacho_SyncBuild() assigns them */
+#define TACHO_SYNC_C_55 1U  /**< 0x55 */
+#define TACHO_SYNC_C_D 2U  /**< 'D' */
+#define TACHO_SYNC_C_T 3U  /**< 'T' */
+#define TACHO_SYNC_C_C 4U  /**< 'C' */
+#define TACHO_SYNC_C_O 5U  /**< 'O' */
+#define TACHO_SYNC_C_FF 6U  /**< 0xFF */
+
+/**
+ * Automaton of the built-in start sequences, as Tacho_SyncBuild() compiles
+ * TACHO_VDO_START_SEQ and TACHO_SR_START_SEQ (checked by test/test_sync.c).
+ * States 1 to 5 follow "UDTCO", states 6 to 8 a run of 0xFF.
+ */
+static const Tacho_SyncDfa_t Tacho_SyncBuiltinDfa =
+{
+    {
+        [0x55] = TACHO_SYNC_C_55, [0x44] = TACHO_SYNC_C_D, [0x54] = TACHO_SYNC_C_T,
+        [0x43] = TACHO_SYNC_C_C, [0x4F] = TACHO_SYNC_C_O, [0xFF] = TACHO_SYNC_C_FF
+    },
+    {
+        /*  -  55 D  T  C  O  FF */
+        {   0, 1, 0, 0, 0, 0, 6 },
+        {   0, 1, 2, 0, 0, 0, 6 },
+        {   0, 1, 0, 3, 0, 0, 6 },
+        {   0, 1, 0, 0, 4, 0, 6 },
+        {   0, 1, 0, 0, 0, 5, 6 },
+        {   0, 1, 0, 0, 0, 0, 6 },
+        {   0, 1, 0, 0, 0, 0, 7 },
+        {   0, 1, 0, 0, 0, 0, 8 },
+        {   0, 1, 0, 0, 0, 0, 8 }
+    },
+    {
+        [5] = TACHO_STANDARD_VDO + 1U, [8] = TACHO_STANDARD_STONERIDGE + 1U
+    }
+};
+
+/* The built-in table must fit the configured limits */
+typedef char Tacho_SyncBuiltinStates[(9 <= TACHO_SYNC_MAX_STATES) ? 1 : -1];
+typedef char Tacho_SyncBuiltinClasses[(7 <= TACHO_SYNC_MAX_CLASSES) ? 1 : -1];
+typedef char Tacho_SyncBuiltinPatterns[(TACHO_STANDARD_MAX <= TACHO_SYNC_MAX_PATTERNS) ? 1 : -1];
+
+/** Compiled start sequences, built-in ones first */
+static Tacho_SyncPattern_t Tacho_SyncPatterns[TACHO_SYNC_MAX_PATTERNS] =
+{
+    { {TACHO_VDO_START_SEQ}, TACHO_VDO_SEQSZ, TACHO_STANDARD_VDO },
+    { {TACHO_SR_START_SEQ}, TACHO_SR_SEQSZ, TACHO_STANDARD_STONERIDGE }
+};
+static uint8_t Tacho_SyncPatternCount = TACHO_STANDARD_MAX;  /**< Number of entries in Tacho_SyncPatterns */
+
+static Tacho_SyncDfa_t Tacho_SyncRamDfa;  /**< Automaton including the registered start sequences */
+
+/** Automaton used by all decoder contexts (built-in table until a start sequence is registered) */
+const Tacho_SyncDfa_t *Tacho_SyncDfa = &Tacho_SyncBuiltinDfa;
+
+/******************************************************************************/
+/*    PRIVATE FUNCTIONS                                                       */
+/******************************************************************************/
+
+static Std_ReturnType Tacho_SyncBuild(void);
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+/**
+ * Adds a start sequence to the automaton
+ * Must not be called while a context is decoding (on a threaded host,
+ * before the decoder threads start).
+ * @param seq[in] Start sequence
+ * @param size Number of bytes in seq
+ * @param id Value reported by Tacho_SyncMatch() for this sequence
+ *  (values below TACHO_STANDARD_MAX are decoded as the corresponding protocol)
+ * @return E_OK if the sequence was added, E_NOT_OK if it is invalid or does
+ *  not fit the automaton limits (the automaton is then left unchanged)
+ */
+Std_ReturnType Tacho_SyncRegister(const uint8_t *seq, uint8_t size, uint8_t id)
+{
+    Tacho_SyncPattern_t *pattern;
+    uint8_t i;
+
+    if ( (0 == size) || (TACHO_SYNC_MAX_SEQ < size) || (TACHO_SYNC_NONE == id) ||
+         (TACHO_SYNC_MAX_PATTERNS <= Tacho_SyncPatternCount) )
+    {
+        return E_NOT_OK;
+    }
+
+    pattern = &Tacho_SyncPatterns[Tacho_SyncPatternCount++];
+    for (i = 0; i < size; i++)
+    {
+        pattern->seq[i] = seq[i];
+    }
+    pattern->size = size;
+    pattern->id = id;
+
+    if (E_OK != Tacho_SyncBuild())
+    {
+        /* Back to the previous automaton (the built-in table needs no rebuild) */
+        Tacho_SyncPatternCount--;
+        if (TACHO_STANDARD_MAX < Tacho_SyncPatternCount)
+        {
+            (void) Tacho_SyncBuild();
+        }
+        return E_NOT_OK;
+    }
+    Tacho_SyncDfa = &Tacho_SyncRamDfa;
+    return E_OK;
+}
+
+/**
+ * Compiles the start sequences into Tacho_SyncRamDfa
+ * @return E_OK if the automaton fits the configured limits, E_NOT_OK otherwise
+ */
+static Std_ReturnType Tacho_SyncBuild(void)
+{
+    Tacho_SyncDfa_t *dfa = &Tacho_SyncRamDfa;
+    uint8_t fail[TACHO_SYNC_MAX_STATES];
+    uint8_t queue[TACHO_SYNC_MAX_STATES];
+    uint8_t states = 1;
+    uint8_t classes = 1;
+    uint8_t head = 0;
+    uint8_t tail = 0;
+    uint8_t state, next;
+    uint8_t p, i, c;
+    uint16_t b;
+
+    for (b = 0; b < 256; b++)
+    {
+        dfa->byte_class[b] = 0;
+    }
+    for (state = 0; state < TACHO_SYNC_MAX_STATES; state++)
+    {
+        for (c = 0; c < TACHO_SYNC_MAX_CLASSES; c++)
+        {
+            dfa->next[state][c] = 0;
+        }
+        dfa->match[state] = 0;
+    }
+
+    /* Trie of the start sequences (state 0 is the root, so 0 means "no edge") */
+    for (p = 0; p < Tacho_SyncPatternCount; p++)
+    {
+        state = 0;
+        for (i = 0; i < Tacho_SyncPatterns[p].size; i++)
+        {
+            b = Tacho_SyncPatterns[p].seq[i];
+            if (0 == dfa->byte_class[b])
+            {
+                if (TACHO_SYNC_MAX_CLASSES <= classes)
+                {
+                    return E_NOT_OK;
+                }
+                dfa->byte_class[b] = classes++;
+            }
+            c = dfa->byte_class[b];
+            if (0 == dfa->next[state][c])
+            {
+                if (TACHO_SYNC_MAX_STATES <= states)
+                {
+                    return E_NOT_OK;
+                }
+                dfa->next[state][c] = states++;
+            }
+            state = dfa->next[state][c];
+        }
+        dfa->match[state] = (uint8_t) (Tacho_SyncPatterns[p].id + 1U);
+    }
+
+    /* Breadth-first: resolve missing edges through the failure link of each state */
+    for (c = 0; c < classes; c++)
+    {
+        next = dfa->next[0][c];
+        if (0 != next)
+        {
+            fail[next] = 0;
+            queue[tail++] = next;
+        }
+    }
+    while (head < tail)
+    {
+        state = queue[head++];
+        for (c = 0; c < classes; c++)
+        {
+            next = dfa->next[state][c];
+            if (0 != next)
+            {
+                fail[next] = dfa->next[fail[state]][c];
+                if (0 == dfa->match[next])
+                {
+                    /* Longest start sequence that is a suffix of this one */
+                    dfa->match[next] = dfa->match[fail[next]];
+                }
+                queue[tail++] = next;
+            }
+            else
+            {
+                dfa->next[state][c] = dfa->next[fail[state]][c];
+            }
+        }
+    }
+
+    return E_OK;
+}
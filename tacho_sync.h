@@ -0,0 +1,87 @@
+/**
+ * @file tacho_sync.h
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Tachograph D8 start sequence automaton
+ *
+ * All known start sequences (VDO, Stoneridge and any registered one) are
+ * compiled into a single DFA, so frame starts of every protocol are found in
+ * one pass with one table lookup per byte, overlapping prefixes included.
+ * The automaton of the built-in sequences is a constant table, so contexts
+ * need no initialization and may run on any thread; Tacho_SyncRegister()
+ * switches them to a table built in RAM.
+ */
+
+#ifndef TACHO_SYNC_H
+#define	TACHO_SYNC_H
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+/** Maximum number of start sequences (built-in ones included) */
+#ifndef TACHO_SYNC_MAX_PATTERNS
+#define TACHO_SYNC_MAX_PATTERNS 4
+#endif
+
+/** Maximum start sequence size in bytes */
+#ifndef TACHO_SYNC_MAX_SEQ
+#define TACHO_SYNC_MAX_SEQ 8
+#endif
+
+/** Maximum number of automaton states (root included) */
+#ifndef TACHO_SYNC_MAX_STATES
+#define TACHO_SYNC_MAX_STATES 24
+#endif
+
+/** Maximum number of byte classes (distinct start sequence bytes + 1) */
+#ifndef TACHO_SYNC_MAX_CLASSES
+#define TACHO_SYNC_MAX_CLASSES 16
+#endif
+
+#define TACHO_SYNC_NONE 0xFF  /**< No start sequence ends at this state */
+
+/******************************************************************************/
+/*    PUBLIC TYPES                                                            */
+/******************************************************************************/
+
+/** Start sequence automaton */
+typedef struct
+{
+    uint8_t byte_class[256];  /**< Byte value to input class */
+    uint8_t next[TACHO_SYNC_MAX_STATES][TACHO_SYNC_MAX_CLASSES];  /**< Transition table */
+    uint8_t match[TACHO_SYNC_MAX_STATES];  /**< ID + 1 of the longest start sequence ending at each state (0 if none) */
+} Tacho_SyncDfa_t;
+
+/** Automaton used by all decoder contexts (built-in table until a start sequence is registered) */
+extern const Tacho_SyncDfa_t *Tacho_SyncDfa;
+
+/******************************************************************************/
+/*    PUBLIC FUNCTIONS                                                        */
+/******************************************************************************/
+
+Std_ReturnType Tacho_SyncRegister(const uint8_t *seq, uint8_t size, uint8_t id);
+
+/**
+ * Advances the automaton by one byte
+ * @param state Current state (0 = nothing matched)
+ * @param rx_byte Received byte
+ * @return Next state
+ */
+static inline uint8_t Tacho_SyncNext(uint8_t state, uint8_t rx_byte)
+{
+    return Tacho_SyncDfa->next[state][Tacho_SyncDfa->byte_class[rx_byte]];
+}
+
+/**
+ * Start sequence recognized at a state
+ * @param state Automaton state
+ * @return ID of the start sequence ending at state, TACHO_SYNC_NONE if none
+ */
+static inline uint8_t Tacho_SyncMatch(uint8_t state)
+{
+    return (uint8_t) (Tacho_SyncDfa->match[state] - 1U);
+}
+
+#endif	/* TACHO_SYNC_H */
@@ -0,0 +1,248 @@
+/**
+ * @file tacho_wakeup_posix.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Event-driven decoder task on POSIX hosts (TACHO_CFG_WAKEUP)
+ *
+ * On Linux the event is an eventfd: a signal is one write(), with no lock
+ * taken in the reception thread, and the wait is a poll() whose timeout
+ * runs on the monotonic clock. Elsewhere a condition variable waits on
+ * CLOCK_MONOTONIC, so that setting the system time does not stretch or
+ * cut a timeout either.
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200112L  /* clock_gettime(), pthread_condattr_setclock() under -std=c99 */
+#endif
+#include <pthread.h>
+#include <time.h>
+#if defined(__linux__)
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#endif
+#include "std_types.h"
+#include "tacho_countries.h"
+#include "tacho.h"
+#include "tacho_d8.h"
+#include "tacho_ctx.h"
+#include "tacho_wakeup_posix.h"
+
+/******************************************************************************/
+/*    PRIVATE FUNCTIONS                                                       */
+/******************************************************************************/
+
+static void Tacho_WakeupDeadline(uint32_t timeout_ms, struct timespec *deadline);
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+/**
+ * Monotonic time at which a wait times out
+ * @param timeout_ms Wait in milliseconds
+ * @param deadline[out] CLOCK_MONOTONIC time
+ */
+static void Tacho_WakeupDeadline(uint32_t timeout_ms, struct timespec *deadline)
+{
+    (void) clock_gettime(CLOCK_MONOTONIC, deadline);
+    deadline->tv_sec += (time_t) (timeout_ms / 1000U);
+    deadline->tv_nsec += (long) (timeout_ms % 1000U) * 1000000L;
+    if (1000000000L <= deadline->tv_nsec)
+    {
+        deadline->tv_sec++;
+        deadline->tv_nsec -= 1000000000L;
+    }
+}
+
+#if defined(__linux__)
+
+/**
+ * Initializes an event (before the reception and decoder threads start)
+ * @param event[out] Event
+ * @return E_OK if the event is ready, E_NOT_OK otherwise
+ */
+Std_ReturnType Tacho_WakeupPosixInit(Tacho_WakeupPosix_t *event)
+{
+    event->fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    event->signals = 0;
+    return (0 <= event->fd) ? E_OK : E_NOT_OK;
+}
+
+/**
+ * Releases an event (after the reception and decoder threads stopped)
+ * @param event[in,out] Event
+ */
+void Tacho_WakeupPosixDeInit(Tacho_WakeupPosix_t *event)
+{
+    if (0 <= event->fd)
+    {
+        (void) close(event->fd);
+        event->fd = -1;
+    }
+}
+
+/**
+ * Wakes the thread waiting on an event
+ * @param event[in,out] Event
+ */
+void Tacho_WakeupPosixSignalEvent(Tacho_WakeupPosix_t *event)
+{
+    const uint64_t one = 1U;
+
+    /* Fails only once 2^64 - 2 signals are pending: the waiter wakes anyway */
+    (void) write(event->fd, &one, sizeof(one));
+}
+
+/**
+ * Waits until a context bound to an event needs its task to run
+ * A timeout still lets the application run the task now and then (e.g.
+ * for the journal or the statistics).
+ * @param event[in,out] Event
+ * @param timeout_ms Maximum wait in milliseconds
+ * @return TRUE if woken by a signal, FALSE on timeout
+ */
+bool_t Tacho_WakeupPosixWait(Tacho_WakeupPosix_t *event, uint32_t timeout_ms)
+{
+    struct pollfd pfd;
+    struct timespec deadline;
+    struct timespec now;
+    uint64_t count;
+    int64_t left_ms = timeout_ms;
+
+    Tacho_WakeupDeadline(timeout_ms, &deadline);
+    pfd.fd = event->fd;
+    pfd.events = POLLIN;
+    /* A signal handler interrupting the poll only shortens it to what is left */
+    while ( (0 > poll(&pfd, 1, (int) MIN(left_ms, 0x7FFFFFFFLL))) && (EINTR == errno) )
+    {
+        (void) clock_gettime(CLOCK_MONOTONIC, &now);
+        left_ms = (int64_t) (deadline.tv_sec - now.tv_sec) * 1000 + (deadline.tv_nsec - now.tv_nsec) / 1000000L;
+        left_ms = MAX(left_ms, 0);
+    }
+
+    /* Takes every pending signal at once */
+    if (sizeof(count) != read(event->fd, &count, sizeof(count)))
+    {
+        return FALSE;
+    }
+    event->signals += (uint32_t) count;
+    return TRUE;
+}
+
+#else
+
+/**
+ * Initializes an event (before the reception and decoder threads start)
+ * @param event[out] Event
+ * @return E_OK if the event is ready, E_NOT_OK otherwise
+ */
+Std_ReturnType Tacho_WakeupPosixInit(Tacho_WakeupPosix_t *event)
+{
+    pthread_condattr_t attr;
+    Std_ReturnType op_status = E_NOT_OK;
+
+    event->pending = 0;
+    event->signals = 0;
+    if (0 != pthread_mutex_init(&event->mutex, NULL))
+    {
+        return E_NOT_OK;
+    }
+    if (0 == pthread_condattr_init(&attr))
+    {
+        if ( (0 == pthread_condattr_setclock(&attr, CLOCK_MONOTONIC)) &&
+             (0 == pthread_cond_init(&event->cond, &attr)) )
+        {
+            op_status = E_OK;
+        }
+        (void) pthread_condattr_destroy(&attr);
+    }
+    if (E_OK != op_status)
+    {
+        (void) pthread_mutex_destroy(&event->mutex);
+    }
+    return op_status;
+}
+
+/**
+ * Releases an event (after the reception and decoder threads stopped)
+ * @param event[in,out] Event
+ */
+void Tacho_WakeupPosixDeInit(Tacho_WakeupPosix_t *event)
+{
+    (void) pthread_cond_destroy(&event->cond);
+    (void) pthread_mutex_destroy(&event->mutex);
+}
+
+/**
+ * Wakes the thread waiting on an event
+ * @param event[in,out] Event
+ */
+void Tacho_WakeupPosixSignalEvent(Tacho_WakeupPosix_t *event)
+{
+    (void) pthread_mutex_lock(&event->mutex);
+    event->pending++;
+    (void) pthread_cond_signal(&event->cond);
+    (void) pthread_mutex_unlock(&event->mutex);
+}
+
+/**
+ * Waits until a context bound to an event needs its task to run
+ * A timeout still lets the application run the task now and then (e.g.
+ * for the journal or the statistics).
+ * @param event[in,out] Event
+ * @param timeout_ms Maximum wait in milliseconds
+ * @return TRUE if woken by a signal, FALSE on timeout
+ */
+bool_t Tacho_WakeupPosixWait(Tacho_WakeupPosix_t *event, uint32_t timeout_ms)
+{
+    struct timespec deadline;
+    uint32_t count;
+
+    Tacho_WakeupDeadline(timeout_ms, &deadline);
+
+    (void) pthread_mutex_lock(&event->mutex);
+    while (0U == event->pending)
+    {
+        if (0 != pthread_cond_timedwait(&event->cond, &event->mutex, &deadline))
+        {
+            break;
+        }
+    }
+    count = event->pending;
+    event->pending = 0;
+    (void) pthread_mutex_unlock(&event->mutex);
+
+    event->signals += count;
+    return (0U != count) ? TRUE : FALSE;
+}
+
+#endif
+
+/**
+ * wakeup binding: wakes the decoder thread waiting on the event the user
+ * pointer of the context points to
+ * @param ctx Decoder context
+ */
+void Tacho_WakeupPosixSignal(Tacho_Ctx_t *ctx)
+{
+    Tacho_WakeupPosixSignalEvent((Tacho_WakeupPosix_t *) ctx->user);
+}
+
+/**
+ * Number of signals taken by the waits on an event
+ * Called from the waiting thread; signals pending since the last wait are
+ * not counted yet.
+ * @param event[in] Event
+ * @return Free-running signal counter
+ */
+uint32_t Tacho_WakeupPosixCount(const Tacho_WakeupPosix_t *event)
+{
+    return event->signals;
+}
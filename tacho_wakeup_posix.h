@@ -0,0 +1,51 @@
+/**
+ * @file tacho_wakeup_posix.h
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Event-driven decoder task on POSIX hosts (TACHO_CFG_WAKEUP)
+ *
+ * Each Tacho_WakeupPosix_t is an event owned by the caller: an eventfd on
+ * Linux, a condition variable elsewhere. Tacho_WakeupPosixSignal() is a
+ * wakeup binding of Tacho_CtxConfig_t signalling the event the context's
+ * user pointer points to; the decoder thread waits on it with
+ * Tacho_WakeupPosixWait() instead of polling Tacho_CtxTask(). Contexts run
+ * by one decoder thread may share an event; an application using the user
+ * pointer for more wraps Tacho_WakeupPosixSignalEvent() instead.
+ * Signals are remembered until the next wait, so none is lost while the
+ * decoder thread is busy.
+ * Needs <pthread.h> outside Linux.
+ */
+
+#ifndef TACHO_WAKEUP_POSIX_H
+#define	TACHO_WAKEUP_POSIX_H
+
+/******************************************************************************/
+/*    PUBLIC TYPES                                                            */
+/******************************************************************************/
+
+/** Wakeup event of a decoder thread */
+typedef struct
+{
+#if defined(__linux__)
+    int fd;  /**< eventfd, its counter holding the signals not taken by a wait yet */
+#else
+    pthread_mutex_t mutex;  /**< Protects pending */
+    pthread_cond_t cond;  /**< Signalled by Tacho_WakeupPosixSignalEvent() */
+    uint32_t pending;  /**< Signals not taken by a wait yet */
+#endif
+    uint32_t signals;  /**< Signals taken by the waits since Tacho_WakeupPosixInit() */
+} Tacho_WakeupPosix_t;
+
+/******************************************************************************/
+/*    PUBLIC FUNCTIONS                                                        */
+/******************************************************************************/
+
+Std_ReturnType Tacho_WakeupPosixInit(Tacho_WakeupPosix_t *event);
+void Tacho_WakeupPosixDeInit(Tacho_WakeupPosix_t *event);
+void Tacho_WakeupPosixSignalEvent(Tacho_WakeupPosix_t *event);
+void Tacho_WakeupPosixSignal(Tacho_Ctx_t *ctx);
+bool_t Tacho_WakeupPosixWait(Tacho_WakeupPosix_t *event, uint32_t timeout_ms);
+uint32_t Tacho_WakeupPosixCount(const Tacho_WakeupPosix_t *event);
+
+#endif	/* TACHO_WAKEUP_POSIX_H */
@@ -0,0 +1,318 @@
+/**
+ * @file test_can.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * J1939 reception straight from the CAN driver (Tacho_CtxCanRx())
+ *
+ * TCO1 is taken from the tachograph address only. The driver
+ * identification comes in a single frame padded with 0xFF or over TP.BAM;
+ * a transfer is dropped by a packet out of sequence or by another BAM, and
+ * a message longer than the cached DI is cut and zero-terminated. A DI
+ * change is seen through change_notif, fired by the next TCO1 with
+ * TACHO_DIRTY_DI in the notification mask: it must be reported only when a
+ * byte of the cached DI changed.
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#include <string.h>
+#include "std_types.h"
+#include "tacho_countries.h"
+#include "tacho.h"
+#include "tacho_d8.h"
+#include "tacho_ctx.h"
+#include "test_util.h"
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#define TEST_ID(_prio,_pf,_ps,_sa) \
+    (((uint32_t) (_prio) << 26) | ((uint32_t) (_pf) << 16) | ((uint32_t) (_ps) << 8) | (uint32_t) (_sa))
+#define TEST_TCO1_ID(_sa) TEST_ID(3U, 0xFEU, 0x6CU, (_sa))  /**< TCO1, PGN 65132 */
+#define TEST_DI_ID(_sa) TEST_ID(6U, 0xFEU, 0x6BU, (_sa))  /**< DI, PGN 65131 */
+#define TEST_TP_CM_ID(_da) TEST_ID(7U, 0xECU, (_da), TACHO_CAN_TACHO_SA)  /**< TP.CM of the tachograph */
+#define TEST_TP_DT_ID(_da) TEST_ID(7U, 0xEBU, (_da), TACHO_CAN_TACHO_SA)  /**< TP.DT of the tachograph */
+#define TEST_GLOBAL 0xFFU
+#define TEST_OTHER_SA 0x17U  /**< Another node (instrument cluster) */
+#define TEST_PGN_DI 0xFE6BUL
+#define TEST_PGN_VI 0xFEECUL  /**< Vehicle identification, another BAM */
+#define TEST_DT_SIZE 7U  /**< Message bytes per TP.DT packet */
+#define TEST_LONG_DI 50U  /**< Longer than the cached DI */
+
+/******************************************************************************/
+/*    PRIVATE DATA                                                            */
+/******************************************************************************/
+
+static uint32_t Test_Tco1Notifs;  /**< tco1_notif calls */
+static uint32_t Test_Changes;  /**< change_notif calls */
+static uint16_t Test_Dirty;  /**< Mask of the last change_notif */
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+/**
+ * tco1_notif binding: counts the calls
+ * @param ctx Decoder context
+ */
+static void Test_Tco1Notif(Tacho_Ctx_t *ctx)
+{
+    (void) ctx;
+    Test_Tco1Notifs++;
+}
+
+/**
+ * change_notif binding: records the mask
+ * @param ctx Decoder context
+ * @param dirty TACHO_DIRTY_* changes
+ */
+static void Test_ChangeNotif(Tacho_Ctx_t *ctx, uint16_t dirty)
+{
+    (void) ctx;
+    Test_Changes++;
+    Test_Dirty = dirty;
+}
+
+/**
+ * Sends a TCO1
+ * @param ctx Decoder context
+ * @param sa Source address
+ * @param speed Speed MSB, in km/h
+ */
+static void Test_Tco1(Tacho_Ctx_t *ctx, uint8_t sa, uint8_t speed)
+{
+    uint8_t data[TACHO_TCO1_SIZE];
+
+    memset(data, 0, sizeof(data));
+    data[TACHO_TCO1_SPEED_MSB] = speed;
+    Tacho_CtxCanRx(ctx, TEST_TCO1_ID(sa), data, TACHO_TCO1_SIZE);
+}
+
+/**
+ * Tells whether the DI changed since the last call, with a TCO1 equal to
+ * the published one so that only TACHO_DIRTY_DI can fire change_notif
+ * @param ctx Decoder context
+ * @return TRUE if change_notif reported TACHO_DIRTY_DI
+ */
+static bool_t Test_DiChanged(Tacho_Ctx_t *ctx)
+{
+    uint32_t changes = Test_Changes;
+
+    Test_Dirty = 0;
+    Test_Tco1(ctx, TACHO_CAN_TACHO_SA, ctx->cached.tco1_cmn[TACHO_TCO1_SPEED_MSB]);
+    return (bool_t) ( (changes != Test_Changes) && (0U != (Test_Dirty & TACHO_DIRTY_DI)) );
+}
+
+/**
+ * Sends a TP.CM BAM
+ * @param ctx Decoder context
+ * @param pgn Announced PGN
+ * @param size Message size in bytes
+ */
+static void Test_Bam(Tacho_Ctx_t *ctx, uint32_t pgn, uint16_t size)
+{
+    uint8_t data[8];
+
+    data[0] = 32U;
+    data[1] = (uint8_t) size;
+    data[2] = (uint8_t) (size >> 8);
+    data[3] = (uint8_t) ((size + TEST_DT_SIZE - 1U) / TEST_DT_SIZE);
+    data[4] = 0xFFU;
+    data[5] = (uint8_t) pgn;
+    data[6] = (uint8_t) (pgn >> 8);
+    data[7] = (uint8_t) (pgn >> 16);
+    Tacho_CtxCanRx(ctx, TEST_TP_CM_ID(TEST_GLOBAL), data, sizeof(data));
+}
+
+/**
+ * Sends a TP.DT packet of a message
+ * @param ctx Decoder context
+ * @param msg[in] Message
+ * @param size Message size in bytes
+ * @param seq Sequence number, from 1
+ */
+static void Test_Dt(Tacho_Ctx_t *ctx, const uint8_t *msg, uint16_t size, uint8_t seq)
+{
+    uint8_t data[8];
+    uint16_t pos = (uint16_t) ((seq - 1U) * TEST_DT_SIZE);
+    uint8_t i;
+
+    data[0] = seq;
+    for (i = 0; i < TEST_DT_SIZE; i++)
+    {
+        data[1U + i] = (pos + i < size) ? msg[pos + i] : 0xFFU;
+    }
+    Tacho_CtxCanRx(ctx, TEST_TP_DT_ID(TEST_GLOBAL), data, sizeof(data));
+}
+
+/**
+ * Sends a DI message over TP.BAM, every packet in order
+ * @param ctx Decoder context
+ * @param msg[in] Message
+ */
+static void Test_Transfer(Tacho_Ctx_t *ctx, const char *msg)
+{
+    uint16_t size = (uint16_t) strlen(msg);
+    uint8_t seq;
+
+    Test_Bam(ctx, TEST_PGN_DI, size);
+    for (seq = 1; seq <= (size + TEST_DT_SIZE - 1U) / TEST_DT_SIZE; seq++)
+    {
+        Test_Dt(ctx, (const uint8_t *) msg, size, seq);
+    }
+}
+
+/**
+ * Checks TCO1 reception and the source address filter
+ * @param ctx Decoder context
+ */
+static void Test_Tco1Rx(Tacho_Ctx_t *ctx)
+{
+    uint8_t data[TACHO_TCO1_SIZE];
+
+    Test_Tco1(ctx, TACHO_CAN_TACHO_SA, 50U);
+    TEST_CHECK(50U == ctx->cached.tco1_cmn[TACHO_TCO1_SPEED_MSB]);
+    TEST_CHECK(1U == Test_Tco1Notifs);
+    TEST_CHECK(TACHO_DIRTY_SPEED == Test_Dirty);
+
+    /* Another node, a short frame: ignored */
+    Test_Tco1(ctx, TEST_OTHER_SA, 60U);
+    memset(data, 0, sizeof(data));
+    data[TACHO_TCO1_SPEED_MSB] = 70U;
+    Tacho_CtxCanRx(ctx, TEST_TCO1_ID(TACHO_CAN_TACHO_SA), data, TACHO_TCO1_SIZE - 1U);
+    TEST_CHECK(50U == ctx->cached.tco1_cmn[TACHO_TCO1_SPEED_MSB]);
+    TEST_CHECK(1U == Test_Tco1Notifs);
+
+    /* The priority is not part of the PGN */
+    Tacho_CtxCanRx(ctx, TEST_ID(6U, 0xFEU, 0x6CU, TACHO_CAN_TACHO_SA), data, TACHO_TCO1_SIZE);
+    TEST_CHECK(70U == ctx->cached.tco1_cmn[TACHO_TCO1_SPEED_MSB]);
+    TEST_CHECK(2U == Test_Tco1Notifs);
+}
+
+/**
+ * Checks TP.BAM reassembly of the DI
+ * @param ctx Decoder context
+ */
+static void Test_Reassembly(Tacho_Ctx_t *ctx)
+{
+    /* 20 bytes: 3 packets, the last one carrying 6 */
+    static const char di_a[] = "RO0000000000086H10*1";
+    static const char di_b[] = "RO0000000000086H10*2";
+    static const char di_c[] = "DF00000012345678*D  ";
+    uint8_t long_di[TEST_LONG_DI];
+    Tacho_VdoInfo_t guard;
+    uint16_t i;
+
+    Test_Transfer(ctx, di_a);
+    TEST_CHECK(0 == strcmp((const char *) ctx->cached.di, di_a));
+    TEST_CHECK(Test_DiChanged(ctx));
+
+    /* Same message again: nothing changed */
+    Test_Transfer(ctx, di_a);
+    TEST_CHECK(0 == strcmp((const char *) ctx->cached.di, di_a));
+    TEST_CHECK(FALSE == Test_DiChanged(ctx));
+
+    /* Packet 3 before packet 2: the transfer is dropped, packet 2 then ignored */
+    Test_Bam(ctx, TEST_PGN_DI, (uint16_t) strlen(di_b));
+    Test_Dt(ctx, (const uint8_t *) di_b, (uint16_t) strlen(di_b), 1U);
+    Test_Dt(ctx, (const uint8_t *) di_b, (uint16_t) strlen(di_b), 3U);
+    Test_Dt(ctx, (const uint8_t *) di_b, (uint16_t) strlen(di_b), 2U);
+    TEST_CHECK(0 == strcmp((const char *) ctx->cached.di, di_a));
+    TEST_CHECK(FALSE == Test_DiChanged(ctx));
+
+    /* A BAM of another PGN drops the transfer in progress */
+    Test_Bam(ctx, TEST_PGN_DI, (uint16_t) strlen(di_c));
+    Test_Dt(ctx, (const uint8_t *) di_c, (uint16_t) strlen(di_c), 1U);
+    Test_Bam(ctx, TEST_PGN_VI, 17U);
+    Test_Dt(ctx, (const uint8_t *) di_c, (uint16_t) strlen(di_c), 2U);
+    Test_Dt(ctx, (const uint8_t *) di_c, (uint16_t) strlen(di_c), 3U);
+    /* Packet 1 stays written, but the DI is not reported */
+    TEST_CHECK(0 == memcmp(ctx->cached.di, di_c, TEST_DT_SIZE));
+    TEST_CHECK(0 == strcmp((const char *) &ctx->cached.di[TEST_DT_SIZE], &di_a[TEST_DT_SIZE]));
+    TEST_CHECK(FALSE == Test_DiChanged(ctx));
+
+    /* A new BAM of the DI restarts it */
+    Test_Bam(ctx, TEST_PGN_DI, (uint16_t) strlen(di_b));
+    Test_Dt(ctx, (const uint8_t *) di_b, (uint16_t) strlen(di_b), 1U);
+    Test_Transfer(ctx, di_b);
+    TEST_CHECK(0 == strcmp((const char *) ctx->cached.di, di_b));
+    TEST_CHECK(Test_DiChanged(ctx));
+
+    /* Packets of the tachograph sent to a single node are not for us */
+    Test_Bam(ctx, TEST_PGN_DI, (uint16_t) strlen(di_c));
+    for (i = 1; i <= 3U; i++)
+    {
+        uint8_t data[8];
+
+        data[0] = (uint8_t) i;
+        memcpy(&data[1], &di_c[(i - 1U) * TEST_DT_SIZE], TEST_DT_SIZE);
+        Tacho_CtxCanRx(ctx, TEST_TP_DT_ID(TEST_OTHER_SA), data, sizeof(data));
+    }
+    TEST_CHECK(0 == strcmp((const char *) ctx->cached.di, di_b));
+    TEST_CHECK(FALSE == Test_DiChanged(ctx));
+
+    /* Longer than the cached DI: cut and zero-terminated */
+    for (i = 0; i < TEST_LONG_DI; i++)
+    {
+        long_di[i] = (uint8_t) ('A' + i % 26U);
+    }
+    memset(&ctx->cached.vdo, 0xA5, sizeof(ctx->cached.vdo));
+    guard = ctx->cached.vdo;
+    Test_Bam(ctx, TEST_PGN_DI, TEST_LONG_DI);
+    for (i = 1; i <= (TEST_LONG_DI + TEST_DT_SIZE - 1U) / TEST_DT_SIZE; i++)
+    {
+        Test_Dt(ctx, long_di, TEST_LONG_DI, (uint8_t) i);
+    }
+    TEST_CHECK(0 == memcmp(ctx->cached.di, long_di, TACHO_MAX_DI_MSG - 1));
+    TEST_CHECK(0U == ctx->cached.di[TACHO_MAX_DI_MSG - 1]);
+    TEST_CHECK(0 == memcmp(&guard, &ctx->cached.vdo, sizeof(guard)));  /* Nothing written past the DI */
+    TEST_CHECK(Test_DiChanged(ctx));
+
+    /* A shorter one after it is terminated at its own end */
+    Test_Transfer(ctx, di_a);
+    TEST_CHECK(0 == strcmp((const char *) ctx->cached.di, di_a));
+    TEST_CHECK(Test_DiChanged(ctx));
+}
+
+/**
+ * Checks the single-frame DI
+ * @param ctx Decoder context
+ */
+static void Test_SingleDi(Tacho_Ctx_t *ctx)
+{
+    static const uint8_t short_di[8] = { 'A', 'B', 'C', 'D', 'E', 0xFFU, 0xFFU, 0xFFU };
+
+    Tacho_CtxCanRx(ctx, TEST_DI_ID(TACHO_CAN_TACHO_SA), short_di, sizeof(short_di));
+    TEST_CHECK(0 == strcmp((const char *) ctx->cached.di, "ABCDE"));
+    TEST_CHECK(Test_DiChanged(ctx));
+    Tacho_CtxCanRx(ctx, TEST_DI_ID(TACHO_CAN_TACHO_SA), short_di, sizeof(short_di));
+    TEST_CHECK(FALSE == Test_DiChanged(ctx));
+
+    /* From another node: ignored */
+    Tacho_CtxCanRx(ctx, TEST_DI_ID(TEST_OTHER_SA), (const uint8_t *) "XYZ", 3U);
+    TEST_CHECK(0 == strcmp((const char *) ctx->cached.di, "ABCDE"));
+    TEST_CHECK(FALSE == Test_DiChanged(ctx));
+}
+
+int main(void)
+{
+    static Tacho_Ctx_t ctx;
+    static const Tacho_Thresholds_t thresholds = { TACHO_DIRTY_TCO1 | TACHO_DIRTY_DI, 0, 0, 0 };
+    Tacho_CtxConfig_t config;
+
+    memset(&config, 0, sizeof(config));
+    config.tco1_notif = Test_Tco1Notif;
+    config.change_notif = Test_ChangeNotif;
+    Tacho_CtxInit(&ctx, &config, NULL_PTR);
+    Tacho_CtxSetThresholds(&ctx, &thresholds);
+
+    Test_Tco1Rx(&ctx);
+    Test_SingleDi(&ctx);
+    Test_Reassembly(&ctx);
+
+    return Test_Result("test_can");
+}
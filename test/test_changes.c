@@ -0,0 +1,223 @@
+/**
+ * @file test_changes.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * TCO1 change reporting thresholds (Tacho_CtxSetThresholds())
+ *
+ * A speed change is reported once it is larger than speed_deadband, either
+ * way. A new state byte value is reported once state_hysteresis + 1
+ * consecutive TCO1 carried it, any other value starting the count over.
+ * Changes outside notify_mask are not published on their own but are
+ * accumulated into the mask change_notif gets with the next notification.
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#include <string.h>
+#include "std_types.h"
+#include "tacho_countries.h"
+#include "tacho.h"
+#include "tacho_d8.h"
+#include "tacho_ctx.h"
+#include "test_util.h"
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#define TEST_DEADBAND 100U  /**< speed_deadband, 1/256 km/h/bit */
+#define TEST_HYSTERESIS 2U  /**< state_hysteresis */
+
+/******************************************************************************/
+/*    PRIVATE DATA                                                            */
+/******************************************************************************/
+
+static uint32_t Test_Tco1Notifs;  /**< tco1_notif calls */
+static uint32_t Test_Changes;  /**< change_notif calls */
+static uint16_t Test_Dirty;  /**< Mask of the last change_notif */
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+/**
+ * tco1_notif binding: counts the calls
+ * @param ctx Decoder context
+ */
+static void Test_Tco1Notif(Tacho_Ctx_t *ctx)
+{
+    (void) ctx;
+    Test_Tco1Notifs++;
+}
+
+/**
+ * change_notif binding: records the mask
+ * @param ctx Decoder context
+ * @param dirty TACHO_DIRTY_* changes
+ */
+static void Test_ChangeNotif(Tacho_Ctx_t *ctx, uint16_t dirty)
+{
+    (void) ctx;
+    Test_Changes++;
+    Test_Dirty = dirty;
+}
+
+/**
+ * Initializes a context with some thresholds
+ * @param ctx[out] Decoder context
+ * @param thresholds[in] Thresholds
+ */
+static void Test_Init(Tacho_Ctx_t *ctx, const Tacho_Thresholds_t *thresholds)
+{
+    static Tacho_CtxConfig_t config;
+
+    config.tco1_notif = Test_Tco1Notif;
+    config.change_notif = Test_ChangeNotif;
+    Tacho_CtxInit(ctx, &config, NULL_PTR);
+    Tacho_CtxSetThresholds(ctx, thresholds);
+}
+
+/**
+ * Sends a TCO1 and tells whether it was notified
+ * @param ctx Decoder context
+ * @param state Working state
+ * @param speed Vehicle speed
+ * @return TRUE if change_notif was called
+ */
+static bool_t Test_Send(Tacho_Ctx_t *ctx, uint8_t state, uint16_t speed)
+{
+    uint8_t tco1[TACHO_TCO1_SIZE];
+    uint32_t changes = Test_Changes;
+
+    memset(tco1, 0, sizeof(tco1));
+    tco1[TACHO_TCO1_WORKING_STATE] = state;
+    tco1[TACHO_TCO1_SPEED_LSB] = (uint8_t) speed;
+    tco1[TACHO_TCO1_SPEED_MSB] = (uint8_t) (speed >> 8);
+    Tacho_CtxProcessTco1(ctx, tco1);
+    return (bool_t) (changes != Test_Changes);
+}
+
+/**
+ * Published speed
+ * @param ctx Decoder context
+ * @return Speed in tco1_cmn
+ */
+static uint16_t Test_Speed(const Tacho_Ctx_t *ctx)
+{
+    return (uint16_t) ((ctx->cached.tco1_cmn[TACHO_TCO1_SPEED_MSB] << 8) | ctx->cached.tco1_cmn[TACHO_TCO1_SPEED_LSB]);
+}
+
+/**
+ * Checks the speed deadband
+ */
+static void Test_Deadband(void)
+{
+    static const Tacho_Thresholds_t thresholds = { TACHO_DIRTY_TCO1, TEST_DEADBAND, 0, 0 };
+    static Tacho_Ctx_t ctx;
+    uint16_t speed = 0x1234U;
+
+    Test_Init(&ctx, &thresholds);
+    TEST_CHECK(TRUE == Test_Send(&ctx, 0U, speed));
+    TEST_CHECK(TACHO_DIRTY_SPEED == Test_Dirty);
+    TEST_CHECK(speed == Test_Speed(&ctx));
+
+    /* Up to the deadband: ignored, compared with the published speed, not the last one */
+    TEST_CHECK(FALSE == Test_Send(&ctx, 0U, speed + TEST_DEADBAND));
+    TEST_CHECK(FALSE == Test_Send(&ctx, 0U, speed - TEST_DEADBAND));
+    TEST_CHECK(FALSE == Test_Send(&ctx, 0U, speed + TEST_DEADBAND));
+    TEST_CHECK(speed == Test_Speed(&ctx));
+
+    /* Beyond it, both ways */
+    TEST_CHECK(TRUE == Test_Send(&ctx, 0U, speed + TEST_DEADBAND + 1U));
+    TEST_CHECK(TACHO_DIRTY_SPEED == Test_Dirty);
+    TEST_CHECK(speed + TEST_DEADBAND + 1U == Test_Speed(&ctx));
+    TEST_CHECK(TRUE == Test_Send(&ctx, 0U, speed));
+    TEST_CHECK(TACHO_DIRTY_SPEED == Test_Dirty);
+    TEST_CHECK(speed == Test_Speed(&ctx));
+    TEST_CHECK(FALSE == Test_Send(&ctx, 0U, speed));
+}
+
+/**
+ * Checks the state hysteresis
+ */
+static void Test_Hysteresis(void)
+{
+    static const Tacho_Thresholds_t thresholds = { TACHO_DIRTY_TCO1, 0xFFFFU, 0, TEST_HYSTERESIS };
+    static Tacho_Ctx_t ctx;
+    uint8_t i;
+
+    Test_Init(&ctx, &thresholds);
+
+    /* Reported with the (state_hysteresis + 1)th identical TCO1 */
+    for (i = 0; i < TEST_HYSTERESIS; i++)
+    {
+        TEST_CHECK(FALSE == Test_Send(&ctx, 5U, 0U));
+        TEST_CHECK(0U == ctx.cached.tco1_cmn[TACHO_TCO1_WORKING_STATE]);
+    }
+    TEST_CHECK(TRUE == Test_Send(&ctx, 5U, 0U));
+    TEST_CHECK(TACHO_DIRTY_WORKING_STATE == Test_Dirty);
+    TEST_CHECK(5U == ctx.cached.tco1_cmn[TACHO_TCO1_WORKING_STATE]);
+    TEST_CHECK(FALSE == Test_Send(&ctx, 5U, 0U));
+
+    /* Another new value starts the count over */
+    TEST_CHECK(FALSE == Test_Send(&ctx, 6U, 0U));
+    TEST_CHECK(FALSE == Test_Send(&ctx, 6U, 0U));
+    TEST_CHECK(FALSE == Test_Send(&ctx, 7U, 0U));
+    TEST_CHECK(FALSE == Test_Send(&ctx, 7U, 0U));
+    TEST_CHECK(TRUE == Test_Send(&ctx, 7U, 0U));
+    TEST_CHECK(7U == ctx.cached.tco1_cmn[TACHO_TCO1_WORKING_STATE]);
+
+    /* So does a flicker back to the published value */
+    TEST_CHECK(FALSE == Test_Send(&ctx, 8U, 0U));
+    TEST_CHECK(FALSE == Test_Send(&ctx, 8U, 0U));
+    TEST_CHECK(FALSE == Test_Send(&ctx, 7U, 0U));
+    TEST_CHECK(FALSE == Test_Send(&ctx, 8U, 0U));
+    TEST_CHECK(FALSE == Test_Send(&ctx, 8U, 0U));
+    TEST_CHECK(7U == ctx.cached.tco1_cmn[TACHO_TCO1_WORKING_STATE]);
+    TEST_CHECK(TRUE == Test_Send(&ctx, 8U, 0U));
+    TEST_CHECK(8U == ctx.cached.tco1_cmn[TACHO_TCO1_WORKING_STATE]);
+}
+
+/**
+ * Checks the mask passed to change_notif
+ */
+static void Test_Mask(void)
+{
+    static const Tacho_Thresholds_t thresholds = { TACHO_DIRTY_WORKING_STATE, 0, 0, 0 };
+    static Tacho_Ctx_t ctx;
+    uint32_t tco1_notifs;
+
+    Test_Init(&ctx, &thresholds);
+    tco1_notifs = Test_Tco1Notifs;
+
+    /* A change outside notify_mask is kept for later */
+    TEST_CHECK(FALSE == Test_Send(&ctx, 0U, 0x0100U));
+    TEST_CHECK(0U == Test_Speed(&ctx));
+    TEST_CHECK(tco1_notifs == Test_Tco1Notifs);
+
+    /* and reported along with the next one in it, even if the speed went back since */
+    TEST_CHECK(TRUE == Test_Send(&ctx, 1U, 0U));
+    TEST_CHECK((TACHO_DIRTY_WORKING_STATE | TACHO_DIRTY_SPEED) == Test_Dirty);
+    TEST_CHECK(0U == Test_Speed(&ctx));
+    TEST_CHECK(1U == ctx.cached.tco1_cmn[TACHO_TCO1_WORKING_STATE]);
+    TEST_CHECK(tco1_notifs + 1U == Test_Tco1Notifs);
+
+    /* Then cleared; the speed is published with any notification */
+    TEST_CHECK(TRUE == Test_Send(&ctx, 2U, 0x0200U));
+    TEST_CHECK((TACHO_DIRTY_WORKING_STATE | TACHO_DIRTY_SPEED) == Test_Dirty);
+    TEST_CHECK(0x0200U == Test_Speed(&ctx));
+    TEST_CHECK(TRUE == Test_Send(&ctx, 3U, 0x0200U));
+    TEST_CHECK(TACHO_DIRTY_WORKING_STATE == Test_Dirty);
+}
+
+int main(void)
+{
+    Test_Deadband();
+    Test_Hysteresis();
+    Test_Mask();
+
+    return Test_Result("test_changes");
+}
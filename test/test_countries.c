@@ -0,0 +1,88 @@
+/**
+ * @file test_countries.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Round trip of the nation code and country code tables
+ *
+ * Every nation code must map to a country code that maps back to it, or to
+ * "RFU" for unknown codes; every combination of letters and spaces the
+ * reverse look-up accepts must map back to itself.
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#include <string.h>
+#include "std_types.h"
+#include "tacho_countries.h"
+#include "test_util.h"
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#define TEST_RFU_CODE 0x38U  /**< Nation code of "RFU" */
+#define TEST_KNOWN_NATIONS 59U  /**< Nation codes in the table, RFU excluded */
+
+/******************************************************************************/
+/*    PRIVATE DATA                                                            */
+/******************************************************************************/
+
+/** Letters of country codes */
+static const char Test_Letters[] = " ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+int main(void)
+{
+    uint8_t country[TACHO_MAX_COUNTRY_CODE];
+    const uint8_t *letters;
+    uint32_t known = 0;
+    uint32_t accepted = 0;
+    uint32_t i, j, k;
+    uint8_t code;
+
+    /* Nation code -> country code -> nation code */
+    for (i = 0; i < 256U; i++)
+    {
+        letters = Tacho_GetCountryCode((uint8_t) i);
+        TEST_CHECK(E_OK == Tacho_GetNationCode(letters, &code));
+        if (0 == memcmp(letters, "RFU", TACHO_MAX_COUNTRY_CODE))
+        {
+            TEST_CHECK(TEST_RFU_CODE == code);
+        }
+        else
+        {
+            TEST_CHECK(i == code);
+            known++;
+        }
+    }
+    TEST_CHECK(TEST_KNOWN_NATIONS == known);
+
+    /* Country code -> nation code -> country code */
+    for (i = 0; i < sizeof(Test_Letters) - 1U; i++)
+    {
+        for (j = 0; j < sizeof(Test_Letters) - 1U; j++)
+        {
+            for (k = 0; k < sizeof(Test_Letters) - 1U; k++)
+            {
+                country[0] = (uint8_t) Test_Letters[i];
+                country[1] = (uint8_t) Test_Letters[j];
+                country[2] = (uint8_t) Test_Letters[k];
+                if (E_OK == Tacho_GetNationCode(country, &code))
+                {
+                    TEST_CHECK(0 == memcmp(country, Tacho_GetCountryCode(code), TACHO_MAX_COUNTRY_CODE));
+                    accepted++;
+                }
+            }
+        }
+    }
+    /* Every known nation plus RFU */
+    TEST_CHECK(TEST_KNOWN_NATIONS + 1U == accepted);
+
+    return Test_Result("test_countries");
+}
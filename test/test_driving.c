@@ -0,0 +1,129 @@
+/**
+ * @file test_driving.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Driving and rest time accumulators against the get_time clock
+ *
+ * VDO frames are sent four times a second, so totals built from a frame
+ * count would be four times too long. Driver 1 drives for an hour, rests
+ * for a 45 min break and drives again; driver 2 stays available. Every
+ * total must follow the clock. A context without a get_time binding must
+ * account nothing.
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#include <string.h>
+#include "std_types.h"
+#include "tacho_countries.h"
+#include "tacho.h"
+#include "tacho_d8.h"
+#include "tacho_ctx.h"
+#include "tacho_encode.h"
+#include "bench_util.h"
+#include "test_util.h"
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#define TEST_FRAMES_PER_S 4U  /**< Frame rate */
+#define TEST_TICK (TACHO_DRIVING_TICKS_PER_S / TEST_FRAMES_PER_S)  /**< Clock step between two frames */
+#define TEST_DRIVE 3600U  /**< Driving before and after the break, in seconds */
+#define TEST_WS_REST 0U  /**< Working states (Tacho_WorkingState_t values) */
+#define TEST_WS_AVAILABLE 1U
+#define TEST_WS_DRIVE 3U
+
+/******************************************************************************/
+/*    PRIVATE DATA                                                            */
+/******************************************************************************/
+
+static uint32_t Test_Now;  /**< get_time value */
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+/**
+ * get_time binding
+ * @param ctx Decoder context
+ * @return Test_Now
+ */
+static uint32_t Test_GetTime(Tacho_Ctx_t *ctx)
+{
+    (void) ctx;
+    return Test_Now;
+}
+
+/**
+ * Sends frames with both cards inserted, one every TEST_TICK
+ * A frame accounts the time since the previous one to the state that frame
+ * reported, so the first frame of a period closes the one before.
+ * @param ctx Decoder context
+ * @param frames Number of frames
+ * @param driver1 Working state of driver 1
+ */
+static void Test_Run(Tacho_Ctx_t *ctx, uint32_t frames, uint8_t driver1)
+{
+    uint8_t raw[BENCH_MAX_FRAME];
+    Tacho_Frame_t frame;
+    uint32_t k;
+    uint16_t n;
+
+    memset(&frame, 0, sizeof(frame));
+    memcpy(frame.driver[0].country, "RO ", TACHO_MAX_COUNTRY_CODE);
+    memcpy(frame.driver[0].cardnr, "0000000000086H10", TACHO_MAX_CARD_NR);
+    memcpy(frame.driver[1].country, "D  ", TACHO_MAX_COUNTRY_CODE);
+    memcpy(frame.driver[1].cardnr, "DF00000012345678", TACHO_MAX_CARD_NR);
+    frame.working_state = (uint8_t) (driver1 | (TEST_WS_AVAILABLE << 3));
+    n = Tacho_EncodeVdo(&frame, (const uint8_t *) BENCH_VIN, BENCH_VIN_LEN,
+                        (const uint8_t *) BENCH_CSTR, BENCH_CSTR_LEN, raw, sizeof(raw));
+
+    for (k = 0; k < frames; k++)
+    {
+        Tacho_CtxRxBlock(ctx, raw, n);
+        Test_Now += TEST_TICK;
+    }
+}
+
+int main(void)
+{
+    static Tacho_Ctx_t ctx;
+    Tacho_CtxConfig_t config;
+    Tacho_DrivingTime_t cards[TACHO_DRIVING_CARDS];
+
+    /* No clock: nothing accounted */
+    memset(&config, 0, sizeof(config));
+    Tacho_CtxInit(&ctx, &config, NULL_PTR);
+    Test_Run(&ctx, TEST_DRIVE * TEST_FRAMES_PER_S, TEST_WS_DRIVE);
+    TEST_CHECK(0U == Tacho_CtxGetDrivingTimes(&ctx, cards, TACHO_DRIVING_CARDS));
+
+    /* Clocked: an hour of driving */
+    config.get_time = Test_GetTime;
+    Tacho_CtxInit(&ctx, &config, NULL_PTR);
+    Test_Run(&ctx, TEST_DRIVE * TEST_FRAMES_PER_S, TEST_WS_DRIVE);
+    Test_Run(&ctx, 1U, TEST_WS_REST);
+    TEST_CHECK(2U == Tacho_CtxGetDrivingTimes(&ctx, cards, TACHO_DRIVING_CARDS));
+    TEST_CHECK(TEST_DRIVE == cards[0].continuous_driving);
+    TEST_CHECK(TEST_DRIVE == cards[0].daily_driving);
+    TEST_CHECK(0U == cards[1].daily_driving);
+
+    /* A 45 min break resets the continuous driving time only */
+    Test_Run(&ctx, TACHO_DRIVING_BREAK * TEST_FRAMES_PER_S - 1U, TEST_WS_REST);
+    Test_Run(&ctx, 1U, TEST_WS_DRIVE);
+    TEST_CHECK(2U == Tacho_CtxGetDrivingTimes(&ctx, cards, TACHO_DRIVING_CARDS));
+    TEST_CHECK(0U == cards[0].continuous_driving);
+    TEST_CHECK(TEST_DRIVE == cards[0].daily_driving);
+
+    Test_Run(&ctx, TEST_DRIVE * TEST_FRAMES_PER_S - 1U, TEST_WS_DRIVE);
+    Test_Run(&ctx, 1U, TEST_WS_REST);
+    TEST_CHECK(2U == Tacho_CtxGetDrivingTimes(&ctx, cards, TACHO_DRIVING_CARDS));
+    TEST_CHECK(TEST_DRIVE == cards[0].continuous_driving);
+    TEST_CHECK(2U * TEST_DRIVE == cards[0].daily_driving);
+    TEST_CHECK(0U == cards[1].daily_driving);
+
+    return Test_Result("test_driving");
+}
@@ -0,0 +1,269 @@
+/**
+ * @file test_fusion.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * TCO1 fusion between CAN (Tacho_CtxProcessTco1()) and the D8 link
+ *
+ * Every field is published from CAN while CAN reported it valid within the
+ * fusion timeout, from the D8 link once CAN went quiet or reported it as not
+ * available (speed 0xFB00 and above, state 0xFF), and from the source that
+ * reported it valid last when none did so recently. The fusion clock is the
+ * get_time binding, or the number of TCO1 reports without it; the age and
+ * source accessors tell nothing before the first report.
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#include <string.h>
+#include "std_types.h"
+#include "tacho_countries.h"
+#include "tacho.h"
+#include "tacho_d8.h"
+#include "tacho_ctx.h"
+#include "tacho_encode.h"
+#include "bench_util.h"
+#include "test_util.h"
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#define TEST_NA 0xFFU  /**< State not available */
+#define TEST_NA_SPEED 0xFB00U  /**< First speed that is not a value */
+#define TEST_MAX_SPEED 0xFAFFU  /**< Last valid speed */
+
+/******************************************************************************/
+/*    PRIVATE DATA                                                            */
+/******************************************************************************/
+
+static uint32_t Test_Now;  /**< get_time value */
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+/**
+ * get_time binding
+ * @param ctx Decoder context
+ * @return Test_Now
+ */
+static uint32_t Test_GetTime(Tacho_Ctx_t *ctx)
+{
+    (void) ctx;
+    return Test_Now;
+}
+
+/**
+ * Sends a TCO1 from CAN
+ * @param ctx Decoder context
+ * @param state Working state
+ * @param driver1 Driver 1 state
+ * @param speed Vehicle speed
+ */
+static void Test_Can(Tacho_Ctx_t *ctx, uint8_t state, uint8_t driver1, uint16_t speed)
+{
+    uint8_t tco1[TACHO_TCO1_SIZE];
+
+    memset(tco1, TEST_NA, sizeof(tco1));
+    tco1[TACHO_TCO1_WORKING_STATE] = state;
+    tco1[TACHO_TCO1_DRV1_STATE] = driver1;
+    tco1[TACHO_TCO1_SPEED_LSB] = (uint8_t) speed;
+    tco1[TACHO_TCO1_SPEED_MSB] = (uint8_t) (speed >> 8);
+    Tacho_CtxProcessTco1(ctx, tco1);
+}
+
+/**
+ * Sends a VDO frame over the D8 link
+ * @param ctx Decoder context
+ * @param state Working state
+ * @param driver1 Driver 1 state
+ * @param speed Vehicle speed
+ */
+static void Test_D8(Tacho_Ctx_t *ctx, uint8_t state, uint8_t driver1, uint16_t speed)
+{
+    uint8_t raw[BENCH_MAX_FRAME];
+    Tacho_Frame_t frame;
+    uint16_t n;
+
+    memset(&frame, 0, sizeof(frame));
+    frame.working_state = state;
+    frame.driver1_state = driver1;
+    frame.speed_lsb = (uint8_t) speed;
+    frame.speed_msb = (uint8_t) (speed >> 8);
+    n = Tacho_EncodeVdo(&frame, (const uint8_t *) BENCH_VIN, BENCH_VIN_LEN,
+                        (const uint8_t *) BENCH_CSTR, BENCH_CSTR_LEN, raw, sizeof(raw));
+    Tacho_CtxRxBlock(ctx, raw, n);
+}
+
+/**
+ * Published speed
+ * @param ctx Decoder context
+ * @return Speed in tco1_cmn
+ */
+static uint16_t Test_Speed(const Tacho_Ctx_t *ctx)
+{
+    return (uint16_t) ((ctx->cached.tco1_cmn[TACHO_TCO1_SPEED_MSB] << 8) | ctx->cached.tco1_cmn[TACHO_TCO1_SPEED_LSB]);
+}
+
+/**
+ * Tells whether the published TCO1 holds some values, all taken from the given sources
+ * @param ctx Decoder context
+ * @param state Expected working state
+ * @param state_source Expected source of the working state
+ * @param speed Expected speed
+ * @param speed_source Expected source of both speed bytes
+ * @return TRUE if so
+ */
+static bool_t Test_Published(Tacho_Ctx_t *ctx, uint8_t state, Tacho_Source_t state_source,
+                             uint16_t speed, Tacho_Source_t speed_source)
+{
+    return (bool_t) ( (state == ctx->cached.tco1_cmn[TACHO_TCO1_WORKING_STATE]) &&
+                      (state_source == Tacho_CtxGetTco1Source(ctx, TACHO_TCO1_WORKING_STATE)) &&
+                      (speed == Test_Speed(ctx)) &&
+                      (speed_source == Tacho_CtxGetTco1Source(ctx, TACHO_TCO1_SPEED_LSB)) &&
+                      (speed_source == Tacho_CtxGetTco1Source(ctx, TACHO_TCO1_SPEED_MSB)) );
+}
+
+/**
+ * Initializes a context receiving VDO frames
+ * @param ctx[out] Decoder context
+ * @param config[in] Bindings
+ */
+static void Test_Init(Tacho_Ctx_t *ctx, const Tacho_CtxConfig_t *config)
+{
+    static const Tacho_Thresholds_t thresholds = { TACHO_DIRTY_TCO1, 0, 0, 0 };
+
+    Tacho_CtxInit(ctx, config, NULL_PTR);
+    Tacho_CtxSetThresholds(ctx, &thresholds);
+    TEST_CHECK(E_OK == Bench_Select(ctx, TACHO_STANDARD_VDO));
+
+    /* Nothing reported yet */
+    TEST_CHECK(TACHO_TCO1_AGE_NONE == Tacho_CtxGetTco1Age(ctx, TACHO_SOURCE_CAN));
+    TEST_CHECK(TACHO_TCO1_AGE_NONE == Tacho_CtxGetTco1Age(ctx, TACHO_SOURCE_D8));
+    TEST_CHECK(TACHO_SOURCE_MAX == Tacho_CtxGetTco1Source(ctx, TACHO_TCO1_WORKING_STATE));
+    TEST_CHECK(TACHO_SOURCE_MAX == Tacho_CtxGetTco1Source(ctx, TACHO_TCO1_SPEED_MSB));
+}
+
+/**
+ * Checks the fusion on the get_time clock
+ */
+static void Test_Time(void)
+{
+    static Tacho_Ctx_t ctx;
+    Tacho_CtxConfig_t config;
+    uint32_t t0 = 1000U;
+
+    memset(&config, 0, sizeof(config));
+    config.get_time = Test_GetTime;
+    Test_Now = t0;
+    Test_Init(&ctx, &config);
+
+    /* CAN wins while fresh, up to the timeout included */
+    Test_Can(&ctx, 1U, 1U, 0x1000U);
+    TEST_CHECK(Test_Published(&ctx, 1U, TACHO_SOURCE_CAN, 0x1000U, TACHO_SOURCE_CAN));
+    TEST_CHECK(TACHO_TCO1_AGE_NONE == Tacho_CtxGetTco1Age(&ctx, TACHO_SOURCE_D8));
+    Test_Now = t0 + 10U;
+    Test_D8(&ctx, 2U, 2U, 0x2000U);
+    TEST_CHECK(Test_Published(&ctx, 1U, TACHO_SOURCE_CAN, 0x1000U, TACHO_SOURCE_CAN));
+    TEST_CHECK(10U == Tacho_CtxGetTco1Age(&ctx, TACHO_SOURCE_CAN));
+    TEST_CHECK(0U == Tacho_CtxGetTco1Age(&ctx, TACHO_SOURCE_D8));
+    Test_Now = t0 + TACHO_FUSION_TIMEOUT;
+    Test_D8(&ctx, 2U, 2U, 0x2000U);
+    TEST_CHECK(Test_Published(&ctx, 1U, TACHO_SOURCE_CAN, 0x1000U, TACHO_SOURCE_CAN));
+
+    /* CAN quiet: D8 takes over */
+    Test_Now = t0 + TACHO_FUSION_TIMEOUT + 1U;
+    Test_D8(&ctx, 2U, 2U, 0x2000U);
+    TEST_CHECK(Test_Published(&ctx, 2U, TACHO_SOURCE_D8, 0x2000U, TACHO_SOURCE_D8));
+    TEST_CHECK(TACHO_FUSION_TIMEOUT + 1U == Tacho_CtxGetTco1Age(&ctx, TACHO_SOURCE_CAN));
+    Test_Now += 5U;
+    TEST_CHECK(5U == Tacho_CtxGetTco1Age(&ctx, TACHO_SOURCE_D8));
+
+    /* CAN back */
+    t0 = Test_Now;
+    Test_Can(&ctx, 3U, 3U, 0x3000U);
+    TEST_CHECK(Test_Published(&ctx, 3U, TACHO_SOURCE_CAN, 0x3000U, TACHO_SOURCE_CAN));
+
+    /* Fields CAN reports as not available come from D8, field by field */
+    Test_Now = t0 + 1U;
+    Test_D8(&ctx, 4U, 4U, 0x4000U);
+    Test_Can(&ctx, TEST_NA, 5U, TEST_NA_SPEED);
+    TEST_CHECK(Test_Published(&ctx, 4U, TACHO_SOURCE_D8, 0x4000U, TACHO_SOURCE_D8));
+    TEST_CHECK(5U == ctx.cached.tco1_cmn[TACHO_TCO1_DRV1_STATE]);
+    TEST_CHECK(TACHO_SOURCE_CAN == Tacho_CtxGetTco1Source(&ctx, TACHO_TCO1_DRV1_STATE));
+    Test_Can(&ctx, 5U, 5U, TEST_MAX_SPEED);
+    TEST_CHECK(Test_Published(&ctx, 5U, TACHO_SOURCE_CAN, TEST_MAX_SPEED, TACHO_SOURCE_CAN));
+
+    /* Every source quiet: the value reported valid last, even by a stale source */
+    Test_Now = t0 + 100U;
+    Test_D8(&ctx, 6U, 6U, 0x0600U);
+    Test_Now = t0 + 200U;
+    Test_Can(&ctx, 7U, 7U, 0x0700U);
+    Test_Now = t0 + 10U * TACHO_FUSION_TIMEOUT;
+    Test_D8(&ctx, TEST_NA, 8U, TEST_NA_SPEED);
+    TEST_CHECK(Test_Published(&ctx, 7U, TACHO_SOURCE_CAN, 0x0700U, TACHO_SOURCE_CAN));
+    Test_Now += 1U;
+    Test_D8(&ctx, 9U, 9U, 0x0900U);
+    Test_Now += 10U * TACHO_FUSION_TIMEOUT;
+    Test_Can(&ctx, TEST_NA, 9U, TEST_NA_SPEED);
+    TEST_CHECK(Test_Published(&ctx, 9U, TACHO_SOURCE_D8, 0x0900U, TACHO_SOURCE_D8));
+
+    /* No source reported a valid speed at all: the one of the report */
+    Test_Now += 1U;
+    Test_D8(&ctx, 9U, 9U, 0xFFFFU);
+    Test_Now += 1U;
+    Test_Can(&ctx, 9U, 9U, TEST_NA_SPEED);
+    TEST_CHECK(TEST_NA_SPEED == Test_Speed(&ctx));
+    TEST_CHECK(TACHO_SOURCE_CAN == Tacho_CtxGetTco1Source(&ctx, TACHO_TCO1_SPEED_MSB));
+}
+
+/**
+ * Checks the fusion on the report count, without a get_time binding
+ */
+static void Test_Reports(void)
+{
+    static Tacho_Ctx_t ctx;
+    Tacho_CtxConfig_t config;
+    uint32_t i;
+
+    memset(&config, 0, sizeof(config));
+    Test_Init(&ctx, &config);
+
+    /* CAN fresh for TACHO_FUSION_TIMEOUT_REPORTS reports */
+    Test_Can(&ctx, 1U, 1U, 0x1000U);
+    TEST_CHECK(Test_Published(&ctx, 1U, TACHO_SOURCE_CAN, 0x1000U, TACHO_SOURCE_CAN));
+    TEST_CHECK(0U == Tacho_CtxGetTco1Age(&ctx, TACHO_SOURCE_CAN));
+    for (i = 0; i < TACHO_FUSION_TIMEOUT_REPORTS; i++)
+    {
+        Test_D8(&ctx, 2U, 2U, 0x2000U);
+        TEST_CHECK(Test_Published(&ctx, 1U, TACHO_SOURCE_CAN, 0x1000U, TACHO_SOURCE_CAN));
+    }
+    Test_D8(&ctx, 2U, 2U, 0x2000U);
+    TEST_CHECK(Test_Published(&ctx, 2U, TACHO_SOURCE_D8, 0x2000U, TACHO_SOURCE_D8));
+    TEST_CHECK(TACHO_FUSION_TIMEOUT_REPORTS + 1U == Tacho_CtxGetTco1Age(&ctx, TACHO_SOURCE_CAN));
+    TEST_CHECK(0U == Tacho_CtxGetTco1Age(&ctx, TACHO_SOURCE_D8));
+
+    /* CAN back, with the working state not available */
+    Test_Can(&ctx, TEST_NA, 3U, 0x3000U);
+    TEST_CHECK(Test_Published(&ctx, 2U, TACHO_SOURCE_D8, 0x3000U, TACHO_SOURCE_CAN));
+    TEST_CHECK(1U == Tacho_CtxGetTco1Age(&ctx, TACHO_SOURCE_D8));
+
+    /* D8 quiet too: its state is still the last valid one */
+    for (i = 0; i < 2U * TACHO_FUSION_TIMEOUT_REPORTS; i++)
+    {
+        Test_Can(&ctx, TEST_NA, 3U, 0x3000U);
+    }
+    TEST_CHECK(Test_Published(&ctx, 2U, TACHO_SOURCE_D8, 0x3000U, TACHO_SOURCE_CAN));
+    TEST_CHECK(2U * TACHO_FUSION_TIMEOUT_REPORTS + 1U == Tacho_CtxGetTco1Age(&ctx, TACHO_SOURCE_D8));
+}
+
+int main(void)
+{
+    Test_Time();
+    Test_Reports();
+
+    return Test_Result("test_fusion");
+}
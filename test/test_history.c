@@ -0,0 +1,297 @@
+/**
+ * @file test_history.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Decoded frame history ring (TACHO_CFG_HISTORY, Tacho_CtxPopFrames())
+ *
+ * Frame k carries a trip of 3k, an odometer of 200000000 + 3k and the clock
+ * BENCH_TIME_BASE + k, and is decoded with get_time returning 1000 + k, so
+ * every popped entry tells which frame it holds. Frames are popped in
+ * batches, in decoding order, with their stamp. A full ring rejects the new
+ * frames (TACHO_CFG_HISTORY_OVERWRITE STD_OFF) or drops the oldest ones
+ * (STD_ON, the default); either way seq shows the frames lost.
+ * Then a writer thread decodes frames while a reader thread pops batches of
+ * random size: entries must come out whole and in order. Also built with
+ * -fsanitize=thread (see Makefile).
+ *
+ * Usage: test_history [frames]
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200112L  /* sched_yield() under -std=c99 */
+#endif
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "std_types.h"
+#include "tacho_countries.h"
+#include "tacho.h"
+#include "tacho_d8.h"
+#include "tacho_ctx.h"
+#include "tacho_atomic.h"
+#include "bench_util.h"
+#include "test_util.h"
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#define TEST_FRAMES 100000UL  /**< Frames decoded by the writer thread (default) */
+#define TEST_LOST 5U  /**< Frames pushed beyond a full ring */
+#define TEST_BURST 8U  /**< Frames the writer decodes before yielding (a reader on the same CPU) */
+#define TEST_STAMP_BASE 1000UL  /**< get_time when frame 0 is decoded */
+#define TEST_ODOMETER_BASE 200000000UL  /**< Odometer of frame 0 (see Bench_Frame()) */
+
+/******************************************************************************/
+/*    PRIVATE TYPES                                                           */
+/******************************************************************************/
+
+/** Reader thread results */
+typedef struct
+{
+    uint32_t batches;  /**< Non-empty pops */
+    uint32_t frames;  /**< Entries popped */
+    uint32_t torn;  /**< Entries mixing two frames */
+    uint32_t disorder;  /**< Entries not newer than the previous one */
+} Test_Reader_t;
+
+/******************************************************************************/
+/*    PRIVATE DATA                                                            */
+/******************************************************************************/
+
+static Tacho_Ctx_t Test_Ctx;
+static uint32_t Test_Frames = TEST_FRAMES;
+static uint32_t Test_Next;  /**< Next frame to decode, read by get_time in the decoding thread */
+static volatile uint8_t Test_Done;  /**< Set by the writer when all frames are decoded */
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+/**
+ * get_time binding
+ * @param ctx Decoder context
+ * @return Stamp of the frame being decoded
+ */
+static uint32_t Test_GetTime(Tacho_Ctx_t *ctx)
+{
+    (void) ctx;
+    return TEST_STAMP_BASE + Test_Next;
+}
+
+/**
+ * Decodes the next frames
+ * @param count Number of frames
+ */
+static void Test_Push(uint32_t count)
+{
+    uint8_t frame[BENCH_MAX_FRAME];
+    uint16_t n;
+
+    while (0U < count--)
+    {
+        n = Bench_Encode(TACHO_STANDARD_VDO, Test_Next, frame, sizeof(frame));
+        Tacho_CtxRxBlock(&Test_Ctx, frame, n);
+        Test_Next++;
+    }
+}
+
+/**
+ * Checks that an entry holds one frame throughout
+ * @param entry[in] Popped entry
+ * @param k[out] Frame number
+ * @return TRUE if consistent
+ */
+static bool_t Test_Consistent(const Tacho_HistFrame_t *entry, uint32_t *k)
+{
+    Tacho_DateTime_t time;
+
+    *k = entry->trip / 3U;
+    if ( (entry->odometer - TEST_ODOMETER_BASE != entry->trip) || (0U != entry->trip % 3U) ||
+         (TEST_STAMP_BASE + *k != entry->stamp) || ((uint16_t) *k != entry->seq) ||
+         (TACHO_STANDARD_VDO != entry->standard) ||
+         ((uint8_t) ((*k / 16U) % 90U) != entry->tco1[TACHO_TCO1_SPEED_MSB]) )
+    {
+        return FALSE;
+    }
+    Bench_SetTime(&time, BENCH_TIME_BASE + *k);
+    return (bool_t) (0 == memcmp(&time, &entry->time, sizeof(time)));
+}
+
+/**
+ * Tells whether a batch holds consecutive frames
+ * @param out[in] Popped entries
+ * @param count Number of entries
+ * @param first Expected first frame
+ * @return TRUE if out holds frames first to first + count - 1
+ */
+static bool_t Test_Batch(const Tacho_HistFrame_t *out, uint16_t count, uint32_t first)
+{
+    uint32_t k;
+    uint16_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        if ( (FALSE == Test_Consistent(&out[i], &k)) || (first + i != k) )
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/**
+ * Checks batch drains and the full ring policy on a single thread
+ */
+static void Test_Ring(void)
+{
+    Tacho_HistFrame_t out[TACHO_HISTORY_SIZE + TEST_LOST];
+    uint32_t first;
+
+    TEST_CHECK(0U == Tacho_CtxPopFrames(&Test_Ctx, out, TACHO_HISTORY_SIZE));
+
+    /* Batch drain, in decoding order, stamped */
+    Test_Push(5U);
+    TEST_CHECK(5U == Tacho_CtxPopFrames(&Test_Ctx, out, TACHO_HISTORY_SIZE));
+    TEST_CHECK(Test_Batch(out, 5U, 0U));
+    TEST_CHECK(TEST_STAMP_BASE == out[0].stamp);
+    TEST_CHECK(0U == Tacho_CtxPopFrames(&Test_Ctx, out, TACHO_HISTORY_SIZE));
+
+    /* Batches smaller than the backlog */
+    Test_Push(6U);
+    TEST_CHECK(4U == Tacho_CtxPopFrames(&Test_Ctx, out, 4U));
+    TEST_CHECK(Test_Batch(out, 4U, 5U));
+    TEST_CHECK(2U == Tacho_CtxPopFrames(&Test_Ctx, out, 4U));
+    TEST_CHECK(Test_Batch(out, 2U, 9U));
+    TEST_CHECK(0U == Tacho_CtxPopFrames(&Test_Ctx, out, 0U));
+
+    /* Full ring */
+    first = Test_Next;
+    Test_Push(TACHO_HISTORY_SIZE + TEST_LOST);
+    TEST_CHECK(TACHO_HISTORY_SIZE == Tacho_CtxPopFrames(&Test_Ctx, out, TACHO_HISTORY_SIZE + TEST_LOST));
+#if (TACHO_CFG_HISTORY_OVERWRITE == STD_ON)
+    /* The oldest frames were dropped */
+    TEST_CHECK(Test_Batch(out, TACHO_HISTORY_SIZE, first + TEST_LOST));
+#else
+    /* The newest frames were rejected */
+    TEST_CHECK(Test_Batch(out, TACHO_HISTORY_SIZE, first));
+#endif
+    TEST_CHECK(0U == Tacho_CtxPopFrames(&Test_Ctx, out, TACHO_HISTORY_SIZE));
+
+    /* Room again, seq past the lost frames */
+    Test_Push(1U);
+    TEST_CHECK(1U == Tacho_CtxPopFrames(&Test_Ctx, out, TACHO_HISTORY_SIZE));
+    TEST_CHECK(Test_Batch(out, 1U, first + TACHO_HISTORY_SIZE + TEST_LOST));
+}
+
+/**
+ * Writer thread: decodes the frames
+ * @param arg Unused
+ * @return NULL
+ */
+static void *Test_Writer(void *arg)
+{
+    uint32_t left = Test_Frames;
+
+    (void) arg;
+
+    while (0U < left)
+    {
+        Test_Push(MIN(left, TEST_BURST));
+        left -= MIN(left, TEST_BURST);
+        sched_yield();
+    }
+    TACHO_STORE_RELEASE(&Test_Done, 1U);
+    return NULL_PTR;
+}
+
+/**
+ * Reader thread: pops batches of random size until the writer is done and
+ * the ring is empty
+ * @param arg Test_Reader_t results
+ * @return NULL
+ */
+static void *Test_Reader(void *arg)
+{
+    Test_Reader_t *reader = (Test_Reader_t *) arg;
+    Tacho_HistFrame_t out[TACHO_HISTORY_SIZE];
+    uint32_t rng = 0x5EEDU;
+    uint32_t last = 0;
+    uint32_t k;
+    uint8_t done;
+    uint16_t count;
+    uint16_t i;
+
+    do
+    {
+        done = TACHO_LOAD_ACQUIRE(&Test_Done);
+        count = Tacho_CtxPopFrames(&Test_Ctx, out, (uint16_t) (1U + Bench_Rand(&rng) % TACHO_HISTORY_SIZE));
+        reader->batches += (0U < count) ? 1U : 0U;
+        for (i = 0; i < count; i++)
+        {
+            if (FALSE == Test_Consistent(&out[i], &k))
+            {
+                reader->torn++;
+                continue;
+            }
+            if ( (0U < reader->frames) && (k <= last) )
+            {
+                reader->disorder++;
+            }
+            last = k;
+            reader->frames++;
+        }
+    } while ( (0U == done) || (0U < count) );
+    return NULL_PTR;
+}
+
+/**
+ * Runs the writer and reader threads
+ */
+static void Test_Stress(void)
+{
+    Test_Reader_t reader;
+    pthread_t reader_thread;
+    pthread_t writer_thread;
+
+    memset(&reader, 0, sizeof(reader));
+    Test_Next = 0;
+    TEST_CHECK(0 == pthread_create(&reader_thread, NULL_PTR, Test_Reader, &reader));
+    TEST_CHECK(0 == pthread_create(&writer_thread, NULL_PTR, Test_Writer, NULL_PTR));
+    (void) pthread_join(writer_thread, NULL_PTR);
+    (void) pthread_join(reader_thread, NULL_PTR);
+
+    printf("reader: %u frames in %u batches, %u lost, %u torn, %u out of order\n", (unsigned) reader.frames,
+           (unsigned) reader.batches, (unsigned) (Test_Frames - reader.frames - reader.torn),
+           (unsigned) reader.torn, (unsigned) reader.disorder);
+    TEST_CHECK(0U < reader.frames);
+    TEST_CHECK(0U == reader.torn);
+    TEST_CHECK(0U == reader.disorder);
+}
+
+int main(int argc, char **argv)
+{
+    Tacho_CtxConfig_t config;
+
+    if (1 < argc)
+    {
+        Test_Frames = (uint32_t) strtoul(argv[1], NULL_PTR, 0);
+    }
+
+    memset(&config, 0, sizeof(config));
+    config.get_time = Test_GetTime;
+    Tacho_CtxInit(&Test_Ctx, &config, NULL_PTR);
+    Test_Ring();
+
+    Tacho_CtxInit(&Test_Ctx, &config, NULL_PTR);
+    Test_Stress();
+
+    return Test_Result("test_history");
+}
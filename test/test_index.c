@@ -0,0 +1,322 @@
+/**
+ * @file test_index.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Time index of a raw D8 capture
+ *
+ * Tacho_IndexTime() is checked against the civil calendar of
+ * Bench_SetTime() over the whole 32-bit range. The capture holds VDO frames
+ * at 1 Hz. The clock jumps forward an hour now and then, junk bytes sit
+ * between some frames and some frames fail their checksum. It is indexed
+ * in chunks of random size, as a capture growing on disk would be. Every
+ * seek must start at most one interval of frames before the first intact
+ * frame at or after the time asked for, and decoding from there must reach
+ * exactly that frame. Frames without a clock are stamped with the receive
+ * time.
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#include <string.h>
+#include "std_types.h"
+#include "tacho_countries.h"
+#include "tacho.h"
+#include "tacho_d8.h"
+#include "tacho_ctx.h"
+#include "tacho_encode.h"
+#include "tacho_index.h"
+#include "bench_util.h"
+#include "test_util.h"
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#define TEST_FRAMES 50000U  /**< Frames in the capture */
+#define TEST_INTERVAL 60U  /**< Index interval in seconds */
+#define TEST_GAP_PERIOD 1000U  /**< One frame in this many is followed by an hour without frames */
+#define TEST_BAD_PERIOD 97U  /**< One frame in this many fails its checksum */
+#define TEST_JUNK_PERIOD 50U  /**< Junk bytes after one frame in this many */
+#define TEST_MAX_JUNK 20U  /**< Junk bytes are below this (and below the start sequence bytes) */
+#define TEST_MAX_CHUNK 4096U  /**< Chunks passed to Tacho_IndexAdd() are TACHO_FRAME_MAX to this */
+#define TEST_SEEKS 20000U  /**< Random seeks */
+#define TEST_CALENDAR 200000U  /**< Random times converted */
+#define TEST_RX_TIME 1300000000UL  /**< Receive time of the frames without a clock */
+#define TEST_INDEX_SIZE (TACHO_INDEX_HEADER_SIZE + TEST_FRAMES * TACHO_INDEX_RECORD_SIZE)
+
+/******************************************************************************/
+/*    PRIVATE DATA                                                            */
+/******************************************************************************/
+
+static uint8_t Test_Capture[TEST_FRAMES * (BENCH_MAX_FRAME + TEST_MAX_JUNK)];
+static uint32_t Test_Len;
+static uint32_t Test_Offset[TEST_FRAMES];  /**< Offset of every intact frame */
+static uint32_t Test_Time[TEST_FRAMES];  /**< Clock of every intact frame */
+static uint32_t Test_Intact;  /**< Number of intact frames */
+static uint8_t Test_Index[TEST_INDEX_SIZE];
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+/**
+ * Checks the conversion of D8 dates to index time
+ * @param rng[in,out] Generator state
+ */
+static void Test_Calendar(uint32_t *rng)
+{
+    Tacho_DateTime_t time;
+    uint32_t seconds;
+    uint32_t errors = 0;
+    uint32_t i;
+
+    for (i = 0; i < TEST_CALENDAR; i++)
+    {
+        seconds = (Bench_Rand(rng) << 16) ^ Bench_Rand(rng);
+        seconds %= TACHO_INDEX_NO_TIME;
+        Bench_SetTime(&time, seconds);
+        if ( (136U > time.year) && (seconds != Tacho_IndexTime(&time)) )
+        {
+            errors++;
+        }
+    }
+    TEST_CHECK(0U == errors);
+
+    /* Clock not set */
+    memset(&time, 0, sizeof(time));
+    TEST_CHECK(TACHO_INDEX_NO_TIME == Tacho_IndexTime(&time));
+}
+
+/**
+ * Builds the capture
+ * @param rng[in,out] Generator state
+ */
+static void Test_Build(uint32_t *rng)
+{
+    uint8_t raw[BENCH_MAX_FRAME];
+    Tacho_Frame_t frame;
+    uint32_t time = BENCH_TIME_BASE;
+    uint32_t k;
+    uint16_t n;
+    uint8_t junk;
+
+    Test_Len = 0;
+    Test_Intact = 0;
+    for (k = 0; k < TEST_FRAMES; k++)
+    {
+        Bench_Frame(TACHO_STANDARD_VDO, k, &frame);
+        Bench_SetTime(&frame.vdo.time, time);
+        n = Tacho_EncodeVdo(&frame, (const uint8_t *) BENCH_VIN, BENCH_VIN_LEN,
+                            (const uint8_t *) BENCH_CSTR, BENCH_CSTR_LEN, raw, sizeof(raw));
+        if (0U == Bench_Rand(rng) % TEST_BAD_PERIOD)
+        {
+            raw[n - 1U] ^= 0x01U;
+        }
+        else
+        {
+            Test_Offset[Test_Intact] = Test_Len;
+            Test_Time[Test_Intact] = time;
+            Test_Intact++;
+        }
+        memcpy(&Test_Capture[Test_Len], raw, n);
+        Test_Len += n;
+
+        if (0U == Bench_Rand(rng) % TEST_JUNK_PERIOD)
+        {
+            for (junk = (uint8_t) (Bench_Rand(rng) % TEST_MAX_JUNK); 0U < junk; junk--)
+            {
+                Test_Capture[Test_Len++] = (uint8_t) (Bench_Rand(rng) % 0x40U);
+            }
+        }
+        time += (0U == Bench_Rand(rng) % TEST_GAP_PERIOD) ? 3600U : 1U;
+    }
+}
+
+/**
+ * Indexes the capture in chunks of random size
+ * @param rng[in,out] Generator state
+ * @return Size of the index in bytes
+ */
+static uint32_t Test_BuildIndex(uint32_t *rng)
+{
+    Tacho_IndexBuilder_t builder;
+    uint32_t pos = 0;
+    uint32_t chunk;
+    bool_t last = FALSE;
+
+    Tacho_IndexInit(&builder, Test_Index, sizeof(Test_Index), TEST_INTERVAL);
+    while (FALSE == last)
+    {
+        /* The bytes not consumed are passed again, the last chunk ends the capture */
+        chunk = TACHO_FRAME_MAX + Bench_Rand(rng) % (TEST_MAX_CHUNK - TACHO_FRAME_MAX);
+        last = (bool_t) (chunk >= Test_Len - pos);
+        pos += Tacho_IndexAdd(&builder, &Test_Capture[pos], MIN(chunk, Test_Len - pos), TACHO_INDEX_NO_TIME);
+    }
+
+    return Tacho_IndexFinish(&builder);
+}
+
+/**
+ * First intact frame at or after a time
+ * @param time Index time
+ * @return Position in Test_Offset and Test_Time, Test_Intact if none
+ */
+static uint32_t Test_Expected(uint32_t time)
+{
+    uint32_t low = 0;
+    uint32_t high = Test_Intact;
+    uint32_t mid;
+
+    while (low < high)
+    {
+        mid = low + ((high - low) / 2);
+        if (Test_Time[mid] < time)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/**
+ * Decodes from an offset up to the first frame at or after a time
+ * @param offset Capture offset to start from
+ * @param time Index time
+ * @param skipped[out] Frames decoded before it
+ * @return Offset of the frame, Test_Len if none
+ */
+static uint32_t Test_Reach(uint32_t offset, uint32_t time, uint32_t *skipped)
+{
+    Tacho_DateTime_t clock;
+    Tacho_Standard_t standard;
+    uint32_t pos = offset;
+
+    *skipped = 0;
+    while (pos < Test_Len)
+    {
+        pos += Tacho_DetectFrame(&Test_Capture[pos], Test_Len - pos, &standard);
+        if (pos >= Test_Len)
+        {
+            break;
+        }
+        clock.seconds = Test_Capture[pos + TACHO_VDO_UTC_SECONDS];
+        clock.minutes = Test_Capture[pos + TACHO_VDO_UTC_MINUTES];
+        clock.hours = Test_Capture[pos + TACHO_VDO_UTC_HOURS];
+        clock.month = Test_Capture[pos + TACHO_VDO_UTC_MONTH];
+        clock.day = Test_Capture[pos + TACHO_VDO_UTC_DAY];
+        clock.year = Test_Capture[pos + TACHO_VDO_UTC_YEAR];
+        if (Tacho_IndexTime(&clock) >= time)
+        {
+            return pos;
+        }
+        (*skipped)++;
+        pos += Tacho_ValidFrameLength(standard, &Test_Capture[pos], Test_Len - pos);
+    }
+    return Test_Len;
+}
+
+/**
+ * Seeks random times of the capture and a bit beyond
+ * @param rng[in,out] Generator state
+ * @param index[in] Opened index
+ */
+static void Test_Seek(uint32_t *rng, const Tacho_Index_t *index)
+{
+    Tacho_IndexEntry_t entry;
+    uint32_t first = Test_Time[0];
+    uint32_t span = Test_Time[Test_Intact - 1U] - first + 2U * TEST_INTERVAL;
+    uint32_t wrong = 0;
+    uint32_t far = 0;
+    uint32_t time, expected, skipped;
+    uint32_t i;
+
+    for (i = 0; i < TEST_SEEKS; i++)
+    {
+        time = first - TEST_INTERVAL + ((Bench_Rand(rng) << 16) ^ Bench_Rand(rng)) % span;
+        expected = Test_Expected(time);
+        if ( (E_OK != Tacho_IndexSeek(index, time, &entry)) ||
+             (TACHO_STANDARD_VDO != entry.standard) || (TACHO_INDEX_FRAME_TIME != entry.source) ||
+             (Test_Reach((uint32_t) entry.offset, time, &skipped) !=
+              ( (Test_Intact > expected) ? Test_Offset[expected] : Test_Len )) )
+        {
+            wrong++;
+        }
+        else if ( (Test_Intact > expected) && (TEST_INTERVAL < skipped) )
+        {
+            far++;
+        }
+    }
+    TEST_CHECK(0U == wrong);
+    TEST_CHECK(0U == far);
+}
+
+/**
+ * Checks the index of frames without a clock
+ */
+static void Test_RxTime(void)
+{
+    uint8_t capture[4U * BENCH_MAX_FRAME];
+    uint8_t index_buf[TACHO_INDEX_HEADER_SIZE + 4U * TACHO_INDEX_RECORD_SIZE];
+    Tacho_IndexBuilder_t builder;
+    Tacho_IndexEntry_t entry;
+    Tacho_Index_t index;
+    Tacho_Frame_t frame;
+    uint32_t len;
+    uint32_t size;
+
+    /* Stoneridge frame, then a VDO frame whose clock is not set */
+    len = Bench_Encode(TACHO_STANDARD_STONERIDGE, 0, capture, sizeof(capture));
+    memset(&frame, 0, sizeof(frame));
+    len += Tacho_EncodeVdo(&frame, (const uint8_t *) BENCH_VIN, BENCH_VIN_LEN, (const uint8_t *) BENCH_CSTR,
+                           BENCH_CSTR_LEN, &capture[len], (uint16_t) (sizeof(capture) - len));
+
+    Tacho_IndexInit(&builder, index_buf, sizeof(index_buf), 0);
+    TEST_CHECK(len == Tacho_IndexAdd(&builder, capture, len, TEST_RX_TIME));
+    size = Tacho_IndexFinish(&builder);
+    TEST_CHECK(E_OK == Tacho_IndexOpen(index_buf, size, &index));
+    TEST_CHECK(2U == index.count);
+    TEST_CHECK(E_OK == Tacho_IndexGet(&index, 0, &entry));
+    TEST_CHECK( (TACHO_STANDARD_STONERIDGE == entry.standard) && (TACHO_INDEX_RX_TIME == entry.source) &&
+                (TEST_RX_TIME == entry.time) && (0U == entry.offset) );
+    TEST_CHECK(E_OK == Tacho_IndexGet(&index, 1, &entry));
+    TEST_CHECK( (TACHO_STANDARD_VDO == entry.standard) && (TACHO_INDEX_RX_TIME == entry.source) &&
+                (TEST_RX_TIME == entry.time) );
+
+    /* Without a receive time they are not indexed */
+    Tacho_IndexInit(&builder, index_buf, sizeof(index_buf), 0);
+    (void) Tacho_IndexAdd(&builder, capture, len, TACHO_INDEX_NO_TIME);
+    TEST_CHECK(0U == builder.count);
+
+    /* Index too small for its records */
+    Tacho_IndexInit(&builder, index_buf, TACHO_INDEX_HEADER_SIZE + TACHO_INDEX_RECORD_SIZE, 0);
+    (void) Tacho_IndexAdd(&builder, capture, len, TEST_RX_TIME);
+    TEST_CHECK(0U == Tacho_IndexFinish(&builder));
+}
+
+int main(void)
+{
+    Tacho_Index_t index;
+    uint32_t rng = 0x5EEDU;
+    uint32_t size;
+
+    Test_Calendar(&rng);
+
+    Test_Build(&rng);
+    size = Test_BuildIndex(&rng);
+    TEST_CHECK(E_OK == Tacho_IndexOpen(Test_Index, size, &index));
+    TEST_CHECK(0U < index.count);
+    TEST_CHECK(E_NOT_OK == Tacho_IndexOpen(Test_Index, size - 1U, &index));
+    TEST_CHECK(E_OK == Tacho_IndexOpen(Test_Index, size, &index));
+    Test_Seek(&rng, &index);
+
+    Test_RxTime();
+
+    return Test_Result("test_index");
+}
@@ -0,0 +1,296 @@
+/**
+ * @file test_journal.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Journal writes on every reception path
+ *
+ * Frame k carries a speed of k km/h, every change being reported. The frames come one every TEST_FRAME_TICKS
+ * through the byte path, the block path or CAN. The journal is kept in RAM
+ * owned by each context (user pointer). A context restored from a copy of
+ * that RAM must hold the frame decoded when the journal period ran out, and
+ * the last frame once the link went quiet and Tacho_CtxJournalTask() ran
+ * after another period.
+ * Two contexts then keep their journal in files of their own
+ * (tacho_nvm_file.c): each restores its own data, and a power loss cutting
+ * the writes of one leaves the other alone.
+ *
+ * Usage: test_journal [directory of the memory files]
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "std_types.h"
+#include "tacho_countries.h"
+#include "tacho.h"
+#include "tacho_d8.h"
+#include "tacho_ctx.h"
+#include "tacho_encode.h"
+#include "tacho_nvm_file.h"
+#include "bench_util.h"
+#include "test_util.h"
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#define TEST_FRAME_TICKS (TACHO_JOURNAL_PERIOD / 10U)  /**< Clock step between two frames */
+#define TEST_FRAMES 16U  /**< Frames sent, the period running out at frame 10 */
+#define TEST_FILES 2U  /**< Contexts with a memory file */
+#define TEST_PATH_MAX 256U
+#define TEST_CAN_TCO1_ID 0x0CFE6C00UL  /**< TCO1, priority 3, without the source address */
+
+/******************************************************************************/
+/*    PRIVATE TYPES                                                           */
+/******************************************************************************/
+
+/** Reception path */
+typedef enum
+{
+    TEST_PATH_BYTE,
+    TEST_PATH_BLOCK,
+    TEST_PATH_CAN
+} Test_Path_t;
+
+/** Persistent memory of a context */
+typedef struct
+{
+    uint8_t data[TACHO_JOURNAL_SIZE];
+} Test_Nvm_t;
+
+/******************************************************************************/
+/*    PRIVATE DATA                                                            */
+/******************************************************************************/
+
+static uint32_t Test_Now;  /**< get_time value */
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+/**
+ * get_time binding
+ * @param ctx Decoder context
+ * @return Test_Now
+ */
+static uint32_t Test_GetTime(Tacho_Ctx_t *ctx)
+{
+    (void) ctx;
+    return Test_Now;
+}
+
+/**
+ * read_nvm binding: reads the Test_Nvm_t of the context
+ * @param ctx Decoder context
+ * @param addr Journal offset
+ * @param buf[out] Read bytes
+ * @param len Number of bytes
+ * @return E_OK
+ */
+static Std_ReturnType Test_ReadNvm(Tacho_Ctx_t *ctx, uint16_t addr, uint8_t *buf, uint16_t len)
+{
+    memcpy(buf, &((Test_Nvm_t *) ctx->user)->data[addr], len);
+    return E_OK;
+}
+
+/**
+ * write_nvm binding: writes the Test_Nvm_t of the context
+ * @param ctx Decoder context
+ * @param addr Journal offset
+ * @param buf[in] Bytes to write
+ * @param len Number of bytes
+ * @return E_OK
+ */
+static Std_ReturnType Test_WriteNvm(Tacho_Ctx_t *ctx, uint16_t addr, const uint8_t *buf, uint16_t len)
+{
+    memcpy(&((Test_Nvm_t *) ctx->user)->data[addr], buf, len);
+    return E_OK;
+}
+
+/**
+ * Sends frame k
+ * @param ctx Decoder context
+ * @param path Reception path
+ * @param k Frame number
+ */
+static void Test_Send(Tacho_Ctx_t *ctx, Test_Path_t path, uint32_t k)
+{
+    uint8_t raw[BENCH_MAX_FRAME];
+    Tacho_Frame_t frame;
+    uint16_t n;
+    uint16_t i;
+
+    if (TEST_PATH_CAN == path)
+    {
+        memset(raw, 0xFF, TACHO_TCO1_SIZE);
+        raw[TACHO_TCO1_SPEED_LSB] = 0;
+        raw[TACHO_TCO1_SPEED_MSB] = (uint8_t) k;
+        Tacho_CtxCanRx(ctx, TEST_CAN_TCO1_ID | TACHO_CAN_TACHO_SA, raw, TACHO_TCO1_SIZE);
+        return;
+    }
+
+    memset(&frame, 0, sizeof(frame));
+    frame.speed_msb = (uint8_t) k;
+    n = Tacho_EncodeVdo(&frame, (const uint8_t *) BENCH_VIN, BENCH_VIN_LEN,
+                        (const uint8_t *) BENCH_CSTR, BENCH_CSTR_LEN, raw, sizeof(raw));
+    if (TEST_PATH_BLOCK == path)
+    {
+        Tacho_CtxRxBlock(ctx, raw, n);
+    }
+    else
+    {
+        for (i = 0; i < n; i++)
+        {
+            Tacho_CtxRxNotif(ctx, raw[i]);
+        }
+        Tacho_CtxTask(ctx);
+    }
+}
+
+/**
+ * Speed of the data a context restores from a copy of a journal
+ * @param nvm[in] Journal
+ * @return Frame number of the restored TCO1, -1 if nothing was restored
+ */
+static int Test_Restored(const Test_Nvm_t *nvm)
+{
+    static Tacho_Ctx_t ctx;
+    Test_Nvm_t copy = *nvm;
+    Tacho_CtxConfig_t config;
+
+    memset(&config, 0, sizeof(config));
+    config.read_nvm = Test_ReadNvm;
+    config.write_nvm = Test_WriteNvm;
+    Tacho_CtxInit(&ctx, &config, &copy);
+    if (FALSE == Tacho_CtxJournalRestored(&ctx))
+    {
+        return -1;
+    }
+    return ctx.cached.tco1_cmn[TACHO_TCO1_SPEED_MSB];
+}
+
+/**
+ * Checks the journal of one reception path
+ * @param path Reception path
+ */
+static void Test_Path(Test_Path_t path)
+{
+    static const Tacho_Thresholds_t thresholds = { TACHO_DIRTY_TCO1, 0, 0, 0 };
+    static Tacho_Ctx_t ctx;
+    Tacho_CtxConfig_t config;
+    Test_Nvm_t nvm;
+    uint32_t k;
+
+    memset(&nvm, 0, sizeof(nvm));
+    memset(&config, 0, sizeof(config));
+    config.get_time = Test_GetTime;
+    config.read_nvm = Test_ReadNvm;
+    config.write_nvm = Test_WriteNvm;
+    Test_Now = 0;
+    Tacho_CtxInit(&ctx, &config, &nvm);
+    Tacho_CtxSetAutoStandard(&ctx, TRUE);
+    Tacho_CtxSetThresholds(&ctx, &thresholds);
+    TEST_CHECK(-1 == Test_Restored(&nvm));
+
+    for (k = 1; k < TEST_FRAMES; k++)
+    {
+        Test_Now += TEST_FRAME_TICKS;
+        Test_Send(&ctx, path, k);
+    }
+    /* Written by the reception path, with the frame just decoded */
+    TEST_CHECK((int) (TACHO_JOURNAL_PERIOD / TEST_FRAME_TICKS) == Test_Restored(&nvm));
+
+    /* Link quiet: the last frame once the period ran out again */
+    Test_Now = 2U * TACHO_JOURNAL_PERIOD - 1U;
+    Tacho_CtxJournalTask(&ctx);
+    TEST_CHECK((int) (TACHO_JOURNAL_PERIOD / TEST_FRAME_TICKS) == Test_Restored(&nvm));
+    Test_Now = 2U * TACHO_JOURNAL_PERIOD;
+    Tacho_CtxJournalTask(&ctx);
+    TEST_CHECK((int) (TEST_FRAMES - 1U) == Test_Restored(&nvm));
+}
+
+/**
+ * Speed of the data a context restores from a memory file
+ * @param path File name
+ * @return Frame number of the restored TCO1, -1 if nothing was restored
+ */
+static int Test_RestoredFile(const char *path)
+{
+    static Tacho_Ctx_t ctx;
+    Tacho_CtxConfig_t config;
+    Tacho_NvmFile_t nvm;
+    int k = -1;
+
+    memset(&config, 0, sizeof(config));
+    config.read_nvm = Tacho_NvmFileRead;
+    config.write_nvm = Tacho_NvmFileWrite;
+    if (E_OK == Tacho_NvmFileOpen(&nvm, path, TACHO_JOURNAL_SIZE))
+    {
+        Tacho_CtxInit(&ctx, &config, &nvm);
+        if (Tacho_CtxJournalRestored(&ctx))
+        {
+            k = ctx.cached.tco1_cmn[TACHO_TCO1_SPEED_MSB];
+        }
+        Tacho_NvmFileClose(&nvm);
+    }
+    return k;
+}
+
+/**
+ * Checks that contexts with memory files of their own keep apart
+ * @param dir Directory of the memory files
+ */
+static void Test_Files(const char *dir)
+{
+    static const Tacho_Thresholds_t thresholds = { TACHO_DIRTY_TCO1, 0, 0, 0 };
+    static Tacho_Ctx_t ctx[TEST_FILES];
+    Tacho_NvmFile_t nvm[TEST_FILES];
+    char path[TEST_FILES][TEST_PATH_MAX];
+    Tacho_CtxConfig_t config;
+    uint32_t i;
+
+    memset(&config, 0, sizeof(config));
+    config.read_nvm = Tacho_NvmFileRead;
+    config.write_nvm = Tacho_NvmFileWrite;
+    for (i = 0; i < TEST_FILES; i++)
+    {
+        (void) snprintf(path[i], TEST_PATH_MAX, "%s/journal%u.nvm", dir, (unsigned) i);
+        (void) remove(path[i]);
+        TEST_CHECK(E_OK == Tacho_NvmFileOpen(&nvm[i], path[i], TACHO_JOURNAL_SIZE));
+        Tacho_CtxInit(&ctx[i], &config, &nvm[i]);
+        Tacho_CtxSetAutoStandard(&ctx[i], TRUE);
+        Tacho_CtxSetThresholds(&ctx[i], &thresholds);
+        Test_Send(&ctx[i], TEST_PATH_BLOCK, 1U + i);
+        TEST_CHECK(E_OK == Tacho_CtxJournalFlush(&ctx[i]));
+    }
+    for (i = 0; i < TEST_FILES; i++)
+    {
+        TEST_CHECK((int) (1U + i) == Test_RestoredFile(path[i]));
+    }
+
+    /* Power lost in the middle of the record of context 0 only */
+    Tacho_NvmFileCutAfter(&nvm[0], TACHO_JOURNAL_SLOT_SIZE / 2U);
+    for (i = 0; i < TEST_FILES; i++)
+    {
+        Test_Send(&ctx[i], TEST_PATH_BLOCK, 10U + i);
+        TEST_CHECK(((0U == i) ? E_NOT_OK : E_OK) == Tacho_CtxJournalFlush(&ctx[i]));
+        Tacho_NvmFileClose(&nvm[i]);
+    }
+    TEST_CHECK(1 == Test_RestoredFile(path[0]));
+    TEST_CHECK(11 == Test_RestoredFile(path[1]));
+}
+
+int main(int argc, char **argv)
+{
+    Test_Path(TEST_PATH_BYTE);
+    Test_Path(TEST_PATH_BLOCK);
+    Test_Path(TEST_PATH_CAN);
+    Test_Files((1 < argc) ? argv[1] : ".");
+
+    return Test_Result("test_journal");
+}
@@ -0,0 +1,236 @@
+/**
+ * @file test_pool.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Decoder pool (tacho_pool.c) fed with many interleaved streams
+ *
+ * Every stream carries its own VDO frames, frame j of stream s being frame
+ * number s * TEST_FRAMES + j of bench_util.c, so the odometer of a decoded
+ * frame tells which stream it belongs to. The streams are fed in rounds, a
+ * chunk of random size per stream and round, through Tacho_PoolRxBlock() or
+ * through Tacho_PoolRxNotif() with Tacho_PoolTask() runs whose budget is
+ * smaller than the number of streams. Every frame must reach the sink once,
+ * in order, with the index of its stream.
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#include <string.h>
+#include "std_types.h"
+#include "tacho_countries.h"
+#include "tacho.h"
+#include "tacho_d8.h"
+#include "tacho_ctx.h"
+#include "tacho_pool.h"
+#include "bench_util.h"
+#include "test_util.h"
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#define TEST_STREAMS 97U  /**< Streams of the pool, not a multiple of TEST_BUDGET */
+#define TEST_FRAMES 12U  /**< Frames per stream */
+#define TEST_MAX_CHUNK 40U  /**< Bytes fed to a stream per round are 1 to this */
+#define TEST_BUDGET 7U  /**< Streams serviced by a Tacho_PoolTask() run */
+#define TEST_ODOMETER_BASE 200000000UL  /**< Odometer of frame 0 (bench_util.c) */
+
+/******************************************************************************/
+/*    PRIVATE TYPES                                                           */
+/******************************************************************************/
+
+/** Stream as fed to the pool */
+typedef struct
+{
+    uint8_t data[TEST_FRAMES * BENCH_MAX_FRAME];  /**< Encoded frames */
+    uint32_t len;  /**< Bytes in data */
+    uint32_t pos;  /**< Bytes fed so far */
+    uint32_t next;  /**< Frame expected next by the sink */
+    uint32_t wrong;  /**< Frames reported out of order or for another stream */
+    uint32_t changes;  /**< change callbacks */
+} Test_Stream_t;
+
+/******************************************************************************/
+/*    PRIVATE DATA                                                            */
+/******************************************************************************/
+
+static Tacho_Ctx_t Test_Ctx[TEST_STREAMS];
+static Test_Stream_t Test_Streams[TEST_STREAMS];
+static uint32_t Test_Now;  /**< Sink clock */
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+/**
+ * Sink: checks that a frame belongs to the stream it is reported for
+ * @param pool Decoder pool
+ * @param stream Stream index
+ * @param ctx Context of the stream
+ */
+static void Test_SinkFrame(Tacho_Pool_t *pool, uint16_t stream, Tacho_Ctx_t *ctx)
+{
+    Test_Stream_t *s;
+    uint32_t k = (ctx->frame.vdo.odometer - TEST_ODOMETER_BASE) / 3U;
+
+    if ( (TEST_STREAMS <= stream) || (ctx != Tacho_PoolGetCtx(pool, stream)) )
+    {
+        TEST_CHECK(FALSE);
+        return;
+    }
+    s = &Test_Streams[stream];
+    if (k == stream * TEST_FRAMES + s->next)
+    {
+        s->next++;
+    }
+    else
+    {
+        s->wrong++;
+    }
+}
+
+/**
+ * Sink: counts the changes of a stream
+ * @param pool Decoder pool
+ * @param stream Stream index
+ * @param ctx Context of the stream
+ * @param dirty TACHO_DIRTY_* changes
+ */
+static void Test_SinkChange(Tacho_Pool_t *pool, uint16_t stream, Tacho_Ctx_t *ctx, uint16_t dirty)
+{
+    TEST_CHECK( (TEST_STREAMS > stream) && (ctx == Tacho_PoolGetCtx(pool, stream)) && (0U != dirty) );
+    if (TEST_STREAMS > stream)
+    {
+        Test_Streams[stream].changes++;
+    }
+}
+
+/**
+ * Sink clock
+ * @param pool Decoder pool
+ * @return Test_Now
+ */
+static uint32_t Test_SinkTime(Tacho_Pool_t *pool)
+{
+    (void) pool;
+    return Test_Now;
+}
+
+/**
+ * Builds the streams
+ */
+static void Test_Build(void)
+{
+    uint32_t s, j;
+
+    for (s = 0; s < TEST_STREAMS; s++)
+    {
+        memset(&Test_Streams[s], 0, sizeof(Test_Streams[s]));
+        for (j = 0; j < TEST_FRAMES; j++)
+        {
+            Test_Streams[s].len += Bench_Encode(TACHO_STANDARD_VDO, s * TEST_FRAMES + j,
+                                                &Test_Streams[s].data[Test_Streams[s].len], BENCH_MAX_FRAME);
+        }
+    }
+}
+
+/**
+ * Feeds the streams in rounds until all are fed
+ * @param pool Decoder pool
+ * @param block_path TRUE for Tacho_PoolRxBlock(), FALSE for Tacho_PoolRxNotif() and Tacho_PoolTask()
+ */
+static void Test_Feed(Tacho_Pool_t *pool, bool_t block_path)
+{
+    uint32_t rng = 0x5EEDU;
+    uint32_t busy = TEST_STREAMS;
+    uint32_t pending;
+    uint32_t serviced;
+    uint32_t s, n, i;
+
+    while (0U < busy)
+    {
+        busy = 0;
+        pending = 0;
+        for (s = 0; s < TEST_STREAMS; s++)
+        {
+            n = 1U + Bench_Rand(&rng) % TEST_MAX_CHUNK;
+            n = MIN(n, Test_Streams[s].len - Test_Streams[s].pos);
+            if (0U == n)
+            {
+                continue;
+            }
+            if (block_path)
+            {
+                Tacho_PoolRxBlock(pool, (uint16_t) s, &Test_Streams[s].data[Test_Streams[s].pos], n);
+            }
+            else
+            {
+                for (i = 0; i < n; i++)
+                {
+                    Tacho_PoolRxNotif(pool, (uint16_t) s, Test_Streams[s].data[Test_Streams[s].pos + i]);
+                }
+                pending++;
+            }
+            Test_Streams[s].pos += n;
+            busy++;
+        }
+        Test_Now++;
+
+        /* Every stream fed in this round is serviced exactly once, TEST_BUDGET at a time */
+        while (0U < pending)
+        {
+            serviced = Tacho_PoolTask(pool, TEST_BUDGET);
+            TEST_CHECK(MIN(TEST_BUDGET, pending) == serviced);
+            pending -= MIN(serviced, pending);
+            if (0U == serviced)
+            {
+                break;
+            }
+        }
+        if (FALSE == block_path)
+        {
+            TEST_CHECK(0U == Tacho_PoolTask(pool, TEST_BUDGET));
+        }
+    }
+}
+
+/**
+ * Runs one reception path
+ * @param block_path TRUE for Tacho_PoolRxBlock(), FALSE for Tacho_PoolRxNotif() and Tacho_PoolTask()
+ */
+static void Test_Pool(bool_t block_path)
+{
+    static const Tacho_PoolSink_t sink = { Test_SinkFrame, Test_SinkChange, Test_SinkTime };
+    Tacho_Pool_t pool;
+    uint32_t s;
+    uint32_t done = 0;
+    uint32_t wrong = 0;
+    uint32_t quiet = 0;
+
+    Test_Build();
+    Tacho_PoolInit(&pool, Test_Ctx, TEST_STREAMS, &sink, NULL_PTR);
+    TEST_CHECK(NULL_PTR == Tacho_PoolGetCtx(&pool, TEST_STREAMS));
+    Test_Feed(&pool, block_path);
+
+    for (s = 0; s < TEST_STREAMS; s++)
+    {
+        done += (TEST_FRAMES == Test_Streams[s].next) ? 1U : 0U;
+        wrong += Test_Streams[s].wrong;
+        quiet += (0U == Test_Streams[s].changes) ? 1U : 0U;
+        TEST_CHECK(0U == Tacho_CtxGetDroppedBytes(&Test_Ctx[s]));
+    }
+    TEST_CHECK(TEST_STREAMS == done);
+    TEST_CHECK(0U == wrong);
+    TEST_CHECK(0U == quiet);
+}
+
+int main(void)
+{
+    Test_Pool(TRUE);
+    Test_Pool(FALSE);
+
+    return Test_Result("test_pool");
+}
@@ -0,0 +1,230 @@
+/**
+ * @file test_recovery.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Frame recovery on a noisy stream
+ *
+ * Frames are numbered through their odometer (VDO) or speed (Stoneridge).
+ * One frame in ten loses a few bytes, so its length field claims the start
+ * of the next frame, and one in twenty gets a bit error. The recovery rate
+ * is the share of intact frames decoded; without the search of rejected
+ * bytes for the next start sequence, most frames following a shortened one
+ * would be lost with it. The byte and block paths must recover the same
+ * frames.
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "std_types.h"
+#include "tacho_countries.h"
+#include "tacho.h"
+#include "tacho_d8.h"
+#include "tacho_ctx.h"
+#include "tacho_encode.h"
+#include "bench_util.h"
+#include "test_util.h"
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#define TEST_FRAMES 20000U  /**< Frames in the stream */
+#define TEST_SHORT_PERCENT 10U  /**< Frames losing bytes */
+#define TEST_FLIP_PERCENT 5U  /**< Frames with a bit error */
+#define TEST_MAX_LOST 6U  /**< Bytes lost by a shortened frame are 1 to this */
+#define TEST_TASK_PERIOD 16U  /**< Bytes received between two task runs (byte path) */
+#define TEST_BLOCK 64U  /**< Block size (block path) */
+#define TEST_MIN_RECOVERY 0.995  /**< Minimum share of intact frames decoded */
+
+/******************************************************************************/
+/*    PRIVATE DATA                                                            */
+/******************************************************************************/
+
+static uint8_t Test_Stream[TEST_FRAMES * BENCH_MAX_FRAME + BENCH_MAX_FRAME];
+static uint32_t Test_Len;
+static bool_t Test_Intact[TEST_FRAMES];  /**< Frame sent unchanged */
+static bool_t Test_Got[2][TEST_FRAMES];  /**< Frame decoded, per path */
+static bool_t *Test_Record;  /**< Where Test_FrameNotif() records */
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+/**
+ * frame_notif binding: records the number of the decoded frame
+ * @param ctx Decoder context
+ */
+static void Test_FrameNotif(Tacho_Ctx_t *ctx)
+{
+    uint32_t k;
+
+    if (TACHO_STANDARD_VDO == Tacho_CtxGetSelectedStandard(ctx))
+    {
+        k = ctx->frame.vdo.odometer;
+    }
+    else
+    {
+        k = ((uint32_t) ctx->frame.speed_msb << 8) | ctx->frame.speed_lsb;
+    }
+    if (TEST_FRAMES > k)
+    {
+        Test_Record[k] = TRUE;
+    }
+}
+
+/**
+ * Builds the noisy stream
+ * @param standard Protocol
+ * @param rng[in,out] Generator state
+ */
+static void Test_Build(Tacho_Standard_t standard, uint32_t *rng)
+{
+    static const uint8_t vdo_end_seq[TACHO_VDO_SEQSZ] = {TACHO_VDO_START_SEQ};
+    static const uint8_t sr_end_seq[TACHO_SR_SEQSZ] = {TACHO_SR_START_SEQ};
+    uint8_t frame[BENCH_MAX_FRAME];
+    Tacho_Frame_t data;
+    uint32_t k;
+    uint32_t noise;
+    uint16_t n, at, lost;
+
+    Test_Len = 0;
+    for (k = 0; k < TEST_FRAMES; k++)
+    {
+        memset(&data, 0, sizeof(data));
+        memcpy(data.driver[0].country, "RO ", TACHO_MAX_COUNTRY_CODE);
+        memcpy(data.driver[0].cardnr, "0000000000086H10", TACHO_MAX_CARD_NR);
+        data.vdo.odometer = k;
+        data.speed_lsb = (uint8_t) k;
+        data.speed_msb = (uint8_t) (k >> 8);
+        if (TACHO_STANDARD_VDO == standard)
+        {
+            n = Tacho_EncodeVdo(&data, (const uint8_t *) BENCH_VIN, BENCH_VIN_LEN,
+                                (const uint8_t *) BENCH_CSTR, BENCH_CSTR_LEN, frame, sizeof(frame));
+        }
+        else
+        {
+            n = Tacho_EncodeStoneridge(&data, TACHO_SR_MSG_DIN1, (const uint8_t *) BENCH_VIN, BENCH_VIN_LEN,
+                                       frame, sizeof(frame));
+        }
+
+        Test_Intact[k] = FALSE;
+        noise = Bench_Rand(rng) % 100U;
+        if (TEST_SHORT_PERCENT > noise)
+        {
+            /* Bytes lost after the header */
+            at = (uint16_t) (TACHO_VDO_SEQSZ + Bench_Rand(rng) % (n - 2U * TACHO_VDO_SEQSZ));
+            lost = (uint16_t) (1U + Bench_Rand(rng) % TEST_MAX_LOST);
+            memmove(&frame[at], &frame[at + lost], n - at - lost);
+            n = (uint16_t) (n - lost);
+        }
+        else if (TEST_SHORT_PERCENT + TEST_FLIP_PERCENT > noise)
+        {
+            frame[TACHO_VDO_SEQSZ + Bench_Rand(rng) % (n - TACHO_VDO_SEQSZ)] ^= (uint8_t) (1U << (Bench_Rand(rng) % 8U));
+        }
+        else
+        {
+            Test_Intact[k] = TRUE;
+        }
+        memcpy(&Test_Stream[Test_Len], frame, n);
+        Test_Len += n;
+    }
+
+    /* Start sequence of a frame that never ends, so the last one is seen complete */
+    if (TACHO_STANDARD_VDO == standard)
+    {
+        memcpy(&Test_Stream[Test_Len], vdo_end_seq, sizeof(vdo_end_seq));
+        Test_Len += sizeof(vdo_end_seq);
+    }
+    else
+    {
+        memcpy(&Test_Stream[Test_Len], sr_end_seq, sizeof(sr_end_seq));
+        Test_Len += sizeof(sr_end_seq);
+    }
+    Test_Stream[Test_Len++] = 0;
+}
+
+/**
+ * Decodes the stream
+ * @param standard Protocol
+ * @param block_path TRUE for Tacho_CtxRxBlock(), FALSE for the byte path
+ * @param got[out] Decoded frames
+ */
+static void Test_Decode(Tacho_Standard_t standard, bool_t block_path, bool_t *got)
+{
+    static Tacho_Ctx_t ctx;
+    Tacho_CtxConfig_t config;
+    uint32_t pos;
+
+    memset(&config, 0, sizeof(config));
+    config.frame_notif = Test_FrameNotif;
+    Tacho_CtxInit(&ctx, &config, NULL_PTR);
+    TEST_CHECK(E_OK == Bench_Select(&ctx, standard));
+    memset(got, 0, TEST_FRAMES * sizeof(bool_t));
+    Test_Record = got;
+
+    if (block_path)
+    {
+        for (pos = 0; pos < Test_Len; pos += TEST_BLOCK)
+        {
+            Tacho_CtxRxBlock(&ctx, &Test_Stream[pos], MIN(TEST_BLOCK, Test_Len - pos));
+        }
+    }
+    else
+    {
+        for (pos = 0; pos < Test_Len; pos++)
+        {
+            Tacho_CtxRxNotif(&ctx, Test_Stream[pos]);
+            if (0U == pos % TEST_TASK_PERIOD)
+            {
+                Tacho_CtxTask(&ctx);
+            }
+        }
+        Tacho_CtxTask(&ctx);
+    }
+}
+
+/**
+ * Measures the recovery rate of one protocol
+ * @param standard Protocol
+ * @param name Protocol name
+ */
+static void Test_Recovery(Tacho_Standard_t standard, const char *name)
+{
+    uint32_t rng = 0x5EEDU;
+    uint32_t intact = 0;
+    uint32_t decoded = 0;
+    uint32_t k;
+    double rate;
+
+    Test_Build(standard, &rng);
+    Test_Decode(standard, FALSE, Test_Got[0]);
+    Test_Decode(standard, TRUE, Test_Got[1]);
+
+    for (k = 0; k < TEST_FRAMES; k++)
+    {
+        if (Test_Intact[k])
+        {
+            intact++;
+            decoded += Test_Got[0][k] ? 1U : 0U;
+        }
+    }
+    rate = (double) decoded / (double) intact;
+    printf("%-10s %u intact frames, %u decoded (%.2f%%)\n", name, (unsigned) intact, (unsigned) decoded,
+           100.0 * rate);
+
+    TEST_CHECK(TEST_MIN_RECOVERY <= rate);
+    TEST_CHECK(0 == memcmp(Test_Got[0], Test_Got[1], sizeof(Test_Got[0])));
+}
+
+int main(void)
+{
+    Test_Recovery(TACHO_STANDARD_VDO, "VDO");
+    Test_Recovery(TACHO_STANDARD_STONERIDGE, "Stoneridge");
+
+    return Test_Result("test_recovery");
+}
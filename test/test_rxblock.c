@@ -0,0 +1,180 @@
+/**
+ * @file test_rxblock.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Block reception of a capture mixing both protocols
+ *
+ * Runs of VDO and Stoneridge frames are separated by junk bytes, then the
+ * capture is fed to Tacho_CtxRxBlock() in blocks of random size on a
+ * context with automatic protocol selection. Every frame must be decoded, in
+ * order and with the protocol it was encoded with, whatever block boundary
+ * splits its start sequence.
+ * With frames cut short, a cut frame completed by the bytes that follow can
+ * pass the 8-bit checksum, so the block path is then held to the frames the
+ * byte path (Tacho_CtxRxNotif()) decodes instead.
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#include <string.h>
+#include "std_types.h"
+#include "tacho_countries.h"
+#include "tacho.h"
+#include "tacho_d8.h"
+#include "tacho_ctx.h"
+#include "bench_util.h"
+#include "test_util.h"
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#define TEST_RUNS 2000U  /**< Runs of frames of one protocol */
+#define TEST_MAX_RUN 12U  /**< Frames in a run are below this */
+#define TEST_MAX_JUNK 40U  /**< Junk bytes between two runs are below this */
+#define TEST_CUT_PERIOD 7U  /**< One run in this many ends with a frame cut short */
+#define TEST_MAX_BLOCK 64U  /**< Block sizes are 1 to this */
+#define TEST_MAX_FRAMES (TEST_RUNS * TEST_MAX_RUN)
+#define TEST_CAPTURE_SIZE (TEST_MAX_FRAMES * BENCH_MAX_FRAME + TEST_RUNS * (TEST_MAX_JUNK + BENCH_MAX_FRAME))
+
+/******************************************************************************/
+/*    PRIVATE DATA                                                            */
+/******************************************************************************/
+
+static uint8_t Test_Capture[TEST_CAPTURE_SIZE];
+static uint8_t Test_Expected[TEST_MAX_FRAMES];  /**< Protocol of every complete frame */
+static uint8_t Test_ByteDecoded[TEST_MAX_FRAMES];  /**< Protocol of every frame decoded by the byte path */
+static uint8_t Test_Decoded[TEST_MAX_FRAMES];  /**< Protocol of every frame decoded by the block path */
+static uint8_t *Test_Record;  /**< Where Test_FrameNotif() records */
+static uint32_t Test_DecodedCount;
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+/**
+ * frame_notif binding: records the protocol of the decoded frame
+ * @param ctx Decoder context
+ */
+static void Test_FrameNotif(Tacho_Ctx_t *ctx)
+{
+    if (TEST_MAX_FRAMES > Test_DecodedCount)
+    {
+        Test_Record[Test_DecodedCount] = (uint8_t) Tacho_CtxGetSelectedStandard(ctx);
+    }
+    Test_DecodedCount++;
+}
+
+/**
+ * Builds the capture
+ * @param rng[in,out] Generator state
+ * @param cut TRUE to cut some frames short
+ * @param frames[out] Number of complete frames
+ * @return Capture length
+ */
+static uint32_t Test_Build(uint32_t *rng, bool_t cut, uint32_t *frames)
+{
+    uint8_t frame[BENCH_MAX_FRAME];
+    Tacho_Standard_t standard;
+    uint32_t len = 0;
+    uint32_t k = 0;
+    uint32_t run, count, i;
+    uint16_t n;
+
+    *frames = 0;
+    for (run = 0; run < TEST_RUNS; run++)
+    {
+        standard = (0U == Bench_Rand(rng) % 2U) ? TACHO_STANDARD_VDO : TACHO_STANDARD_STONERIDGE;
+        count = 1U + Bench_Rand(rng) % (TEST_MAX_RUN - 1U);
+        for (i = 0; i < count; i++)
+        {
+            n = Bench_Encode(standard, k++, frame, sizeof(frame));
+            memcpy(&Test_Capture[len], frame, n);
+            len += n;
+            Test_Expected[(*frames)++] = (uint8_t) standard;
+        }
+        if ( cut && (0U == run % TEST_CUT_PERIOD) )
+        {
+            /* Frame cut short: its length field claims bytes of what follows */
+            n = Bench_Encode(standard, k++, frame, sizeof(frame));
+            n = (uint16_t) (TACHO_VDO_SEQSZ + Bench_Rand(rng) % (n - TACHO_VDO_SEQSZ));
+            memcpy(&Test_Capture[len], frame, n);
+            len += n;
+        }
+        for (i = Bench_Rand(rng) % TEST_MAX_JUNK; 0U < i; i--)
+        {
+            Test_Capture[len++] = (uint8_t) (Bench_Rand(rng) % 0x50U);
+        }
+    }
+    return len;
+}
+
+/**
+ * Decodes a capture
+ * @param rng[in,out] Generator state (block sizes)
+ * @param len Capture length
+ * @param block_path TRUE for Tacho_CtxRxBlock(), FALSE for the byte path
+ * @param record[out] Protocol of every decoded frame
+ * @return Number of decoded frames
+ */
+static uint32_t Test_Decode(uint32_t *rng, uint32_t len, bool_t block_path, uint8_t *record)
+{
+    Tacho_CtxConfig_t config;
+    Tacho_Ctx_t ctx;
+    uint32_t pos;
+    uint32_t block;
+
+    memset(&config, 0, sizeof(config));
+    config.frame_notif = Test_FrameNotif;
+    Tacho_CtxInit(&ctx, &config, NULL_PTR);
+    Tacho_CtxSetAutoStandard(&ctx, TRUE);
+    Test_Record = record;
+    Test_DecodedCount = 0;
+
+    for (pos = 0; pos < len; pos += block)
+    {
+        block = MIN(1U + Bench_Rand(rng) % TEST_MAX_BLOCK, len - pos);
+        if (block_path)
+        {
+            Tacho_CtxRxBlock(&ctx, &Test_Capture[pos], block);
+        }
+        else
+        {
+            block = 1;
+            Tacho_CtxRxNotif(&ctx, Test_Capture[pos]);
+            if (0U == pos % TEST_MAX_BLOCK)
+            {
+                Tacho_CtxTask(&ctx);
+            }
+        }
+    }
+    Tacho_CtxTask(&ctx);
+
+    return Test_DecodedCount;
+}
+
+int main(void)
+{
+    uint32_t rng = 0x5EEDU;
+    uint32_t frames;
+    uint32_t decoded;
+    uint32_t len;
+
+    /* Clean capture: every frame */
+    len = Test_Build(&rng, FALSE, &frames);
+    decoded = Test_Decode(&rng, len, TRUE, Test_Decoded);
+    TEST_CHECK(frames == decoded);
+    TEST_CHECK(0 == memcmp(Test_Expected, Test_Decoded, MIN(frames, decoded)));
+
+    /* Frames cut short: same frames as the byte path */
+    len = Test_Build(&rng, TRUE, &frames);
+    frames = Test_Decode(&rng, len, FALSE, Test_ByteDecoded);
+    decoded = Test_Decode(&rng, len, TRUE, Test_Decoded);
+    TEST_CHECK(frames == decoded);
+    TEST_CHECK(0 == memcmp(Test_ByteDecoded, Test_Decoded, MIN(frames, decoded)));
+
+    return Test_Result("test_rxblock");
+}
@@ -0,0 +1,246 @@
+/**
+ * @file test_snapshot.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Stress test of the cache sequence lock
+ *
+ * A writer thread decodes VDO frames while reader threads take snapshots
+ * with Tacho_CtxReadSnapshot(). Frame k carries a trip of 3k, an odometer of
+ * 200000000 + 3k and the clock BENCH_TIME_BASE + k; the TCO1 and DI it
+ * leaves in the cache are recorded beforehand by a single-threaded pass.
+ * All of them are written in one cache write section, so a snapshot mixing
+ * two frames shows up as fields that disagree. Frames seen by a reader must
+ * never go backwards (generations wrap too fast for that check).
+ * Also built with -fsanitize=thread (see Makefile).
+ *
+ * Usage: test_snapshot [frames]
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "std_types.h"
+#include "tacho_countries.h"
+#include "tacho.h"
+#include "tacho_d8.h"
+#include "tacho_ctx.h"
+#include "tacho_atomic.h"
+#include "bench_util.h"
+#include "test_util.h"
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#define TEST_FRAMES 200000UL  /**< Frames decoded by the writer (default) */
+#define TEST_READERS 3U  /**< Reader threads */
+#define TEST_ODOMETER_BASE 200000000UL  /**< Odometer of frame 0 (see Bench_Frame()) */
+#define TEST_FNV_BASIS 2166136261UL
+#define TEST_FNV_PRIME 16777619UL
+
+/******************************************************************************/
+/*    PRIVATE TYPES                                                           */
+/******************************************************************************/
+
+/** Reader thread results */
+typedef struct
+{
+    uint32_t copies;  /**< Consistent snapshots */
+    uint32_t busy;  /**< Attempts given up on a busy writer */
+    uint32_t torn;  /**< Snapshots mixing two frames */
+    uint32_t backwards;  /**< Snapshots older than the previous one */
+} Test_Reader_t;
+
+/******************************************************************************/
+/*    PRIVATE DATA                                                            */
+/******************************************************************************/
+
+static Tacho_Ctx_t Test_Ctx;
+static uint32_t Test_Frames = TEST_FRAMES;
+static uint32_t *Test_Hash;  /**< Hash of the cached TCO1 and DI after each frame */
+static volatile uint8_t Test_Done;  /**< Set by the writer when all frames are decoded */
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+/**
+ * Hash of the cached TCO1 and DI
+ * @param cached[in] Cached data
+ * @return FNV-1a hash
+ */
+static uint32_t Test_CacheHash(const Tacho_CachedData_t *cached)
+{
+    uint32_t hash = TEST_FNV_BASIS;
+    uint8_t i;
+
+    for (i = 0; i < TACHO_TCO1_SIZE; i++)
+    {
+        hash = (hash ^ cached->tco1[i]) * TEST_FNV_PRIME;
+    }
+    for (i = 0; i < TACHO_MAX_DI_MSG; i++)
+    {
+        hash = (hash ^ cached->di[i]) * TEST_FNV_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * Records the cache hash after each frame, decoding on a private context
+ */
+static void Test_Record(void)
+{
+    static Tacho_Ctx_t ctx;
+    Tacho_CtxConfig_t config;
+    Tacho_Snapshot_t snap;
+    uint8_t frame[BENCH_MAX_FRAME];
+    uint32_t k;
+    uint16_t n;
+
+    memset(&config, 0, sizeof(config));
+    Tacho_CtxInit(&ctx, &config, NULL_PTR);
+    for (k = 0; k < Test_Frames; k++)
+    {
+        n = Bench_Encode(TACHO_STANDARD_VDO, k, frame, sizeof(frame));
+        Tacho_CtxRxBlock(&ctx, frame, n);
+        (void) Tacho_CtxReadSnapshot(&ctx, &snap);
+        Test_Hash[k] = Test_CacheHash(&snap.data);
+    }
+}
+
+/**
+ * Writer thread: decodes the frames
+ * @param arg Unused
+ * @return NULL
+ */
+static void *Test_Writer(void *arg)
+{
+    uint8_t frame[BENCH_MAX_FRAME];
+    uint32_t k;
+    uint16_t n;
+
+    (void) arg;
+
+    for (k = 0; k < Test_Frames; k++)
+    {
+        n = Bench_Encode(TACHO_STANDARD_VDO, k, frame, sizeof(frame));
+        Tacho_CtxRxBlock(&Test_Ctx, frame, n);
+    }
+    TACHO_STORE_RELEASE(&Test_Done, 1U);
+    return NULL_PTR;
+}
+
+/**
+ * Checks that the fields of a snapshot come from the same frame
+ * @param snap[in] Snapshot
+ * @return TRUE if consistent
+ */
+static bool_t Test_Consistent(const Tacho_Snapshot_t *snap)
+{
+    const Tacho_VdoInfo_t *vdo = &snap->data.vdo;
+    Tacho_DateTime_t time;
+
+    if (0U == vdo->odometer)
+    {
+        /* No frame yet: still all zero */
+        return (bool_t) ( (0U == vdo->trip) && (0U == vdo->time.year) );
+    }
+    if ( (vdo->odometer - TEST_ODOMETER_BASE != vdo->trip) || (0U != vdo->trip % 3U) ||
+         (Test_Frames <= vdo->trip / 3U) || (Test_Hash[vdo->trip / 3U] != Test_CacheHash(&snap->data)) )
+    {
+        return FALSE;
+    }
+    Bench_SetTime(&time, BENCH_TIME_BASE + vdo->trip / 3U);
+    return (bool_t) (0 == memcmp(&time, &vdo->time, sizeof(time)));
+}
+
+/**
+ * Reader thread: takes snapshots until the writer is done
+ * @param arg Test_Reader_t results
+ * @return NULL
+ */
+static void *Test_Reader(void *arg)
+{
+    Test_Reader_t *reader = (Test_Reader_t *) arg;
+    Tacho_Snapshot_t snap;
+    uint32_t last = 0;
+
+    while (0U == TACHO_LOAD_ACQUIRE(&Test_Done))
+    {
+        if (E_OK != Tacho_CtxReadSnapshot(&Test_Ctx, &snap))
+        {
+            reader->busy++;
+            continue;
+        }
+        reader->copies++;
+        if (FALSE == Test_Consistent(&snap))
+        {
+            reader->torn++;
+        }
+        if (snap.data.vdo.trip < last)
+        {
+            reader->backwards++;
+        }
+        last = snap.data.vdo.trip;
+    }
+    return NULL_PTR;
+}
+
+int main(int argc, char **argv)
+{
+    Tacho_CtxConfig_t config;
+    Test_Reader_t readers[TEST_READERS];
+    pthread_t reader_threads[TEST_READERS];
+    pthread_t writer_thread;
+    Tacho_Snapshot_t snap;
+    uint32_t copies = 0;
+    uint32_t i;
+
+    if (1 < argc)
+    {
+        Test_Frames = (uint32_t) strtoul(argv[1], NULL_PTR, 0);
+    }
+    Test_Hash = (uint32_t *) malloc(Test_Frames * sizeof(uint32_t));
+    if ( (0U == Test_Frames) || (NULL_PTR == Test_Hash) )
+    {
+        return 1;
+    }
+    Test_Record();
+
+    memset(&config, 0, sizeof(config));
+    Tacho_CtxInit(&Test_Ctx, &config, NULL_PTR);
+    memset(readers, 0, sizeof(readers));
+
+    for (i = 0; i < TEST_READERS; i++)
+    {
+        TEST_CHECK(0 == pthread_create(&reader_threads[i], NULL_PTR, Test_Reader, &readers[i]));
+    }
+    TEST_CHECK(0 == pthread_create(&writer_thread, NULL_PTR, Test_Writer, NULL_PTR));
+
+    (void) pthread_join(writer_thread, NULL_PTR);
+    for (i = 0; i < TEST_READERS; i++)
+    {
+        (void) pthread_join(reader_threads[i], NULL_PTR);
+        printf("reader %u: %u snapshots, %u busy, %u torn, %u backwards\n", (unsigned) i,
+               (unsigned) readers[i].copies, (unsigned) readers[i].busy,
+               (unsigned) readers[i].torn, (unsigned) readers[i].backwards);
+        TEST_CHECK(0U == readers[i].torn);
+        TEST_CHECK(0U == readers[i].backwards);
+        copies += readers[i].copies;
+    }
+    TEST_CHECK(0U < copies);
+
+    /* Once the writer is done the last frame is visible */
+    TEST_CHECK(E_OK == Tacho_CtxReadSnapshot(&Test_Ctx, &snap));
+    TEST_CHECK(Test_Consistent(&snap));
+    TEST_CHECK((Test_Frames - 1U) * 3U == snap.data.vdo.trip);
+
+    free(Test_Hash);
+    return Test_Result("test_snapshot");
+}
@@ -0,0 +1,194 @@
+/**
+ * @file test_stoneridge.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Stoneridge vehicle snapshot (Tacho_CtxGetSrSnapshot())
+ *
+ * VIN, DIN1, DIN2 and VRN messages built with tacho_encode.c are decoded
+ * one at a time. The snapshot is published once every part arrived, with
+ * the VIN, the registering member state and VRN and both driver IDs of
+ * the messages, and TACHO_DIRTY_SR_SNAPSHOT reported whenever a message
+ * changed it. An empty DIN (0xFF) empties the card number of its driver,
+ * reported as a change once.
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#include <string.h>
+#include "std_types.h"
+#include "tacho_countries.h"
+#include "tacho.h"
+#include "tacho_d8.h"
+#include "tacho_ctx.h"
+#include "tacho_encode.h"
+#include "bench_util.h"
+#include "test_util.h"
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#define TEST_DRIVER1 0U  /**< Index of driver 1 in driver[] */
+#define TEST_DRIVER2 1U  /**< Index of driver 2 in driver[] */
+#define TEST_CARD1 "0000000000086H10"  /**< Card number of driver 1 */
+#define TEST_CARD2 "DF00000012345678"  /**< Card number of driver 2 */
+#define TEST_RMS "RO "  /**< Registering member state of BENCH_VRN */
+#define TEST_PLATE "B-123-ABC"  /**< Registration number of BENCH_VRN */
+#define TEST_PLATE_LEN 9U
+#define TEST_VRN2 "RO CJ-99-XYZ"  /**< Another registration */
+#define TEST_VRN2_LEN 12U
+
+/******************************************************************************/
+/*    PRIVATE DATA                                                            */
+/******************************************************************************/
+
+static uint32_t Test_Changes;  /**< change_notif calls carrying TACHO_DIRTY_SR_SNAPSHOT */
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+/**
+ * change_notif binding: counts the snapshot changes
+ * @param ctx Decoder context
+ * @param dirty TACHO_DIRTY_* changes
+ */
+static void Test_ChangeNotif(Tacho_Ctx_t *ctx, uint16_t dirty)
+{
+    (void) ctx;
+    if (0U != (dirty & TACHO_DIRTY_SR_SNAPSHOT))
+    {
+        Test_Changes++;
+    }
+}
+
+/**
+ * Sends a Stoneridge message and tells whether it changed the snapshot
+ * @param ctx Decoder context
+ * @param msg_id Message identifier
+ * @param text[in] VIN or RMS + VRN (VIN and VRN messages)
+ * @param text_len Number of bytes in text
+ * @param card2 Driver 2 card inserted (DIN2 message)
+ * @return TRUE if a snapshot change was notified
+ */
+static bool_t Test_Send(Tacho_Ctx_t *ctx, uint8_t msg_id, const char *text, uint8_t text_len, bool_t card2)
+{
+    uint8_t raw[BENCH_MAX_FRAME];
+    Tacho_Frame_t frame;
+    uint32_t changes = Test_Changes;
+    uint16_t n;
+
+    memset(&frame, 0, sizeof(frame));
+    frame.working_state = 0x21U;
+    memcpy(frame.driver[TEST_DRIVER1].country, "RO ", TACHO_MAX_COUNTRY_CODE);
+    memcpy(frame.driver[TEST_DRIVER1].cardnr, TEST_CARD1, TACHO_MAX_CARD_NR);
+    if (card2)
+    {
+        memcpy(frame.driver[TEST_DRIVER2].country, "D  ", TACHO_MAX_COUNTRY_CODE);
+        memcpy(frame.driver[TEST_DRIVER2].cardnr, TEST_CARD2, TACHO_MAX_CARD_NR);
+    }
+    n = Tacho_EncodeStoneridge(&frame, msg_id, (const uint8_t *) text, text_len, raw, sizeof(raw));
+    TEST_CHECK(0U < n);
+    Tacho_CtxRxBlock(ctx, raw, n);
+    return (bool_t) (changes != Test_Changes);
+}
+
+/**
+ * Tells whether a text field holds a string padded with spaces
+ * @param field[in] Field
+ * @param len Number of bytes in field
+ * @param text[in] Expected string
+ * @param text_len Number of bytes in text
+ * @return TRUE if so
+ */
+static bool_t Test_Padded(const uint8_t *field, uint8_t len, const char *text, uint8_t text_len)
+{
+    uint8_t i;
+
+    if ( (len < text_len) || (0 != memcmp(field, text, text_len)) )
+    {
+        return FALSE;
+    }
+    for (i = text_len; i < len; i++)
+    {
+        if (' ' != field[i])
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/**
+ * Checks the snapshot assembly
+ */
+static void Test_Snapshot(void)
+{
+    static const Tacho_Thresholds_t thresholds = { TACHO_DIRTY_SR_SNAPSHOT, 0xFFFFU, 0, 0 };
+    static Tacho_CtxConfig_t config;
+    static Tacho_Ctx_t ctx;
+    const Tacho_SrSnapshot_t *sr = Tacho_CtxGetSrSnapshot(&ctx);
+
+    config.change_notif = Test_ChangeNotif;
+    Tacho_CtxInit(&ctx, &config, NULL_PTR);
+    Tacho_CtxSetThresholds(&ctx, &thresholds);
+    TEST_CHECK(E_OK == Bench_Select(&ctx, TACHO_STANDARD_STONERIDGE));
+
+    /* Nothing published until every part arrived */
+    TEST_CHECK(FALSE == Test_Send(&ctx, TACHO_SR_MSG_VIN, BENCH_VIN, BENCH_VIN_LEN, TRUE));
+    TEST_CHECK(FALSE == Test_Send(&ctx, TACHO_SR_MSG_DIN1, NULL_PTR, 0U, TRUE));
+    TEST_CHECK(FALSE == Test_Send(&ctx, TACHO_SR_MSG_DIN2, NULL_PTR, 0U, TRUE));
+    TEST_CHECK(FALSE == Tacho_CtxSrSnapshotComplete(&ctx));
+    TEST_CHECK(0U == sr->valid);
+    TEST_CHECK(TACHO_SR_AGE_NONE == Tacho_CtxGetSrPartAge(&ctx, TACHO_SR_PART_VRN));
+    TEST_CHECK(2U == Tacho_CtxGetSrPartAge(&ctx, TACHO_SR_PART_VIN));
+
+    TEST_CHECK(TRUE == Test_Send(&ctx, TACHO_SR_MSG_VRN, BENCH_VRN, BENCH_VRN_LEN, TRUE));
+    TEST_CHECK(TRUE == Tacho_CtxSrSnapshotComplete(&ctx));
+    TEST_CHECK(TACHO_SR_PART_ALL == sr->valid);
+    TEST_CHECK( (BENCH_VIN_LEN == sr->vin_len) && (0 == memcmp(sr->vin, BENCH_VIN, BENCH_VIN_LEN)) );
+    TEST_CHECK(0 == memcmp(sr->rms, TEST_RMS, TACHO_MAX_COUNTRY_CODE));
+    TEST_CHECK(Test_Padded(sr->vrn, sr->vrn_len, TEST_PLATE, TEST_PLATE_LEN));
+    TEST_CHECK(0 == memcmp(sr->driver[TEST_DRIVER1].country, "RO ", TACHO_MAX_COUNTRY_CODE));
+    TEST_CHECK(0 == memcmp(sr->driver[TEST_DRIVER1].cardnr, TEST_CARD1, TACHO_MAX_CARD_NR));
+    TEST_CHECK(0 == memcmp(sr->driver[TEST_DRIVER2].country, "D  ", TACHO_MAX_COUNTRY_CODE));
+    TEST_CHECK(0 == memcmp(sr->driver[TEST_DRIVER2].cardnr, TEST_CARD2, TACHO_MAX_CARD_NR));
+    TEST_CHECK(0U == Tacho_CtxGetSrPartAge(&ctx, TACHO_SR_PART_VRN));
+
+    /* The same parts again: no change */
+    TEST_CHECK(FALSE == Test_Send(&ctx, TACHO_SR_MSG_VIN, BENCH_VIN, BENCH_VIN_LEN, TRUE));
+    TEST_CHECK(FALSE == Test_Send(&ctx, TACHO_SR_MSG_DIN1, NULL_PTR, 0U, TRUE));
+    TEST_CHECK(FALSE == Test_Send(&ctx, TACHO_SR_MSG_DIN2, NULL_PTR, 0U, TRUE));
+    TEST_CHECK(FALSE == Test_Send(&ctx, TACHO_SR_MSG_VRN, BENCH_VRN, BENCH_VRN_LEN, TRUE));
+    TEST_CHECK(0U == Tacho_CtxGetSrPartAge(&ctx, TACHO_SR_PART_VRN));
+    TEST_CHECK(3U == Tacho_CtxGetSrPartAge(&ctx, TACHO_SR_PART_VIN));
+
+    /* Card 2 withdrawn: empty DIN, reported once */
+    TEST_CHECK(TRUE == Test_Send(&ctx, TACHO_SR_MSG_DIN2, NULL_PTR, 0U, FALSE));
+    TEST_CHECK('\0' == sr->driver[TEST_DRIVER2].cardnr[0]);
+    TEST_CHECK(0 == memcmp(sr->driver[TEST_DRIVER1].cardnr, TEST_CARD1, TACHO_MAX_CARD_NR));
+    TEST_CHECK(TRUE == Tacho_CtxSrSnapshotComplete(&ctx));
+    TEST_CHECK(FALSE == Test_Send(&ctx, TACHO_SR_MSG_DIN2, NULL_PTR, 0U, FALSE));
+    TEST_CHECK(FALSE == Test_Send(&ctx, TACHO_SR_MSG_DIN1, NULL_PTR, 0U, FALSE));
+    TEST_CHECK('\0' == sr->driver[TEST_DRIVER2].cardnr[0]);
+
+    /* and inserted again */
+    TEST_CHECK(TRUE == Test_Send(&ctx, TACHO_SR_MSG_DIN2, NULL_PTR, 0U, TRUE));
+    TEST_CHECK(0 == memcmp(sr->driver[TEST_DRIVER2].cardnr, TEST_CARD2, TACHO_MAX_CARD_NR));
+
+    /* New registration */
+    TEST_CHECK(TRUE == Test_Send(&ctx, TACHO_SR_MSG_VRN, TEST_VRN2, TEST_VRN2_LEN, TRUE));
+    TEST_CHECK(0 == memcmp(sr->rms, TEST_RMS, TACHO_MAX_COUNTRY_CODE));
+    TEST_CHECK(Test_Padded(sr->vrn, sr->vrn_len, &TEST_VRN2[TACHO_MAX_COUNTRY_CODE],
+                           TEST_VRN2_LEN - TACHO_MAX_COUNTRY_CODE));
+}
+
+int main(void)
+{
+    Test_Snapshot();
+
+    return Test_Result("test_stoneridge");
+}
@@ -0,0 +1,148 @@
+/**
+ * @file test_sync.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Start sequence automaton against a naive search
+ *
+ * A random stream over the bytes of the start sequences is run through the
+ * automaton, first the built-in constant table, then the one built in RAM
+ * after registering a sequence. At every byte, the start sequence reported
+ * must be the longest known one ending there.
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#include <string.h>
+#include "std_types.h"
+#include "tacho_countries.h"
+#include "tacho.h"
+#include "tacho_d8.h"
+#include "tacho_ctx.h"
+#include "tacho_sync.h"
+#include "bench_util.h"
+#include "test_util.h"
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#define TEST_STREAM 1000000UL  /**< Bytes run through the automaton per pass */
+#define TEST_EXTRA_ID 5U  /**< ID of the registered start sequence */
+
+/******************************************************************************/
+/*    PRIVATE TYPES                                                           */
+/******************************************************************************/
+
+/** Start sequence known to the reference search */
+typedef struct
+{
+    const uint8_t *seq;
+    uint8_t size;
+    uint8_t id;
+} Test_Pattern_t;
+
+/******************************************************************************/
+/*    PRIVATE DATA                                                            */
+/******************************************************************************/
+
+static const uint8_t Test_VdoSeq[TACHO_VDO_SEQSZ] = {TACHO_VDO_START_SEQ};
+static const uint8_t Test_SrSeq[TACHO_SR_SEQSZ] = {TACHO_SR_START_SEQ};
+static const uint8_t Test_ExtraSeq[] = {0x41, 0x55, 0xFF};  /**< Shares bytes with both built-in sequences */
+
+/** Stream bytes: every start sequence byte, and two others */
+static const uint8_t Test_Alphabet[] = {0x55, 0x44, 0x54, 0x43, 0x4F, 0xFF, 0x41, 0x00};
+
+static const Test_Pattern_t Test_Patterns[] =
+{
+    { Test_VdoSeq, TACHO_VDO_SEQSZ, TACHO_STANDARD_VDO },
+    { Test_SrSeq, TACHO_SR_SEQSZ, TACHO_STANDARD_STONERIDGE },
+    { Test_ExtraSeq, sizeof(Test_ExtraSeq), TEST_EXTRA_ID }
+};
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+/**
+ * Longest start sequence ending at the last byte of a history
+ * @param hist[in] Last received bytes, most recent last
+ * @param count Number of bytes in hist
+ * @param patterns Number of entries of Test_Patterns known
+ * @return ID of the sequence, TACHO_SYNC_NONE if none
+ */
+static uint8_t Test_Naive(const uint8_t *hist, uint8_t count, uint8_t patterns)
+{
+    uint8_t best = TACHO_SYNC_NONE;
+    uint8_t best_size = 0;
+    uint8_t p;
+
+    for (p = 0; p < patterns; p++)
+    {
+        if ( (Test_Patterns[p].size <= count) && (Test_Patterns[p].size > best_size) &&
+             (0 == memcmp(&hist[count - Test_Patterns[p].size], Test_Patterns[p].seq, Test_Patterns[p].size)) )
+        {
+            best = Test_Patterns[p].id;
+            best_size = Test_Patterns[p].size;
+        }
+    }
+    return best;
+}
+
+/**
+ * Runs a random stream through the automaton and the naive search
+ * @param rng[in,out] Generator state
+ * @param patterns Number of entries of Test_Patterns known to the automaton
+ * @return Number of positions where both disagree
+ */
+static uint32_t Test_Pass(uint32_t *rng, uint8_t patterns)
+{
+    uint8_t hist[TACHO_SYNC_MAX_SEQ];
+    uint8_t count = 0;
+    uint8_t state = 0;
+    uint32_t errors = 0;
+    uint32_t i;
+    uint8_t b;
+
+    for (i = 0; i < TEST_STREAM; i++)
+    {
+        b = Test_Alphabet[Bench_Rand(rng) % sizeof(Test_Alphabet)];
+        if (TACHO_SYNC_MAX_SEQ == count)
+        {
+            memmove(hist, &hist[1], TACHO_SYNC_MAX_SEQ - 1U);
+            count--;
+        }
+        hist[count++] = b;
+
+        state = Tacho_SyncNext(state, b);
+        if (Tacho_SyncMatch(state) != Test_Naive(hist, count, patterns))
+        {
+            errors++;
+        }
+    }
+    return errors;
+}
+
+int main(void)
+{
+    static const uint8_t too_long[TACHO_SYNC_MAX_SEQ + 1] = {0};
+    const Tacho_SyncDfa_t *builtin = Tacho_SyncDfa;
+    uint32_t rng = 0x5EEDU;
+
+    /* Constant table of the built-in sequences */
+    TEST_CHECK(0 == Test_Pass(&rng, TACHO_STANDARD_MAX));
+
+    /* Rejected sequences leave the automaton alone */
+    TEST_CHECK(E_NOT_OK == Tacho_SyncRegister(too_long, sizeof(too_long), TEST_EXTRA_ID));
+    TEST_CHECK(E_NOT_OK == Tacho_SyncRegister(Test_ExtraSeq, sizeof(Test_ExtraSeq), TACHO_SYNC_NONE));
+    TEST_CHECK(builtin == Tacho_SyncDfa);
+
+    /* Table built in RAM */
+    TEST_CHECK(E_OK == Tacho_SyncRegister(Test_ExtraSeq, sizeof(Test_ExtraSeq), TEST_EXTRA_ID));
+    TEST_CHECK(builtin != Tacho_SyncDfa);
+    TEST_CHECK(0 == Test_Pass(&rng, TACHO_STANDARD_MAX + 1U));
+
+    return Test_Result("test_sync");
+}
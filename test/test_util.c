@@ -0,0 +1,61 @@
+/**
+ * @file test_util.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Checks shared by the host tests
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "std_types.h"
+#include "test_util.h"
+
+/******************************************************************************/
+/*    PRIVATE DATA                                                            */
+/******************************************************************************/
+
+static uint32_t Test_Checks;  /**< Checks run */
+static uint32_t Test_Failures;  /**< Checks failed */
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+/**
+ * Records the result of a check (use TEST_CHECK())
+ * @param ok Check result
+ * @param file Source file
+ * @param line Source line
+ * @param cond Condition checked
+ * @return ok
+ */
+bool_t Test_Check(bool_t ok, const char *file, int line, const char *cond)
+{
+    Test_Checks++;
+    if (FALSE == ok)
+    {
+        /* Report the first failures only, a broken loop would flood the log */
+        if (20U > Test_Failures)
+        {
+            printf("%s:%d: check failed: %s\n", file, line, cond);
+        }
+        Test_Failures++;
+    }
+    return ok;
+}
+
+/**
+ * Prints the test summary
+ * @param name Test name
+ * @return Exit status of the test program
+ */
+int Test_Result(const char *name)
+{
+    printf("%s: %u checks, %u failed\n", name, (unsigned) Test_Checks, (unsigned) Test_Failures);
+    return (0U == Test_Failures) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,29 @@
+/**
+ * @file test_util.h
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Checks shared by the host tests
+ *
+ * A failed TEST_CHECK() prints its location and condition and the test
+ * goes on; Test_Result() turns the failures into the exit status.
+ */
+
+#ifndef TEST_UTIL_H
+#define	TEST_UTIL_H
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+/** Records a failure if cond is false */
+#define TEST_CHECK(cond) Test_Check((cond) ? TRUE : FALSE, __FILE__, __LINE__, #cond)
+
+/******************************************************************************/
+/*    PUBLIC FUNCTIONS                                                        */
+/******************************************************************************/
+
+bool_t Test_Check(bool_t ok, const char *file, int line, const char *cond);
+int Test_Result(const char *name);
+
+#endif	/* TEST_UTIL_H */
@@ -0,0 +1,220 @@
+/**
+ * @file test_vdo_engines.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Cross-check of the VDO frame engine and the legacy per-byte engine
+ * (TACHO_CFG_VDO_BYTEWISE)
+ *
+ * The test is built once per engine (see Makefile) and both builds must
+ * write the same trace: one line per frame with the TCO1 notifications so
+ * far and the cached TCO1 and DI. The corpus mixes encoder frames (0 to 2
+ * cards) with frames of random VIN, custom string and DIN lengths and
+ * content, some of them with a wrong checksum; each build also checks that
+ * every encoder frame is decoded or rejected as expected (TACHO_CFG_STATS).
+ *
+ * Usage: test_vdo_engines trace_file
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "std_types.h"
+#include "tacho_countries.h"
+#include "tacho.h"
+#include "tacho_d8.h"
+#include "tacho_ctx.h"
+#include "tacho_checksum.h"
+#include "bench_util.h"
+#include "stubs.h"
+#include "test_util.h"
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#define TEST_FRAMES 20000U  /**< Frames in the corpus */
+#define TEST_TASK_PERIOD 50U  /**< Bytes received between two task runs */
+#define TEST_MAX_SECTION 30U  /**< Random VIN, custom string and DIN lengths are below this */
+#define TEST_BAD_CRC_PERIOD 53U  /**< One frame in this many has a wrong checksum */
+#define TEST_DIN_SIZE (TACHO_VDO_CC_POS + 1U + TACHO_MAX_CARD_NR)  /**< Size of a present DIN */
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+/**
+ * Builds a VDO frame with random section lengths and content
+ * @param rng[in,out] Generator state
+ * @param out[out] Frame
+ * @return Frame length
+ */
+static uint16_t Test_RandomFrame(uint32_t *rng, uint8_t *out)
+{
+    static const uint8_t start_seq[TACHO_VDO_SEQSZ] = {TACHO_VDO_START_SEQ};
+    uint16_t len = TACHO_VDO_SEQSZ;
+    uint8_t section_len;
+    uint8_t section;
+    uint8_t k;
+
+    memcpy(out, start_seq, TACHO_VDO_SEQSZ);
+    while (TACHO_VDO_VIN_LENGTH > len)
+    {
+        out[len++] = (uint8_t) (Bench_Rand(rng) & 0x3FU);
+    }
+    /*
+     * VIN, custom string, DIN1, DIN2. DINs are empty or of the card size: the
+     * legacy engine keeps bytes of a rejected frame in the driver IDs, which
+     * a shorter DIN would let through.
+     */
+    for (section = 0; section < 4U; section++)
+    {
+        section_len = (uint8_t) (Bench_Rand(rng) % TEST_MAX_SECTION);
+        if (2U <= section)
+        {
+            section_len = (0U == Bench_Rand(rng) % 3U) ? 0U : (uint8_t) TEST_DIN_SIZE;
+        }
+        out[len++] = section_len;
+        for (k = 0; k < section_len; k++)
+        {
+            out[len++] = (uint8_t) ( ((2U <= section) && (TACHO_VDO_CC_POS == k)) ?
+                                     (Bench_Rand(rng) % 0x40U) : ('0' + (Bench_Rand(rng) % 40U)) );
+        }
+    }
+    out[len] = Tacho_ChecksumXor(&out[TACHO_VDO_SEQSZ], len - TACHO_VDO_SEQSZ, TACHO_VDO_CRC_INIT);
+    return len + 1U;
+}
+
+/**
+ * Cached DI a frame should produce
+ * @param frame[in] Encoded frame content
+ * @param di[out] Country code and card number of each inserted card, each
+ *  driver followed by '*', then '\0'
+ * @return Number of bytes in di
+ */
+static uint16_t Test_ExpectedDi(const Tacho_Frame_t *frame, uint8_t *di)
+{
+    uint16_t len = 0;
+    uint8_t i;
+
+    for (i = 0; i < TACHO_MAX_DRIVERS; i++)
+    {
+        if ('\0' != frame->driver[i].cardnr[0])
+        {
+            memcpy(&di[len], frame->driver[i].country, TACHO_MAX_COUNTRY_CODE);
+            len += TACHO_MAX_COUNTRY_CODE;
+            memcpy(&di[len], frame->driver[i].cardnr, TACHO_MAX_CARD_NR);
+            len += TACHO_MAX_CARD_NR;
+        }
+        di[len++] = '*';
+    }
+    di[len++] = '\0';
+    return len;
+}
+
+/**
+ * Writes the trace line of the last frame
+ * @param trace Trace file
+ */
+static void Test_Trace(FILE *trace)
+{
+    const uint8_t *tco1 = tacho_get_cached_tco1_content_p();
+    const uint8_t *di = tacho_get_cached_di_content_p();
+    uint32_t i;
+
+    fprintf(trace, "%u ", (unsigned) Stub_FmiEvents);
+    for (i = 0; i < TACHO_TCO1_SIZE; i++)
+    {
+        fprintf(trace, "%02x", tco1[i]);
+    }
+    fputc(' ', trace);
+    for (i = 0; i < TACHO_MAX_DI_MSG; i++)
+    {
+        fprintf(trace, "%02x", di[i]);
+    }
+    fputc('\n', trace);
+}
+
+int main(int argc, char **argv)
+{
+    uint8_t frame[TACHO_VDO_VIN_LENGTH + 4U * TEST_MAX_SECTION + 1U];
+    uint8_t di[TACHO_MAX_DI_MSG];
+    Tacho_Frame_t expected;
+    Tacho_Stats_t stats;
+    uint32_t decoded = 0;
+    uint32_t checksum = 0;
+    FILE *trace;
+    uint32_t rng = 0x2545F491UL;
+    uint32_t fed = 0;
+    uint32_t n;
+    uint16_t len;
+    uint16_t i;
+    bool_t encoded;
+    bool_t bad;
+
+    trace = (1 < argc) ? fopen(argv[1], "w") : NULL;
+    if (NULL == trace)
+    {
+        printf("usage: %s trace_file\n", argv[0]);
+        return 2;
+    }
+
+    Tacho_Init();
+    TEST_CHECK(TACHO_STANDARD_VDO == Tacho_GetSelectedStandard());
+
+    for (n = 0; n < TEST_FRAMES; n++)
+    {
+        encoded = (0U == (n & 1U)) ? TRUE : FALSE;
+        if (TRUE == encoded)
+        {
+            Bench_Frame(TACHO_STANDARD_VDO, n, &expected);
+            len = Bench_Encode(TACHO_STANDARD_VDO, n, frame, sizeof(frame));
+        }
+        else
+        {
+            len = Test_RandomFrame(&rng, frame);
+        }
+        bad = (0U == (n % TEST_BAD_CRC_PERIOD)) ? TRUE : FALSE;
+        if (TRUE == bad)
+        {
+            frame[len - 1U] ^= 0x5AU;
+        }
+
+        for (i = 0; i < len; i++)
+        {
+            Tacho_RxNotif(frame[i]);
+            if (0U == (++fed % TEST_TASK_PERIOD))
+            {
+                Tacho_Task();
+            }
+        }
+        Tacho_Task();
+
+        (void) Tacho_GetStats(&stats);
+        if (TRUE == bad)
+        {
+            TEST_CHECK(checksum + 1U == stats.counter[TACHO_STAT_CHECKSUM]);
+        }
+        else if (TRUE == encoded)
+        {
+            TEST_CHECK(decoded + 1U == stats.counter[TACHO_STAT_FRAMES]);
+            len = Test_ExpectedDi(&expected, di);
+            TEST_CHECK(0 == memcmp(di, tacho_get_cached_di_content_p(), len));
+        }
+        decoded = stats.counter[TACHO_STAT_FRAMES];
+        checksum = stats.counter[TACHO_STAT_CHECKSUM];
+        Test_Trace(trace);
+    }
+    TEST_CHECK(0U == Tacho_GetDroppedBytes());
+    TEST_CHECK(0U < Stub_FmiEvents);
+
+    (void) fclose(trace);
+#if (TACHO_CFG_VDO_BYTEWISE == STD_ON)
+    return Test_Result("test_vdo_engines (bytewise)");
+#else
+    return Test_Result("test_vdo_engines (frame)");
+#endif
+}
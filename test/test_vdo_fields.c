@@ -0,0 +1,205 @@
+/**
+ * @file test_vdo_fields.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Fields of a VDO frame as decoded by the frame engine
+ *
+ * The sample frame of the README (one card, 88 bytes) is decoded through
+ * Tacho_CtxRxBlock(): every field of Tacho_Frame_t.vdo is checked in
+ * frame resolution and in units (UTC time at 0.25 s/bit, date at
+ * 0.25 day/bit, distances at 5 m/bit), with the VIN and custom string
+ * views pointing at the bytes of the frame while frame_notif runs and
+ * into the cache afterwards. A frame encoded with extreme values (odd
+ * quarters, distances and K-factor with every byte set, a short VIN, an
+ * empty custom string) checks the byte order and the view lengths.
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#include <string.h>
+#include "std_types.h"
+#include "tacho_countries.h"
+#include "tacho.h"
+#include "tacho_d8.h"
+#include "tacho_ctx.h"
+#include "tacho_encode.h"
+#include "bench_util.h"
+#include "test_util.h"
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#define TEST_README_LEN 88U  /**< Sample frame length, one card */
+#define TEST_README_VIN 35U  /**< First VIN byte in the sample frame */
+#define TEST_README_CSTR 53U  /**< First custom string byte in the sample frame */
+#define TEST_SHORT_VIN "ABC12"
+#define TEST_SHORT_VIN_LEN 5U
+
+/******************************************************************************/
+/*    PRIVATE DATA                                                            */
+/******************************************************************************/
+
+/** Sample frame of the README */
+static const uint8_t Test_Readme[TEST_README_LEN] =
+{
+    0x55, 0x44, 0x54, 0x43, 0x4F, 0x00,  /* UDTCO, reserved */
+    0xAC, 0x1E, 0x0D, 0x08, 0x47, 0x20, 0x7D, 0x80,  /* 2017-08-18 13:30:43 UTC */
+    0x0A, 0x00, 0xC0, 0xC0,  /* States */
+    0x00, 0x00,  /* Speed */
+    0x9B, 0xB2, 0xE1, 0x05,  /* Total distance */
+    0x03, 0x6F, 0x53, 0x00,  /* Trip distance */
+    0x40, 0x1F,  /* K-factor */
+    0xFF, 0xFF, 0x50, 0x04,
+    0x11, 'W', 'D', 'B', '9', '6', '3', '4', '0', '3', '1', 'L', '7', '1', '7', '7', '2', '9',
+    0x0E, 0x01, '1', '2', '3', 'T', 'E', 'S', 'T', ' ', ' ', ' ', ' ', ' ', ' ',
+    0x12, 0x04, 0x29, '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '8', '6', 'H', '1', '0', '1',
+    0x00,  /* No second card */
+    0xCC  /* CRC */
+};
+
+static const uint8_t *Test_Raw;  /**< Frame being decoded */
+static Tacho_VdoInfo_t Test_Notified;  /**< Tacho_Frame_t.vdo seen by frame_notif */
+static uint8_t Test_NotifiedVin[256];  /**< VIN view content seen by frame_notif */
+static uint8_t Test_NotifiedCstr[256];  /**< Custom string view content seen by frame_notif */
+static uint32_t Test_Frames;  /**< frame_notif calls */
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+/**
+ * frame_notif binding: copies the VDO data and the content of its views
+ * @param ctx Decoder context
+ */
+static void Test_FrameNotif(Tacho_Ctx_t *ctx)
+{
+    Test_Frames++;
+    Test_Notified = ctx->frame.vdo;
+    memcpy(Test_NotifiedVin, Test_Notified.vin.data, Test_Notified.vin.length);
+    memcpy(Test_NotifiedCstr, Test_Notified.cstr.data, Test_Notified.cstr.length);
+}
+
+/**
+ * Decodes one frame on a fresh context
+ * @param ctx[out] Decoder context
+ * @param raw[in] Frame
+ * @param length Frame length
+ * @return TRUE if the frame was decoded
+ */
+static bool_t Test_Decode(Tacho_Ctx_t *ctx, const uint8_t *raw, uint16_t length)
+{
+    static Tacho_CtxConfig_t config;
+    uint32_t frames = Test_Frames;
+
+    config.frame_notif = Test_FrameNotif;
+    Tacho_CtxInit(ctx, &config, NULL_PTR);
+    Test_Raw = raw;
+    Tacho_CtxRxBlock(ctx, raw, length);
+    return (bool_t) (frames + 1U == Test_Frames);
+}
+
+/**
+ * Checks the README sample frame
+ */
+static void Test_ReadmeFrame(void)
+{
+    static Tacho_Ctx_t ctx;
+    const Tacho_VdoInfo_t *vdo = &Test_Notified;
+    const Tacho_VdoInfo_t *cached = Tacho_CtxGetCachedVdo(&ctx);
+
+    TEST_CHECK(Test_Decode(&ctx, Test_Readme, TEST_README_LEN));
+
+    /* 2017-08-18 13:30:43 UTC, day 18 being in its second half */
+    TEST_CHECK(172U == vdo->time.seconds);
+    TEST_CHECK(43U == vdo->time.seconds / 4U);
+    TEST_CHECK(30U == vdo->time.minutes);
+    TEST_CHECK(13U == vdo->time.hours);
+    TEST_CHECK(8U == vdo->time.month);
+    TEST_CHECK(71U == vdo->time.day);
+    TEST_CHECK(18U == (vdo->time.day - 1U) / 4U + 1U);
+    TEST_CHECK(2017U == vdo->time.year + 1985U);
+    TEST_CHECK(125U == vdo->time.local_min_offset);
+    TEST_CHECK(128U == vdo->time.local_hour_offset);
+
+    /* 493387.015 km in total, 27339.535 km trip */
+    TEST_CHECK(0x05E1B29BUL == vdo->odometer);
+    TEST_CHECK(493387015ULL == vdo->odometer * 5ULL);
+    TEST_CHECK(0x00536F03UL == vdo->trip);
+    TEST_CHECK(27339535ULL == vdo->trip * 5ULL);
+    TEST_CHECK(8000U == vdo->k_factor);
+
+    /* Views into the frame while it is reported */
+    TEST_CHECK(17U == vdo->vin.length);
+    TEST_CHECK(0 == memcmp(Test_NotifiedVin, &Test_Raw[TEST_README_VIN], 17U));
+    TEST_CHECK(0 == memcmp(Test_NotifiedVin, BENCH_VIN, BENCH_VIN_LEN));
+    TEST_CHECK(14U == vdo->cstr.length);
+    TEST_CHECK(0 == memcmp(Test_NotifiedCstr, &Test_Raw[TEST_README_CSTR], 14U));
+    TEST_CHECK(0 == memcmp(Test_NotifiedCstr, BENCH_CSTR, BENCH_CSTR_LEN));
+
+    /* and into the cache afterwards */
+    TEST_CHECK(0 == memcmp(&cached->time, &vdo->time, sizeof(vdo->time)));
+    TEST_CHECK( (vdo->odometer == cached->odometer) && (vdo->trip == cached->trip) &&
+                (vdo->k_factor == cached->k_factor) );
+    TEST_CHECK( (17U == cached->vin.length) && (0 == memcmp(cached->vin.data, BENCH_VIN, BENCH_VIN_LEN)) );
+    TEST_CHECK( (14U == cached->cstr.length) && (0 == memcmp(cached->cstr.data, BENCH_CSTR, BENCH_CSTR_LEN)) );
+    TEST_CHECK( ((const uint8_t *) &ctx.cached <= cached->vin.data) &&
+                (cached->vin.data < (const uint8_t *) (&ctx.cached + 1)) );
+
+    /* Driver 1 only */
+    TEST_CHECK(0 == memcmp(ctx.frame.driver[0].cardnr, "000000000086H101", TACHO_MAX_CARD_NR));
+    TEST_CHECK('\0' == ctx.frame.driver[1].cardnr[0]);
+}
+
+/**
+ * Checks an encoded frame with extreme values
+ */
+static void Test_EncodedFrame(void)
+{
+    static Tacho_Ctx_t ctx;
+    const Tacho_VdoInfo_t *vdo = &Test_Notified;
+    uint8_t raw[BENCH_MAX_FRAME];
+    Tacho_Frame_t frame;
+    uint16_t n;
+
+    memset(&frame, 0, sizeof(frame));
+    frame.vdo.time.seconds = 4U * 59U + 3U;  /* 59.75 s */
+    frame.vdo.time.minutes = 59U;
+    frame.vdo.time.hours = 23U;
+    frame.vdo.time.month = 12U;
+    frame.vdo.time.day = 4U * 30U + 4U;  /* 31st, last quarter */
+    frame.vdo.time.year = 0xFFU;
+    frame.vdo.time.local_min_offset = 0U;
+    frame.vdo.time.local_hour_offset = 0xFFU;
+    frame.vdo.odometer = 0xFEDCBA98UL;
+    frame.vdo.trip = 0x01020304UL;
+    frame.vdo.k_factor = 0xA55AU;
+    n = Tacho_EncodeVdo(&frame, (const uint8_t *) TEST_SHORT_VIN, TEST_SHORT_VIN_LEN, NULL_PTR, 0U, raw, sizeof(raw));
+    TEST_CHECK(0U < n);
+    TEST_CHECK(Test_Decode(&ctx, raw, n));
+
+    TEST_CHECK(59U == vdo->time.seconds / 4U);
+    TEST_CHECK(3U == vdo->time.seconds % 4U);
+    TEST_CHECK( (59U == vdo->time.minutes) && (23U == vdo->time.hours) && (12U == vdo->time.month) );
+    TEST_CHECK(31U == (vdo->time.day - 1U) / 4U + 1U);
+    TEST_CHECK(3U == (vdo->time.day - 1U) % 4U);
+    TEST_CHECK(0 == memcmp(&frame.vdo.time, &vdo->time, sizeof(vdo->time)));
+    TEST_CHECK(0xFEDCBA98UL == vdo->odometer);
+    TEST_CHECK(0x01020304UL == vdo->trip);
+    TEST_CHECK(0xA55AU == vdo->k_factor);
+    TEST_CHECK(TEST_SHORT_VIN_LEN == vdo->vin.length);
+    TEST_CHECK(0 == memcmp(Test_NotifiedVin, TEST_SHORT_VIN, TEST_SHORT_VIN_LEN));
+    TEST_CHECK(0U == vdo->cstr.length);
+    TEST_CHECK(0U == Tacho_CtxGetCachedVdo(&ctx)->cstr.length);
+}
+
+int main(void)
+{
+    Test_ReadmeFrame();
+    Test_EncodedFrame();
+
+    return Test_Result("test_vdo_fields");
+}
@@ -0,0 +1,280 @@
+/**
+ * @file test_wakeup.c
+ * @author gabi
+ * @date 16 Oct 2026
+ *
+ * Wait and signal of the POSIX wakeup events (tacho_wakeup_posix.c)
+ *
+ * Two contexts each have an event of their own. A signal is remembered
+ * until the next wait, wakes the waiter of its own event only, and a wait
+ * without one times out no earlier than asked. Then each context gets a
+ * producer thread feeding VDO frames byte by byte and a decoder thread
+ * running the task only when woken: every frame must be decoded without a
+ * single timeout, and every call of the wakeup binding must be taken by a
+ * wait on the event of its context.
+ */
+
+/******************************************************************************/
+/*    INCLUDED FILES                                                          */
+/******************************************************************************/
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200112L  /* sched_yield() under -std=c99 */
+#endif
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include "std_types.h"
+#include "tacho_countries.h"
+#include "tacho.h"
+#include "tacho_d8.h"
+#include "tacho_ctx.h"
+#include "tacho_atomic.h"
+#include "tacho_wakeup_posix.h"
+#include "bench_util.h"
+#include "test_util.h"
+
+/******************************************************************************/
+/*    DEFINITIONS                                                             */
+/******************************************************************************/
+
+#define TEST_CTXS 2U  /**< Contexts, each with its own event */
+#define TEST_FRAMES 500U  /**< Frames sent to each context */
+#define TEST_SHORT_MS 50U  /**< Wait expected to time out */
+#define TEST_LONG_MS 2000U  /**< Wait expected to be woken, a lost signal costing that much */
+#define TEST_NANOS_PER_MS 1000000ULL
+
+/******************************************************************************/
+/*    PRIVATE TYPES                                                           */
+/******************************************************************************/
+
+/** Wait run by a thread */
+typedef struct
+{
+    Tacho_WakeupPosix_t *event;  /**< Event waited on */
+    uint32_t timeout_ms;  /**< Maximum wait */
+    bool_t woken;  /**< Wait result */
+} Test_Wait_t;
+
+/******************************************************************************/
+/*    PRIVATE DATA                                                            */
+/******************************************************************************/
+
+static Tacho_Ctx_t Test_Ctx[TEST_CTXS];
+static Tacho_WakeupPosix_t Test_Event[TEST_CTXS];
+static uint32_t Test_Decoded[TEST_CTXS];  /**< Frames decoded, written by the decoder thread */
+static uint32_t Test_Wakeups[TEST_CTXS];  /**< Calls of the wakeup binding, made by the producer thread */
+static uint32_t Test_Timeouts[TEST_CTXS];  /**< Waits of the decoder thread that timed out */
+
+/******************************************************************************/
+/*    IMPLEMENTATION                                                          */
+/******************************************************************************/
+
+/**
+ * Index of a context
+ * @param ctx Decoder context
+ * @return Index in Test_Ctx
+ */
+static uint32_t Test_Index(const Tacho_Ctx_t *ctx)
+{
+    return (uint32_t) (ctx - Test_Ctx);
+}
+
+/**
+ * wakeup binding: counts the call and signals the event of the context
+ * @param ctx Decoder context
+ */
+static void Test_Wakeup(Tacho_Ctx_t *ctx)
+{
+    Test_Wakeups[Test_Index(ctx)]++;
+    Tacho_WakeupPosixSignal(ctx);
+}
+
+/**
+ * frame_notif binding: publishes the number of decoded frames
+ * @param ctx Decoder context
+ */
+static void Test_FrameNotif(Tacho_Ctx_t *ctx)
+{
+    uint32_t i = Test_Index(ctx);
+
+    TACHO_STORE_RELEASE(&Test_Decoded[i], Test_Decoded[i] + 1U);
+}
+
+/**
+ * Thread waiting once on an event
+ * @param arg Test_Wait_t
+ * @return NULL
+ */
+static void *Test_Waiter(void *arg)
+{
+    Test_Wait_t *wait = (Test_Wait_t *) arg;
+
+    wait->woken = Tacho_WakeupPosixWait(wait->event, wait->timeout_ms);
+    return NULL_PTR;
+}
+
+/**
+ * Producer thread: feeds the frames of a context byte by byte, the next one
+ * once the decoder thread is done with the previous one
+ * @param arg Context index
+ * @return NULL
+ */
+static void *Test_Producer(void *arg)
+{
+    uint32_t i = *(const uint32_t *) arg;
+    uint8_t frame[BENCH_MAX_FRAME];
+    uint32_t k;
+    uint16_t n, b;
+
+    for (k = 0; k < TEST_FRAMES; k++)
+    {
+        n = Bench_Encode(TACHO_STANDARD_VDO, k, frame, sizeof(frame));
+        for (b = 0; b < n; b++)
+        {
+            Tacho_CtxRxNotif(&Test_Ctx[i], frame[b]);
+        }
+        while ( (k >= TACHO_LOAD_ACQUIRE(&Test_Decoded[i])) && (0U == TACHO_LOAD_RELAXED(&Test_Timeouts[i])) )
+        {
+            sched_yield();
+        }
+    }
+    return NULL_PTR;
+}
+
+/**
+ * Decoder thread: runs the task of a context each time its event is signalled
+ * @param arg Context index
+ * @return NULL
+ */
+static void *Test_Decoder(void *arg)
+{
+    uint32_t i = *(const uint32_t *) arg;
+
+    while (TEST_FRAMES > Test_Decoded[i])
+    {
+        if (FALSE == Tacho_WakeupPosixWait(&Test_Event[i], TEST_LONG_MS))
+        {
+            /* A lost wakeup: give up rather than hang */
+            TACHO_STORE_RELAXED(&Test_Timeouts[i], 1U);
+            break;
+        }
+        Tacho_CtxTask(&Test_Ctx[i]);
+    }
+    return NULL_PTR;
+}
+
+/**
+ * Checks waits and signals without a decoder
+ */
+static void Test_Events(void)
+{
+    pthread_t threads[TEST_CTXS];
+    Test_Wait_t waits[TEST_CTXS];
+    uint32_t base[TEST_CTXS];
+    uint64_t t0;
+    uint32_t i;
+
+    for (i = 0; i < TEST_CTXS; i++)
+    {
+        base[i] = Tacho_WakeupPosixCount(&Test_Event[i]);
+    }
+
+    /* Nothing signalled: both time out, not earlier than asked */
+    t0 = Bench_Nanos();
+    TEST_CHECK(FALSE == Tacho_WakeupPosixWait(&Test_Event[0], TEST_SHORT_MS));
+    TEST_CHECK(Bench_Nanos() - t0 >= TEST_SHORT_MS * TEST_NANOS_PER_MS);
+    TEST_CHECK(FALSE == Tacho_WakeupPosixWait(&Test_Event[1], 0U));
+
+    /* Signals without a waiter are remembered, for their own event only */
+    Tacho_WakeupPosixSignal(&Test_Ctx[0]);
+    Tacho_WakeupPosixSignal(&Test_Ctx[0]);
+    Tacho_WakeupPosixSignal(&Test_Ctx[0]);
+    TEST_CHECK(FALSE == Tacho_WakeupPosixWait(&Test_Event[1], 0U));
+    TEST_CHECK(TRUE == Tacho_WakeupPosixWait(&Test_Event[0], 0U));
+    TEST_CHECK(base[0] + 3U == Tacho_WakeupPosixCount(&Test_Event[0]));
+    TEST_CHECK(base[1] == Tacho_WakeupPosixCount(&Test_Event[1]));
+    TEST_CHECK(FALSE == Tacho_WakeupPosixWait(&Test_Event[0], 0U));
+
+    /* Both events waited on: the signal of context 0 wakes its waiter only */
+    waits[0].timeout_ms = TEST_LONG_MS;
+    waits[1].timeout_ms = TEST_SHORT_MS;
+    for (i = 0; i < TEST_CTXS; i++)
+    {
+        waits[i].event = &Test_Event[i];
+        TEST_CHECK(0 == pthread_create(&threads[i], NULL_PTR, Test_Waiter, &waits[i]));
+    }
+    Tacho_WakeupPosixSignal(&Test_Ctx[0]);
+    for (i = 0; i < TEST_CTXS; i++)
+    {
+        (void) pthread_join(threads[i], NULL_PTR);
+    }
+    TEST_CHECK(TRUE == waits[0].woken);
+    TEST_CHECK(FALSE == waits[1].woken);
+    TEST_CHECK(base[0] + 4U == Tacho_WakeupPosixCount(&Test_Event[0]));
+    TEST_CHECK(base[1] == Tacho_WakeupPosixCount(&Test_Event[1]));
+}
+
+/**
+ * Checks event-driven decoding of both contexts at once
+ */
+static void Test_Decoding(void)
+{
+    static const uint32_t index[TEST_CTXS] = { 0U, 1U };
+    pthread_t producers[TEST_CTXS];
+    pthread_t decoders[TEST_CTXS];
+    uint32_t signals[TEST_CTXS];
+    uint32_t wakeups[TEST_CTXS];
+    uint32_t i;
+
+    for (i = 0; i < TEST_CTXS; i++)
+    {
+        signals[i] = Tacho_WakeupPosixCount(&Test_Event[i]);
+        wakeups[i] = Test_Wakeups[i];
+        TEST_CHECK(0 == pthread_create(&decoders[i], NULL_PTR, Test_Decoder, (void *) &index[i]));
+        TEST_CHECK(0 == pthread_create(&producers[i], NULL_PTR, Test_Producer, (void *) &index[i]));
+    }
+    for (i = 0; i < TEST_CTXS; i++)
+    {
+        (void) pthread_join(producers[i], NULL_PTR);
+        (void) pthread_join(decoders[i], NULL_PTR);
+    }
+
+    for (i = 0; i < TEST_CTXS; i++)
+    {
+        /* Signals of the last task runs not waited for yet */
+        (void) Tacho_WakeupPosixWait(&Test_Event[i], 0U);
+        TEST_CHECK(0U == Test_Timeouts[i]);
+        TEST_CHECK(TEST_FRAMES == Test_Decoded[i]);
+        TEST_CHECK(0U == Tacho_CtxGetDroppedBytes(&Test_Ctx[i]));
+        TEST_CHECK(TEST_FRAMES <= Test_Wakeups[i] - wakeups[i]);
+        TEST_CHECK(Test_Wakeups[i] - wakeups[i] == Tacho_WakeupPosixCount(&Test_Event[i]) - signals[i]);
+    }
+}
+
+int main(void)
+{
+    Tacho_CtxConfig_t config;
+    uint32_t i;
+
+    memset(&config, 0, sizeof(config));
+    config.frame_notif = Test_FrameNotif;
+    config.wakeup = Test_Wakeup;
+    for (i = 0; i < TEST_CTXS; i++)
+    {
+        TEST_CHECK(E_OK == Tacho_WakeupPosixInit(&Test_Event[i]));
+        Tacho_CtxInit(&Test_Ctx[i], &config, &Test_Event[i]);
+        TEST_CHECK(E_OK == Bench_Select(&Test_Ctx[i], TACHO_STANDARD_VDO));
+        /* Framing errors sent to select the protocol woke the task too */
+        (void) Tacho_WakeupPosixWait(&Test_Event[i], 0U);
+    }
+
+    Test_Events();
+    Test_Decoding();
+
+    for (i = 0; i < TEST_CTXS; i++)
+    {
+        Tacho_WakeupPosixDeInit(&Test_Event[i]);
+    }
+    return Test_Result("test_wakeup");
+}